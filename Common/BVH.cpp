@@ -0,0 +1,107 @@
+// Gmsh - Copyright (C) 1997-2018 C. Geuzaine, J.-F. Remacle
+//
+// See the LICENSE.txt file for license information. Please report all
+// issues on https://gitlab.onelab.info/gmsh/gmsh/issues
+
+#include <cmath>
+#include <algorithm>
+#include "BVH.h"
+
+class centerLessThan {
+private:
+  const std::vector<double> &_centers;
+  int _axis;
+
+public:
+  centerLessThan(const std::vector<double> &centers, int axis)
+    : _centers(centers), _axis(axis)
+  {
+  }
+  bool operator()(int a, int b) const
+  {
+    return _centers[3 * a + _axis] < _centers[3 * b + _axis];
+  }
+};
+
+void BVH::clear()
+{
+  std::vector<node>().swap(_nodes);
+  std::vector<int>().swap(_items);
+  std::vector<int>().swap(_leaf);
+  std::vector<double>().swap(_boxes);
+}
+
+void BVH::build(const std::vector<double> &boxes, int leafSize)
+{
+  clear();
+  int n = boxes.size() / 6;
+  if(!n) return;
+  _boxes.assign(boxes.begin(), boxes.begin() + 6 * n);
+  _items.resize(n);
+  std::vector<double> centers(3 * n);
+  for(int i = 0; i < n; i++) {
+    _items[i] = i;
+    for(int j = 0; j < 3; j++)
+      centers[3 * i + j] = 0.5 * (boxes[6 * i + j] + boxes[6 * i + 3 + j]);
+  }
+  _nodes.reserve(2 * (n / std::max(1, leafSize) + 1));
+  _build(boxes, centers, 0, n, std::max(1, leafSize));
+  _leaf.resize(n);
+  for(std::size_t i = 0; i < _nodes.size(); i++)
+    for(int k = _nodes[i].first; k < _nodes[i].first + _nodes[i].count; k++)
+      _leaf[_items[k]] = i;
+}
+
+int BVH::_build(const std::vector<double> &boxes,
+                const std::vector<double> &centers, int begin, int end,
+                int leafSize)
+{
+  int index = _nodes.size();
+  _nodes.push_back(node());
+  double box[6] = {1.e300, 1.e300, 1.e300, -1.e300, -1.e300, -1.e300};
+  double cmin[3] = {1.e300, 1.e300, 1.e300};
+  double cmax[3] = {-1.e300, -1.e300, -1.e300};
+  for(int k = begin; k < end; k++) {
+    int i = _items[k];
+    for(int j = 0; j < 3; j++) {
+      box[j] = std::min(box[j], boxes[6 * i + j]);
+      box[3 + j] = std::max(box[3 + j], boxes[6 * i + 3 + j]);
+      cmin[j] = std::min(cmin[j], centers[3 * i + j]);
+      cmax[j] = std::max(cmax[j], centers[3 * i + j]);
+    }
+  }
+  for(int j = 0; j < 6; j++) _nodes[index].box[j] = box[j];
+
+  // split at the median of the centers along the largest extent
+  int axis = 0;
+  for(int j = 1; j < 3; j++)
+    if(cmax[j] - cmin[j] > cmax[axis] - cmin[axis]) axis = j;
+  if(end - begin <= leafSize || cmax[axis] <= cmin[axis]) {
+    _nodes[index].first = begin;
+    _nodes[index].count = end - begin;
+    return index;
+  }
+  int mid = (begin + end) / 2;
+  std::nth_element(_items.begin() + begin, _items.begin() + mid,
+                   _items.begin() + end, centerLessThan(centers, axis));
+  _build(boxes, centers, begin, mid, leafSize);
+  int right = _build(boxes, centers, mid, end, leafSize);
+  _nodes[index].first = right;
+  _nodes[index].count = 0;
+  return index;
+}
+
+double BVH::_distance(int i, const double *p) const
+{
+  const double *b = _nodes[i].box;
+  double d2 = 0.;
+  for(int j = 0; j < 3; j++) {
+    double d = 0.;
+    if(p[j] < b[j])
+      d = b[j] - p[j];
+    else if(p[j] > b[3 + j])
+      d = p[j] - b[3 + j];
+    d2 += d * d;
+  }
+  return sqrt(d2);
+}
@@ -0,0 +1,150 @@
+// Gmsh - Copyright (C) 1997-2018 C. Geuzaine, J.-F. Remacle
+//
+// See the LICENSE.txt file for license information. Please report all
+// issues on https://gitlab.onelab.info/gmsh/gmsh/issues
+
+#ifndef _BVH_H_
+#define _BVH_H_
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+// A bounding volume hierarchy over a set of items (typically mesh elements)
+// given by their axis-aligned bounding boxes. The nodes are stored in a flat
+// array in depth-first order (the left child of an inner node directly follows
+// it), and the items of each leaf are contiguous in a permutation array. The
+// tree is not modified by the queries, which can thus be run concurrently by
+// several threads once it is built.
+class BVH {
+private:
+  struct node {
+    double box[6]; // xmin, ymin, zmin, xmax, ymax, zmax
+    int first; // first item of a leaf, or right child of an inner node
+    int count; // number of items of a leaf, 0 for an inner node
+  };
+  std::vector<node> _nodes;
+  std::vector<int> _items;
+  std::vector<int> _leaf; // leaf of each item
+  std::vector<double> _boxes; // bounding box of each item
+  int _build(const std::vector<double> &boxes,
+             const std::vector<double> &centers, int begin, int end,
+             int leafSize);
+  // distance between the point p and the box of node i (0 if p is inside)
+  double _distance(int i, const double *p) const;
+  bool _inside(int i, const double *p, double tol) const
+  {
+    const double *b = _nodes[i].box;
+    return (p[0] >= b[0] - tol && p[0] <= b[3] + tol && p[1] >= b[1] - tol &&
+            p[1] <= b[4] + tol && p[2] >= b[2] - tol && p[2] <= b[5] + tol);
+  }
+  bool _itemInside(int i, const double *p, double tol) const
+  {
+    const double *b = &_boxes[6 * i];
+    return (p[0] >= b[0] - tol && p[0] <= b[3] + tol && p[1] >= b[1] - tol &&
+            p[1] <= b[4] + tol && p[2] >= b[2] - tol && p[2] <= b[5] + tol);
+  }
+  // the tree is balanced: its depth is bounded by the number of bits of the
+  // number of items
+  enum { MAX_DEPTH = 64 };
+
+public:
+  BVH() {}
+  // build the tree over the items whose bounding boxes are given as 6
+  // consecutive values (xmin, ymin, zmin, xmax, ymax, zmax) per item
+  void build(const std::vector<double> &boxes, int leafSize = 4);
+  void clear();
+  bool empty() const { return _items.empty(); }
+  std::size_t getNumItems() const { return _items.size(); }
+  // bounding box of all the items
+  const double *getBoundingBox() const { return _nodes[0].box; }
+
+  // return the item i minimizing f(i, p), as well as the minimum in dist, or
+  // -1 if no item is closer than maxDist; f(i, p) must not be smaller than the
+  // distance between p and the bounding box of item i, which is used to prune
+  // the tree
+  template <class F>
+  int closest(const double *p, const F &f, double &dist,
+              double maxDist = 1.e300) const
+  {
+    int best = -1;
+    dist = maxDist;
+    if(_items.empty()) return best;
+    int stack[2 * MAX_DEPTH];
+    double dstack[2 * MAX_DEPTH];
+    int n = 0;
+    stack[n] = 0;
+    dstack[n++] = _distance(0, p);
+    while(n) {
+      n--;
+      if(dstack[n] >= dist) continue;
+      const node &nd = _nodes[stack[n]];
+      if(nd.count) {
+        for(int k = nd.first; k < nd.first + nd.count; k++) {
+          double d = f(_items[k], p);
+          if(d < dist) {
+            dist = d;
+            best = _items[k];
+          }
+        }
+      }
+      else {
+        // visit the closest child first
+        int l = stack[n] + 1, r = nd.first;
+        double dl = _distance(l, p), dr = _distance(r, p);
+        if(dl < dr) {
+          std::swap(l, r);
+          std::swap(dl, dr);
+        }
+        if(dl < dist) {
+          stack[n] = l;
+          dstack[n++] = dl;
+        }
+        if(dr < dist) {
+          stack[n] = r;
+          dstack[n++] = dr;
+        }
+      }
+    }
+    return best;
+  }
+
+  // call f(i) for the items i whose bounding box (enlarged by tol) contains
+  // the point p, until f returns true; return the corresponding item, or -1.
+  // If a hint is given (typically the item found for a previous, nearby
+  // point), the hint and the other items of its leaf are tried first.
+  template <class F>
+  int find(const double *p, F &f, double tol = 0., int hint = -1) const
+  {
+    if(_items.empty()) return -1;
+    if(hint >= 0 && hint < (int)_leaf.size()) {
+      if(_itemInside(hint, p, tol) && f(hint)) return hint;
+      const node &nd = _nodes[_leaf[hint]];
+      if(_inside(_leaf[hint], p, tol)) {
+        for(int k = nd.first; k < nd.first + nd.count; k++)
+          if(_items[k] != hint && _itemInside(_items[k], p, tol) &&
+             f(_items[k]))
+            return _items[k];
+      }
+    }
+    int stack[2 * MAX_DEPTH];
+    int n = 0;
+    stack[n++] = 0;
+    while(n) {
+      int i = stack[--n];
+      if(!_inside(i, p, tol)) continue;
+      const node &nd = _nodes[i];
+      if(nd.count) {
+        for(int k = nd.first; k < nd.first + nd.count; k++)
+          if(_itemInside(_items[k], p, tol) && f(_items[k])) return _items[k];
+      }
+      else {
+        stack[n++] = nd.first;
+        stack[n++] = i + 1;
+      }
+    }
+    return -1;
+  }
+};
+
+#endif
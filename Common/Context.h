@@ -24,7 +24,7 @@ struct contextMeshOptions {
   double qualityInf, qualitySup, radiusInf, radiusSup;
   double lcMin, lcMax, toleranceEdgeLength, toleranceInitialDelaunay;
   double anisoMax, smoothRatio;
-  int lcFromPoints, lcFromCurvature, lcExtendFromBoundary;
+  int lcFromPoints, lcFromCurvature, lcExtendFromBoundary, lcCache;
   int nbSmoothing, algo2d, algo3d, algoSubdivide;
   int algoRecombine, recombineAll, recombine3DAll, recombine3DLevel;
   int recombine3DConformity, flexibleTransfinite;
@@ -280,7 +280,7 @@ public:
     int smooth, animCycle, animStep, combineTime, combineRemoveOrig;
     int fileFormat, plugins, forceNodeData, forceElementData;
     int saveMesh, saveInterpolationMatrices;
-    double animDelay;
+    double animDelay, maxStepMemory;
     std::string doubleClickedGraphPointCommand;
     double doubleClickedGraphPointX, doubleClickedGraphPointY;
     int doubleClickedView;
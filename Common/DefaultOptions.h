@@ -1006,6 +1006,10 @@ StringXNumber MeshOptions_Number[] = {
    "(1, 2, 4, 8, ...)" },
   { F|O, "CgnsConstructTopology" , opt_mesh_cgns_construct_topology , 0. ,
    "Reconstruct the model topology (BREP) after reading a CGNS file" },
+  { F|O, "CharacteristicLengthCache" , opt_mesh_lc_cache , 0. ,
+    "Number of mesh element sizes computed from the background field that are "
+    "cached (per thread) during mesh generation, to avoid evaluating the field "
+    "several times at the same point (0: no cache)" },
   { F|O, "CharacteristicLengthExtendFromBoundary" ,
     opt_mesh_lc_extend_from_boundary, 1. ,
     "Extend computation of mesh element sizes from the boundaries into the interior "
@@ -1378,6 +1382,12 @@ StringXNumber PostProcessingOptions_Number[] = {
     "Post-processing view links (0: apply next option changes to selected views, "
     "1: force same options for all selected views)" },
 
+  { F|O, "MaxStepMemory" , opt_post_max_step_memory , 0. ,
+    "Maximum memory (in Mb) used by the time steps of model-based views read "
+    "from MSH files (0: no limit); beyond this budget the least recently used "
+    "steps are dropped from memory, and read again from the file when needed. "
+    "Binary node and element data are then only decoded when first accessed" },
+
   { F,   "NbViews" , opt_post_nb_views , 0. ,
     "Current number of views merged (read-only)" },
 
@@ -9,6 +9,18 @@
 #include "MallocUtils.h"
 #include "GmshMessage.h"
 
+#if defined(WIN32) && !defined(__CYGWIN__)
+#include <malloc.h>
+#endif
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#define POOL_GRANULARITY 8
+#define POOL_MAX_SIZE 256
+#define POOL_CHUNK_SIZE 65536
+
 void *Malloc(size_t size)
 {
   void *ptr;
@@ -42,3 +54,217 @@ void Free(void *ptr)
   if(ptr == NULL) return;
   free(ptr);
 }
+
+// free objects are linked through their first bytes
+struct poolFreeObject {
+  poolFreeObject *next;
+};
+
+struct poolThread;
+
+// chunks are aligned on their size, so that the chunk of an object (and thus
+// the pool that owns it) is found by masking its address; they are linked
+// through their first bytes, the objects being carved out of the rest of the
+// chunk
+struct poolChunk {
+  poolChunk *next;
+  poolThread *owner;
+  double align;
+};
+
+struct poolSizeClass {
+  poolFreeObject *freeList;
+  char *next, *end;
+};
+
+#define POOL_NUM_CLASSES (POOL_MAX_SIZE / POOL_GRANULARITY)
+
+// the pool of a thread: each thread allocates from and frees to its own pool,
+// without any lock. An object freed by another thread than the one that
+// allocated it is given back to the pool of its owner, through a list of
+// remote frees protected by a critical section; the owner recycles these
+// objects once its own free list is empty. Pools are allocated on the heap
+// (only a pointer to it is thread-private) and are registered in a global
+// list, so that they can all be released at once.
+struct poolThread {
+  poolSizeClass classes[POOL_NUM_CLASSES];
+  poolChunk *chunks;
+  long live;
+  // objects freed by other threads, and their number
+  poolFreeObject *remote[POOL_NUM_CLASSES];
+  long remoteFreed;
+  int hasRemote;
+  poolThread *next;
+};
+
+static poolThread *currentPool = 0;
+#if defined(_OPENMP)
+#pragma omp threadprivate(currentPool)
+#endif
+
+static poolThread *allPools = 0;
+
+static poolThread *getPool()
+{
+  if(!currentPool) {
+    poolThread *p = (poolThread *)Calloc(1, sizeof(poolThread));
+#if defined(_OPENMP)
+#pragma omp critical(PoolRegister)
+#endif
+    {
+      p->next = allPools;
+      allPools = p;
+    }
+    currentPool = p;
+  }
+  return currentPool;
+}
+
+static poolChunk *allocateChunk()
+{
+  void *ptr = 0;
+#if defined(WIN32) && !defined(__CYGWIN__)
+  ptr = _aligned_malloc(POOL_CHUNK_SIZE, POOL_CHUNK_SIZE);
+#else
+  if(posix_memalign(&ptr, POOL_CHUNK_SIZE, POOL_CHUNK_SIZE)) ptr = 0;
+#endif
+  if(ptr == NULL) Msg::Fatal("Out of memory (buy some more RAM!)");
+  return (poolChunk *)ptr;
+}
+
+static void freeChunk(poolChunk *chunk)
+{
+#if defined(WIN32) && !defined(__CYGWIN__)
+  _aligned_free(chunk);
+#else
+  free(chunk);
+#endif
+}
+
+static poolChunk *getChunk(void *ptr)
+{
+  return (poolChunk *)((char *)ptr - ((size_t)ptr & (POOL_CHUNK_SIZE - 1)));
+}
+
+// move the objects freed by other threads to the free lists of the pool
+static void recycleRemoteFrees(poolThread *t)
+{
+#if defined(_OPENMP)
+#pragma omp critical(PoolRemoteFree)
+#endif
+  {
+    for(int c = 0; c < POOL_NUM_CLASSES; c++) {
+      poolFreeObject *f = t->remote[c];
+      if(!f) continue;
+      while(f->next) f = f->next;
+      f->next = t->classes[c].freeList;
+      t->classes[c].freeList = t->remote[c];
+      t->remote[c] = 0;
+    }
+    t->live -= t->remoteFreed;
+    t->remoteFreed = 0;
+#if defined(_OPENMP)
+#pragma omp atomic write
+#endif
+    t->hasRemote = 0;
+  }
+}
+
+void *PoolMalloc(size_t size)
+{
+  if(size > POOL_MAX_SIZE) return Malloc(size);
+  if(!size) size = 1;
+  size_t c = (size - 1) / POOL_GRANULARITY;
+  size_t s = (c + 1) * POOL_GRANULARITY;
+  poolThread *t = getPool();
+  poolSizeClass &p = t->classes[c];
+  if(!p.freeList) {
+    int hasRemote;
+#if defined(_OPENMP)
+#pragma omp atomic read
+#endif
+    hasRemote = t->hasRemote;
+    if(hasRemote) recycleRemoteFrees(t);
+  }
+  void *ptr;
+  if(p.freeList) {
+    ptr = p.freeList;
+    p.freeList = p.freeList->next;
+  }
+  else {
+    if(p.next + s > p.end) {
+      // the rest of the previous chunk (less than one object) is lost
+      poolChunk *chunk = allocateChunk();
+      chunk->next = t->chunks;
+      chunk->owner = t;
+      t->chunks = chunk;
+      p.next = (char *)chunk + sizeof(poolChunk);
+      p.end = (char *)chunk + POOL_CHUNK_SIZE;
+    }
+    ptr = p.next;
+    p.next += s;
+  }
+  t->live++;
+  return ptr;
+}
+
+void PoolFree(void *ptr, size_t size)
+{
+  if(ptr == NULL) return;
+  if(size > POOL_MAX_SIZE) {
+    Free(ptr);
+    return;
+  }
+  if(!size) size = 1;
+  size_t c = (size - 1) / POOL_GRANULARITY;
+  poolThread *t = getChunk(ptr)->owner;
+  poolFreeObject *f = (poolFreeObject *)ptr;
+  if(t == currentPool) {
+    f->next = t->classes[c].freeList;
+    t->classes[c].freeList = f;
+    t->live--;
+    return;
+  }
+#if defined(_OPENMP)
+#pragma omp critical(PoolRemoteFree)
+#endif
+  {
+    f->next = t->remote[c];
+    t->remote[c] = f;
+    t->remoteFreed++;
+#if defined(_OPENMP)
+#pragma omp atomic write
+#endif
+    t->hasRemote = 1;
+  }
+}
+
+bool PoolRelease()
+{
+#if defined(_OPENMP)
+  if(omp_in_parallel()) return false;
+#endif
+  long live = 0;
+  for(poolThread *t = allPools; t; t = t->next)
+    live += t->live - t->remoteFreed;
+  if(live) return false;
+  int numChunks = 0;
+  for(poolThread *t = allPools; t; t = t->next) {
+    while(t->chunks) {
+      poolChunk *next = t->chunks->next;
+      freeChunk(t->chunks);
+      t->chunks = next;
+      numChunks++;
+    }
+    for(int c = 0; c < POOL_NUM_CLASSES; c++) {
+      t->classes[c].freeList = 0;
+      t->classes[c].next = t->classes[c].end = 0;
+      t->remote[c] = 0;
+    }
+    t->live = 0;
+    t->remoteFreed = 0;
+    t->hasRemote = 0;
+  }
+  if(numChunks) Msg::Debug("Released %d pool chunks", numChunks);
+  return true;
+}
@@ -13,4 +13,22 @@ void *Calloc(size_t num, size_t size);
 void *Realloc(void *ptr, size_t size);
 void Free(void *ptr);
 
+// Allocation of small objects that are created and destroyed in large numbers
+// (mesh vertices and elements): objects are carved out of 64 kB chunks, one
+// set of chunks per size class (rounded up to 8 bytes), and freed objects are
+// recycled through a free list of their size class. This avoids the per-object
+// overhead of malloc and keeps the objects created together contiguous in
+// memory. Each thread has its own pool, so that both functions can be called
+// concurrently from OpenMP threads without any lock. An object freed by
+// another thread is given back to the pool of the thread that allocated it.
+// Objects larger than 256 bytes are allocated with Malloc.
+void *PoolMalloc(size_t size);
+void PoolFree(void *ptr, size_t size);
+
+// Return the chunks of all the pools to the system if no object allocated
+// with PoolMalloc is alive anymore (typically once all the meshes have been
+// deleted); return false if objects are still alive or if called from within
+// a parallel region.
+bool PoolRelease();
+
 #endif
@@ -40,8 +40,10 @@
 
 #if !defined(WIN32) || defined(__CYGWIN__)
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/time.h>
 #include <sys/resource.h>
+#include <sys/mman.h>
 #endif
 
 #if defined(WIN32)
@@ -280,6 +282,24 @@ FILE *Fopen(const char *f, const char *mode)
 #endif
 }
 
+int64_t FileTell(FILE *fp)
+{
+#if defined(WIN32) && !defined(__CYGWIN__)
+  return _ftelli64(fp);
+#else
+  return ftello(fp);
+#endif
+}
+
+int FileSeek(FILE *fp, int64_t offset, int whence)
+{
+#if defined(WIN32) && !defined(__CYGWIN__)
+  return _fseeki64(fp, offset, whence);
+#else
+  return fseeko(fp, offset, whence);
+#endif
+}
+
 const char *GetEnvironmentVar(const char *var)
 {
 #if defined(WIN32) && !defined(__CYGWIN__)
@@ -764,3 +784,53 @@ void UnzipFile(const std::string &fileName, const std::string &prependDir)
   Msg::Error("Gmsh must be compiled with Zipper support to extract zip files");
 #endif
 }
+
+const char *MapFile(const std::string &fileName, std::size_t &size)
+{
+  // map the whole file read-only in memory; returns 0 if the file cannot be
+  // mapped (in which case the caller should fall back to standard reads)
+  size = 0;
+#if defined(WIN32) && !defined(__CYGWIN__)
+  setwbuf(0, fileName.c_str());
+  HANDLE file = CreateFileW(wbuf[0], GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if(file == INVALID_HANDLE_VALUE) return 0;
+  LARGE_INTEGER fileSize;
+  if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+    CloseHandle(file);
+    return 0;
+  }
+  HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(file);
+  if(!mapping) return 0;
+  // the view keeps a reference to the mapping, so we can close it right away
+  void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if(!data) return 0;
+  size = (std::size_t)fileSize.QuadPart;
+  return (const char *)data;
+#else
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if(fd < 0) return 0;
+  struct stat st;
+  if(fstat(fd, &st) || st.st_size <= 0) {
+    close(fd);
+    return 0;
+  }
+  void *data = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(data == MAP_FAILED) return 0;
+  size = st.st_size;
+  return (const char *)data;
+#endif
+}
+
+void UnmapFile(const char *data, std::size_t size)
+{
+  if(!data) return;
+#if defined(WIN32) && !defined(__CYGWIN__)
+  UnmapViewOfFile(data);
+#else
+  munmap((void *)data, size);
+#endif
+}
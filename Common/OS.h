@@ -8,8 +8,13 @@
 
 #include <string>
 #include <stdio.h>
+#include <stdint.h>
+#include <cstddef>
 
 FILE *Fopen(const char *f, const char *mode);
+// ftell and fseek with 64-bit offsets (a long only has 32 bits on Windows)
+int64_t FileTell(FILE *fp);
+int FileSeek(FILE *fp, int64_t offset, int whence);
 const char *GetEnvironmentVar(const char *var);
 void SetEnvironmentVar(const char *var, const char *val);
 double GetTimeInSeconds();
@@ -34,5 +39,7 @@ int SystemCallExe(const std::string &exe, const std::string &argsOrCommand,
 std::string GetCurrentWorkdir();
 void RedirectIOToConsole();
 void UnzipFile(const std::string &fileName, const std::string &prependDir = "");
+const char *MapFile(const std::string &fileName, std::size_t &size);
+void UnmapFile(const char *data, std::size_t size);
 
 #endif
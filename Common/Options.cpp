@@ -5187,6 +5187,12 @@ double opt_mesh_lc_from_points(OPT_ARGS_NUM)
   return CTX::instance()->mesh.lcFromPoints;
 }
 
+double opt_mesh_lc_cache(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET) CTX::instance()->mesh.lcCache = (int)val;
+  return CTX::instance()->mesh.lcCache;
+}
+
 double opt_mesh_lc_extend_from_boundary(OPT_ARGS_NUM)
 {
   if(action & GMSH_SET){
@@ -6669,6 +6675,13 @@ double opt_post_smooth(OPT_ARGS_NUM)
   return CTX::instance()->post.smooth;
 }
 
+double opt_post_max_step_memory(OPT_ARGS_NUM)
+{
+  if(action & GMSH_SET)
+    CTX::instance()->post.maxStepMemory = (val >= 0.) ? val : 0.;
+  return CTX::instance()->post.maxStepMemory;
+}
+
 double opt_post_anim_delay(OPT_ARGS_NUM)
 {
   if(action & GMSH_SET)
@@ -103,13 +103,7 @@ void VertexArray::add(double *x, double *y, double *z, SVector3 *n, unsigned cha
   int npe = getNumVerticesPerElement();
 
   if(boundary && npe == 3){
-    ElementData<3> e(x, y, z, n, r, g, b, a, ele);
-    ElementDataLessThan<3>::tolerance = (float)(CTX::instance()->lc * 1.e-12);
-    std::set<ElementData<3>, ElementDataLessThan<3> >::iterator it = _data3.find(e);
-    if(it == _data3.end())
-      _data3.insert(e);
-    else
-      _data3.erase(it);
+    _data3.push_back(ElementData<3>(x, y, z, n, r, g, b, a, ele));
     return;
   }
 
@@ -135,19 +129,62 @@ void VertexArray::add(double *x, double *y, double *z, SVector3 *n, unsigned cha
   }
 }
 
+// stable sort, with the chunks sorted concurrently and then merged pairwise
+template <class T, class Compare>
+static void parallelStableSort(std::vector<T> &v, Compare comp)
+{
+  int nc = 1;
+#if defined(_OPENMP)
+  if(v.size() > 10000) nc = Msg::GetMaxThreads();
+#endif
+  if(nc < 2){
+    std::stable_sort(v.begin(), v.end(), comp);
+    return;
+  }
+  std::vector<std::size_t> bounds(nc + 1);
+  for(int i = 0; i <= nc; i++) bounds[i] = (v.size() * i) / nc;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static, 1)
+#endif
+  for(int i = 0; i < nc; i++)
+    std::stable_sort(v.begin() + bounds[i], v.begin() + bounds[i + 1], comp);
+  for(int step = 1; step < nc; step *= 2){
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static, 1)
+#endif
+    for(int i = 0; i < nc - step; i += 2 * step){
+      int last = std::min(i + 2 * step, nc);
+      std::inplace_merge(v.begin() + bounds[i], v.begin() + bounds[i + step],
+                         v.begin() + bounds[last], comp);
+    }
+  }
+}
+
 void VertexArray::finalize()
 {
   if(_data3.size()){
-    std::set<ElementData<3>, ElementDataLessThan<3> >::iterator it = _data3.begin();
-    for(; it != _data3.end(); it++){
-      for(int i = 0; i < 3; i++){
-        _addVertex(it->x(i), it->y(i), it->z(i));
-        _addNormal(it->nx(i), it->ny(i), it->nz(i));
-        _addColor(it->r(i), it->g(i), it->b(i), it->a(i));
-        _addElement(it->ele());
+    // a triangle shared by two elements is not on the boundary: sort the
+    // triangles by barycenter and only keep those that appear an odd number
+    // of times
+    ElementDataLessThan<3> comp;
+    ElementDataLessThan<3>::tolerance = (float)(CTX::instance()->lc * 1.e-12);
+    parallelStableSort(_data3, comp);
+    std::size_t i = 0;
+    while(i < _data3.size()){
+      std::size_t j = i + 1;
+      while(j < _data3.size() && !comp(_data3[i], _data3[j])) j++;
+      if((j - i) % 2){
+        const ElementData<3> &d = _data3[i];
+        for(int k = 0; k < 3; k++){
+          _addVertex(d.x(k), d.y(k), d.z(k));
+          _addNormal(d.nx(k), d.ny(k), d.nz(k));
+          _addColor(d.r(k), d.g(k), d.b(k), d.a(k));
+          _addElement(d.ele());
+        }
       }
+      i = j;
     }
-    _data3.clear();
+    std::vector<ElementData<3> >().swap(_data3);
   }
   _barycenters.clear();
 }
@@ -349,4 +386,5 @@ void VertexArray::merge(VertexArray* va)
     _elements.insert(_elements.end(), va->firstElementPointer(),
                      va->lastElementPointer());
   }
+  _data3.insert(_data3.end(), va->_data3.begin(), va->_data3.end());
 }
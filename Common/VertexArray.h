@@ -155,7 +155,8 @@ private:
   std::vector<normal_type> _normals;
   std::vector<unsigned char> _colors;
   std::vector<MElement *> _elements;
-  std::set<ElementData<3>, ElementDataLessThan<3> > _data3;
+  // boundary (skin) triangles, sorted and reduced in finalize()
+  std::vector<ElementData<3> > _data3;
   std::set<Barycenter, BarycenterLessThan> _barycenters;
   // std::tr1::unordered_set<Barycenter, BarycenterHash, BarycenterEqual>
   // _barycenters;
@@ -212,7 +213,8 @@ public:
   void add(double *x, double *y, double *z, SVector3 *n, unsigned char *r = 0,
            unsigned char *g = 0, unsigned char *b = 0, unsigned char *a = 0,
            MElement *ele = 0, bool unique = true, bool boundary = false);
-  // finalize the arrays
+  // finalize the arrays (only the boundary triangles that were added an odd
+  // number of times are kept)
   void finalize();
   // sort the arrays with elements back to front wrt the eye position
   void sort(double x, double y, double z);
@@ -229,7 +231,9 @@ public:
                           double &max, int &numSteps, double &time,
                           double &xmin, double &ymin, double &zmin,
                           double &xmax, double &ymax, double &zmax);
-  // merge another vertex array into this one
+  // merge another vertex array into this one (the boundary triangles not
+  // finalized yet are merged too, so that per-thread chunks of an array can be
+  // filled independently and concatenated before finalize())
   void merge(VertexArray *va);
 };
 
@@ -881,7 +881,7 @@ GMSH_API void gmsh::model::mesh::getLastEntityError(vectorpair &dimTags)
     dimTags.push_back(std::pair<int, int>(e[i]->dim(), e[i]->tag()));
 }
 
-GMSH_API void gmsh::model::mesh::getLastNodeError(std::vector<int> &nodeTags)
+GMSH_API void gmsh::model::mesh::getLastNodeError(std::vector<std::size_t> &nodeTags)
 {
   if(!_isInitialized()) {
     throw -1;
@@ -892,7 +892,7 @@ GMSH_API void gmsh::model::mesh::getLastNodeError(std::vector<int> &nodeTags)
 }
 
 static void _getAdditionalNodesOnBoundary(GEntity *entity,
-                                          std::vector<int> &nodeTags,
+                                          std::vector<std::size_t> &nodeTags,
                                           std::vector<double> &coord,
                                           std::vector<double> &parametricCoord,
                                           bool parametric)
@@ -924,8 +924,8 @@ static void _getAdditionalNodesOnBoundary(GEntity *entity,
       if(entity->dim() == 2 && parametric) {
         SPoint2 param;
         if(!reparamMeshVertexOnFace(v, (GFace *)entity, param))
-          Msg::Warning("Failed to compute parameters of node %d on surface %d",
-                       v->getNum(), entity->tag());
+          Msg::Warning("Failed to compute parameters of node %lu on surface %d",
+                       (unsigned long)v->getNum(), entity->tag());
         parametricCoord.push_back(param.x());
         parametricCoord.push_back(param.y());
       }
@@ -942,23 +942,23 @@ static void _getAdditionalNodesOnBoundary(GEntity *entity,
       if(entity->dim() == 2 && parametric) {
         SPoint2 param;
         if(!reparamMeshVertexOnFace(v, (GFace *)entity, param))
-          Msg::Warning("Failed to compute parameters of node %d on surface %d",
-                       v->getNum(), entity->tag());
+          Msg::Warning("Failed to compute parameters of node %lu on surface %d",
+                       (unsigned long)v->getNum(), entity->tag());
         parametricCoord.push_back(param.x());
         parametricCoord.push_back(param.y());
       }
       else if(entity->dim() == 1 && parametric) {
         double param;
         if(!reparamMeshVertexOnEdge(v, (GEdge *)entity, param))
-          Msg::Warning("Failed to compute parameters of node %d on edge %d",
-                       v->getNum(), entity->tag());
+          Msg::Warning("Failed to compute parameters of node %lu on edge %d",
+                       (unsigned long)v->getNum(), entity->tag());
         parametricCoord.push_back(param);
       }
     }
   }
 }
 
-GMSH_API void gmsh::model::mesh::getNodes(std::vector<int> &nodeTags,
+GMSH_API void gmsh::model::mesh::getNodes(std::vector<std::size_t> &nodeTags,
                                           std::vector<double> &coord,
                                           std::vector<double> &parametricCoord,
                                           const int dim, const int tag,
@@ -1003,7 +1003,7 @@ GMSH_API void gmsh::model::mesh::getNodes(std::vector<int> &nodeTags,
   }
 }
 
-GMSH_API void gmsh::model::mesh::getNode(const int nodeTag,
+GMSH_API void gmsh::model::mesh::getNode(const std::size_t nodeTag,
                                          std::vector<double> &coord,
                                          std::vector<double> &parametricCoord)
 {
@@ -1012,7 +1012,7 @@ GMSH_API void gmsh::model::mesh::getNode(const int nodeTag,
   }
   MVertex *v = GModel::current()->getMeshVertexByTag(nodeTag);
   if(!v) {
-    Msg::Error("Unknown node %d", nodeTag);
+    Msg::Error("Unknown node %lu", nodeTag);
     throw 2;
   }
   coord.resize(3);
@@ -1035,7 +1035,7 @@ GMSH_API void gmsh::model::mesh::rebuildNodeCache(bool onlyIfNecessary)
 
 GMSH_API void
 gmsh::model::mesh::getNodesForPhysicalGroup(const int dim, const int tag,
-                                            std::vector<int> &nodeTags,
+                                            std::vector<std::size_t> &nodeTags,
                                             std::vector<double> &coord)
 {
   if(!_isInitialized()) {
@@ -1057,7 +1057,7 @@ gmsh::model::mesh::getNodesForPhysicalGroup(const int dim, const int tag,
 }
 
 GMSH_API void gmsh::model::mesh::setNodes(
-  const int dim, const int tag, const std::vector<int> &nodeTags,
+  const int dim, const int tag, const std::vector<std::size_t> &nodeTags,
   const std::vector<double> &coord, const std::vector<double> &parametricCoord)
 {
   if(!_isInitialized()) {
@@ -1087,7 +1087,7 @@ GMSH_API void gmsh::model::mesh::setNodes(
   // delete nodes and elements; this will also delete the model mesh cache
   ge->deleteMesh();
   for(int i = 0; i < numNodes; i++) {
-    int n = (numNodeTags ? nodeTags[i] : -1);
+    std::size_t n = (numNodeTags ? nodeTags[i] : 0);
     double x = coord[3 * i];
     double y = coord[3 * i + 1];
     double z = coord[3 * i + 2];
@@ -1235,8 +1235,10 @@ static unsigned int _getNumElementsByType(const int elementType, const int tag)
 }
 
 GMSH_API void gmsh::model::mesh::getElements(
-  std::vector<int> &elementTypes, std::vector<std::vector<int> > &elementTags,
-  std::vector<std::vector<int> > &nodeTags, const int dim, const int tag)
+  std::vector<int> &elementTypes,
+  std::vector<std::vector<std::size_t> > &elementTags,
+  std::vector<std::vector<std::size_t> > &nodeTags, const int dim,
+  const int tag)
 {
   if(!_isInitialized()) {
     throw -1;
@@ -1250,8 +1252,8 @@ GMSH_API void gmsh::model::mesh::getElements(
         typeMap.begin();
       it != typeMap.end(); it++) {
     elementTypes.push_back(it->first);
-    elementTags.push_back(std::vector<int>());
-    nodeTags.push_back(std::vector<int>());
+    elementTags.push_back(std::vector<std::size_t>());
+    nodeTags.push_back(std::vector<std::size_t>());
     int elementType = it->first;
     for(unsigned int i = 0; i < it->second.size(); i++) {
       GEntity *ge = it->second[i];
@@ -1268,16 +1270,16 @@ GMSH_API void gmsh::model::mesh::getElements(
   }
 }
 
-GMSH_API void gmsh::model::mesh::getElement(const int elementTag,
+GMSH_API void gmsh::model::mesh::getElement(const std::size_t elementTag,
                                             int &elementType,
-                                            std::vector<int> &nodeTags)
+                                            std::vector<std::size_t> &nodeTags)
 {
   if(!_isInitialized()) {
     throw -1;
   }
   MElement *e = GModel::current()->getMeshElementByTag(elementTag);
   if(!e) {
-    Msg::Error("Unknown element %d", elementTag);
+    Msg::Error("Unknown element %lu", elementTag);
     throw 2;
   }
   elementType = e->getTypeForMSH();
@@ -1285,7 +1287,7 @@ GMSH_API void gmsh::model::mesh::getElement(const int elementTag,
   for(std::size_t i = 0; i < e->getNumVertices(); i++) {
     MVertex *v = e->getVertex(i);
     if(!v) {
-      Msg::Error("Unknown node in element %d", elementTag);
+      Msg::Error("Unknown node in element %lu", elementTag);
       throw 2;
     }
     nodeTags.push_back(v->getNum());
@@ -1293,8 +1295,8 @@ GMSH_API void gmsh::model::mesh::getElement(const int elementTag,
 }
 
 GMSH_API void gmsh::model::mesh::getElementByCoordinates(
-  const double x, const double y, const double z, int &elementTag,
-  int &elementType, std::vector<int> &nodeTags)
+  const double x, const double y, const double z, std::size_t &elementTag,
+  int &elementType, std::vector<std::size_t> &nodeTags)
 {
   if(!_isInitialized()) {
     throw -1;
@@ -1311,7 +1313,7 @@ GMSH_API void gmsh::model::mesh::getElementByCoordinates(
   for(std::size_t i = 0; i < e->getNumVertices(); i++) {
     MVertex *v = e->getVertex(i);
     if(!v) {
-      Msg::Error("Unknown node in element %d", elementTag);
+      Msg::Error("Unknown node in element %lu", elementTag);
       throw 2;
     }
     nodeTags.push_back(v->getNum());
@@ -1328,8 +1330,8 @@ static void _addElements(int dim, int tag, const std::vector<MElement *> &src,
 
 GMSH_API void gmsh::model::mesh::setElements(
   const int dim, const int tag, const std::vector<int> &elementTypes,
-  const std::vector<std::vector<int> > &elementTags,
-  const std::vector<std::vector<int> > &nodeTags)
+  const std::vector<std::vector<std::size_t> > &elementTags,
+  const std::vector<std::vector<std::size_t> > &nodeTags)
 {
   if(!_isInitialized()) {
     throw -1;
@@ -1366,14 +1368,14 @@ GMSH_API void gmsh::model::mesh::setElements(
     std::vector<MElement *> elements(numEle);
     std::vector<MVertex *> nodes(numVertPerEle);
     for(unsigned int j = 0; j < numEle; j++) {
-      int etag = (numEleTags ? elementTags[i][j] : -1);
+      std::size_t etag = (numEleTags ? elementTags[i][j] : 0);
       MElementFactory f;
       for(unsigned int k = 0; k < numVertPerEle; k++) {
-        int vtag = nodeTags[i][numVertPerEle * j + k];
+        std::size_t vtag = nodeTags[i][numVertPerEle * j + k];
         // this will rebuild the node cache if necessary
         nodes[k] = GModel::current()->getMeshVertexByTag(vtag);
         if(!nodes[k]) {
-          Msg::Error("Unknown node %d", vtag);
+          Msg::Error("Unknown node %lu", vtag);
           throw 2;
         }
       }
@@ -1466,8 +1468,9 @@ GMSH_API void gmsh::model::mesh::getElementProperties(
 
 GMSH_API void
 gmsh::model::mesh::getElementsByType(const int elementType,
-                                     std::vector<int> &elementTags,
-                                     std::vector<int> &nodeTags, const int tag,
+                                     std::vector<std::size_t> &elementTags,
+                                     std::vector<std::size_t> &nodeTags,
+                                     const int tag,
                                      const size_t task, const size_t numTasks)
 {
   if(!_isInitialized()) {
@@ -1492,12 +1495,12 @@ gmsh::model::mesh::getElementsByType(const int elementType,
                               elementTags, nodeTags, tag);
   }
   if(haveElementTags && (elementTags.size() < numElements)) {
-    Msg::Error("Wrong size of elementTags array (%d < %d)", elementTags.size(),
-               numElements);
+    Msg::Error("Wrong size of elementTags array (%lu < %lu)",
+               elementTags.size(), numElements);
     throw 4;
   }
   if(haveNodeTags && (nodeTags.size() < numElements * numNodes)) {
-    Msg::Error("Wrong size of nodeTags array (%d < %d)", nodeTags.size(),
+    Msg::Error("Wrong size of nodeTags array (%lu < %lu)", nodeTags.size(),
                numElements * numNodes);
     throw 4;
   }
@@ -1523,7 +1526,8 @@ gmsh::model::mesh::getElementsByType(const int elementType,
 
 GMSH_API void gmsh::model::mesh::preallocateElementsByType(
   const int elementType, const bool elementTag, const bool nodeTag,
-  std::vector<int> &elementTags, std::vector<int> &nodeTags, const int tag)
+  std::vector<std::size_t> &elementTags, std::vector<std::size_t> &nodeTags,
+  const int tag)
 {
   if(!_isInitialized()) {
     throw -1;
@@ -3771,7 +3775,7 @@ GMSH_API void gmsh::view::getTags(std::vector<int> &tags)
 
 GMSH_API void gmsh::view::addModelData(
   const int tag, const int step, const std::string &modelName,
-  const std::string &dataType, const std::vector<int> &tags,
+  const std::string &dataType, const std::vector<std::size_t> &tags,
   const std::vector<std::vector<double> > &data, const double time,
   const int numComponents, const int partition)
 {
@@ -3833,7 +3837,7 @@ GMSH_API void gmsh::view::addModelData(
 
 GMSH_API void gmsh::view::getModelData(const int tag, const int step,
                                        std::string &dataType,
-                                       std::vector<int> &tags,
+                                       std::vector<std::size_t> &tags,
                                        std::vector<std::vector<double> > &data,
                                        double &time, int &numComponents)
 {
@@ -3899,7 +3903,8 @@ GMSH_API void gmsh::view::getModelData(const int tag, const int step,
 
 // for better performance, manual C implementation of gmsh::view::getModelData
 GMSH_API void gmshViewGetModelData(const int tag, const int step,
-                                   char **dataType, int **tags, size_t *tags_n,
+                                   char **dataType, size_t **tags,
+                                   size_t *tags_n,
                                    double ***data, size_t **data_n,
                                    size_t *data_nn, double *time,
                                    int *numComponents, int *ierr)
@@ -3946,7 +3951,7 @@ GMSH_API void gmshViewGetModelData(const int tag, const int step,
   }
   if(!numEnt) return;
   *data = (double **)Malloc(numEnt * sizeof(double *));
-  *tags = (int *)Malloc(numEnt * sizeof(int));
+  *tags = (size_t *)Malloc(numEnt * sizeof(size_t));
   int j = 0;
   for(int i = 0; i < s->getNumData(); i++) {
     double *dd = s->getData(i);
@@ -97,7 +97,7 @@ statisticsWindow::statisticsWindow(int deltaFontSize)
 
   int num = 0;
   int width = 26 * FL_NORMAL_SIZE;
-  int height = 5 * WB + 18 * BH;
+  int height = 5 * WB + 19 * BH;
 
   win = new paletteWindow(width, height,
                           CTX::instance()->nonModalWindows ? true : false,
@@ -152,6 +152,11 @@ statisticsWindow::statisticsWindow(int deltaFontSize)
       value[num] = new Fl_Output(2 * WB, 2 * WB + 16 * BH, IW, BH, "SIGE");
       value[num]->tooltip("~ signed inverse error on gradient FE solution");
       num++;
+      value[num] =
+        new Fl_Output(2 * WB, 2 * WB + 17 * BH, IW, BH, "Size cache");
+      value[num]->tooltip("Number of mesh sizes found in the cache / "
+                          "computed during the last mesh generation");
+      num++;
 
       for(int i = 0; i < 3; i++) {
         int ww = 3 * FL_NORMAL_SIZE;
@@ -319,6 +324,9 @@ void statisticsWindow::compute(bool elementQuality)
     value[num]->value(label[num]);
     num++;
   }
+  sprintf(label[num], "%g / %g", s[38], s[39]);
+  value[num]->value(label[num]);
+  num++;
 
   // post
   sprintf(label[num], "%g", s[27]);
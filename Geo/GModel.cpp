@@ -36,6 +36,7 @@
 #include "Context.h"
 #include "OS.h"
 #include "StringUtils.h"
+#include "MallocUtils.h"
 #include "GEdgeLoop.h"
 #include "MVertexRTree.h"
 #include "OpenFile.h"
@@ -69,7 +70,8 @@ int GModel::_current = -1;
 GModel::GModel(const std::string &name)
   : _maxVertexNum(0), _maxElementNum(0), _checkPointedMaxVertexNum(0),
     _checkPointedMaxElementNum(0), _destroying(false), _name(name), _visible(1),
-    _elementOctree(0), _geo_internals(0), _occ_internals(0), _acis_internals(0),
+    _vertexCacheReady(0), _elementCacheReady(0), _elementOctree(0),
+    _geo_internals(0), _occ_internals(0), _acis_internals(0),
     _fields(0), _currentMeshEntity(0), _numPartitions(0),
     normals(0)
 {
@@ -189,6 +191,7 @@ void GModel::destroy(bool keepName)
   std::set<GVertex *, GEntityLessThan>().swap(vertices);
 
   destroyMeshCaches();
+  PoolRelease();
 
   _resetOCCInternals();
 
@@ -205,14 +208,14 @@ void GModel::destroy(bool keepName)
 
 void GModel::destroyMeshCaches()
 {
+  _vertexCacheReady = 0;
+  _elementCacheReady = 0;
   _vertexVectorCache.clear();
   std::vector<MVertex *>().swap(_vertexVectorCache);
   _vertexMapCache.clear();
-  std::map<int, MVertex *>().swap(_vertexMapCache);
   _elementVectorCache.clear();
   std::vector<MElement *>().swap(_elementVectorCache);
   _elementMapCache.clear();
-  std::map<int, MElement *>().swap(_elementMapCache);
   _elementIndexCache.clear();
   std::map<int, int>().swap(_elementIndexCache);
   delete _elementOctree;
@@ -233,6 +236,9 @@ void GModel::deleteMesh(bool deleteOnlyElements)
   _currentMeshEntity = 0;
   _lastMeshEntityError.clear();
   _lastMeshVertexError.clear();
+  // give the memory of the vertex and element pools back to the system if no
+  // other mesh is alive
+  PoolRelease();
 }
 
 bool GModel::empty() const
@@ -889,11 +895,14 @@ addToMap(std::multimap<MFace, MElement *, Less_Face> &faceToElement,
     faceToElement.insert(std::pair<MFace, MElement *>(face, el));
     if(faceToElement.count(face) > 2) {
       Msg::Error(
-        "Topological fault: Face sharing two other faces. Element %i. "
-        "Number of nodes %i. Count of faces: %i Three first nodes %i %i %i",
-        el->getNum(), face.getNumVertices(), faceToElement.count(face),
-        face.getVertex(0)->getNum(), face.getVertex(1)->getNum(),
-        face.getVertex(2)->getNum());
+        "Topological fault: Face sharing two other faces. Element %lu. "
+        "Number of nodes %lu. Count of faces: %lu Three first nodes %lu %lu "
+        "%lu",
+        (unsigned long)el->getNum(), (unsigned long)face.getNumVertices(),
+        (unsigned long)faceToElement.count(face),
+        (unsigned long)face.getVertex(0)->getNum(),
+        (unsigned long)face.getVertex(1)->getNum(),
+        (unsigned long)face.getVertex(2)->getNum());
       return;
     }
     MFace outFace = fit->first;
@@ -921,8 +930,9 @@ checkConformity(std::multimap<MFace, MElement *, Less_Face> &faceToElement,
   if(ElementType::getParentType(el->getType()) == TYPE_TRIH) {
     // Each face of a trihedron should exist twice (no face on the boundary)
     if(connectivity != 2)
-      Msg::Error("Non conforming trihedron %i (nb connections for a face %i)",
-                 el->getNum(), faceToElement.count(face));
+      Msg::Error("Non conforming trihedron %lu (nb connections for a face %lu)",
+                 (unsigned long)el->getNum(),
+                 (unsigned long)faceToElement.count(face));
   }
   else {
     // A face can exist  twice (inside) or once (boundary)
@@ -930,13 +940,14 @@ checkConformity(std::multimap<MFace, MElement *, Less_Face> &faceToElement,
       for(std::size_t iV = 0; iV < face.getNumVertices(); iV++)
         if(face.getVertex(iV)->onWhat()->dim() == 3 || connectivity != 1) {
           for(std::size_t jV = 0; jV < face.getNumVertices(); jV++)
-            Msg::Info("Vertex %i dim %i", face.getVertex(jV)->getNum(),
+            Msg::Info("Vertex %lu dim %i",
+                      (unsigned long)face.getVertex(jV)->getNum(),
                       face.getVertex(iV)->onWhat()->dim());
-          Msg::Error("Non conforming element %i (%i connection(s) for a face "
-                     "located on dim %i (vertex %i))",
-                     el->getNum(), connectivity,
+          Msg::Error("Non conforming element %lu (%i connection(s) for a face "
+                     "located on dim %i (vertex %lu))",
+                     (unsigned long)el->getNum(), connectivity,
                      face.getVertex(iV)->onWhat()->dim(),
-                     face.getVertex(iV)->getNum());
+                     (unsigned long)face.getVertex(iV)->getNum());
         }
     }
   }
@@ -1303,71 +1314,141 @@ int GModel::getNumMeshElements(unsigned c[6])
   return 0;
 }
 
-MElement *GModel::getMeshElementByCoord(SPoint3 &p, int dim, bool strict)
+MElementOctree *GModel::_getElementOctree()
 {
-  if(!_elementOctree) {
-    Msg::Debug("Rebuilding mesh element octree");
-    _elementOctree = new MElementOctree(this);
+  // the search structure can be requested concurrently by several threads
+  // (e.g. by plugins locating points in parallel): it is built once and then
+  // only read
+  MElementOctree *octree;
+#if defined(_OPENMP)
+#pragma omp atomic read
+#endif
+  octree = _elementOctree;
+#if defined(_OPENMP)
+#pragma omp flush
+#endif
+  if(octree) return octree;
+#if defined(_OPENMP)
+#pragma omp critical(GModelElementOctree)
+#endif
+  {
+    if(!_elementOctree) {
+      Msg::Debug("Rebuilding mesh element octree");
+      octree = new MElementOctree(this);
+#if defined(_OPENMP)
+#pragma omp flush
+#pragma omp atomic write
+#endif
+      _elementOctree = octree;
+    }
+    octree = _elementOctree;
   }
-  return _elementOctree->find(p.x(), p.y(), p.z(), dim, strict);
+  return octree;
+}
+
+MElement *GModel::getMeshElementByCoord(SPoint3 &p, int dim, bool strict,
+                                        MElement *hint)
+{
+  return _getElementOctree()->find(p.x(), p.y(), p.z(), dim, strict, hint);
 }
 
 std::vector<MElement *> GModel::getMeshElementsByCoord(SPoint3 &p, int dim,
                                                        bool strict)
 {
-  if(!_elementOctree) {
-    Msg::Debug("Rebuilding mesh element octree");
-    _elementOctree = new MElementOctree(this);
-  }
-  return _elementOctree->findAll(p.x(), p.y(), p.z(), dim, strict);
+  return _getElementOctree()->findAll(p.x(), p.y(), p.z(), dim, strict);
 }
 
 void GModel::rebuildMeshVertexCache(bool onlyIfNecessary)
 {
   if(!onlyIfNecessary ||
      (_vertexVectorCache.empty() && _vertexMapCache.empty())) {
+    _vertexCacheReady = 0;
     _vertexVectorCache.clear();
     _vertexMapCache.clear();
+    std::size_t numVertices = getNumMeshVertices();
     bool dense = false;
-    if(_maxVertexNum == getNumMeshVertices()) {
+    if(_maxVertexNum == numVertices) {
       Msg::Debug("We have a dense vertex numbering in the cache");
       dense = true;
     }
-    else if(_maxVertexNum < 10 * getNumMeshVertices()) {
+    else if(_maxVertexNum < 10 * numVertices) {
       Msg::Debug(
         "We have a fairly dense vertex numbering - still using cache vector");
       dense = true;
     }
     std::vector<GEntity *> entities;
     getEntities(entities);
+    // fill the cache before making it visible, so that concurrent lookups
+    // never see it partially built
     if(dense) {
       // numbering starts at 1
-      _vertexVectorCache.resize(_maxVertexNum + 1, (MVertex *)0);
+      std::vector<MVertex *> cache(_maxVertexNum + 1, (MVertex *)0);
       for(unsigned int i = 0; i < entities.size(); i++)
         for(unsigned int j = 0; j < entities[i]->mesh_vertices.size(); j++)
-          _vertexVectorCache[entities[i]->mesh_vertices[j]->getNum()] =
+          cache[entities[i]->mesh_vertices[j]->getNum()] =
             entities[i]->mesh_vertices[j];
+      _vertexVectorCache.swap(cache);
     }
     else {
+      TagCache<MVertex> cache;
+      cache.reserve(numVertices);
       for(unsigned int i = 0; i < entities.size(); i++)
         for(unsigned int j = 0; j < entities[i]->mesh_vertices.size(); j++)
-          _vertexMapCache[entities[i]->mesh_vertices[j]->getNum()] =
-            entities[i]->mesh_vertices[j];
+          cache.insert(entities[i]->mesh_vertices[j]->getNum(),
+                       entities[i]->mesh_vertices[j]);
+      cache.sort();
+      _vertexMapCache.swap(cache);
     }
   }
 }
 
-MVertex *GModel::getMeshVertexByTag(int n)
+void GModel::_sortMeshVertexCache()
 {
-  if(_vertexVectorCache.empty() && _vertexMapCache.empty()) {
-    Msg::Debug("Rebuilding mesh vertex cache");
-    rebuildMeshVertexCache();
+  std::vector<MVertex *> duplicates;
+  _vertexMapCache.sort(&duplicates);
+  if(duplicates.size())
+    Msg::Warning("Skipping %lu duplicate vertices",
+                 (unsigned long)duplicates.size());
+  for(std::size_t i = 0; i < duplicates.size(); i++) delete duplicates[i];
+  _vertexCacheReady = 0;
+}
+
+MVertex *GModel::getMeshVertexByTag(std::size_t n)
+{
+  // the cache is built (or sorted, if it was filled by a mesh reader) by the
+  // first thread that needs it, and then published through the ready flag;
+  // once ready, concurrent lookups are safe
+  int ready;
+#if defined(_OPENMP)
+#pragma omp atomic read
+#endif
+  ready = _vertexCacheReady;
+#if defined(_OPENMP)
+#pragma omp flush
+#endif
+  if(!ready) {
+#if defined(_OPENMP)
+#pragma omp critical(GModelVertexCache)
+#endif
+    {
+      if(!_vertexCacheReady) {
+        if(_vertexVectorCache.empty() && _vertexMapCache.empty()) {
+          Msg::Debug("Rebuilding mesh vertex cache");
+          rebuildMeshVertexCache();
+        }
+        _vertexMapCache.sort();
+#if defined(_OPENMP)
+#pragma omp flush
+#pragma omp atomic write
+#endif
+        _vertexCacheReady = 1;
+      }
+    }
   }
 
-  if(n < (int)_vertexVectorCache.size())
+  if(n < _vertexVectorCache.size())
     return _vertexVectorCache[n];
-  else
-    return _vertexMapCache[n];
+  return _vertexMapCache.find(n);
 }
 
 void GModel::getMeshVerticesForPhysicalGroup(int dim, int num,
@@ -1396,46 +1477,81 @@ void GModel::getMeshVerticesForPhysicalGroup(int dim, int num,
   v.insert(v.begin(), sv.begin(), sv.end());
 }
 
-MElement *GModel::getMeshElementByTag(int n)
+void GModel::_rebuildMeshElementCache()
 {
-  if(_elementVectorCache.empty() && _elementMapCache.empty()) {
-    Msg::Debug("Rebuilding mesh element cache");
-    _elementVectorCache.clear();
-    _elementMapCache.clear();
-    bool dense = false;
-    if(_maxElementNum == getNumMeshElements()) {
-      Msg::Debug("We have a dense element numbering in the cache");
-      dense = true;
-    }
-    else if(_maxElementNum < 10 * getNumMeshElements()) {
-      Msg::Debug(
-        "We have a fairly dense element numbering - still using cache vector");
-      dense = true;
-    }
-    std::vector<GEntity *> entities;
-    getEntities(entities);
-    if(dense) {
-      // numbering starts at 1
-      _elementVectorCache.resize(_maxElementNum + 1, (MElement *)0);
-      for(unsigned int i = 0; i < entities.size(); i++)
-        for(unsigned int j = 0; j < entities[i]->getNumMeshElements(); j++) {
-          MElement *e = entities[i]->getMeshElement(j);
-          _elementVectorCache[e->getNum()] = e;
-        }
-    }
-    else {
-      for(unsigned int i = 0; i < entities.size(); i++)
-        for(unsigned int j = 0; j < entities[i]->getNumMeshElements(); j++) {
-          MElement *e = entities[i]->getMeshElement(j);
-          _elementMapCache[e->getNum()] = e;
-        }
+  Msg::Debug("Rebuilding mesh element cache");
+  _elementCacheReady = 0;
+  _elementVectorCache.clear();
+  _elementMapCache.clear();
+  std::size_t numElements = getNumMeshElements();
+  bool dense = false;
+  if(_maxElementNum == numElements) {
+    Msg::Debug("We have a dense element numbering in the cache");
+    dense = true;
+  }
+  else if(_maxElementNum < 10 * numElements) {
+    Msg::Debug(
+      "We have a fairly dense element numbering - still using cache vector");
+    dense = true;
+  }
+  std::vector<GEntity *> entities;
+  getEntities(entities);
+  // see rebuildMeshVertexCache
+  if(dense) {
+    // numbering starts at 1
+    std::vector<MElement *> cache(_maxElementNum + 1, (MElement *)0);
+    for(unsigned int i = 0; i < entities.size(); i++)
+      for(unsigned int j = 0; j < entities[i]->getNumMeshElements(); j++) {
+        MElement *e = entities[i]->getMeshElement(j);
+        cache[e->getNum()] = e;
+      }
+    _elementVectorCache.swap(cache);
+  }
+  else {
+    TagCache<MElement> cache;
+    cache.reserve(numElements);
+    for(unsigned int i = 0; i < entities.size(); i++)
+      for(unsigned int j = 0; j < entities[i]->getNumMeshElements(); j++) {
+        MElement *e = entities[i]->getMeshElement(j);
+        cache.insert(e->getNum(), e);
+      }
+    cache.sort();
+    _elementMapCache.swap(cache);
+  }
+}
+
+MElement *GModel::getMeshElementByTag(std::size_t n)
+{
+  // see getMeshVertexByTag
+  int ready;
+#if defined(_OPENMP)
+#pragma omp atomic read
+#endif
+  ready = _elementCacheReady;
+#if defined(_OPENMP)
+#pragma omp flush
+#endif
+  if(!ready) {
+#if defined(_OPENMP)
+#pragma omp critical(GModelElementCache)
+#endif
+    {
+      if(!_elementCacheReady) {
+        if(_elementVectorCache.empty() && _elementMapCache.empty())
+          _rebuildMeshElementCache();
+        _elementMapCache.sort();
+#if defined(_OPENMP)
+#pragma omp flush
+#pragma omp atomic write
+#endif
+        _elementCacheReady = 1;
+      }
     }
   }
 
-  if(n < (int)_elementVectorCache.size())
+  if(n < _elementVectorCache.size())
     return _elementVectorCache[n];
-  else
-    return _elementMapCache[n];
+  return _elementMapCache.find(n);
 }
 
 int GModel::getMeshElementIndex(MElement *e)
@@ -1794,6 +1910,28 @@ void GModel::_storeVerticesInEntities(std::map<int, MVertex *> &vertices)
   }
 }
 
+void GModel::_storeVerticesInEntities(TagCache<MVertex> &vertices)
+{
+  // vertices with duplicate tags are not stored in any entity: delete them
+  std::vector<MVertex *> duplicates;
+  vertices.sort(&duplicates);
+  if(duplicates.size())
+    Msg::Warning("Skipping %lu duplicate vertices",
+                 (unsigned long)duplicates.size());
+  for(std::size_t i = 0; i < duplicates.size(); i++) delete duplicates[i];
+  TagCache<MVertex>::iterator it = vertices.begin();
+  for(; it != vertices.end(); ++it) {
+    MVertex *v = it->second;
+    GEntity *ge = v->onWhat();
+    if(ge)
+      ge->mesh_vertices.push_back(v);
+    else {
+      delete v; // we delete all unused vertices
+      it->second = 0;
+    }
+  }
+}
+
 void GModel::_storeVerticesInEntities(std::vector<MVertex *> &vertices)
 {
   for(unsigned int i = 0; i < vertices.size(); i++) {
@@ -2106,7 +2244,7 @@ void GModel::checkMeshCoherence(double tolerance)
         for(std::set<MVertex *>::iterator it = duplicates.begin();
             it != duplicates.end(); it++) {
           MVertex *v = *it;
-          fprintf(fp, "SP(%.16g,%.16g,%.16g){%d};\n", v->x(), v->y(), v->z(),
+          fprintf(fp, "SP(%.16g,%.16g,%.16g){%lu};\n", v->x(), v->y(), v->z(),
                   v->getNum());
         }
         fprintf(fp, "};\n");
@@ -2124,9 +2262,11 @@ void GModel::checkMeshCoherence(double tolerance)
         MElement *e = entities[i]->getMeshElement(j);
         double vol = e->getVolume();
         if(vol < 0)
-          Msg::Warning("Element %d has negative volume", e->getNum());
+          Msg::Warning("Element %lu has negative volume",
+                       (unsigned long)e->getNum());
         else if(vol < eps * eps * eps)
-          Msg::Warning("Element %d has zero volume", e->getNum());
+          Msg::Warning("Element %lu has zero volume",
+                       (unsigned long)e->getNum());
         SPoint3 p = e->barycenter();
         vertices.push_back(new MVertex(p.x(), p.y(), p.z()));
       }
@@ -2366,8 +2506,8 @@ void GModel::alignPeriodicBoundaries()
       for(unsigned int i = 0; i < src->getNumMeshElements(); i++) {
         MLine *srcLine = dynamic_cast<MLine *>(src->getMeshElement(i));
         if(!srcLine) {
-          Msg::Error("Master element %d is not an edge ",
-                     src->getMeshElement(i)->getNum());
+          Msg::Error("Master element %lu is not an edge ",
+                     (unsigned long)src->getMeshElement(i)->getNum());
           return;
         }
         srcLines[MEdge(srcLine->getVertex(0), srcLine->getVertex(1))] = srcLine;
@@ -2381,8 +2521,8 @@ void GModel::alignPeriodicBoundaries()
         MLine *tgtLine = dynamic_cast<MLine *>(tgt->getMeshElement(i));
 
         if(!tgtLine) {
-          Msg::Error("Slave element %d is not an edge ",
-                     tgt->getMeshElement(i)->getNum());
+          Msg::Error("Slave element %lu is not an edge ",
+                     (unsigned long)tgt->getMeshElement(i)->getNum());
           return;
         }
 
@@ -2401,9 +2541,9 @@ void GModel::alignPeriodicBoundaries()
             srcIter = geV2v.find(tgtVtx);
             if(srcIter == geV2v.end() || !srcIter->second) {
               Msg::Error(
-                "Cannot find periodic counterpart of vertex %d on edge %d"
+                "Cannot find periodic counterpart of vertex %lu on edge %d"
                 " nor on %d",
-                tgtVtx->getNum(), tgt->tag(), ge->tag());
+                (unsigned long)tgtVtx->getNum(), tgt->tag(), ge->tag());
               return;
             }
             else
@@ -2419,11 +2559,12 @@ void GModel::alignPeriodicBoundaries()
           srcLines.find(tgtEdge);
 
         if(sIter == srcLines.end() || !sIter->second) {
-          Msg::Error("Can't find periodic counterpart of edge %d-%d on edge %d"
-                     ", connected to edge %d-%d on %d",
-                     tgtLine->getVertex(0)->getNum(),
-                     tgtLine->getVertex(1)->getNum(), tgt->tag(),
-                     tgtVtcs[0]->getNum(), tgtVtcs[1]->getNum(), src->tag());
+          Msg::Error("Can't find periodic counterpart of edge %lu-%lu on edge "
+                     "%d, connected to edge %lu-%lu on %d",
+                     (unsigned long)tgtLine->getVertex(0)->getNum(),
+                     (unsigned long)tgtLine->getVertex(1)->getNum(), tgt->tag(),
+                     (unsigned long)tgtVtcs[0]->getNum(),
+                     (unsigned long)tgtVtcs[1]->getNum(), src->tag());
           return;
         }
         else {
@@ -2475,13 +2616,14 @@ void GModel::alignPeriodicBoundaries()
 
           std::map<MVertex *, MVertex *>::iterator vIter = v2v.find(vtx);
           if(vIter == v2v.end() || !vIter->second) {
-            Msg::Info("Could not find copy of vertex %d in face %d"
+            Msg::Info("Could not find copy of vertex %lu in face %d"
                       ", looking in entity %d of dimension %d",
-                      vtx->getNum(), tgt->tag(), ge->tag(), ge->dim());
+                      (unsigned long)vtx->getNum(), tgt->tag(), ge->tag(),
+                      ge->dim());
             vIter = geV2v.find(vtx);
             if(vIter == geV2v.end() || !vIter->second) {
-              Msg::Error("Could not find copy of vertex %d in %d nor in %d",
-                         vtx->getNum(), tgt->tag(), ge->tag());
+              Msg::Error("Could not find copy of vertex %lu in %d nor in %d",
+                         (unsigned long)vtx->getNum(), tgt->tag(), ge->tag());
               return;
             }
             else
@@ -2516,10 +2658,13 @@ void GModel::alignPeriodicBoundaries()
 
           if(!tgtFace.computeCorrespondence(srcFace, rotation, swap)) {
             Msg::Error(
-              "Non-corresponding face %d-%d-%d (slave) %d-%d-%d (master)",
-              tgtElmt->getVertex(0)->getNum(), tgtElmt->getVertex(1)->getNum(),
-              tgtElmt->getVertex(2)->getNum(), srcElmt->getVertex(0)->getNum(),
-              srcElmt->getVertex(1)->getNum(), srcElmt->getVertex(2)->getNum());
+              "Non-corresponding face %lu-%lu-%lu (slave) %lu-%lu-%lu (master)",
+              (unsigned long)tgtElmt->getVertex(0)->getNum(),
+              (unsigned long)tgtElmt->getVertex(1)->getNum(),
+              (unsigned long)tgtElmt->getVertex(2)->getNum(),
+              (unsigned long)srcElmt->getVertex(0)->getNum(),
+              (unsigned long)srcElmt->getVertex(1)->getNum(),
+              (unsigned long)srcElmt->getVertex(2)->getNum());
             return;
           }
 
@@ -17,6 +17,7 @@
 #include "GRegion.h"
 #include "SPoint3.h"
 #include "SBoundingBox3d.h"
+#include "TagCache.h"
 
 template <class scalar> class simpleFunction;
 
@@ -43,8 +44,8 @@ private:
   std::set<GVertex *, GEntityLessThan> _chainVertices;
 
   // the maximum vertex and element id number in the mesh
-  int _maxVertexNum, _maxElementNum;
-  int _checkPointedMaxVertexNum, _checkPointedMaxElementNum;
+  std::size_t _maxVertexNum, _maxElementNum;
+  std::size_t _checkPointedMaxVertexNum, _checkPointedMaxElementNum;
   // flag set to true when the model is being destroyed
   bool _destroying;
 
@@ -85,20 +86,26 @@ protected:
   char _visible;
 
   // vertex and element caches to speed-up direct access by tag (mostly
-  // used for post-processing I/O)
+  // used for post-processing I/O): a vector indexed by tag if the numbering
+  // is dense, or a flat table sorted by tag otherwise
   std::vector<MVertex *> _vertexVectorCache;
-  std::map<int, MVertex *> _vertexMapCache;
+  TagCache<MVertex> _vertexMapCache;
   std::vector<MElement *> _elementVectorCache;
-  std::map<int, MElement *> _elementMapCache;
+  TagCache<MElement> _elementMapCache;
   std::map<int, int> _elementIndexCache;
+  // set (atomically) once the vertex or element cache is complete and sorted,
+  // so that lookups can then proceed without locking; reset whenever the
+  // cache is modified
+  int _vertexCacheReady, _elementCacheReady;
 
   // ghost cell information (stores partitions for each element acting
   // as a ghost cell)
   // /!\ Use only for compatibility with mesh format msh2 and msh3
   std::multimap<MElement *, short> _ghostCells;
 
-  // an octree for fast mesh element lookup
+  // a bounding volume hierarchy for fast mesh element lookup
   MElementOctree *_elementOctree;
+  MElementOctree *_getElementOctree();
 
   // Geo (Gmsh native) model internal data
   GEO_Internals *_geo_internals;
@@ -163,8 +170,17 @@ protected:
   // store the vertices in the geometrical entity they are associated
   // with, and delete those that are not associated with any entity
   void _storeVerticesInEntities(std::map<int, MVertex *> &vertices);
+  void _storeVerticesInEntities(TagCache<MVertex> &vertices);
   void _storeVerticesInEntities(std::vector<MVertex *> &vertices);
 
+  // sort the vertex cache filled by a mesh reader with the vertices it
+  // created: as with a map, only the last vertex read with a given tag is
+  // kept, and the others are deleted
+  void _sortMeshVertexCache();
+
+  // rebuild the element cache used by getMeshElementByTag
+  void _rebuildMeshElementCache();
+
   // store the physical tags in the geometrical entities
   void
   _storePhysicalTagsInEntities(int dim,
@@ -214,16 +230,16 @@ public:
   bool isBeingDestroyed() const { return _destroying; }
 
   // get/set global vertex/element num
-  int getMaxVertexNumber() { return _maxVertexNum; }
-  int getMaxElementNumber() { return _maxElementNum; }
-  void setMaxVertexNumber(int num) { _maxVertexNum = num; }
-  void setMaxElementNumber(int num) { _maxElementNum = num; }
+  std::size_t getMaxVertexNumber() const { return _maxVertexNum; }
+  std::size_t getMaxElementNumber() const { return _maxElementNum; }
+  void setMaxVertexNumber(std::size_t num) { _maxVertexNum = num; }
+  void setMaxElementNumber(std::size_t num) { _maxElementNum = num; }
   void checkPointMaxNumbers()
   {
     _checkPointedMaxVertexNum = _maxVertexNum;
     _checkPointedMaxVertexNum = _maxVertexNum;
   }
-  void getCheckPointedMaxNumbers(int &maxv, int &maxe)
+  void getCheckPointedMaxNumbers(std::size_t &maxv, std::size_t &maxe)
   {
     maxv = _checkPointedMaxVertexNum;
     maxe = _checkPointedMaxElementNum;
@@ -436,13 +452,16 @@ public:
   // dimension and return the dimension
   int getNumMeshElements(unsigned c[6]);
 
-  // access a mesh element by coordinates (using an octree search)
-  MElement *getMeshElementByCoord(SPoint3 &p, int dim = -1, bool strict = true);
+  // access a mesh element by coordinates (using a bounding volume hierarchy,
+  // built on first use); if hint is given (e.g. the element found for a
+  // previous, nearby point), its neighborhood is searched first
+  MElement *getMeshElementByCoord(SPoint3 &p, int dim = -1, bool strict = true,
+                                  MElement *hint = 0);
   std::vector<MElement *> getMeshElementsByCoord(SPoint3 &p, int dim = -1,
                                                  bool strict = true);
 
   // access a mesh element by tag, using the element cache
-  MElement *getMeshElementByTag(int n);
+  MElement *getMeshElementByTag(std::size_t n);
 
   // access temporary mesh element index
   int getMeshElementIndex(MElement *e);
@@ -456,7 +475,7 @@ public:
   void rebuildMeshVertexCache(bool onlyIfNecessary = false);
 
   // access a mesh vertex by tag, using the vertex cache
-  MVertex *getMeshVertexByTag(int n);
+  MVertex *getMeshVertexByTag(std::size_t n);
 
   // get all the mesh vertices associated with the physical group
   // of dimension "dim" and id number "num"
@@ -219,8 +219,8 @@ void createTopologyFromMesh1D(GModel *gm, int &num)
       MVertex *mv = gv->mesh_vertices[0];
       mVertexToGVertex[mv] = gv;
       Msg::Info(
-        "The mesh contains already topological vertex %i containing vertex %i",
-        gv->tag(), mv->getNum());
+        "The mesh contains already topological vertex %i containing vertex %lu",
+        gv->tag(), (unsigned long)mv->getNum());
     }
   }
 
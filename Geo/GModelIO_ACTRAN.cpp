@@ -77,8 +77,9 @@ int GModel::readACTRAN(const std::string &name)
           sscanf(buffer, "%d %lf %lf %lf", &num, &x, &y, &z);
         else
           sscanf(buffer, "%d %lf %lf", &num, &x, &y);
-        _vertexMapCache[num] = new MVertex(x, y, z, 0, num);
+        _vertexMapCache.insert(num, new MVertex(x, y, z, 0, num));
       }
+      _sortMeshVertexCache();
     }
     else if(!strcmp(str, "BEGIN") && !strcmp(str2, "ELEMENT")) {
       Msg::Info("%d elements", nbe);
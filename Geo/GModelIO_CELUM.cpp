@@ -92,8 +92,8 @@ int GModel::writeCELUM(const std::string &name, bool saveAll,
           SPoint2 param;
           bool ok = reparamMeshVertexOnFace(v, f, param);
           if(!ok)
-            Msg::Warning("Could not reparamtrize vertex %d on face %d",
-                         v->getNum(), f->tag());
+            Msg::Warning("Could not reparamtrize vertex %lu on face %d",
+                         (unsigned long)v->getNum(), f->tag());
           CelumInfo info;
           info.normal = f->normal(param);
           f->curvatures(param, info.dirMax, info.dirMin, info.curvMax,
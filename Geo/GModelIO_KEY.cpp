@@ -119,9 +119,9 @@ int GModel::writeKEY(const std::string &name, int saveAll,
                       physicalName(this, dim, it->first).c_str(), ++setid);
             }
             if(!(n % 8))
-              fprintf(fp, "\n%d", e->getNum());
+              fprintf(fp, "\n%lu", e->getNum());
             else
-              fprintf(fp, ", %d", e->getNum());
+              fprintf(fp, ", %lu", e->getNum());
             n++;
           }
         }
@@ -605,10 +605,16 @@ int GModel::_readMSH2(const std::string &name)
     else if(!strncmp(&str[1], "NodeData", 8)) {
       // there's some nodal post-processing data to read later on, so
       // cache the vertex indexing data
+      _vertexCacheReady = 0;
       if(vertexVector.size())
         _vertexVectorCache = vertexVector;
-      else
-        _vertexMapCache = vertexMap;
+      else {
+        _vertexMapCache.clear();
+        _vertexMapCache.reserve(vertexMap.size());
+        for(std::map<int, MVertex *>::const_iterator it = vertexMap.begin();
+            it != vertexMap.end(); ++it)
+          _vertexMapCache.insert(it->first, it->second);
+      }
       postpro = true;
       break;
     }
@@ -396,12 +396,11 @@ int GModel::_readMSH3(const std::string &name)
         }
         minVertex = std::min(minVertex, num);
         maxVertex = std::max(maxVertex, num);
-        if(_vertexMapCache.count(num))
-          Msg::Warning("Skipping duplicate vertex %d", num);
-        _vertexMapCache[num] = vertex;
+        _vertexMapCache.insert(num, vertex);
         if(numVertices > 100000)
           Msg::ProgressMeter(i + 1, numVertices, true, "Reading nodes");
       }
+      _sortMeshVertexCache();
       // if the vertex numbering is dense, transfer the map into a vector to
       // speed up element creation
       if((int)_vertexMapCache.size() == numVertices &&
@@ -413,8 +412,7 @@ int GModel::_readMSH3(const std::string &name)
           _vertexVectorCache[0] = 0;
         else
           _vertexVectorCache[numVertices] = 0;
-        for(std::map<int, MVertex *>::const_iterator it =
-              _vertexMapCache.begin();
+        for(TagCache<MVertex>::const_iterator it = _vertexMapCache.begin();
             it != _vertexMapCache.end(); ++it)
           _vertexVectorCache[it->first] = it->second;
         _vertexMapCache.clear();
@@ -694,7 +692,7 @@ void writeMSHPeriodicNodes(FILE *fp, std::vector<GEntity *> &entities,
         if(renumber)
           fprintf(fp, "%d %d\n", v1->getIndex(), v2->getIndex());
         else
-          fprintf(fp, "%d %d\n", v1->getNum(), v2->getNum());
+          fprintf(fp, "%lu %lu\n", v1->getNum(), v2->getNum());
       }
     }
   }
@@ -13,6 +13,8 @@
 #include <sstream>
 #include <string>
 #include <cstdlib>
+#include <cstring>
+#include <climits>
 
 #include "GmshDefines.h"
 #include "OS.h"
@@ -473,7 +475,33 @@ static bool readMSH4Entities(GModel *const model, FILE *fp, bool partition,
   return true;
 }
 
-static std::pair<int, MVertex *> *
+// binary MSH 4.0 files store node and element tags as 32-bit integers
+static bool readMSH4BinaryTag(FILE *fp, bool swap, unsigned long &tag)
+{
+  int t;
+  if(fread(&t, sizeof(int), 1, fp) != 1) return false;
+  if(swap) SwapBytes((char *)&t, sizeof(int), 1);
+  tag = t;
+  return true;
+}
+
+static bool isDenseNumbering(unsigned long minNum, unsigned long maxNum,
+                             unsigned long nbr, const char *what)
+{
+  if(minNum == 1 && maxNum == nbr) {
+    Msg::Debug("%s numbering is dense", what);
+    return true;
+  }
+  else if(maxNum < 10 * nbr) {
+    Msg::Debug("%s numbering is fairly dense - still caching with a vector",
+               what);
+    return true;
+  }
+  Msg::Debug("%s numbering is not dense", what);
+  return false;
+}
+
+static std::pair<std::size_t, MVertex *> *
 readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
               unsigned long &nbrNodes, unsigned long &maxNodeNum, bool swap)
 {
@@ -497,8 +525,8 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
 
   unsigned long nodeRead = 0;
   unsigned long minNodeNum = nbrNodes + 1;
-  std::pair<int, MVertex *> *vertexCache =
-    new std::pair<int, MVertex *>[nbrNodes];
+  std::pair<std::size_t, MVertex *> *vertexCache =
+    new std::pair<std::size_t, MVertex *>[nbrNodes];
   Msg::Info("%lu vertices", nbrNodes);
   for(unsigned int i = 0; i < numBlock; i++) {
     int parametric = 0;
@@ -541,7 +569,7 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
 
     for(unsigned int j = 0; j < numNodes; j++) {
       double xyz[3];
-      int nodeTag = 0;
+      unsigned long nodeTag = 0;
       MVertex *vertex = 0;
 
       if(parametric) {
@@ -550,11 +578,10 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
         switch(entityDim) {
         case 0:
           if(binary) {
-            if(fread(&nodeTag, sizeof(int), 1, fp) != 1) {
+            if(!readMSH4BinaryTag(fp, swap, nodeTag)) {
               delete [] vertexCache;
               return 0;
             }
-            if(swap) SwapBytes((char *)&nodeTag, sizeof(int), 1);
 
             if(fread(xyz, sizeof(double), 3, fp) != 3) {
               delete [] vertexCache;
@@ -563,7 +590,7 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
             if(swap) SwapBytes((char *)xyz, sizeof(double), 3);
           }
           else {
-            if(fscanf(fp, "%d %lf %lf %lf", &nodeTag, &xyz[0], &xyz[1],
+            if(fscanf(fp, "%lu %lf %lf %lf", &nodeTag, &xyz[0], &xyz[1],
                       &xyz[2]) != 4) {
               delete [] vertexCache;
               return 0;
@@ -573,11 +600,10 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
           break;
         case 1:
           if(binary) {
-            if(fread(&nodeTag, sizeof(int), 1, fp) != 1) {
+            if(!readMSH4BinaryTag(fp, swap, nodeTag)) {
               delete [] vertexCache;
               return 0;
             }
-            if(swap) SwapBytes((char *)&nodeTag, sizeof(int), 1);
 
             if(fread(xyz, sizeof(double), 3, fp) != 3) {
               delete [] vertexCache;
@@ -592,7 +618,7 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
             if(swap) SwapBytes((char *)&u, sizeof(double), 1);
           }
           else {
-            if(fscanf(fp, "%d %lf %lf %lf %lf", &nodeTag, &xyz[0], &xyz[1],
+            if(fscanf(fp, "%lu %lf %lf %lf %lf", &nodeTag, &xyz[0], &xyz[1],
                       &xyz[2], &u) != 5) {
               delete [] vertexCache;
               return 0;
@@ -603,11 +629,10 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
           break;
         case 2:
           if(binary) {
-            if(fread(&nodeTag, sizeof(int), 1, fp) != 1) {
+            if(!readMSH4BinaryTag(fp, swap, nodeTag)) {
               delete [] vertexCache;
               return 0;
             }
-            if(swap) SwapBytes((char *)&nodeTag, sizeof(int), 1);
 
             if(fread(xyz, sizeof(double), 3, fp) != 3) {
               delete [] vertexCache;
@@ -626,7 +651,7 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
             v = uv[1];
           }
           else {
-            if(fscanf(fp, "%d %lf %lf %lf %lf %lf", &nodeTag, &xyz[0], &xyz[1],
+            if(fscanf(fp, "%lu %lf %lf %lf %lf %lf", &nodeTag, &xyz[0], &xyz[1],
                       &xyz[2], &u, &v) != 6) {
               delete [] vertexCache;
               return 0;
@@ -637,11 +662,10 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
           break;
         case 3:
           if(binary) {
-            if(fread(&nodeTag, sizeof(int), 1, fp) != 1) {
+            if(!readMSH4BinaryTag(fp, swap, nodeTag)) {
               delete [] vertexCache;
               return 0;
             }
-            if(swap) SwapBytes((char *)&nodeTag, sizeof(int), 1);
 
             if(fread(xyz, sizeof(double), 3, fp) != 3) {
               delete [] vertexCache;
@@ -650,7 +674,7 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
             if(swap) SwapBytes((char *)xyz, sizeof(double), 3);
           }
           else {
-            if(fscanf(fp, "%d %lf %lf %lf", &nodeTag, &xyz[0], &xyz[1],
+            if(fscanf(fp, "%lu %lf %lf %lf", &nodeTag, &xyz[0], &xyz[1],
                       &xyz[2]) != 4) {
               delete [] vertexCache;
               return 0;
@@ -663,11 +687,10 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
       }
       else {
         if(binary) {
-          if(fread(&nodeTag, sizeof(int), 1, fp) != 1) {
+          if(!readMSH4BinaryTag(fp, swap, nodeTag)) {
             delete [] vertexCache;
             return 0;
           }
-          if(swap) SwapBytes((char *)&nodeTag, sizeof(int), 1);
 
           if(fread(xyz, sizeof(double), 3, fp) != 3) {
             delete [] vertexCache;
@@ -676,7 +699,7 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
           if(swap) SwapBytes((char *)xyz, sizeof(double), 3);
         }
         else {
-          if(fscanf(fp, "%d %lf %lf %lf", &nodeTag, &xyz[0], &xyz[1],
+          if(fscanf(fp, "%lu %lf %lf %lf", &nodeTag, &xyz[0], &xyz[1],
                     &xyz[2]) != 4) {
             delete [] vertexCache;
             return 0;
@@ -686,10 +709,11 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
       }
       entity->addMeshVertex(vertex);
       vertex->setEntity(entity);
-      minNodeNum = std::min(minNodeNum, (unsigned long)nodeTag);
-      maxNodeNum = std::max(maxNodeNum, (unsigned long)nodeTag);
+      minNodeNum = std::min(minNodeNum, nodeTag);
+      maxNodeNum = std::max(maxNodeNum, nodeTag);
 
-      vertexCache[nodeRead] = std::pair<int, MVertex *>(nodeTag, vertex);
+      vertexCache[nodeRead] =
+        std::pair<std::size_t, MVertex *>(nodeTag, vertex);
       nodeRead++;
 
       if(nbrNodes > 100000)
@@ -698,24 +722,12 @@ readMSH4Nodes(GModel *const model, FILE *fp, bool binary, bool &dense,
   }
   // if the vertex numbering is (fairly) dense, we fill the vector cache,
   // otherwise we fill the map cache
-  if(minNodeNum == 1 && maxNodeNum == nbrNodes) {
-    Msg::Debug("Vertex numbering is dense");
-    dense = true;
-  }
-  else if(maxNodeNum < 10 * nbrNodes) { //
-    Msg::Debug(
-      "Vertex numbering is fairly dense - still caching with a vector");
-    dense = true;
-  }
-  else {
-    Msg::Debug("Vertex numbering is not dense");
-    dense = false;
-  }
+  dense = isDenseNumbering(minNodeNum, maxNodeNum, nbrNodes, "Vertex");
 
   return vertexCache;
 }
 
-static std::pair<int, MElement *> *
+static std::pair<std::size_t, MElement *> *
 readMSH4Elements(GModel *const model, FILE *fp, bool binary, bool &dense,
                  unsigned long &nbrElements, unsigned long &maxElementNum,
                  bool swap)
@@ -742,8 +754,8 @@ readMSH4Elements(GModel *const model, FILE *fp, bool binary, bool &dense,
 
   unsigned long elementRead = 0;
   unsigned long minElementNum = nbrElements + 1;
-  std::pair<int, MElement *> *elementCache =
-    new std::pair<int, MElement *>[nbrElements];
+  std::pair<std::size_t, MElement *> *elementCache =
+    new std::pair<std::size_t, MElement *>[nbrElements];
   Msg::Info("%lu elements", nbrElements);
   for(unsigned int i = 0; i < numBlock; i++) {
     int entityTag = 0, entityDim = 0, elmType = 0;
@@ -832,7 +844,7 @@ readMSH4Elements(GModel *const model, FILE *fp, bool binary, bool &dense,
         maxElementNum = std::max(maxElementNum, (unsigned long)data[j]);
 
         elementCache[elementRead] =
-          std::pair<int, MElement *>(data[j], element);
+          std::pair<std::size_t, MElement *>(data[j], element);
         elementRead++;
 
         if(nbrElements > 100000)
@@ -844,8 +856,8 @@ readMSH4Elements(GModel *const model, FILE *fp, bool binary, bool &dense,
     }
     else {
       for(unsigned int j = 0; j < numElements; j++) {
-        int elmTag = 0;
-        if(fscanf(fp, "%d", &elmTag) != 1) {
+        unsigned long elmTag = 0;
+        if(fscanf(fp, "%lu", &elmTag) != 1) {
           delete[] elementCache;
           return 0;
         }
@@ -857,15 +869,15 @@ readMSH4Elements(GModel *const model, FILE *fp, bool binary, bool &dense,
         std::vector<MVertex *> vertices(nbrVertices, (MVertex *)0);
 
         for(int k = 0; k < nbrVertices; k++) {
-          int vertexTag = 0;
+          unsigned long vertexTag = 0;
           if(k != nbrVertices - 1) {
-            if(sscanf(str, "%d %[0-9- ]", &vertexTag, str) != 2) {
+            if(sscanf(str, "%lu %[0-9- ]", &vertexTag, str) != 2) {
               delete[] elementCache;
               return 0;
             }
           }
           else {
-            if(sscanf(str, "%d", &vertexTag) != 1) {
+            if(sscanf(str, "%lu", &vertexTag) != 1) {
               delete[] elementCache;
               return 0;
             }
@@ -873,7 +885,7 @@ readMSH4Elements(GModel *const model, FILE *fp, bool binary, bool &dense,
 
           vertices[k] = model->getMeshVertexByTag(vertexTag);
           if(!vertices[k]) {
-            Msg::Error("Unknown vertex %d in element %d", vertexTag, elmTag);
+            Msg::Error("Unknown vertex %lu in element %lu", vertexTag, elmTag);
             delete[] elementCache;
             return 0;
           }
@@ -889,10 +901,11 @@ readMSH4Elements(GModel *const model, FILE *fp, bool binary, bool &dense,
           entity->addElement(element->getType(), element);
         }
 
-        minElementNum = std::min(minElementNum, (unsigned long)elmTag);
-        maxElementNum = std::max(maxElementNum, (unsigned long)elmTag);
+        minElementNum = std::min(minElementNum, elmTag);
+        maxElementNum = std::max(maxElementNum, elmTag);
 
-        elementCache[elementRead] = std::pair<int, MElement *>(elmTag, element);
+        elementCache[elementRead] =
+          std::pair<std::size_t, MElement *>(elmTag, element);
         elementRead++;
 
         if(nbrElements > 100000)
@@ -903,19 +916,289 @@ readMSH4Elements(GModel *const model, FILE *fp, bool binary, bool &dense,
   }
   // if the vertex numbering is dense, we fill the vector cache, otherwise we
   // fill the map cache
-  if(minElementNum == 1 && maxElementNum == nbrElements) {
-    Msg::Debug("Element numbering is dense");
-    dense = true;
+  dense = isDenseNumbering(minElementNum, maxElementNum, nbrElements,
+                           "Element");
+
+  return elementCache;
+}
+
+// Binary $Nodes and $Elements sections can also be decoded directly from a
+// memory-mapped file: since the size of each entity block is known from its
+// header, a first (cheap) pass indexes the blocks, and the nodes and elements
+// are then created in parallel into pre-sized caches. Blocks are not aligned
+// in the file, so all the reads go through memcpy.
+
+template <class T>
+static bool readMapped(const char *&p, const char *end, T *data,
+                       std::size_t n, bool swap)
+{
+  std::size_t bytes = n * sizeof(T);
+  if((std::size_t)(end - p) < bytes) return false;
+  memcpy(data, p, bytes);
+  if(swap) SwapBytes((char *)data, sizeof(T), n);
+  p += bytes;
+  return true;
+}
+
+struct MSH4NodeBlock {
+  GEntity *entity;
+  int numParams;
+  unsigned long numNodes, first;
+  const char *data;
+};
+
+static std::pair<std::size_t, MVertex *> *
+readMSH4NodesMapped(GModel *const model, const char *&p, const char *end,
+                    bool &dense, unsigned long &nbrNodes,
+                    unsigned long &maxNodeNum, bool swap)
+{
+  nbrNodes = 0;
+  maxNodeNum = 0;
+  unsigned long data[2];
+  if(!readMapped(p, end, data, 2, swap)) return 0;
+  unsigned long numBlock = data[0];
+  nbrNodes = data[1];
+  Msg::Info("%lu vertices", nbrNodes);
+
+  std::vector<MSH4NodeBlock> blocks(numBlock);
+  unsigned long nodeRead = 0;
+  for(unsigned long i = 0; i < numBlock; i++) {
+    int header[3];
+    unsigned long numNodes = 0;
+    if(!readMapped(p, end, header, 3, swap) ||
+       !readMapped(p, end, &numNodes, 1, swap))
+      return 0;
+    int entityTag = header[0], entityDim = header[1], parametric = header[2];
+    GEntity *entity = model->getEntityByTag(entityDim, entityTag);
+    if(!entity) {
+      Msg::Error("Unknown entity %d of dimension %d", entityTag, entityDim);
+      return 0;
+    }
+    // parametric coordinates are only stored for nodes on curves and surfaces
+    int numParams = (parametric && (entityDim == 1 || entityDim == 2)) ?
+                      entityDim : 0;
+    std::size_t recordSize = sizeof(int) + (3 + numParams) * sizeof(double);
+    if(numNodes > (std::size_t)(end - p) / recordSize) return 0;
+    blocks[i].entity = entity;
+    blocks[i].numParams = numParams;
+    blocks[i].numNodes = numNodes;
+    blocks[i].first = nodeRead;
+    blocks[i].data = p;
+    p += numNodes * recordSize;
+    nodeRead += numNodes;
+  }
+  if(nodeRead != nbrNodes) {
+    Msg::Error("Wrong number of vertices: %lu (expected %lu)", nodeRead,
+               nbrNodes);
+    return 0;
   }
-  else if(maxElementNum < 10 * nbrElements) {
-    Msg::Debug(
-      "Element numbering is fairly dense - still caching with a vector");
-    dense = true;
+
+  // the records of all the blocks are decoded concurrently; the vertices are
+  // created without updating the maximum node number of the model, which is
+  // updated once all the blocks have been read
+  std::pair<std::size_t, MVertex *> *vertexCache =
+    new std::pair<std::size_t, MVertex *>[nbrNodes];
+#pragma omp parallel
+  {
+    MVertex::setUpdateMaxNumber(false);
+    for(std::size_t i = 0; i < blocks.size(); i++) {
+      const MSH4NodeBlock &b = blocks[i];
+      const std::size_t recordSize =
+        sizeof(int) + (3 + b.numParams) * sizeof(double);
+#pragma omp for nowait
+      for(long j = 0; j < (long)b.numNodes; j++) {
+        const char *q = b.data + j * recordSize;
+        int nodeTag = 0;
+        double xyz[3], uv[2] = {0., 0.};
+        // bounds were checked when indexing the block
+        readMapped(q, q + recordSize, &nodeTag, 1, swap);
+        readMapped(q, q + recordSize, xyz, 3, swap);
+        readMapped(q, q + recordSize, uv, b.numParams, swap);
+        MVertex *vertex = 0;
+        if(b.numParams == 1)
+          vertex =
+            new MEdgeVertex(xyz[0], xyz[1], xyz[2], b.entity, uv[0], nodeTag);
+        else if(b.numParams == 2)
+          vertex = new MFaceVertex(xyz[0], xyz[1], xyz[2], b.entity, uv[0],
+                                   uv[1], nodeTag);
+        else
+          vertex = new MVertex(xyz[0], xyz[1], xyz[2], b.entity, nodeTag);
+        vertexCache[b.first + j] =
+          std::pair<std::size_t, MVertex *>(nodeTag, vertex);
+      }
+    }
+    MVertex::setUpdateMaxNumber(true);
   }
-  else {
-    Msg::Debug("Element numbering is not dense");
-    dense = false;
+
+  for(std::size_t i = 0; i < blocks.size(); i++) {
+    const MSH4NodeBlock &b = blocks[i];
+    b.entity->mesh_vertices.reserve(b.entity->mesh_vertices.size() +
+                                    b.numNodes);
+    for(unsigned long j = 0; j < b.numNodes; j++)
+      b.entity->addMeshVertex(vertexCache[b.first + j].second);
+    if(nbrNodes > 100000)
+      Msg::ProgressMeter(b.first + b.numNodes, nbrNodes, true,
+                         "Reading nodes");
+  }
+
+  unsigned long minNodeNum = nbrNodes + 1;
+  for(unsigned long i = 0; i < nbrNodes; i++) {
+    minNodeNum = std::min(minNodeNum, (unsigned long)vertexCache[i].first);
+    maxNodeNum = std::max(maxNodeNum, (unsigned long)vertexCache[i].first);
+  }
+  dense = isDenseNumbering(minNodeNum, maxNodeNum, nbrNodes, "Vertex");
+
+  GModel *current = GModel::current();
+  current->setMaxVertexNumber(
+    std::max(current->getMaxVertexNumber(), (std::size_t)maxNodeNum));
+
+  return vertexCache;
+}
+
+struct MSH4ElementBlock {
+  GEntity *entity;
+  int elmType, numVertices;
+  unsigned long numElements, first;
+  const char *data;
+};
+
+static std::pair<std::size_t, MElement *> *
+readMSH4ElementsMapped(GModel *const model, const char *&p, const char *end,
+                       bool &dense, unsigned long &nbrElements,
+                       unsigned long &maxElementNum, bool swap)
+{
+  nbrElements = 0;
+  maxElementNum = 0;
+  unsigned long data[2];
+  if(!readMapped(p, end, data, 2, swap)) return 0;
+  unsigned long numBlock = data[0];
+  nbrElements = data[1];
+  Msg::Info("%lu elements", nbrElements);
+
+  std::vector<MSH4ElementBlock> blocks(numBlock);
+  unsigned long elementRead = 0;
+  for(unsigned long i = 0; i < numBlock; i++) {
+    int header[3];
+    unsigned long numElements = 0;
+    if(!readMapped(p, end, header, 3, swap) ||
+       !readMapped(p, end, &numElements, 1, swap))
+      return 0;
+    int entityTag = header[0], entityDim = header[1], elmType = header[2];
+    GEntity *entity = model->getEntityByTag(entityDim, entityTag);
+    if(!entity) {
+      Msg::Error("Unknown entity %d of dimension %d", entityTag, entityDim);
+      return 0;
+    }
+    if(entity->geomType() == GEntity::GhostCurve) {
+      static_cast<ghostEdge *>(entity)->haveMesh(true);
+    }
+    else if(entity->geomType() == GEntity::GhostSurface) {
+      static_cast<ghostFace *>(entity)->haveMesh(true);
+    }
+    else if(entity->geomType() == GEntity::GhostVolume) {
+      static_cast<ghostRegion *>(entity)->haveMesh(true);
+    }
+    int numVertices = MElement::getInfoMSH(elmType);
+    std::size_t recordSize = (numVertices + 1) * sizeof(int);
+    if(numElements > (std::size_t)(end - p) / recordSize) return 0;
+    blocks[i].entity = entity;
+    blocks[i].elmType = elmType;
+    blocks[i].numVertices = numVertices;
+    blocks[i].numElements = numElements;
+    blocks[i].first = elementRead;
+    blocks[i].data = p;
+    p += numElements * recordSize;
+    elementRead += numElements;
+  }
+  if(elementRead != nbrElements) {
+    Msg::Error("Wrong number of elements: %lu (expected %lu)", elementRead,
+               nbrElements);
+    return 0;
+  }
+
+  // make sure the vertex cache is built before it is accessed concurrently
+  model->rebuildMeshVertexCache(true);
+
+  // as for the nodes, the records of all the blocks are decoded concurrently
+  // and the maximum element number of the model is updated at the end
+  std::pair<std::size_t, MElement *> *elementCache =
+    new std::pair<std::size_t, MElement *>[nbrElements];
+  bool unknown = false;
+  int unknownVertex = 0, unknownVertexElement = 0;
+#pragma omp parallel
+  {
+    MElement::setUpdateMaxNumber(false);
+    MElementFactory elementFactory;
+    for(std::size_t i = 0; i < blocks.size(); i++) {
+      const MSH4ElementBlock &b = blocks[i];
+      std::vector<int> tags(b.numVertices + 1);
+      std::vector<MVertex *> vertices(b.numVertices, (MVertex *)0);
+#pragma omp for nowait
+      for(long j = 0; j < (long)b.numElements; j++) {
+        const char *q = b.data + j * tags.size() * sizeof(int);
+        readMapped(q, q + tags.size() * sizeof(int), &tags[0], tags.size(),
+                   swap);
+        bool ok = true;
+        for(int k = 0; k < b.numVertices; k++) {
+          vertices[k] = model->getMeshVertexByTag(tags[k + 1]);
+          if(!vertices[k]) {
+#pragma omp critical
+            {
+              unknown = true;
+              unknownVertex = tags[k + 1];
+              unknownVertexElement = tags[0];
+            }
+            ok = false;
+            break;
+          }
+        }
+        MElement *element = 0;
+        if(ok)
+          element = elementFactory.create(b.elmType, vertices, tags[0], 0,
+                                          false, 0, 0, 0, 0);
+        elementCache[b.first + j] =
+          std::pair<std::size_t, MElement *>(tags[0], element);
+      }
+    }
+    MElement::setUpdateMaxNumber(true);
+  }
+  if(unknown) {
+    Msg::Error("Unknown vertex %d in element %d", unknownVertex,
+               unknownVertexElement);
+    for(unsigned long j = 0; j < nbrElements; j++)
+      delete elementCache[j].second;
+    delete[] elementCache;
+    return 0;
+  }
+
+  for(std::size_t i = 0; i < blocks.size(); i++) {
+    const MSH4ElementBlock &b = blocks[i];
+    if(b.entity->geomType() != GEntity::GhostCurve &&
+       b.entity->geomType() != GEntity::GhostSurface &&
+       b.entity->geomType() != GEntity::GhostVolume) {
+      for(unsigned long j = 0; j < b.numElements; j++) {
+        MElement *element = elementCache[b.first + j].second;
+        b.entity->addElement(element->getType(), element);
+      }
+    }
+    if(nbrElements > 100000)
+      Msg::ProgressMeter(b.first + b.numElements, nbrElements, true,
+                         "Reading elements");
+  }
+
+  unsigned long minElementNum = nbrElements + 1;
+  for(unsigned long i = 0; i < nbrElements; i++) {
+    minElementNum =
+      std::min(minElementNum, (unsigned long)elementCache[i].first);
+    maxElementNum =
+      std::max(maxElementNum, (unsigned long)elementCache[i].first);
   }
+  dense = isDenseNumbering(minElementNum, maxElementNum, nbrElements,
+                           "Element");
+
+  GModel *current = GModel::current();
+  current->setMaxElementNumber(
+    std::max(current->getMaxElementNumber(), (std::size_t)maxElementNum));
 
   return elementCache;
 }
@@ -1040,7 +1323,7 @@ static bool readMSH4PeriodicNodes(GModel *const model, FILE *fp, bool binary,
     }
 
     for(long j = 0; j < correspondingVertexSize; j++) {
-      int v1 = 0, v2 = 0;
+      unsigned long v1 = 0, v2 = 0;
       if(binary) {
         int data[2];
         if(fread(&data, sizeof(int), 2, fp) != 2) {
@@ -1052,7 +1335,7 @@ static bool readMSH4PeriodicNodes(GModel *const model, FILE *fp, bool binary,
         v2 = data[1];
       }
       else {
-        if(fscanf(fp, "%d %d", &v1, &v2) != 2) {
+        if(fscanf(fp, "%lu %lu", &v1, &v2) != 2) {
           return false;
         }
       }
@@ -1060,10 +1343,10 @@ static bool readMSH4PeriodicNodes(GModel *const model, FILE *fp, bool binary,
       MVertex *mv2 = model->getMeshVertexByTag(v2);
 
       if(!mv1) {
-        Msg::Error("Could not find periodic vertex %d", v1);
+        Msg::Error("Could not find periodic vertex %lu", v1);
       }
       if(!mv2) {
-        Msg::Error("Could not find periodic vertex %d", v2);
+        Msg::Error("Could not find periodic vertex %lu", v2);
       }
 
       slave->correspondingVertices[mv1] = mv2;
@@ -1090,7 +1373,7 @@ static bool readMSH4GhostElements(GModel *const model, FILE *fp, bool binary,
 
   std::multimap<std::pair<MElement *, unsigned int>, unsigned int> ghostCells;
   for(int i = 0; i < numGhostCells; i++) {
-    int numElm = 0;
+    unsigned long numElm = 0;
     int numPart = 0;
     unsigned int numGhost = 0;
     char str[1024];
@@ -1106,7 +1389,7 @@ static bool readMSH4GhostElements(GModel *const model, FILE *fp, bool binary,
       numGhost = data[2];
     }
     else {
-      if(fscanf(fp, "%d %d %d", &numElm, &numPart, &numGhost) != 3) {
+      if(fscanf(fp, "%lu %d %u", &numElm, &numPart, &numGhost) != 3) {
         return false;
       }
       if(!fgets(str, sizeof(str), fp)) {
@@ -1116,7 +1399,7 @@ static bool readMSH4GhostElements(GModel *const model, FILE *fp, bool binary,
 
     MElement *elm = model->getMeshElementByTag(numElm);
     if(!elm) {
-      Msg::Error("No element with tag %d", numElm);
+      Msg::Error("No element with tag %lu", numElm);
       continue;
     }
 
@@ -1187,6 +1470,34 @@ static bool readMSH4GhostElements(GModel *const model, FILE *fp, bool binary,
   return true;
 }
 
+// On-demand read-only memory map of the file being read, with helpers to keep
+// the position of the FILE pointer in sync with the mapped data
+class MSH4FileMap {
+private:
+  const char *_data;
+  std::size_t _size;
+  bool _tried;
+
+public:
+  MSH4FileMap() : _data(0), _size(0), _tried(false) {}
+  ~MSH4FileMap() { UnmapFile(_data, _size); }
+  bool map(const std::string &name, FILE *fp, const char *&p,
+           const char *&end)
+  {
+    if(!_tried) {
+      _tried = true;
+      _data = MapFile(name, _size);
+      if(!_data) Msg::Debug("Could not map file '%s'", name.c_str());
+    }
+    int64_t pos = FileTell(fp);
+    if(!_data || pos < 0 || (std::size_t)pos > _size) return false;
+    p = _data + pos;
+    end = _data + _size;
+    return true;
+  }
+  void sync(FILE *fp, const char *p) { FileSeek(fp, p - _data, SEEK_SET); }
+};
+
 int GModel::_readMSH4(const std::string &name)
 {
   bool partitioned = false;
@@ -1199,6 +1510,7 @@ int GModel::_readMSH4(const std::string &name)
   char str[1024] = "x";
   double version = 1.0;
   bool binary = false, swap = false, postpro = false;
+  MSH4FileMap fileMap;
 
   while(1) {
     while(str[0] != '$') {
@@ -1280,13 +1592,23 @@ int GModel::_readMSH4(const std::string &name)
       partitioned = true;
     }
     else if(!strncmp(&str[1], "Nodes", 5)) {
+      _vertexCacheReady = 0;
       _vertexVectorCache.clear();
       _vertexMapCache.clear();
       Msg::ResetProgressMeter();
       bool dense = false;
       unsigned long nbrNodes = 0, maxNodeNum;
-      std::pair<int, MVertex *> *vertexCache =
-        readMSH4Nodes(this, fp, binary, dense, nbrNodes, maxNodeNum, swap);
+      std::pair<std::size_t, MVertex *> *vertexCache = 0;
+      const char *p, *end;
+      if(binary && fileMap.map(name, fp, p, end)) {
+        vertexCache = readMSH4NodesMapped(this, p, end, dense, nbrNodes,
+                                          maxNodeNum, swap);
+        fileMap.sync(fp, p);
+      }
+      else {
+        vertexCache =
+          readMSH4Nodes(this, fp, binary, dense, nbrNodes, maxNodeNum, swap);
+      }
       if(!vertexCache) {
         Msg::Error("Could not read vertices");
         fclose(fp);
@@ -1299,19 +1621,19 @@ int GModel::_readMSH4(const std::string &name)
             _vertexVectorCache[vertexCache[i].first] = vertexCache[i].second;
           }
           else {
-            Msg::Warning("Skipping duplicate vertex %d", vertexCache[i].first);
+            Msg::Warning("Skipping duplicate vertex %lu", vertexCache[i].first);
           }
         }
       }
       else {
-        for(unsigned int i = 0; i < nbrNodes; i++) {
-          if(_vertexMapCache.count(vertexCache[i].first) == 0) {
-            _vertexMapCache[vertexCache[i].first] = vertexCache[i].second;
-          }
-          else {
-            Msg::Warning("Skipping duplicate vertex %d", vertexCache[i].first);
-          }
-        }
+        _vertexMapCache.reserve(nbrNodes);
+        for(unsigned int i = 0; i < nbrNodes; i++)
+          _vertexMapCache.insert(vertexCache[i].first, vertexCache[i].second);
+        // the vertices belong to their entity: keep the first one, as in the
+        // dense case
+        std::size_t numDuplicates = _vertexMapCache.sort(0, true);
+        if(numDuplicates)
+          Msg::Warning("Skipping %lu duplicate vertices", numDuplicates);
       }
       delete[] vertexCache;
     }
@@ -1319,13 +1641,23 @@ int GModel::_readMSH4(const std::string &name)
       Msg::ResetProgressMeter();
       bool dense = false;
       unsigned long nbrElements = 0, maxElementNum = 0;
-      std::pair<int, MElement *> *elementCache = readMSH4Elements(
-        this, fp, binary, dense, nbrElements, maxElementNum, swap);
+      std::pair<std::size_t, MElement *> *elementCache = 0;
+      const char *p, *end;
+      if(binary && fileMap.map(name, fp, p, end)) {
+        elementCache = readMSH4ElementsMapped(this, p, end, dense, nbrElements,
+                                              maxElementNum, swap);
+        fileMap.sync(fp, p);
+      }
+      else {
+        elementCache = readMSH4Elements(this, fp, binary, dense, nbrElements,
+                                        maxElementNum, swap);
+      }
       if(!elementCache) {
         Msg::Error("Could not read elements");
         fclose(fp);
         return 0;
       }
+      _elementCacheReady = 0;
       if(dense) {
         _elementVectorCache.resize(maxElementNum + 1, (MElement *)0);
         for(unsigned int i = 0; i < nbrElements; i++) {
@@ -1333,21 +1665,19 @@ int GModel::_readMSH4(const std::string &name)
             _elementVectorCache[elementCache[i].first] = elementCache[i].second;
           }
           else {
-            Msg::Warning("Skipping duplicate element %d",
+            Msg::Warning("Skipping duplicate element %lu",
                          elementCache[i].first);
           }
         }
       }
       else {
-        for(unsigned int i = 0; i < nbrElements; i++) {
-          if(_elementMapCache.count(elementCache[i].first) == 0) {
-            _elementMapCache[elementCache[i].first] = elementCache[i].second;
-          }
-          else {
-            Msg::Warning("Skipping duplicate element %d",
-                         elementCache[i].first);
-          }
-        }
+        _elementMapCache.reserve(nbrElements);
+        for(unsigned int i = 0; i < nbrElements; i++)
+          _elementMapCache.insert(elementCache[i].first,
+                                  elementCache[i].second);
+        std::size_t numDuplicates = _elementMapCache.sort(0, true);
+        if(numDuplicates)
+          Msg::Warning("Skipping %lu duplicate elements", numDuplicates);
       }
       delete[] elementCache;
     }
@@ -2012,6 +2342,96 @@ getAdditionalEntities(std::set<GRegion *, GEntityLessThan> &regions,
   return numVertices;
 }
 
+// Entity blocks are serialized in parallel into separate buffers, by chunks of
+// at most MSH4_CHUNK_SIZE nodes or elements, and the buffers are then written in
+// order with one fwrite each. Chunks are processed in batches, so that only a
+// bounded part of the output is kept in memory at any time.
+
+static const std::size_t MSH4_CHUNK_SIZE = 100000;
+
+struct MSH4NodeChunk {
+  GEntity *entity;
+  std::size_t begin, end;
+  bool binary;
+  int saveParametric;
+  double scalingFactor;
+  void serialize(std::string &buf) const
+  {
+    if(begin == 0) { // first chunk of the block: write the block header
+      unsigned long numVerts = entity->getNumMeshVertices();
+      if(binary) {
+        int data[3] = {entity->tag(), entity->dim(), saveParametric};
+        buf.append((const char *)data, 3 * sizeof(int));
+        buf.append((const char *)&numVerts, sizeof(unsigned long));
+      }
+      else {
+        char str[256];
+        int n = sprintf(str, "%d %d %d %lu\n", entity->tag(), entity->dim(),
+                        saveParametric, numVerts);
+        buf.append(str, n);
+      }
+    }
+    buf.reserve(buf.size() + (end - begin) * (binary ? 52 : 80));
+    for(std::size_t i = begin; i < end; i++)
+      entity->getMeshVertex(i)->writeMSH4(buf, binary, saveParametric,
+                                          scalingFactor);
+  }
+};
+
+struct MSH4ElementChunk {
+  const std::vector<MElement *> *elements;
+  int entityTag, dim, elmType;
+  std::size_t begin, end;
+  bool binary;
+  void serialize(std::string &buf) const
+  {
+    if(begin == 0) { // first chunk of the block: write the block header
+      unsigned long numElm = elements->size();
+      if(binary) {
+        int data[3] = {entityTag, dim, elmType};
+        buf.append((const char *)data, 3 * sizeof(int));
+        buf.append((const char *)&numElm, sizeof(unsigned long));
+      }
+      else {
+        char str[256];
+        int n = sprintf(str, "%d %d %d %lu\n", entityTag, dim, elmType, numElm);
+        buf.append(str, n);
+      }
+    }
+    if(binary) {
+      const int nbrVertices = MElement::getInfoMSH(elmType);
+      std::vector<int> data((end - begin) * (nbrVertices + 1));
+      std::size_t k = 0;
+      for(std::size_t i = begin; i < end; i++) {
+        MElement *e = (*elements)[i];
+        data[k++] = e->getNum();
+        for(int j = 0; j < nbrVertices; j++)
+          data[k++] = e->getVertex(j)->getNum();
+      }
+      if(data.size())
+        buf.append((const char *)&data[0], data.size() * sizeof(int));
+    }
+    else {
+      for(std::size_t i = begin; i < end; i++)
+        (*elements)[i]->writeMSH4(buf, false);
+    }
+  }
+};
+
+template <class Chunk>
+static void writeMSH4Chunks(FILE *fp, const std::vector<Chunk> &chunks)
+{
+  const std::size_t batchSize = 4 * Msg::GetMaxThreads();
+  for(std::size_t b = 0; b < chunks.size(); b += batchSize) {
+    const int n = (int)std::min(batchSize, chunks.size() - b);
+    std::vector<std::string> buffers(n);
+#pragma omp parallel for schedule(dynamic)
+    for(int i = 0; i < n; i++) chunks[b + i].serialize(buffers[i]);
+    for(int i = 0; i < n; i++)
+      fwrite(buffers[i].data(), 1, buffers[i].size(), fp);
+  }
+}
+
 static void writeMSH4Nodes(GModel *const model, FILE *fp, bool partitioned,
                            bool binary, int saveParametric,
                            double scalingFactor, bool saveAll)
@@ -2086,85 +2506,28 @@ static void writeMSH4Nodes(GModel *const model, FILE *fp, bool partitioned,
             numVertices);
   }
 
-  for(GModel::viter it = vertices.begin(); it != vertices.end(); ++it) {
-    if(binary) {
-      int entityTag = (*it)->tag();
-      int entityDim = (*it)->dim();
-      unsigned long numVerts = (*it)->getNumMeshVertices();
-      fwrite(&entityTag, sizeof(int), 1, fp);
-      fwrite(&entityDim, sizeof(int), 1, fp);
-      fwrite(&saveParametric, sizeof(int), 1, fp);
-      fwrite(&numVerts, sizeof(unsigned long), 1, fp);
-    }
-    else {
-      fprintf(fp, "%d %d %d %lu\n", (*it)->tag(), (*it)->dim(), saveParametric,
-              (unsigned long)(*it)->getNumMeshVertices());
-    }
-
-    for(unsigned int i = 0; i < (*it)->getNumMeshVertices(); i++)
-      (*it)->getMeshVertex(i)->writeMSH4(fp, binary, saveParametric,
-                                         scalingFactor);
-  }
-
-  for(GModel::eiter it = edges.begin(); it != edges.end(); ++it) {
-    if(binary) {
-      int entityTag = (*it)->tag();
-      int entityDim = (*it)->dim();
-      unsigned long numVerts = (*it)->getNumMeshVertices();
-      fwrite(&entityTag, sizeof(int), 1, fp);
-      fwrite(&entityDim, sizeof(int), 1, fp);
-      fwrite(&saveParametric, sizeof(int), 1, fp);
-      fwrite(&numVerts, sizeof(unsigned long), 1, fp);
-    }
-    else {
-      fprintf(fp, "%d %d %d %lu\n", (*it)->tag(), (*it)->dim(), saveParametric,
-              (unsigned long)(*it)->getNumMeshVertices());
-    }
-
-    for(unsigned int i = 0; i < (*it)->getNumMeshVertices(); i++)
-      (*it)->getMeshVertex(i)->writeMSH4(fp, binary, saveParametric,
-                                         scalingFactor);
-  }
-
-  for(GModel::fiter it = faces.begin(); it != faces.end(); ++it) {
-    if(binary) {
-      int entityTag = (*it)->tag();
-      int entityDim = (*it)->dim();
-      unsigned long numVerts = (*it)->getNumMeshVertices();
-      fwrite(&entityTag, sizeof(int), 1, fp);
-      fwrite(&entityDim, sizeof(int), 1, fp);
-      fwrite(&saveParametric, sizeof(int), 1, fp);
-      fwrite(&numVerts, sizeof(unsigned long), 1, fp);
-    }
-    else {
-      fprintf(fp, "%d %d %d %lu\n", (*it)->tag(), (*it)->dim(), saveParametric,
-              (unsigned long)(*it)->getNumMeshVertices());
-    }
-
-    for(unsigned int i = 0; i < (*it)->getNumMeshVertices(); i++)
-      (*it)->getMeshVertex(i)->writeMSH4(fp, binary, saveParametric,
-                                         scalingFactor);
-  }
-
-  for(GModel::riter it = regions.begin(); it != regions.end(); ++it) {
-    if(binary) {
-      int entityTag = (*it)->tag();
-      int entityDim = (*it)->dim();
-      unsigned long numVerts = (*it)->getNumMeshVertices();
-      fwrite(&entityTag, sizeof(int), 1, fp);
-      fwrite(&entityDim, sizeof(int), 1, fp);
-      fwrite(&saveParametric, sizeof(int), 1, fp);
-      fwrite(&numVerts, sizeof(unsigned long), 1, fp);
-    }
-    else {
-      fprintf(fp, "%d %d %d %lu\n", (*it)->tag(), (*it)->dim(), saveParametric,
-              (unsigned long)(*it)->getNumMeshVertices());
-    }
-
-    for(unsigned int i = 0; i < (*it)->getNumMeshVertices(); i++)
-      (*it)->getMeshVertex(i)->writeMSH4(fp, binary, saveParametric,
-                                         scalingFactor);
-  }
+  std::vector<GEntity *> entities;
+  entities.insert(entities.end(), vertices.begin(), vertices.end());
+  entities.insert(entities.end(), edges.begin(), edges.end());
+  entities.insert(entities.end(), faces.begin(), faces.end());
+  entities.insert(entities.end(), regions.begin(), regions.end());
+
+  std::vector<MSH4NodeChunk> chunks;
+  for(std::size_t i = 0; i < entities.size(); i++) {
+    std::size_t n = entities[i]->getNumMeshVertices(), begin = 0;
+    do {
+      MSH4NodeChunk c;
+      c.entity = entities[i];
+      c.begin = begin;
+      c.end = std::min(n, begin + MSH4_CHUNK_SIZE);
+      c.binary = binary;
+      c.saveParametric = saveParametric;
+      c.scalingFactor = scalingFactor;
+      chunks.push_back(c);
+      begin = c.end;
+    } while(begin < n);
+  }
+  writeMSH4Chunks(fp, chunks);
 
   if(binary) fprintf(fp, "\n");
 }
@@ -2307,47 +2670,27 @@ static void writeMSH4Elements(GModel *const model, FILE *fp, bool partitioned,
     fprintf(fp, "%lu %lu\n", numSection, numElements);
   }
 
+  std::vector<MSH4ElementChunk> chunks;
   for(int dim = 0; dim <= 3; dim++) {
     for(std::map<std::pair<int, int>, std::vector<MElement *> >::iterator it =
           elementsByDegree[dim].begin();
         it != elementsByDegree[dim].end(); ++it) {
-      int entityTag = it->first.first;
-      int elmType = it->first.second;
-      unsigned long numElm = it->second.size();
-      if(binary) {
-        fwrite(&entityTag, sizeof(int), 1, fp);
-        fwrite(&dim, sizeof(int), 1, fp);
-        fwrite(&elmType, sizeof(int), 1, fp);
-        fwrite(&numElm, sizeof(unsigned long), 1, fp);
-      }
-      else {
-        fprintf(fp, "%d %d %d %lu\n", entityTag, dim, elmType, numElm);
-      }
-
-      if(binary) {
-        const int nbrVertices = MElement::getInfoMSH(elmType);
-        int indexElement = 0;
-        int *elementData = new int[it->second.size() * (nbrVertices + 1)];
-        for(unsigned int i = 0; i < it->second.size() * (nbrVertices + 1);
-            i += (nbrVertices + 1)) {
-          elementData[i] = it->second[indexElement]->getNum();
-          for(int j = 0; j < nbrVertices; j++) {
-            elementData[i + 1 + j] =
-              it->second[indexElement]->getVertex(j)->getNum();
-          }
-          indexElement++;
-        }
-        fwrite(elementData, sizeof(int), it->second.size() * (nbrVertices + 1),
-               fp);
-        delete[] elementData;
-      }
-      else {
-        for(unsigned int i = 0; i < it->second.size(); i++) {
-          it->second[i]->writeMSH4(fp, binary);
-        }
-      }
-    }
-  }
+      std::size_t n = it->second.size(), begin = 0;
+      do {
+        MSH4ElementChunk c;
+        c.elements = &it->second;
+        c.entityTag = it->first.first;
+        c.dim = dim;
+        c.elmType = it->first.second;
+        c.begin = begin;
+        c.end = std::min(n, begin + MSH4_CHUNK_SIZE);
+        c.binary = binary;
+        chunks.push_back(c);
+        begin = c.end;
+      } while(begin < n);
+    }
+  }
+  writeMSH4Chunks(fp, chunks);
 
   if(binary) fprintf(fp, "\n");
 }
@@ -2422,7 +2765,7 @@ static void writeMSH4PeriodicNodes(GModel *const model, FILE *fp,
         for(std::map<MVertex *, MVertex *>::iterator it =
               g_slave->correspondingVertices.begin();
             it != g_slave->correspondingVertices.end(); ++it) {
-          fprintf(fp, "%d %d\n", it->first->getNum(), it->second->getNum());
+          fprintf(fp, "%lu %lu\n", it->first->getNum(), it->second->getNum());
         }
       }
     }
@@ -2490,7 +2833,7 @@ static void writeMSH4GhostCells(GModel *const model, FILE *fp, bool binary)
       for(std::map<MElement *, std::vector<unsigned int> >::iterator it =
             ghostCells.begin();
           it != ghostCells.end(); ++it) {
-        fprintf(fp, "%d %d %ld", it->first->getNum(), it->second[0],
+        fprintf(fp, "%lu %d %ld", it->first->getNum(), it->second[0],
                 it->second.size() - 1);
         for(unsigned int i = 1; i < it->second.size(); i++) {
           fprintf(fp, " %d", it->second[i]);
@@ -2517,6 +2860,14 @@ int GModel::_writeMSH4(const std::string &name, double version, bool binary,
     return 0;
   }
 
+  if(binary && (getMaxVertexNumber() > (std::size_t)INT_MAX ||
+                getMaxElementNumber() > (std::size_t)INT_MAX)) {
+    Msg::Error("Binary MSH %g files store node and element tags as 32-bit "
+               "integers: save the mesh in ASCII or renumber it", version);
+    fclose(fp);
+    return 0;
+  }
+
   // if there are no physicals we save all the elements
   if(noPhysicalGroups()) saveAll = true;
 
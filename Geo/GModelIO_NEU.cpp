@@ -197,7 +197,7 @@ int GModel::writeNEU(const std::string &name, bool saveAll,
           MTetrahedron *tet = (*it)->tetrahedra[i];
           elementGroups[(*it)->physicals[phys]].push_back(tet->getNum());
 
-          if(tet->getNum() < lowestId) lowestId = tet->getNum() - 1;
+          if((int)tet->getNum() < lowestId) lowestId = tet->getNum() - 1;
         }
       }
     }
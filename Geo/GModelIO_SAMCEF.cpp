@@ -54,8 +54,9 @@ int GModel::readSAMCEF(const std::string &name)
         if(sscanf(buffer, "%s %d %s %lf %s %lf %s %lf", dummy, &num, dummy, &x,
                   dummy, &y, dummy, &z) != 8)
           return 0;
-        _vertexMapCache[num] = new MVertex(x, y, z, 0, num);
+        _vertexMapCache.insert(num, new MVertex(x, y, z, 0, num));
       }
+      _sortMeshVertexCache();
       Msg::Info("Read %d mesh vertices", (int)_vertexMapCache.size());
     }
     else if(!strncmp(buffer, ".MAI", 4)) {
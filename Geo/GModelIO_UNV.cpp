@@ -66,8 +66,9 @@ int GModel::readUNV(const std::string &name)
           for(unsigned int i = 0; i < strlen(buffer); i++)
             if(buffer[i] == 'D') buffer[i] = 'E';
           if(sscanf(buffer, "%lf %lf %lf", &x, &y, &z) != 3) break;
-          _vertexMapCache[num] = new MVertex(x, y, z, 0, num);
+          _vertexMapCache.insert(num, new MVertex(x, y, z, 0, num));
         }
+        _sortMeshVertexCache();
       }
       else if(record == 2412) { // elements
         Msg::Info("Reading elements");
@@ -377,7 +378,7 @@ int GModel::writeUNV(const std::string &name, bool saveAll,
               fprintf(fp, "\n");
               row = 0;
             }
-            fprintf(fp, "%10d%10d%10d%10d", 8, e->getNum(), 0, 0);
+            fprintf(fp, "%10d%10d%10d%10d", 8, (int)e->getNum(), 0, 0);
             row++;
           }
         }
@@ -190,11 +190,30 @@ template <class T>
 static void addElementsInArrays(GEntity *e, std::vector<T *> &elements,
                                 bool edges, bool faces)
 {
+  // each thread fills its own chunk of the arrays, without synchronization;
+  // the elements are distributed in contiguous ranges, so that appending the
+  // chunks in thread order gives the same arrays as the serial loop (the
+  // first thread directly fills the arrays of the entity)
+  int nthreads = 1;
 #if defined(_OPENMP)
-#pragma omp parallel for schedule(dynamic)
+  if(elements.size() > 1000) nthreads = Msg::GetMaxThreads();
+#endif
+  std::vector<VertexArray *> lines(nthreads, (VertexArray *)0);
+  std::vector<VertexArray *> triangles(nthreads, (VertexArray *)0);
+  lines[0] = e->va_lines;
+  triangles[0] = e->va_triangles;
+  int chunkSize = elements.size() / nthreads + 1;
+  for(int t = 1; t < nthreads; t++) {
+    if(edges) lines[t] = new VertexArray(2, chunkSize);
+    if(faces) triangles[t] = new VertexArray(3, chunkSize);
+  }
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(nthreads)
 #endif
   for(unsigned int i = 0; i < elements.size(); i++) {
     MElement *ele = elements[i];
+    int t = Msg::GetThreadNum();
 
     if(!isElementVisible(ele) || ele->getDim() < 1) continue;
 
@@ -225,12 +244,7 @@ static void addElementsInArrays(GEntity *e, std::vector<T *> &elements,
           for(int k = 0; k < 2; k++)
             e->model()->normals->get(x[k], y[k], z[k], n[k][0], n[k][1],
                                      n[k][2]);
-#if defined(_OPENMP)
-#pragma omp critical
-#endif
-        {
-          e->va_lines->add(x, y, z, n, col, ele, unique);
-        }
+        lines[t]->add(x, y, z, n, col, ele, unique);
       }
     }
 
@@ -252,15 +266,21 @@ static void addElementsInArrays(GEntity *e, std::vector<T *> &elements,
           for(int k = 0; k < 3; k++)
             e->model()->normals->get(x[k], y[k], z[k], n[k][0], n[k][1],
                                      n[k][2]);
-#if defined(_OPENMP)
-#pragma omp critical
-#endif
-        {
-          e->va_triangles->add(x, y, z, n, col, ele, unique, skin);
-        }
+        triangles[t]->add(x, y, z, n, col, ele, unique, skin);
       }
     }
   }
+
+  for(int t = 1; t < nthreads; t++) {
+    if(lines[t]) {
+      e->va_lines->merge(lines[t]);
+      delete lines[t];
+    }
+    if(triangles[t]) {
+      e->va_triangles->merge(triangles[t]);
+      delete triangles[t];
+    }
+  }
 }
 
 class initMeshGEdge {
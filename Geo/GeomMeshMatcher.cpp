@@ -501,7 +501,7 @@ int GeomMeshMatcher::forceTomatch(GModel *geom, GModel *mesh, const double TOL)
       GVertex *gv = getGVertex (v, geom, TOL);
       bool found = 0;
       if (gv){
-        printf("vertex %d matches GVertex %d\n",v->getNum(),gv->tag());
+        printf("vertex %lu matches GVertex %d\n",v->getNum(),gv->tag());
         found=1;
         MVertex *vvv = new MVertex (v->x(),v->y(),v->z(),gv,v->getNum());
         gv->mesh_vertices.push_back(vvv);
@@ -514,7 +514,7 @@ int GeomMeshMatcher::forceTomatch(GModel *geom, GModel *mesh, const double TOL)
           GEntity *gg = (GEntity*)gp.g();
           found=1;
           gg->mesh_vertices.push_back(new MEdgeVertex (gp.x(),gp.y(),gp.z(),
-                                                       gg,gp.u(),-1.,v->getNum()));
+                                                       gg,gp.u(),v->getNum(),-1.));
         }
       }
       if (!found && v->onWhat()->dim() <= 2){
@@ -526,8 +526,9 @@ int GeomMeshMatcher::forceTomatch(GModel *geom, GModel *mesh, const double TOL)
                                                        gg,gp.u(),gp.v(),v->getNum()));
         }
       }
-      if (!found) Msg::Error("vertex %d classified on %d %d not matched",
-                             v->getNum(),v->onWhat()->dim(),v->onWhat()->tag());
+      if (!found) Msg::Error("vertex %lu classified on %d %d not matched",
+                             (unsigned long)v->getNum(),v->onWhat()->dim(),
+                             v->onWhat()->tag());
     }
   }
   for (GModel::eiter it = mesh->firstEdge(); it != mesh->lastEdge(); ++it){
@@ -548,8 +549,8 @@ int GeomMeshMatcher::forceTomatch(GModel *geom, GModel *mesh, const double TOL)
         else printf("argh !\n");
       }
       else{
-        if (!v1)printf("Vertex %d has not been found\n", (*it)->lines[i]->getVertex(0)->getNum());
-        if (!v2)printf("Vertex %d has not been found\n", (*it)->lines[i]->getVertex(1)->getNum());
+        if (!v1)printf("Vertex %lu has not been found\n", (*it)->lines[i]->getVertex(0)->getNum());
+        if (!v2)printf("Vertex %lu has not been found\n", (*it)->lines[i]->getVertex(1)->getNum());
       }
     }
   }
@@ -770,9 +771,9 @@ static void copy_elements (std::vector<ELEMENT*> &to,
       std::map<MVertex*,MVertex*>::iterator vIter = _mesh_to_geom.find(e->getVertex(j));
 
       if (vIter ==_mesh_to_geom.end()) {
-        Msg::Error("Could not find match for vertex %i during element copy "
+        Msg::Error("Could not find match for vertex %lu during element copy "
                    "while matching discrete to actual CAD",
-                   e->getVertex(j)->getNum());
+                   (unsigned long)e->getVertex(j)->getNum());
       }
       else nodes.push_back(vIter->second);
     }
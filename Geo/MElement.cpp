@@ -35,8 +35,23 @@
 
 double MElement::_isInsideTolerance = 1.e-6;
 
-MElement::MElement(int num, int part) : _visible(1)
+static bool updateMaxElementNumber = true;
+#if defined(_OPENMP)
+#pragma omp threadprivate(updateMaxElementNumber)
+#endif
+
+void MElement::setUpdateMaxNumber(bool update)
+{
+  updateMaxElementNumber = update;
+}
+
+MElement::MElement(std::size_t num, int part) : _visible(1)
 {
+  if(num && !updateMaxElementNumber) {
+    _num = num;
+    _partition = (short)part;
+    return;
+  }
 #if defined(_OPENMP)
 #pragma omp critical
 #endif
@@ -55,7 +70,7 @@ MElement::MElement(int num, int part) : _visible(1)
   }
 }
 
-void MElement::forceNum(int num)
+void MElement::forceNum(std::size_t num)
 {
 #if defined(_OPENMP)
 #pragma omp critical
@@ -214,7 +229,8 @@ bool MElement::getEdgeInfo(const MEdge &edge, int &ithEdge, int &sign) const
       return true;
     }
   }
-  Msg::Error("Could not get edge information for element %d", getNum());
+  Msg::Error("Could not get edge information for element %lu",
+             (unsigned long)getNum());
   return false;
 }
 
@@ -1429,10 +1445,10 @@ void MElement::writeMSH2(FILE *fp, double version, bool binary, int num,
     }
   }
 
-  if(CTX::instance()->mesh.preserveNumberingMsh2) num = _num;
+  if(CTX::instance()->mesh.preserveNumberingMsh2) num = (int)_num;
 
   if(!binary) {
-    fprintf(fp, "%d %d", num ? num : _num, type);
+    fprintf(fp, "%d %d", num ? num : (int)_num, type);
     if(version < 2.0)
       fprintf(fp, " %d %d %d", abs(physical), elementary, n);
     else if(version < 2.2)
@@ -1469,8 +1485,14 @@ void MElement::writeMSH2(FILE *fp, double version, bool binary, int num,
     // tags change from element to element (third-party codes can
     // still write MSH file optimized for reading speed, by grouping
     // elements with the same number of tags in blobs)
-    int blob[60] = {type,          1,          numTags,       num ? num : _num,
-                    abs(physical), elementary, 1 + numGhosts, _partition};
+    int blob[60] = {type,
+                    1,
+                    numTags,
+                    num ? num : (int)_num,
+                    abs(physical),
+                    elementary,
+                    1 + numGhosts,
+                    _partition};
     if(ghosts)
       for(int i = 0; i < numGhosts; i++) blob[8 + i] = -(*ghosts)[i];
     if(par) blob[8 + numGhosts] = parentNum;
@@ -1494,24 +1516,29 @@ void MElement::writeMSH2(FILE *fp, double version, bool binary, int num,
   if(physical < 0) reverse();
 }
 
-void MElement::writeMSH4(FILE *fp, bool binary)
+void MElement::writeMSH4(std::string &buf, bool binary)
 {
   std::vector<MVertex *> verts;
   getVertices(verts);
 
-  if(binary) { // Implemented but not used in practice
-    fwrite(&_num, sizeof(int), 1, fp);
+  if(binary) {
+    // binary MSH 4.0 files store tags as 32-bit integers
+    int num = (int)_num;
+    buf.append((const char *)&num, sizeof(int));
     for(unsigned int i = 0; i < verts.size(); i++) {
       int vertNum = verts[i]->getNum();
-      fwrite(&vertNum, sizeof(int), 1, fp);
+      buf.append((const char *)&vertNum, sizeof(int));
     }
   }
   else {
-    fprintf(fp, "%d ", _num);
+    char str[32];
+    int n = sprintf(str, "%lu ", _num);
+    buf.append(str, n);
     for(unsigned int i = 0; i < verts.size(); i++) {
-      fprintf(fp, "%d ", verts[i]->getNum());
+      n = sprintf(str, "%lu ", verts[i]->getNum());
+      buf.append(str, n);
     }
-    fprintf(fp, "\n");
+    buf.push_back('\n');
   }
 }
 
@@ -1547,7 +1574,7 @@ void MElement::writePOS(FILE *fp, bool printElementary, bool printElementNumber,
         first = false;
       else
         fprintf(fp, ",");
-      fprintf(fp, "%d", getNum());
+      fprintf(fp, "%lu", getNum());
     }
   }
   if(printSICN) {
@@ -1737,7 +1764,7 @@ void MElement::writeUNV(FILE *fp, int num, int elementary, int physical)
   int physical_property = elementary;
   int material_property = abs(physical);
   int color = 7;
-  fprintf(fp, "%10d%10d%10d%10d%10d%10d\n", num ? num : _num, type,
+  fprintf(fp, "%10d%10d%10d%10d%10d%10d\n", num ? num : (int)_num, type,
           physical_property, material_property, color, n);
   if(type == 21 || type == 24) // linear beam or parabolic beam
     fprintf(fp, "%10d%10d%10d\n", 0, 0, 0);
@@ -1777,7 +1804,7 @@ void MElement::writeNEU(FILE *fp, unsigned gambitType, int idAdjust, int phys)
 {
   if(phys < 0) reverse();
 
-  fprintf(fp, "%8d %2d %2lu ", _num - idAdjust, gambitType, getNumVertices());
+  fprintf(fp, "%8d %2d %2lu ", (int)_num - idAdjust, gambitType, getNumVertices());
   for(std::size_t i = 0; i < getNumVertices(); ++i) {
     fprintf(fp, "%8d", getVertex(i)->getIndex());
   }
@@ -1820,11 +1847,12 @@ void MElement::writeBDF(FILE *fp, int format, int elementTagType,
               (elementTagType == 2) ? abs(physical) : elementary;
 
   if(format == 0) { // free field format
-    fprintf(fp, "%s,%d,%d", str, _num, tag);
+    fprintf(fp, "%s,%d,%d", str, (int)_num, tag);
     for(int i = 0; i < n; i++) {
       fprintf(fp, ",%d", getVertexBDF(i)->getIndex());
       if(i != n - 1 && !((i + 3) % 8)) {
-        fprintf(fp, ",+%s%d\n+%s%d", cont[ncont], _num, cont[ncont], _num);
+        fprintf(fp, ",+%s%d\n+%s%d", cont[ncont], (int)_num, cont[ncont],
+                (int)_num);
         ncont++;
       }
     }
@@ -1833,11 +1861,12 @@ void MElement::writeBDF(FILE *fp, int format, int elementTagType,
     fprintf(fp, "\n");
   }
   else { // small or large field format
-    fprintf(fp, "%-8s%-8d%-8d", str, _num, tag);
+    fprintf(fp, "%-8s%-8d%-8d", str, (int)_num, tag);
     for(int i = 0; i < n; i++) {
       fprintf(fp, "%-8d", getVertexBDF(i)->getIndex());
       if(i != n - 1 && !((i + 3) % 8)) {
-        fprintf(fp, "+%s%-6d\n+%s%-6d", cont[ncont], _num, cont[ncont], _num);
+        fprintf(fp, "+%s%-6d\n+%s%-6d", cont[ncont], (int)_num, cont[ncont],
+                (int)_num);
         ncont++;
       }
     }
@@ -2433,10 +2462,10 @@ MElement *MElement::copy(std::map<int, MVertex *> &vertexMap,
   return newEl;
 }
 
-MElement *MElementFactory::create(int type, std::vector<MVertex *> &v, int num,
-                                  int part, bool owner, int parent,
-                                  MElement *parent_ptr, MElement *d1,
-                                  MElement *d2)
+MElement *MElementFactory::create(int type, std::vector<MVertex *> &v,
+                                  std::size_t num, int part, bool owner,
+                                  int parent, MElement *parent_ptr,
+                                  MElement *d1, MElement *d2)
 {
   switch(type) {
   case MSH_PNT: return new MPoint(v, num, part);
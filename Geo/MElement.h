@@ -12,6 +12,7 @@
 #include <fstream>
 
 #include "GmshMessage.h"
+#include "MallocUtils.h"
 #include "ElementType.h"
 #include "MVertex.h"
 #include "MEdge.h"
@@ -29,8 +30,9 @@ class MElement {
 private:
   // the id number of the element (this number is unique and is guaranteed never
   // to change once a mesh has been generated, unless the mesh is explicitly
-  // renumbered)
-  int _num;
+  // renumbered); using 64-bit tags adds 8 bytes (16 to 24 bytes on 64-bit
+  // platforms) to the size of the base class
+  std::size_t _num;
   // the number of the mesh partition the element belongs to
   short _partition;
   // a visibility flag
@@ -55,19 +57,31 @@ protected:
                            int &rot);
 
 public:
-  MElement(int num = 0, int part = 0);
+  MElement(std::size_t num = 0, int part = 0);
   virtual ~MElement() {}
 
+  // elements are allocated in the small object pool (see MallocUtils.h)
+  static void *operator new(std::size_t size) { return PoolMalloc(size); }
+  static void operator delete(void *ptr, std::size_t size)
+  {
+    PoolFree(ptr, size);
+  }
+
+  // when disabled, elements created by the calling thread with a given number
+  // do not update the maximum element number of the model: the caller must
+  // then update it after their creation
+  static void setUpdateMaxNumber(bool update);
+
   // set/get the tolerance for isInside() test
   static void setTolerance(const double tol);
   static double getTolerance();
 
   // return the tag of the element
-  virtual int getNum() const { return _num; }
+  virtual std::size_t getNum() const { return _num; }
 
   // force the immutable number (this should never be used, except when
   // explicitly renumbering the mesh)
-  void forceNum(int num);
+  void forceNum(std::size_t num);
 
   // return the geometrical dimension of the element
   virtual int getDim() const = 0;
@@ -435,7 +449,7 @@ public:
                          int num = 0, int elementary = 1, int physical = 1,
                          int parentNum = 0, int dom1Num = 0, int dom2Num = 0,
                          std::vector<short> *ghosts = 0);
-  virtual void writeMSH4(FILE *fp, bool binary = false);
+  virtual void writeMSH4(std::string &buf, bool binary = false);
   virtual void writePOS(FILE *fp, bool printElementary, bool printElementNumber,
                         bool printSICN, bool printSIGE, bool printGamma,
                         bool printDisto, double scalingFactor = 1.0,
@@ -495,7 +509,7 @@ public:
 
 class MElementFactory {
 public:
-  MElement *create(int type, std::vector<MVertex *> &v, int num = 0,
+  MElement *create(int type, std::vector<MVertex *> &v, std::size_t num = 0,
                    int part = 0, bool owner = false, int parent = 0,
                    MElement *parent_ptr = NULL, MElement *d1 = 0,
                    MElement *d2 = 0);
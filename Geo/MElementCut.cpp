@@ -1552,9 +1552,10 @@ GModel *buildCutMesh(GModel *gm, gLevelset *ls,
   for(unsigned int i = 0; i < gmEntities.size(); i++) {
     for(unsigned int j = 0; j < gmEntities[i]->getNumMeshElements(); j++) {
       MElement *e = gmEntities[i]->getMeshElement(j);
-      if(e->getNum() > numEle) numEle = e->getNum();
+      if((int)e->getNum() > numEle) numEle = e->getNum();
       if(e->getParent())
-        if(e->getParent()->getNum() > numEle) numEle = e->getParent()->getNum();
+        if((int)e->getParent()->getNum() > numEle)
+          numEle = e->getParent()->getNum();
     }
   }
 
@@ -1702,10 +1703,14 @@ GModel *buildCutMesh(GModel *gm, gLevelset *ls,
       printf(" elementary : %d\n",it->first);
       for(unsigned int j = 0; j < it->second.size(); j++){
         MElement *e = it->second[j];
-        printf("element %d",e->getNum());
-        if(e->getParent()) printf(" par=%d (%d)",e->getParent()->getNum(),e->ownsParent());
-        if(e->getDomain(0)) printf(" d0=%d",e->getDomain(0)->getNum());
-        if(e->getDomain(1)) printf(" d1=%d",e->getDomain(1)->getNum());
+        printf("element %lu",(unsigned long)e->getNum());
+        if(e->getParent())
+          printf(" par=%lu (%d)",(unsigned long)e->getParent()->getNum(),
+                 e->ownsParent());
+        if(e->getDomain(0))
+          printf(" d0=%lu",(unsigned long)e->getDomain(0)->getNum());
+        if(e->getDomain(1))
+          printf(" d1=%lu",(unsigned long)e->getDomain(1)->getNum());
         printf("\n"); numElements++;
       }
     }
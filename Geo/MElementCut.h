@@ -31,7 +31,7 @@ protected:
   void _init();
 
 public:
-  MPolyhedron(std::vector<MVertex *> v, int num = 0, int part = 0,
+  MPolyhedron(std::vector<MVertex *> v, std::size_t num = 0, int part = 0,
               bool owner = false, MElement *orig = NULL)
     : MElement(num, part), _owner(owner), _orig(orig), _intpt(0)
   {
@@ -43,7 +43,7 @@ public:
       _parts.push_back(new MTetrahedron(v[i], v[i + 1], v[i + 2], v[i + 3]));
     _init();
   }
-  MPolyhedron(std::vector<MTetrahedron *> vT, int num = 0, int part = 0,
+  MPolyhedron(std::vector<MTetrahedron *> vT, std::size_t num = 0, int part = 0,
               bool owner = false, MElement *orig = NULL)
     : MElement(num, part), _owner(owner), _orig(orig), _intpt(0)
   {
@@ -207,7 +207,7 @@ protected:
   void _initVertices();
 
 public:
-  MPolygon(std::vector<MVertex *> v, int num = 0, int part = 0,
+  MPolygon(std::vector<MVertex *> v, std::size_t num = 0, int part = 0,
            bool owner = false, MElement *orig = NULL)
     : MElement(num, part), _owner(owner), _orig(orig), _intpt(0)
   {
@@ -215,7 +215,7 @@ public:
       _parts.push_back(new MTriangle(v[i * 3], v[i * 3 + 1], v[i * 3 + 2]));
     _initVertices();
   }
-  MPolygon(std::vector<MTriangle *> vT, int num = 0, int part = 0,
+  MPolygon(std::vector<MTriangle *> vT, std::size_t num = 0, int part = 0,
            bool owner = false, MElement *orig = NULL)
     : MElement(num, part), _owner(owner), _orig(orig), _intpt(0)
   {
@@ -366,12 +366,12 @@ protected:
   IntPt *_intpt;
 
 public:
-  MLineChild(MVertex *v0, MVertex *v1, int num = 0, int part = 0,
+  MLineChild(MVertex *v0, MVertex *v1, std::size_t num = 0, int part = 0,
              bool owner = false, MElement *orig = NULL)
     : MLine(v0, v1, num, part), _owner(owner), _orig(orig), _intpt(0)
   {
   }
-  MLineChild(const std::vector<MVertex *> &v, int num = 0, int part = 0,
+  MLineChild(const std::vector<MVertex *> &v, std::size_t num = 0, int part = 0,
              bool owner = false, MElement *orig = NULL)
     : MLine(v, num, part), _owner(owner), _orig(orig), _intpt(0)
   {
@@ -428,14 +428,14 @@ protected:
   IntPt *_intpt;
 
 public:
-  MTriangleBorder(MVertex *v0, MVertex *v1, MVertex *v2, int num = 0,
+  MTriangleBorder(MVertex *v0, MVertex *v1, MVertex *v2, std::size_t num = 0,
                   int part = 0, MElement *d1 = NULL, MElement *d2 = NULL)
     : MTriangle(v0, v1, v2, num, part), _intpt(0)
   {
     _domains[0] = d1;
     _domains[1] = d2;
   }
-  MTriangleBorder(const std::vector<MVertex *> &v, int num = 0, int part = 0,
+  MTriangleBorder(const std::vector<MVertex *> &v, std::size_t num = 0, int part = 0,
                   MElement *d1 = NULL, MElement *d2 = NULL)
     : MTriangle(v, num, part), _intpt(0)
   {
@@ -464,7 +464,7 @@ protected:
   IntPt *_intpt;
 
 public:
-  MPolygonBorder(const std::vector<MTriangle *> &v, int num = 0, int part = 0,
+  MPolygonBorder(const std::vector<MTriangle *> &v, std::size_t num = 0, int part = 0,
                  bool own = false, MElement *p = NULL, MElement *d1 = NULL,
                  MElement *d2 = NULL)
     : MPolygon(v, num, part, own, p), _intpt(0)
@@ -472,7 +472,7 @@ public:
     _domains[0] = d1;
     _domains[1] = d2;
   }
-  MPolygonBorder(const std::vector<MVertex *> &v, int num = 0, int part = 0,
+  MPolygonBorder(const std::vector<MVertex *> &v, std::size_t num = 0, int part = 0,
                  bool own = false, MElement *p = NULL, MElement *d1 = NULL,
                  MElement *d2 = NULL)
     : MPolygon(v, num, part, own, p), _intpt(0)
@@ -498,14 +498,14 @@ protected:
   IntPt *_intpt;
 
 public:
-  MLineBorder(MVertex *v0, MVertex *v1, int num = 0, int part = 0,
+  MLineBorder(MVertex *v0, MVertex *v1, std::size_t num = 0, int part = 0,
               MElement *d1 = NULL, MElement *d2 = NULL)
     : MLine(v0, v1, num, part), _intpt(0)
   {
     _domains[0] = d1;
     _domains[1] = d2;
   }
-  MLineBorder(const std::vector<MVertex *> &v, int num = 0, int part = 0,
+  MLineBorder(const std::vector<MVertex *> &v, std::size_t num = 0, int part = 0,
               MElement *d1 = NULL, MElement *d2 = NULL)
     : MLine(v, num, part), _intpt(0)
   {
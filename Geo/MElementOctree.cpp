@@ -3,10 +3,10 @@
 // See the LICENSE.txt file for license information. Please report all
 // issues on https://gitlab.onelab.info/gmsh/gmsh/issues
 
+#include <algorithm>
 #include "GModel.h"
 #include "MElement.h"
 #include "MElementOctree.h"
-#include "Octree.h"
 #include "Context.h"
 #include "fullMatrix.h"
 #include "bezierBasis.h"
@@ -59,26 +59,6 @@ void MElementBB(void *a, double *min, double *max)
   }
 }
 
-static void MElementCentroid(void *a, double *x)
-{
-  MElement *e = (MElement *)a;
-  MVertex *v = e->getVertex(0);
-  int n = e->getNumVertices();
-  x[0] = v->x();
-  x[1] = v->y();
-  x[2] = v->z();
-  for(int i = 1; i < n; i++) {
-    v = e->getVertex(i);
-    x[0] += v->x();
-    x[1] += v->y();
-    x[2] += v->z();
-  }
-  double oc = 1. / (double)n;
-  x[0] *= oc;
-  x[1] *= oc;
-  x[2] *= oc;
-}
-
 int MElementInEle(void *a, double *x)
 {
   MElement *e = (MElement *)a;
@@ -87,20 +67,59 @@ int MElementInEle(void *a, double *x)
   return e->isInside(uvw[0], uvw[1], uvw[2]) ? 1 : 0;
 }
 
+class MElementInside {
+private:
+  const std::vector<MElement *> &_elems;
+  double *_P;
+  int _dim;
+
+public:
+  MElementInside(const std::vector<MElement *> &elems, double *P, int dim)
+    : _elems(elems), _P(P), _dim(dim)
+  {
+  }
+  bool operator()(int i) const
+  {
+    MElement *e = _elems[i];
+    return (_dim == -1 || e->getDim() == _dim) && MElementInEle(e, _P);
+  }
+};
+
+class MElementCollect {
+private:
+  const std::vector<MElement *> &_elems;
+  double *_P;
+  int _dim;
+
+public:
+  std::vector<MElement *> found;
+  MElementCollect(const std::vector<MElement *> &elems, double *P, int dim)
+    : _elems(elems), _P(P), _dim(dim)
+  {
+  }
+  bool operator()(int i)
+  {
+    MElement *e = _elems[i];
+    if((_dim == -1 || e->getDim() == _dim) && MElementInEle(e, _P))
+      found.push_back(e);
+    return false;
+  }
+};
+
+void MElementOctree::_build()
+{
+  std::vector<double> boxes(6 * _elems.size());
+  for(std::size_t i = 0; i < _elems.size(); i++)
+    MElementBB(_elems[i], &boxes[6 * i], &boxes[6 * i + 3]);
+  _bvh.build(boxes);
+  _index.resize(_elems.size());
+  for(std::size_t i = 0; i < _elems.size(); i++)
+    _index[i] = std::make_pair(_elems[i], (int)i);
+  std::sort(_index.begin(), _index.end());
+}
+
 MElementOctree::MElementOctree(GModel *m) : _gm(m)
 {
-  SBoundingBox3d bb = m->bounds();
-  // make bounding box larger up to (absolute) geometrical tolerance
-  double eps = CTX::instance()->geom.tolerance;
-  SPoint3 bbmin = bb.min(), bbmax = bb.max(), bbeps(eps, eps, eps);
-  bbmin -= bbeps;
-  bbmax += bbeps;
-  double min[3] = {bbmin.x(), bbmin.y(), bbmin.z()};
-  double size[3] = {bbmax.x() - bbmin.x(), bbmax.y() - bbmin.y(),
-                    bbmax.z() - bbmin.z()};
-  const int maxElePerBucket = 100; // memory vs. speed trade-off
-  _octree = Octree_Create(maxElePerBucket, min, size, MElementBB,
-                          MElementCentroid, MElementInEle);
   std::vector<GEntity *> entities;
   m->getEntities(entities);
   // do not add Gvertex non-associated to any GEdge
@@ -109,44 +128,27 @@ MElementOctree::MElementOctree(GModel *m) : _gm(m)
       if(entities[i]->dim() == 0) {
         GVertex *gv = dynamic_cast<GVertex *>(entities[i]);
         if(gv && gv->edges().size() > 0) {
-          Octree_Insert(entities[i]->getMeshElement(j), _octree);
+          _elems.push_back(entities[i]->getMeshElement(j));
         }
       }
       else
-        Octree_Insert(entities[i]->getMeshElement(j), _octree);
+        _elems.push_back(entities[i]->getMeshElement(j));
     }
   }
-  // exit(1);
-  Octree_Arrange(_octree);
+  _build();
 }
 
 MElementOctree::MElementOctree(const std::vector<MElement *> &v)
   : _gm(0), _elems(v)
 {
-  SBoundingBox3d bb;
-  for(std::size_t i = 0; i < v.size(); i++) {
-    for(std::size_t j = 0; j < v[i]->getNumVertices(); j++) {
-      // if (!_gm) _gm = v[i]->getVertex(j)->onWhat()->model();
-      bb += SPoint3(v[i]->getVertex(j)->x(), v[i]->getVertex(j)->y(),
-                    v[i]->getVertex(j)->z());
-    }
-  }
-  // make bounding box larger up to (absolute) geometrical tolerance
-  double eps = CTX::instance()->geom.tolerance;
-  SPoint3 bbmin = bb.min(), bbmax = bb.max(), bbeps(eps, eps, eps);
-  bbmin -= bbeps;
-  bbmax += bbeps;
-  double min[3] = {bbmin.x(), bbmin.y(), bbmin.z()};
-  double size[3] = {bbmax.x() - bbmin.x(), bbmax.y() - bbmin.y(),
-                    bbmax.z() - bbmin.z()};
-  const int maxElePerBucket = 100; // memory vs. speed trade-off
-  _octree = Octree_Create(maxElePerBucket, min, size, MElementBB,
-                          MElementCentroid, MElementInEle);
-  for(unsigned int i = 0; i < v.size(); i++) Octree_Insert(v[i], _octree);
-  Octree_Arrange(_octree);
+  _build();
 }
 
-MElementOctree::~MElementOctree() { Octree_Delete(_octree); }
+int MElementOctree::_find(double *P, int dim, int hint) const
+{
+  MElementInside f(_elems, P, dim);
+  return _bvh.find(P, f, 0., hint);
+}
 
 std::vector<MElement *> MElementOctree::findAll(double x, double y, double z,
                                                 int dim, bool strict)
@@ -155,13 +157,9 @@ std::vector<MElement *> MElementOctree::findAll(double x, double y, double z,
   double tolIncr = 10.;
 
   double P[3] = {x, y, z};
-  std::vector<void *> v;
-  std::vector<MElement *> e;
-  Octree_SearchAll(P, _octree, &v);
-  for(std::vector<void *>::iterator it = v.begin(); it != v.end(); ++it) {
-    MElement *el = (MElement *)*it;
-    if(dim == -1 || el->getDim() == dim) e.push_back(el);
-  }
+  MElementCollect f(_elems, P, dim);
+  _bvh.find(P, f);
+  std::vector<MElement *> e(f.found);
   if(e.empty() && !strict && _gm) {
     double initialTol = MElement::getTolerance();
     double tol = initialTol;
@@ -213,22 +211,25 @@ std::vector<MElement *> MElementOctree::findAll(double x, double y, double z,
 }
 
 MElement *MElementOctree::find(double x, double y, double z, int dim,
-                               bool strict) const
+                               bool strict, MElement *hint) const
 {
   double P[3] = {x, y, z};
-  MElement *e = (MElement *)Octree_Search(P, _octree);
-  if(e && (dim == -1 || e->getDim() == dim)) return e;
-  std::vector<void *> l;
-  if(e && e->getDim() != dim) {
-    Octree_SearchAll(P, _octree, &l);
-    for(std::vector<void *>::iterator it = l.begin(); it != l.end(); it++) {
-      MElement *el = (MElement *)*it;
-      if(el->getDim() == dim) {
-        return el;
-      }
-    }
+  int h = -1;
+  if(hint) {
+    std::vector<std::pair<MElement *, int> >::const_iterator it =
+      std::lower_bound(_index.begin(), _index.end(), std::make_pair(hint, 0));
+    if(it != _index.end() && it->first == hint) h = it->second;
   }
-  if(!strict && _gm) {
+  int i = _find(P, dim, h);
+  if(i >= 0) return _elems[i];
+  if(strict) return NULL;
+  return _findWithTolerance(P, dim);
+}
+
+MElement *MElementOctree::_findWithTolerance(double *P, int dim) const
+{
+  MElement *e;
+  if(_gm) {
     double initialTol = MElement::getTolerance();
     double tol = initialTol;
     while(tol < 1.) {
@@ -251,7 +252,7 @@ MElement *MElementOctree::find(double x, double y, double z, int dim,
     MElement::setTolerance(initialTol);
     // Msg::Warning("Point %g %g %g not found",x,y,z);
   }
-  else if(!strict && !_gm) {
+  else {
     double initialTol = MElement::getTolerance();
     double tol = initialTol;
     while(tol < 0.1) {
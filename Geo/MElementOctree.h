@@ -7,24 +7,36 @@
 #define _MELEMENT_OCTREE_
 
 #include <vector>
+#include "BVH.h"
 
-class Octree;
 class GModel;
 class MElement;
 
+// Point location in mesh elements, using a bounding volume hierarchy over the
+// bounding boxes of the elements. The strict queries do not modify the
+// structure and can be run concurrently; the non-strict ones temporarily
+// change the global tolerance of MElement::isInside when no element is found.
 class MElementOctree {
 private:
-  Octree *_octree;
+  BVH _bvh;
   GModel *_gm;
   std::vector<MElement *> _elems;
+  // (element, index in _elems) pairs sorted by element, to use elements as
+  // hints
+  std::vector<std::pair<MElement *, int> > _index;
+  void _build();
+  int _find(double *P, int dim, int hint) const;
+  MElement *_findWithTolerance(double *P, int dim) const;
 
 public:
   MElementOctree(GModel *);
   MElementOctree(const std::vector<MElement *> &);
-  ~MElementOctree();
+  ~MElementOctree() {}
+  // find an element containing the point (x, y, z); if hint is given (e.g. the
+  // element found for a previous, nearby point), the hint and its neighbors in
+  // the hierarchy are tried first
   MElement *find(double x, double y, double z, int dim = -1,
-                 bool strict = false) const;
-  Octree *getInternalOctree() { return _octree; }
+                 bool strict = false, MElement *hint = 0) const;
   std::vector<MElement *> findAll(double x, double y, double z, int dim,
                                   bool strict = false);
 };
@@ -97,7 +97,8 @@ bool MHexahedron::getFaceInfo(const MFace &face, int &ithFace, int &sign,
   for(ithFace = 0; ithFace < 6; ithFace++) {
     if(_getFaceInfo(getFace(ithFace), face, sign, rot)) return true;
   }
-  Msg::Error("Could not get face information for hexahedron %d", getNum());
+  Msg::Error("Could not get face information for hexahedron %lu",
+             (unsigned long)getNum());
   return false;
 }
 
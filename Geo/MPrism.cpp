@@ -81,7 +81,8 @@ bool MPrism::getFaceInfo(const MFace &face, int &ithFace, int &sign,
   for(ithFace = 0; ithFace < 5; ithFace++) {
     if(_getFaceInfo(getFace(ithFace), face, sign, rot)) return true;
   }
-  Msg::Error("Could not get face information for prism %d", getNum());
+  Msg::Error("Could not get face information for prism %lu",
+             (unsigned long)getNum());
   return false;
 }
 
@@ -45,7 +45,8 @@ bool MPyramid::getFaceInfo(const MFace &face, int &ithFace, int &sign,
   for(ithFace = 0; ithFace < 5; ++ithFace) {
     if(_getFaceInfo(getFace(ithFace), face, sign, rot)) return true;
   }
-  Msg::Error("Could not get face information for pyramid %d", getNum());
+  Msg::Error("Could not get face information for pyramid %lu",
+             (unsigned long)getNum());
   return false;
 }
 
@@ -151,7 +151,8 @@ bool MQuadrangle::getFaceInfo(const MFace &face, int &ithFace, int &sign,
   ithFace = 0;
   if(_getFaceInfo(MFace(_v[0], _v[1], _v[2], _v[3]), face, sign, rot))
     return true;
-  Msg::Error("Could not get face information for quadrangle %d", getNum());
+  Msg::Error("Could not get face information for quadrangle %lu",
+             (unsigned long)getNum());
   return false;
 }
 
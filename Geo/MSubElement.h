@@ -45,13 +45,13 @@ protected:
 
 public:
   MSubTetrahedron(MVertex *v0, MVertex *v1, MVertex *v2, MVertex *v3,
-                  int num = 0, int part = 0, bool owner = false,
+                  std::size_t num = 0, int part = 0, bool owner = false,
                   MElement *orig = NULL)
     : MTetrahedron(v0, v1, v2, v3, num, part), _owner(owner), _orig(orig),
       _base(0), _pOrder(-1), _npts(0), _pts(0)
   {
   }
-  MSubTetrahedron(const std::vector<MVertex *> &v, int num = 0, int part = 0,
+  MSubTetrahedron(const std::vector<MVertex *> &v, std::size_t num = 0, int part = 0,
                   bool owner = false, MElement *orig = NULL)
     : MTetrahedron(v, num, part), _owner(owner), _orig(orig), _base(0),
       _pOrder(-1), _npts(0), _pts(0)
@@ -153,13 +153,13 @@ protected:
   virtual void updateParent(
     GModel *gm); // NEVER ever use this ! (except for reading msh files !)
 public:
-  MSubTriangle(MVertex *v0, MVertex *v1, MVertex *v2, int num = 0, int part = 0,
+  MSubTriangle(MVertex *v0, MVertex *v1, MVertex *v2, std::size_t num = 0, int part = 0,
                bool owner = false, MElement *orig = NULL)
     : MTriangle(v0, v1, v2, num, part), _owner(owner), _orig(orig), _base(0),
       _pOrder(-1), _npts(0), _pts(0)
   {
   }
-  MSubTriangle(const std::vector<MVertex *> &v, int num = 0, int part = 0,
+  MSubTriangle(const std::vector<MVertex *> &v, std::size_t num = 0, int part = 0,
                bool owner = false, MElement *orig = NULL)
     : MTriangle(v, num, part), _owner(owner), _orig(orig), _base(0),
       _pOrder(-1), _npts(0), _pts(0)
@@ -260,13 +260,13 @@ protected:
   virtual void updateParent(
     GModel *gm); // NEVER ever use this ! (except for reading msh files !)
 public:
-  MSubLine(MVertex *v0, MVertex *v1, int num = 0, int part = 0,
+  MSubLine(MVertex *v0, MVertex *v1, std::size_t num = 0, int part = 0,
            bool owner = false, MElement *orig = NULL)
     : MLine(v0, v1, num, part), _owner(owner), _orig(orig), _base(0),
       _pOrder(-1), _npts(0), _pts(0)
   {
   }
-  MSubLine(const std::vector<MVertex *> &v, int num = 0, int part = 0,
+  MSubLine(const std::vector<MVertex *> &v, std::size_t num = 0, int part = 0,
            bool owner = false, MElement *orig = NULL)
     : MLine(v, num, part), _owner(owner), _orig(orig), _base(0), _pOrder(-1),
       _npts(0), _pts(0)
@@ -367,13 +367,13 @@ protected:
   virtual void updateParent(
     GModel *gm); // NEVER ever use this ! (except for reading msh files !)
 public:
-  MSubPoint(MVertex *v0, int num = 0, int part = 0, bool owner = false,
+  MSubPoint(MVertex *v0, std::size_t num = 0, int part = 0, bool owner = false,
             MElement *orig = NULL)
     : MPoint(v0, num, part), _owner(owner), _orig(orig), _base(0), _pOrder(-1),
       _npts(0), _pts(0)
   {
   }
-  MSubPoint(const std::vector<MVertex *> &v, int num = 0, int part = 0,
+  MSubPoint(const std::vector<MVertex *> &v, std::size_t num = 0, int part = 0,
             bool owner = false, MElement *orig = NULL)
     : MPoint(v, num, part), _owner(owner), _orig(orig), _base(0), _pOrder(-1),
       _npts(0), _pts(0)
@@ -341,7 +341,8 @@ bool MTetrahedron::getFaceInfo(const MFace &face, int &ithFace, int &sign,
   for(ithFace = 0; ithFace < 4; ithFace++) {
     if(_getFaceInfo(getFace(ithFace), face, sign, rot)) return true;
   }
-  Msg::Error("Could not get face information for tetrahedron %d", getNum());
+  Msg::Error("Could not get face information for tetrahedron %lu",
+             (unsigned long)getNum());
   return false;
 }
 
@@ -252,7 +252,8 @@ bool MTriangle::getFaceInfo(const MFace &face, int &ithFace, int &sign,
 {
   ithFace = 0;
   if(_getFaceInfo(MFace(_v[0], _v[1], _v[2]), face, sign, rot)) return true;
-  Msg::Error("Could not get face information for triangle %d", getNum());
+  Msg::Error("Could not get face information for triangle %lu",
+             (unsigned long)getNum());
   return false;
 }
 
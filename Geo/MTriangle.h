@@ -39,14 +39,14 @@ protected:
   }
 
 public:
-  MTriangle(MVertex *v0, MVertex *v1, MVertex *v2, int num = 0, int part = 0)
+  MTriangle(MVertex *v0, MVertex *v1, MVertex *v2, std::size_t num = 0, int part = 0)
     : MElement(num, part)
   {
     _v[0] = v0;
     _v[1] = v1;
     _v[2] = v2;
   }
-  MTriangle(const std::vector<MVertex *> &v, int num = 0, int part = 0)
+  MTriangle(const std::vector<MVertex *> &v, std::size_t num = 0, int part = 0)
     : MElement(num, part)
   {
     for(int i = 0; i < 3; i++) _v[i] = v[i];
@@ -187,7 +187,7 @@ protected:
 
 public:
   MTriangle6(MVertex *v0, MVertex *v1, MVertex *v2, MVertex *v3, MVertex *v4,
-             MVertex *v5, int num = 0, int part = 0)
+             MVertex *v5, std::size_t num = 0, int part = 0)
     : MTriangle(v0, v1, v2, num, part)
   {
     _vs[0] = v3;
@@ -195,7 +195,7 @@ public:
     _vs[2] = v5;
     for(int i = 0; i < 3; i++) _vs[i]->setPolynomialOrder(2);
   }
-  MTriangle6(const std::vector<MVertex *> &v, int num = 0, int part = 0)
+  MTriangle6(const std::vector<MVertex *> &v, std::size_t num = 0, int part = 0)
     : MTriangle(v, num, part)
   {
     for(int i = 0; i < 3; i++) _vs[i] = v[3 + i];
@@ -315,14 +315,14 @@ protected:
 
 public:
   MTriangleN(MVertex *v0, MVertex *v1, MVertex *v2,
-             const std::vector<MVertex *> &v, char order, int num = 0,
+             const std::vector<MVertex *> &v, char order, std::size_t num = 0,
              int part = 0)
     : MTriangle(v0, v1, v2, num, part), _vs(v), _order(order)
   {
     for(unsigned int i = 0; i < _vs.size(); i++)
       _vs[i]->setPolynomialOrder(_order);
   }
-  MTriangleN(const std::vector<MVertex *> &v, char order, int num = 0,
+  MTriangleN(const std::vector<MVertex *> &v, char order, std::size_t num = 0,
              int part = 0)
     : MTriangle(v[0], v[1], v[2], num, part), _order(order)
   {
@@ -445,10 +445,12 @@ template <class T> void sort3(T t[3])
 struct compareMTriangleLexicographic {
   bool operator()(MTriangle *t1, MTriangle *t2) const
   {
-    int _v1[3] = {t1->getVertex(0)->getNum(), t1->getVertex(1)->getNum(),
-                  t1->getVertex(2)->getNum()};
-    int _v2[3] = {t2->getVertex(0)->getNum(), t2->getVertex(1)->getNum(),
-                  t2->getVertex(2)->getNum()};
+    std::size_t _v1[3] = {t1->getVertex(0)->getNum(),
+                          t1->getVertex(1)->getNum(),
+                          t1->getVertex(2)->getNum()};
+    std::size_t _v2[3] = {t2->getVertex(0)->getNum(),
+                          t2->getVertex(1)->getNum(),
+                          t2->getVertex(2)->getNum()};
     sort3(_v1);
     sort3(_v2);
     if(_v1[0] < _v2[0]) return true;
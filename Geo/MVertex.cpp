@@ -23,9 +23,24 @@ double angle3Vertices(const MVertex *p1, const MVertex *p2, const MVertex *p3)
   return std::atan2(sinA, cosA);
 }
 
-MVertex::MVertex(double x, double y, double z, GEntity *ge, int num)
+static bool updateMaxVertexNumber = true;
+#if defined(_OPENMP)
+#pragma omp threadprivate(updateMaxVertexNumber)
+#endif
+
+void MVertex::setUpdateMaxNumber(bool update)
+{
+  updateMaxVertexNumber = update;
+}
+
+MVertex::MVertex(double x, double y, double z, GEntity *ge, std::size_t num)
   : _visible(1), _order(1), _x(x), _y(y), _z(z), _ge(ge)
 {
+  if(num && !updateMaxVertexNumber) {
+    _num = num;
+    _index = num;
+    return;
+  }
 #if defined(_OPENMP)
 #pragma omp critical
 #endif
@@ -57,7 +72,7 @@ void MVertex::deleteLast()
   }
 }
 
-void MVertex::forceNum(int num)
+void MVertex::forceNum(std::size_t num)
 {
 #if defined(_OPENMP)
 #pragma omp critical
@@ -196,50 +211,41 @@ void MVertex::writeMSH2(FILE *fp, bool binary, bool saveParametric,
   }
 }
 
-void MVertex::writeMSH4(FILE *fp, bool binary, bool saveParametric,
+void MVertex::writeMSH4(std::string &buf, bool binary, bool saveParametric,
                         double scalingFactor)
 {
-  if(binary) {
-    fwrite(&_num, sizeof(int), 1, fp);
-    double xScale = _x * scalingFactor;
-    double yScale = _y * scalingFactor;
-    double zScale = _z * scalingFactor;
-    fwrite(&xScale, sizeof(double), 1, fp);
-    fwrite(&yScale, sizeof(double), 1, fp);
-    fwrite(&zScale, sizeof(double), 1, fp);
-    if(saveParametric) {
-      if(_ge->dim() == 1) {
-        double u;
-        getParameter(0, u);
-        fwrite(&u, sizeof(double), 1, fp);
-      }
-      else if(_ge->dim() == 2) {
-        double u, v;
-        getParameter(0, u);
-        getParameter(1, v);
-        fwrite(&u, sizeof(double), 1, fp);
-        fwrite(&v, sizeof(double), 1, fp);
-      }
+  double u = 0., v = 0.;
+  int numParams = 0;
+  if(saveParametric) {
+    if(_ge->dim() == 1) {
+      getParameter(0, u);
+      numParams = 1;
     }
-  }
-  else {
-    fprintf(fp, "%d %.16g %.16g %.16g", _num, _x * scalingFactor,
-            _y * scalingFactor, _z * scalingFactor);
-    if(saveParametric) {
-      if(_ge->dim() == 1) {
-        double u;
-        getParameter(0, u);
-        fprintf(fp, " %.16g", u);
-      }
-      else if(_ge->dim() == 2) {
-        double u, v;
-        getParameter(0, u);
-        getParameter(1, v);
-        fprintf(fp, " %.16g %.16g", u, v);
-      }
+    else if(_ge->dim() == 2) {
+      getParameter(0, u);
+      getParameter(1, v);
+      numParams = 2;
     }
+  }
 
-    fprintf(fp, "\n");
+  if(binary) {
+    double data[5] = {_x * scalingFactor, _y * scalingFactor,
+                      _z * scalingFactor, u, v};
+    // binary MSH 4.0 files store tags as 32-bit integers
+    int num = (int)_num;
+    buf.append((const char *)&num, sizeof(int));
+    buf.append((const char *)data, (3 + numParams) * sizeof(double));
+  }
+  else {
+    char str[256];
+    int n = sprintf(str, "%lu %.16g %.16g %.16g", _num, _x * scalingFactor,
+                    _y * scalingFactor, _z * scalingFactor);
+    if(numParams == 1)
+      n += sprintf(str + n, " %.16g", u);
+    else if(numParams == 2)
+      n += sprintf(str + n, " %.16g %.16g", u, v);
+    str[n++] = '\n';
+    buf.append(str, n);
   }
 }
 
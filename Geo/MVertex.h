@@ -7,13 +7,16 @@
 #define _MVERTEX_H_
 
 #include <cmath>
+#include <cstddef>
 #include <stdio.h>
 #include <set>
 #include <map>
 #include <fstream>
+#include <string>
 #include "SPoint2.h"
 #include "SPoint3.h"
 #include "MVertexBoundaryLayerData.h"
+#include "MallocUtils.h"
 
 class GEntity;
 class GEdge;
@@ -25,8 +28,10 @@ class MVertex {
 protected:
   // the immutable id number of the vertex (this number is unique and is
   // guaranteed never to change once a vertex has been created, unless the mesh
-  // is explicitely renumbered)
-  int _num;
+  // is explicitely renumbered); tags are 64-bit, which on 64-bit platforms
+  // comes at no memory cost since the field fills the padding before the
+  // (32-bit) index and flags
+  std::size_t _num;
   // a vertex index, used for example during mesh generation or when saving a
   // mesh (this index is not necessarily unique, can change after mesh
   // renumbering, etc.). By convention, vertices with negative indices are not
@@ -40,10 +45,23 @@ protected:
   GEntity *_ge;
 
 public:
-  MVertex(double x, double y, double z, GEntity *ge = 0, int num = 0);
+  MVertex(double x, double y, double z, GEntity *ge = 0, std::size_t num = 0);
   virtual ~MVertex() {}
+
+  // allocate from the small object pool (the destructor being virtual, the
+  // size passed to operator delete is the one of the actual derived class)
+  static void *operator new(std::size_t size) { return PoolMalloc(size); }
+  static void operator delete(void *ptr, std::size_t size)
+  {
+    PoolFree(ptr, size);
+  }
   void deleteLast();
 
+  // when disabled, vertices created by the calling thread with a given number
+  // do not update the maximum vertex number of the model (which is done in a
+  // critical section): the caller must then update it after their creation
+  static void setUpdateMaxNumber(bool update);
+
   // get/set the visibility flag
   virtual char getVisibility() { return _visible; }
   virtual void setVisibility(char val) { _visible = val; }
@@ -73,11 +91,11 @@ public:
   void setEntity(GEntity *ge) { _ge = ge; }
 
   // get the immutab vertex number
-  int getNum() const { return _num; }
+  std::size_t getNum() const { return _num; }
 
   // force the immutable number (this should never be used, except when
   // explicitly renumbering the mesh)
-  void forceNum(int num);
+  void forceNum(std::size_t num);
 
   // get/set the index
   int getIndex() const { return _index; }
@@ -105,8 +123,8 @@ public:
                 double scalingFactor = 1.0);
   void writeMSH2(FILE *fp, bool binary = false, bool saveParametric = false,
                  double scalingFactor = 1.0);
-  void writeMSH4(FILE *fp, bool binary = false, bool saveParametric = false,
-                 double scalingFactor = 1.0);
+  void writeMSH4(std::string &buf, bool binary = false,
+                 bool saveParametric = false, double scalingFactor = 1.0);
   void writePLY2(FILE *fp);
   void writeVRML(FILE *fp, double scalingFactor = 1.0);
   void writeUNV(FILE *fp, double scalingFactor = 1.0);
@@ -130,8 +148,8 @@ protected:
 public:
   MVertexBoundaryLayerData *bl_data;
 
-  MEdgeVertex(double x, double y, double z, GEntity *ge, double u, int num = 0,
-              double lc = -1.0)
+  MEdgeVertex(double x, double y, double z, GEntity *ge, double u,
+              std::size_t num = 0, double lc = -1.0)
     : MVertex(x, y, z, ge, num), _u(u), _lc(lc), bl_data(0)
   {
   }
@@ -160,7 +178,7 @@ public:
   MVertexBoundaryLayerData *bl_data;
 
   MFaceVertex(double x, double y, double z, GEntity *ge, double u, double v,
-              int num = 0)
+              std::size_t num = 0)
     : MVertex(x, y, z, ge, num), _u(u), _v(v), bl_data(0)
   {
   }
@@ -51,10 +51,11 @@ public:
         duplicates->insert(v);
       }
       if(warnIfExists) {
-        Msg::Warning("Vertex %d (%.16g, %.16g, %.16g) already exists in the "
-                     "mesh with tolerance %g: Vertex %d (%.16g, %.16g, %.16g)",
-                     v->getNum(), v->x(), v->y(), v->z(), _tol, out->getNum(),
-                     out->x(), out->y(), out->z());
+        Msg::Warning("Vertex %lu (%.16g, %.16g, %.16g) already exists in the "
+                     "mesh with tolerance %g: Vertex %lu (%.16g, %.16g, %.16g)",
+                     (unsigned long)v->getNum(), v->x(), v->y(), v->z(), _tol,
+                     (unsigned long)out->getNum(), out->x(), out->y(),
+                     out->z());
       }
       return out;
     }
@@ -0,0 +1,102 @@
+// Gmsh - Copyright (C) 1997-2018 C. Geuzaine, J.-F. Remacle
+//
+// See the LICENSE.txt file for license information. Please report all
+// issues on https://gitlab.onelab.info/gmsh/gmsh/issues
+
+#ifndef _TAG_CACHE_H_
+#define _TAG_CACHE_H_
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+// A flat (tag, pointer) lookup table for sparse numberings: entries are stored
+// contiguously (16 bytes per entry on 64-bit platforms) and sorted by tag once
+// all of them have been inserted, so that lookups are binary searches in a
+// single array instead of traversals of a tree with one node per entry. Once
+// sorted, the table can be read concurrently by several threads.
+template <class T> class TagCache {
+public:
+  typedef std::pair<std::size_t, T *> entry;
+  typedef typename std::vector<entry>::iterator iterator;
+  typedef typename std::vector<entry>::const_iterator const_iterator;
+
+private:
+  std::vector<entry> _entries;
+  bool _sorted;
+  struct compareTag {
+    bool operator()(const entry &a, const entry &b) const
+    {
+      return a.first < b.first;
+    }
+    bool operator()(const entry &a, std::size_t tag) const
+    {
+      return a.first < tag;
+    }
+  };
+
+public:
+  TagCache() : _sorted(true) {}
+  void clear()
+  {
+    std::vector<entry>().swap(_entries);
+    _sorted = true;
+  }
+  bool empty() const { return _entries.empty(); }
+  std::size_t size() const { return _entries.size(); }
+  void reserve(std::size_t n) { _entries.reserve(n); }
+  bool sorted() const { return _sorted; }
+  void swap(TagCache<T> &other)
+  {
+    _entries.swap(other._entries);
+    std::swap(_sorted, other._sorted);
+  }
+  // append an entry; the table needs to be sorted before the next lookup
+  void insert(std::size_t tag, T *ptr)
+  {
+    if(_sorted && !_entries.empty() && tag <= _entries.back().first)
+      _sorted = false;
+    _entries.push_back(entry(tag, ptr));
+  }
+  // sort the entries by tag, keeping only the last entry inserted for each
+  // tag (or the first one if keepFirst is set); return the number of
+  // discarded duplicates, and append their pointers to discarded if given
+  std::size_t sort(std::vector<T *> *discarded = 0, bool keepFirst = false)
+  {
+    if(_sorted) return 0;
+    std::stable_sort(_entries.begin(), _entries.end(), compareTag());
+    std::size_t n = 0;
+    for(std::size_t i = 0; i < _entries.size(); i++) {
+      if(n && _entries[n - 1].first == _entries[i].first) {
+        // duplicates are in insertion order after the stable sort
+        if(keepFirst) {
+          if(discarded) discarded->push_back(_entries[i].second);
+          continue;
+        }
+        if(discarded) discarded->push_back(_entries[n - 1].second);
+        n--;
+      }
+      _entries[n++] = _entries[i];
+    }
+    std::size_t numDuplicates = _entries.size() - n;
+    _entries.resize(n);
+    _sorted = true;
+    return numDuplicates;
+  }
+  // find the entry with the given tag (the table must be sorted)
+  T *find(std::size_t tag) const
+  {
+    const_iterator it =
+      std::lower_bound(_entries.begin(), _entries.end(), tag, compareTag());
+    if(it == _entries.end() || it->first != tag) return 0;
+    return it->second;
+  }
+  std::size_t minTag() const { return _entries.front().first; }
+  std::size_t maxTag() const { return _entries.back().first; }
+  iterator begin() { return _entries.begin(); }
+  iterator end() { return _entries.end(); }
+  const_iterator begin() const { return _entries.begin(); }
+  const_iterator end() const { return _entries.end(); }
+};
+
+#endif
@@ -597,7 +597,8 @@ bool buildAdditionalPoints2D(GFace *gf)
         const BoundaryLayerData &data = _columns->getColumn(v,i);
         for(unsigned int j = 0; j < data._column.size(); j++){
           MVertex *blv = data._column[j];
-          fprintf(f,"SP(%g,%g,%g){%d};\n",blv->x(),blv->y(),blv->z(),v->getNum());
+          fprintf(f,"SP(%g,%g,%g){%lu};\n",blv->x(),blv->y(),blv->z(),
+                  (unsigned long)v->getNum());
         }
       }
     }
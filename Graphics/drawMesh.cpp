@@ -63,7 +63,7 @@ static void drawElementLabels(drawContext *ctx, GEntity *e,
       else if(CTX::instance()->mesh.labelType == 1)
         sprintf(str, "%d", e->tag());
       else
-        sprintf(str, "%d", ele->getNum());
+        sprintf(str, "%lu", (unsigned long)ele->getNum());
       ctx->drawString(str, pc.x(), pc.y(), pc.z());
     }
   }
@@ -122,7 +122,7 @@ static void drawVertexLabel(drawContext *ctx, GEntity *e, MVertex *v,
   else if(CTX::instance()->mesh.labelType == 1)
     sprintf(str, "%d", e->tag());
   else
-    sprintf(str, "%d", v->getNum());
+    sprintf(str, "%lu", (unsigned long)v->getNum());
 
   if(CTX::instance()->mesh.colorCarousel == 0 ||
      CTX::instance()->mesh.volumesFaces ||
@@ -226,7 +226,8 @@ BGMBase::get_nodal_value(const MVertex *v, const VectorStorageType &data) const
 {
   VectorStorageType::const_iterator itfind = data.find(v);
   if(itfind == data.end()) {
-    Msg::Error("Unknown vertex %d in BGMBase::get_nodal_value", v->getNum());
+    Msg::Error("Unknown vertex %lu in BGMBase::get_nodal_value",
+               (unsigned long)v->getNum());
     return std::vector<double>(3, 0.);
   }
   return itfind->second;
@@ -237,7 +238,8 @@ double BGMBase::get_nodal_value(const MVertex *v,
 {
   DoubleStorageType::const_iterator itfind = data.find(v);
   if(itfind == data.end()) {
-    Msg::Error("Unknown vertex %d in BGMBase::get_nodal_value", v->getNum());
+    Msg::Error("Unknown vertex %lu in BGMBase::get_nodal_value",
+               (unsigned long)v->getNum());
     return 0.;
   }
   return itfind->second;
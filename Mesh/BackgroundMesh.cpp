@@ -33,6 +33,13 @@
 static int _NBANN = 2;
 #endif
 
+static backgroundMesh *_current = 0;
+#if defined(_OPENMP)
+#pragma omp threadprivate(_current)
+#endif
+
+backgroundMesh *backgroundMesh::current() { return _current; }
+
 void backgroundMesh::set(GFace *gf)
 {
   if(_current) delete _current;
@@ -492,6 +499,9 @@ void backgroundMesh::propagateCrossField(GFace *_gf,
 
 void backgroundMesh::updateSizes(GFace *_gf)
 {
+  // the sizes at the nodes inside the surface are computed all at once
+  std::vector<std::map<MVertex *, double>::iterator> inside;
+  std::vector<double> uv, xyz;
   std::map<MVertex *, double>::iterator itv = _sizes.begin();
   for(; itv != _sizes.end(); ++itv) {
     SPoint2 p;
@@ -507,13 +517,29 @@ void backgroundMesh::updateSizes(GFace *_gf)
     }
     else {
       reparamMeshVertexOnFace(v, _gf, p);
-      lc = BGM_MeshSize(_gf, p.x(), p.y(), v->x(), v->y(), v->z());
+      inside.push_back(itv);
+      uv.push_back(p.x());
+      uv.push_back(p.y());
+      xyz.push_back(v->x());
+      xyz.push_back(v->y());
+      xyz.push_back(v->z());
+      continue;
     }
     // printf("2D -- %g %g 3D -- %g %g\n",p.x(),p.y(),v->x(),v->y());
     itv->second = std::min(lc, itv->second);
     itv->second = std::max(itv->second, CTX::instance()->mesh.lcMin);
     itv->second = std::min(itv->second, CTX::instance()->mesh.lcMax);
   }
+  if(inside.size()) {
+    std::vector<double> lc(inside.size());
+    BGM_MeshSize(_gf, inside.size(), &uv[0], &xyz[0], &lc[0]);
+    for(std::size_t i = 0; i < inside.size(); i++) {
+      itv = inside[i];
+      itv->second = std::min(lc[i], itv->second);
+      itv->second = std::max(itv->second, CTX::instance()->mesh.lcMin);
+      itv->second = std::min(itv->second, CTX::instance()->mesh.lcMax);
+    }
+  }
   // do not allow large variations in the size field
   // (Int. J. Numer. Meth. Engng. 43, 1143-1165 (1998) MESH GRADATION
   // CONTROL, BOROUCHAKI, HECHT, FREY)
@@ -715,4 +741,3 @@ MElement *backgroundMesh::getMeshElementByCoord(double u, double v, double w,
   return _octree->find(u, v, w, 2, strict);
 }
 
-backgroundMesh *backgroundMesh::_current = 0;
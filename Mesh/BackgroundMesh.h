@@ -46,7 +46,6 @@ class backgroundMesh : public simpleFunction<double> {
   std::map<MVertex *, MVertex *> _2Dto3D;
   std::map<MVertex *, double> _distance;
   std::map<MVertex *, double> _angles;
-  static backgroundMesh *_current;
   backgroundMesh(GFace *, bool dist = false);
   ~backgroundMesh();
 #if defined(HAVE_ANN)
@@ -62,7 +61,9 @@ public:
   static void set(GFace *);
   static void setCrossFieldsByDistance(GFace *);
   static void unset();
-  static backgroundMesh *current() { return _current; }
+  // the current background mesh is private to each thread, so that several
+  // surfaces can be meshed concurrently
+  static backgroundMesh *current();
   void propagate1dMesh(GFace *);
   void propagateCrossField(GFace *, simpleFunction<double> *);
   void propagateCrossFieldHJ(GFace *);
@@ -333,6 +333,10 @@ inline double myAngle(const SVector3 &a, const SVector3 &b, const SVector3 &d)
 
 void backgroundMesh2D::updateSizes()
 {
+  // the sizes at the nodes inside the surface are computed all at once
+  std::vector<DoubleStorageType::iterator> inside;
+  std::vector<double> uv, xyz;
+  GFace *face = dynamic_cast<GFace *>(gf);
   DoubleStorageType::iterator itv = sizeField.begin();
   for(; itv != sizeField.end(); ++itv) {
     SPoint2 p;
@@ -347,14 +351,18 @@ void backgroundMesh2D::updateSizes()
       lc = sizeFactor * BGM_MeshSize(v->onWhat(), u, 0, v->x(), v->y(), v->z());
     }
     else {
-      GFace *face = dynamic_cast<GFace *>(gf);
       if(!face) {
         Msg::Error("Entity is not a face in background mesh");
         return;
       }
       reparamMeshVertexOnFace(v, face, p);
-      lc =
-        sizeFactor * BGM_MeshSize(face, p.x(), p.y(), v->x(), v->y(), v->z());
+      inside.push_back(itv);
+      uv.push_back(p.x());
+      uv.push_back(p.y());
+      xyz.push_back(v->x());
+      xyz.push_back(v->y());
+      xyz.push_back(v->z());
+      continue;
     }
     // printf("2D -- %g %g 3D -- %g %g\n",p.x(),p.y(),v->x(),v->y());
     itv->second = std::min(lc, itv->second);
@@ -363,6 +371,18 @@ void backgroundMesh2D::updateSizes()
     itv->second =
       std::min(itv->second, sizeFactor * CTX::instance()->mesh.lcMax);
   }
+  if(inside.size()) {
+    std::vector<double> lc(inside.size());
+    BGM_MeshSize(face, inside.size(), &uv[0], &xyz[0], &lc[0]);
+    for(std::size_t i = 0; i < inside.size(); i++) {
+      itv = inside[i];
+      itv->second = std::min(sizeFactor * lc[i], itv->second);
+      itv->second =
+        std::max(itv->second, sizeFactor * CTX::instance()->mesh.lcMin);
+      itv->second =
+        std::min(itv->second, sizeFactor * CTX::instance()->mesh.lcMax);
+    }
+  }
   // do not allow large variations in the size field
   // (Int. J. Numer. Meth. Engng. 43, 1143-1165 (1998) MESH GRADATION
   // CONTROL, BOROUCHAKI, HECHT, FREY)
@@ -3,6 +3,8 @@
 // See the LICENSE.txt file for license information. Please report all
 // issues on https://gitlab.onelab.info/gmsh/gmsh/issues
 
+#include <string.h>
+#include <vector>
 #include "BackgroundMeshTools.h"
 #include "GFace.h"
 #include "GVertex.h"
@@ -11,6 +13,11 @@
 #include "Context.h"
 #include "Field.h"
 #include "GModel.h"
+#include "Hash.h"
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 static double max_surf_curvature(const GEdge *ge, double u)
 {
@@ -205,9 +212,8 @@ SMetric3 buildMetricTangentToSurface(SVector3 &t1, SVector3 &t2, double l_t1,
   return Metric;
 }
 
-// This is the only function that is used by the meshers
-double BGM_MeshSize(GEntity *ge, double U, double V, double X, double Y,
-                    double Z)
+// combine the size l4 given by the background field with the other sizes
+static double combinedMeshSize(GEntity *ge, double U, double V, double l4)
 {
   // default lc (mesh size == size of the model)
   double l1 = CTX::instance()->lc;
@@ -222,14 +228,6 @@ double BGM_MeshSize(GEntity *ge, double U, double V, double X, double Y,
   if(CTX::instance()->mesh.lcFromCurvature && ge->dim() < 3)
     l3 = LC_MVertex_CURV(ge, U, V);
 
-  // lc from fields
-  double l4 = MAX_LC;
-  FieldManager *fields = ge->model()->getFields();
-  if(fields->getBackgroundField() > 0) {
-    Field *f = fields->get(fields->getBackgroundField());
-    if(f) l4 = (*f)(X, Y, Z, ge);
-  }
-
   // global lc from entity
   double l5 = ge->getMeshSize();
 
@@ -247,9 +245,205 @@ double BGM_MeshSize(GEntity *ge, double U, double V, double X, double Y,
   return lc * CTX::instance()->mesh.lcFactor;
 }
 
-// anisotropic version of the background field
-SMetric3 BGM_MeshMetric(GEntity *ge, double U, double V, double X, double Y,
-                        double Z)
+// Direct-mapped cache of the values computed at points (entity, parametric
+// and physical coordinates): a new value overwrites the one stored in its slot,
+// so that the memory used by the cache is fixed. Each thread has its own cache,
+// to avoid any locking.
+template <class T> class sizeCache {
+private:
+  struct entry {
+    GEntity *ge;
+    double key[5];
+    T value;
+  };
+  std::vector<entry> _entries;
+  std::size_t _mask;
+  static std::size_t _hash(GEntity *ge, const double key[5])
+  {
+    return HashFNV1a<sizeof(double[5])>::eval(key) ^
+           HashFNV1a<sizeof(GEntity *)>::eval(&ge);
+  }
+
+public:
+  std::size_t hits, misses;
+  sizeCache() : _mask(0), hits(0), misses(0) {}
+  void clear()
+  {
+    std::vector<entry>().swap(_entries);
+    _mask = 0;
+  }
+  entry *slot(std::size_t size, GEntity *ge, const double key[5])
+  {
+    if(_entries.empty()) {
+      // round the size down to a power of 2
+      std::size_t n = 1;
+      while(2 * n <= size) n *= 2;
+      entry e;
+      e.ge = 0;
+      _entries.resize(n, e);
+      _mask = n - 1;
+    }
+    return &_entries[_hash(ge, key) & _mask];
+  }
+  // return true and set the value if the point is in the cache
+  bool find(std::size_t size, GEntity *ge, const double key[5], T &value)
+  {
+    entry *e = slot(size, ge, key);
+    if(e->ge == ge && !memcmp(e->key, key, sizeof(e->key))) {
+      value = e->value;
+      hits++;
+      return true;
+    }
+    misses++;
+    return false;
+  }
+  void insert(std::size_t size, GEntity *ge, const double key[5],
+              const T &value)
+  {
+    entry *e = slot(size, ge, key);
+    e->ge = ge;
+    memcpy(e->key, key, sizeof(e->key));
+    e->value = value;
+  }
+};
+
+static bool cacheEnabled = false;
+static std::vector<sizeCache<double> > sizeCaches;
+static std::vector<sizeCache<SMetric3> > metricCaches;
+
+void BGM_StartCache()
+{
+  BGM_StopCache();
+  if(CTX::instance()->mesh.lcCache <= 0) return;
+#if defined(_OPENMP)
+  int nthreads = omp_get_max_threads();
+#else
+  int nthreads = 1;
+#endif
+  sizeCaches.assign(nthreads, sizeCache<double>());
+  metricCaches.assign(nthreads, sizeCache<SMetric3>());
+  cacheEnabled = true;
+}
+
+void BGM_StopCache()
+{
+  // the counters are kept until the next call to BGM_StartCache
+  for(std::size_t i = 0; i < sizeCaches.size(); i++) sizeCaches[i].clear();
+  for(std::size_t i = 0; i < metricCaches.size(); i++) metricCaches[i].clear();
+  cacheEnabled = false;
+}
+
+void BGM_ClearCache()
+{
+  for(std::size_t i = 0; i < sizeCaches.size(); i++) sizeCaches[i].clear();
+  for(std::size_t i = 0; i < metricCaches.size(); i++) metricCaches[i].clear();
+}
+
+void BGM_GetCacheStatistics(std::size_t &hits, std::size_t &misses)
+{
+  hits = misses = 0;
+  for(std::size_t i = 0; i < sizeCaches.size(); i++) {
+    hits += sizeCaches[i].hits;
+    misses += sizeCaches[i].misses;
+  }
+  for(std::size_t i = 0; i < metricCaches.size(); i++) {
+    hits += metricCaches[i].hits;
+    misses += metricCaches[i].misses;
+  }
+}
+
+// return the cache of the calling thread, or 0 if the cache is disabled
+template <class T>
+static sizeCache<T> *threadCache(std::vector<sizeCache<T> > &caches)
+{
+  if(!cacheEnabled) return 0;
+#if defined(_OPENMP)
+  // threads of nested parallel regions share their thread numbers
+  if(omp_get_active_level() > 1) return 0;
+  std::size_t i = omp_get_thread_num();
+#else
+  std::size_t i = 0;
+#endif
+  return (i < caches.size()) ? &caches[i] : 0;
+}
+
+static double meshSize(GEntity *ge, double U, double V, double X, double Y,
+                       double Z)
+{
+  // lc from fields
+  double l4 = MAX_LC;
+  FieldManager *fields = ge->model()->getFields();
+  if(fields->getBackgroundField() > 0) {
+    Field *f = fields->get(fields->getBackgroundField());
+    if(f) l4 = (*f)(X, Y, Z, ge);
+  }
+  return combinedMeshSize(ge, U, V, l4);
+}
+
+// This is the only function that is used by the meshers
+double BGM_MeshSize(GEntity *ge, double U, double V, double X, double Y,
+                    double Z)
+{
+  sizeCache<double> *cache = threadCache(sizeCaches);
+  if(!cache) return meshSize(ge, U, V, X, Y, Z);
+  const std::size_t size = CTX::instance()->mesh.lcCache;
+  const double key[5] = {U, V, X, Y, Z};
+  double lc;
+  if(cache->find(size, ge, key, lc)) return lc;
+  lc = meshSize(ge, U, V, X, Y, Z);
+  cache->insert(size, ge, key, lc);
+  return lc;
+}
+
+void BGM_MeshSize(GEntity *ge, std::size_t n, const double *uv,
+                  const double *xyz, double *lc)
+{
+  // points that are not in the cache
+  sizeCache<double> *cache = threadCache(sizeCaches);
+  const std::size_t size = CTX::instance()->mesh.lcCache;
+  std::vector<std::size_t> todo;
+  std::vector<double> uvTodo, xyzTodo, lcTodo;
+  if(cache) {
+    for(std::size_t i = 0; i < n; i++) {
+      const double key[5] = {uv[2 * i], uv[2 * i + 1], xyz[3 * i],
+                             xyz[3 * i + 1], xyz[3 * i + 2]};
+      if(cache->find(size, ge, key, lc[i])) continue;
+      todo.push_back(i);
+      uvTodo.insert(uvTodo.end(), uv + 2 * i, uv + 2 * i + 2);
+      xyzTodo.insert(xyzTodo.end(), xyz + 3 * i, xyz + 3 * i + 3);
+    }
+    if(todo.empty()) return;
+    lcTodo.resize(todo.size());
+    uv = &uvTodo[0];
+    xyz = &xyzTodo[0];
+  }
+  std::size_t m = cache ? todo.size() : n;
+  double *l = cache ? &lcTodo[0] : lc;
+
+  // lc from fields
+  Field *f = 0;
+  FieldManager *fields = ge->model()->getFields();
+  if(fields->getBackgroundField() > 0)
+    f = fields->get(fields->getBackgroundField());
+  if(f)
+    f->evaluate(xyz, m, l, ge);
+  else
+    std::fill(l, l + m, MAX_LC);
+  for(std::size_t i = 0; i < m; i++)
+    l[i] = combinedMeshSize(ge, uv[2 * i], uv[2 * i + 1], l[i]);
+
+  if(cache) {
+    for(std::size_t i = 0; i < m; i++) {
+      const double key[5] = {uv[2 * i], uv[2 * i + 1], xyz[3 * i],
+                             xyz[3 * i + 1], xyz[3 * i + 2]};
+      cache->insert(size, ge, key, l[i]);
+      lc[todo[i]] = l[i];
+    }
+  }
+}
+
+static SMetric3 meshMetric(GEntity *ge, double U, double V, double X,
+                           double Y, double Z)
 {
   // Metrics based on element size
 
@@ -294,6 +488,21 @@ SMetric3 BGM_MeshMetric(GEntity *ge, double U, double V, double X, double Y,
   return m;
 }
 
+// anisotropic version of the background field
+SMetric3 BGM_MeshMetric(GEntity *ge, double U, double V, double X, double Y,
+                        double Z)
+{
+  sizeCache<SMetric3> *cache = threadCache(metricCaches);
+  if(!cache) return meshMetric(ge, U, V, X, Y, Z);
+  const std::size_t size = CTX::instance()->mesh.lcCache;
+  const double key[5] = {U, V, X, Y, Z};
+  SMetric3 m;
+  if(cache->find(size, ge, key, m)) return m;
+  m = meshMetric(ge, U, V, X, Y, Z);
+  cache->insert(size, ge, key, m);
+  return m;
+}
+
 bool Extend1dMeshIn2dSurfaces()
 {
   return CTX::instance()->mesh.lcExtendFromBoundary;
@@ -6,6 +6,7 @@
 #ifndef _BACKGROUND_MESH_TOOLS_H_
 #define _BACKGROUND_MESH_TOOLS_H_
 
+#include <cstddef>
 #include "STensor3.h"
 
 class GFace;
@@ -18,8 +19,23 @@ SMetric3 buildMetricTangentToSurface(SVector3 &t1, SVector3 &t2, double l_t1,
                                      double l_t2, double l_n);
 double BGM_MeshSize(GEntity *ge, double U, double V, double X, double Y,
                     double Z);
+// same as above for n points on the same entity, with 2 parametric coordinates
+// per point in uv and 3 coordinates per point in xyz: the background field is
+// evaluated for all the points at once
+void BGM_MeshSize(GEntity *ge, std::size_t n, const double *uv,
+                  const double *xyz, double *lc);
 SMetric3 BGM_MeshMetric(GEntity *ge, double U, double V, double X, double Y,
                         double Z);
+// cache the values computed by BGM_MeshSize and BGM_MeshMetric (if
+// Mesh.CharacteristicLengthCache > 0) between BGM_StartCache and
+// BGM_StopCache; the cache must be cleared with BGM_ClearCache if the fields
+// are modified in between
+void BGM_StartCache();
+void BGM_StopCache();
+void BGM_ClearCache();
+// number of values found in the cache and computed since the last call to
+// BGM_StartCache
+void BGM_GetCacheStatistics(std::size_t &hits, std::size_t &misses);
 bool Extend1dMeshIn2dSurfaces();
 bool Extend2dMeshIn3dVolumes();
 SMetric3 max_edge_curvature_metric(const GVertex *gv);
@@ -43,9 +43,6 @@
 #include <unistd.h>
 #endif
 
-#if defined(HAVE_ANN)
-#include "ANN/ANN.h"
-#endif
 
 Field::~Field()
 {
@@ -57,6 +54,13 @@ Field::~Field()
     delete it->second;
 }
 
+void Field::evaluate(const double *xyz, std::size_t n, double *values,
+                     GEntity *ge)
+{
+  for(std::size_t i = 0; i < n; i++)
+    values[i] = (*this)(xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2], ge);
+}
+
 FieldOption *Field::getOption(const std::string &optionName)
 {
   std::map<std::string, FieldOption *>::iterator it = options.find(optionName);
@@ -73,6 +77,7 @@ void FieldManager::reset()
     delete it->second;
   }
   clear();
+  BGM_ClearCache();
 }
 
 Field *FieldManager::get(int id)
@@ -96,6 +101,7 @@ Field *FieldManager::newField(int id, const std::string &type_name)
   if(!f) return 0;
   f->id = id;
   (*this)[id] = f;
+  BGM_ClearCache();
   return f;
 }
 
@@ -128,6 +134,7 @@ void FieldManager::deleteField(int id)
   }
   delete it->second;
   erase(it);
+  BGM_ClearCache();
 }
 
 // StructuredField
@@ -421,6 +428,17 @@ public:
              v_in :
              v_out;
   }
+  void evaluate(const double *xyz, std::size_t n, double *values,
+                GEntity *ge = 0)
+  {
+    for(std::size_t i = 0; i < n; i++) {
+      const double x = xyz[3 * i], y = xyz[3 * i + 1], z = xyz[3 * i + 2];
+      values[i] = (x <= x_max && x >= x_min && y <= y_max && y >= y_min &&
+                   z <= z_max && z >= z_min) ?
+                    v_in :
+                    v_out;
+    }
+  }
 };
 
 class CylinderField : public Field {
@@ -481,6 +499,22 @@ public:
     return ((dx * dx + dy * dy + dz * dz < R * R) && fabs(adx) < 1) ? v_in :
                                                                       v_out;
   }
+  void evaluate(const double *xyz, std::size_t n, double *values,
+                GEntity *ge = 0)
+  {
+    const double a2 = xa * xa + ya * ya + za * za;
+    for(std::size_t i = 0; i < n; i++) {
+      double dx = xyz[3 * i] - xc;
+      double dy = xyz[3 * i + 1] - yc;
+      double dz = xyz[3 * i + 2] - zc;
+      double adx = (xa * dx + ya * dy + za * dz) / a2;
+      dx -= adx * xa;
+      dy -= adx * ya;
+      dz -= adx * za;
+      values[i] =
+        ((dx * dx + dy * dy + dz * dz < R * R) && fabs(adx) < 1) ? v_in : v_out;
+    }
+  }
 };
 
 class BallField : public Field {
@@ -523,6 +557,16 @@ public:
 
     return ((dx * dx + dy * dy + dz * dz < R * R)) ? v_in : v_out;
   }
+  void evaluate(const double *xyz, std::size_t n, double *values,
+                GEntity *ge = 0)
+  {
+    for(std::size_t i = 0; i < n; i++) {
+      double dx = xyz[3 * i] - xc;
+      double dy = xyz[3 * i + 1] - yc;
+      double dz = xyz[3 * i + 2] - zc;
+      values[i] = ((dx * dx + dy * dy + dz * dz < R * R)) ? v_in : v_out;
+    }
+  }
 };
 
 class FrustumField : public Field {
@@ -652,12 +696,9 @@ public:
       stopAtDistMax, "True to not impose element size outside DistMax (i.e., "
                      "F = a very big value if Field[IField] > DistMax)");
   }
-  using Field::operator();
-  double operator()(double x, double y, double z, GEntity *ge = 0)
+  double threshold(double d) const
   {
-    Field *field = GModel::current()->getFields()->get(iField);
-    if(!field || iField == id) return MAX_LC;
-    double r = ((*field)(x, y, z) - dmin) / (dmax - dmin);
+    double r = (d - dmin) / (dmax - dmin);
     r = std::max(std::min(r, 1.), 0.);
     double lc;
     if(stopAtDistMax && r >= 1.) {
@@ -672,6 +713,24 @@ public:
     }
     return lc;
   }
+  using Field::operator();
+  double operator()(double x, double y, double z, GEntity *ge = 0)
+  {
+    Field *field = GModel::current()->getFields()->get(iField);
+    if(!field || iField == id) return MAX_LC;
+    return threshold((*field)(x, y, z));
+  }
+  void evaluate(const double *xyz, std::size_t n, double *values,
+                GEntity *ge = 0)
+  {
+    Field *field = GModel::current()->getFields()->get(iField);
+    if(!field || iField == id) {
+      std::fill(values, values + n, MAX_LC);
+      return;
+    }
+    field->evaluate(xyz, n, values);
+    for(std::size_t i = 0; i < n; i++) values[i] = threshold(values[i]);
+  }
 };
 
 class GradientField : public Field {
@@ -944,7 +1003,7 @@ public:
   double evaluate(double x, double y, double z)
   {
     if(!_f) return MAX_LC;
-    std::vector<double> values(3 + _fields.size()), res(1);
+    std::vector<double> values(3 + _fields.size());
     values[0] = x;
     values[1] = y;
     values[2] = z;
@@ -954,11 +1013,41 @@ public:
       Field *field = GModel::current()->getFields()->get(*it);
       values[i++] = field ? (*field)(x, y, z) : MAX_LC;
     }
-    if(_f->eval(values, res))
-      return res[0];
+    double res;
+    if(_f->eval(&values[0], 1, &res))
+      return res;
     else
       return MAX_LC;
   }
+  void evaluate(const double *xyz, std::size_t n, double *out)
+  {
+    if(!_f) {
+      std::fill(out, out + n, MAX_LC);
+      return;
+    }
+    // evaluate the fields appearing in the expression for all the points first
+    std::vector<std::vector<double> > fieldValues(_fields.size());
+    int k = 0;
+    for(std::set<int>::iterator it = _fields.begin(); it != _fields.end();
+        it++, k++) {
+      fieldValues[k].resize(n, MAX_LC);
+      Field *field = GModel::current()->getFields()->get(*it);
+      if(field && n) field->evaluate(xyz, n, &fieldValues[k][0]);
+    }
+    // evaluate the compiled expression on all the points at once
+    const std::size_t nv = 3 + _fields.size();
+    std::vector<double> values(n * nv);
+    for(std::size_t i = 0; i < n; i++) {
+      values[nv * i] = xyz[3 * i];
+      values[nv * i + 1] = xyz[3 * i + 1];
+      values[nv * i + 2] = xyz[3 * i + 2];
+      for(std::size_t j = 0; j < fieldValues.size(); j++)
+        values[nv * i + 3 + j] = fieldValues[j][i];
+    }
+    if(!n || _f->eval(&values[0], n, out)) return;
+    for(std::size_t i = 0; i < n; i++)
+      if(!_f->eval(&values[nv * i], 1, &out[i])) out[i] = MAX_LC;
+  }
 };
 
 class MathEvalExpressionAniso {
@@ -1023,7 +1112,8 @@ public:
       if(!_f[iFunction])
         metr(index[iFunction][0], index[iFunction][1]) = MAX_LC;
       else {
-        std::vector<double> values(3 + _fields[iFunction].size()), res(1);
+        std::vector<double> values(3 + _fields[iFunction].size());
+        double res;
         values[0] = x;
         values[1] = y;
         values[2] = z;
@@ -1033,8 +1123,8 @@ public:
           Field *field = GModel::current()->getFields()->get(*it);
           values[i++] = field ? (*field)(x, y, z) : MAX_LC;
         }
-        if(_f[iFunction]->eval(values, res))
-          metr(index[iFunction][0], index[iFunction][1]) = res[0];
+        if(_f[iFunction]->eval(&values[0], 1, &res))
+          metr(index[iFunction][0], index[iFunction][1]) = res;
         else
           metr(index[iFunction][0], index[iFunction][1]) = MAX_LC;
       }
@@ -1064,6 +1154,17 @@ public:
     }
     return expr.evaluate(x, y, z);
   }
+  void evaluate(const double *xyz, std::size_t n, double *values,
+                GEntity *ge = 0)
+  {
+    if(update_needed) {
+      if(!expr.set_function(f))
+        Msg::Error("Field %i: Invalid matheval expression \"%s\"", this->id,
+                   f.c_str());
+      update_needed = false;
+    }
+    expr.evaluate(xyz, n, values);
+  }
   const char *getName() { return "MathEval"; }
   std::string getDescription()
   {
@@ -1694,6 +1795,30 @@ public:
     }
     return v;
   }
+  void evaluate(const double *xyz, std::size_t n, double *values,
+                GEntity *ge = 0)
+  {
+    std::fill(values, values + n, MAX_LC);
+    std::vector<double> v(n);
+    for(std::list<int>::iterator it = idlist.begin(); it != idlist.end();
+        it++) {
+      Field *f = (GModel::current()->getFields()->get(*it));
+      if(!f || *it == id || !n) continue;
+      if(f->isotropic())
+        f->evaluate(xyz, n, &v[0], ge);
+      else {
+        for(std::size_t i = 0; i < n; i++) {
+          SMetric3 ff;
+          (*f)(xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2], ff, ge);
+          fullMatrix<double> V(3, 3);
+          fullVector<double> S(3);
+          ff.eig(V, S, 1);
+          v[i] = sqrt(1. / S(2)); // S(2) is largest eigenvalue
+        }
+      }
+      for(std::size_t i = 0; i < n; i++) values[i] = std::min(values[i], v[i]);
+    }
+  }
   const char *getName() { return "Min"; }
 };
 
@@ -1732,6 +1857,30 @@ public:
     }
     return v;
   }
+  void evaluate(const double *xyz, std::size_t n, double *values,
+                GEntity *ge = 0)
+  {
+    std::fill(values, values + n, -MAX_LC);
+    std::vector<double> v(n);
+    for(std::list<int>::iterator it = idlist.begin(); it != idlist.end();
+        it++) {
+      Field *f = (GModel::current()->getFields()->get(*it));
+      if(!f || *it == id || !n) continue;
+      if(f->isotropic())
+        f->evaluate(xyz, n, &v[0], ge);
+      else {
+        for(std::size_t i = 0; i < n; i++) {
+          SMetric3 ff;
+          (*f)(xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2], ff, ge);
+          fullMatrix<double> V(3, 3);
+          fullVector<double> S(3);
+          ff.eig(V, S, 1);
+          v[i] = sqrt(1. / S(0)); // S(0) is smallest eigenvalue
+        }
+      }
+      for(std::size_t i = 0; i < n; i++) values[i] = std::max(values[i], v[i]);
+    }
+  }
   const char *getName() { return "Max"; }
 };
 
@@ -1754,27 +1903,101 @@ public:
     return "Restrict the application of a field to a given list of geometrical "
            "points, curves, surfaces or volumes.";
   }
+  bool applies(GEntity *ge) const
+  {
+    if(!ge) return true;
+    return (ge->dim() == 0 && std::find(vertices.begin(), vertices.end(),
+                                        ge->tag()) != vertices.end()) ||
+           (ge->dim() == 1 &&
+            std::find(edges.begin(), edges.end(), ge->tag()) != edges.end()) ||
+           (ge->dim() == 2 &&
+            std::find(faces.begin(), faces.end(), ge->tag()) != faces.end()) ||
+           (ge->dim() == 3 && std::find(regions.begin(), regions.end(),
+                                        ge->tag()) != regions.end());
+  }
   using Field::operator();
   double operator()(double x, double y, double z, GEntity *ge = 0)
   {
     Field *f = (GModel::current()->getFields()->get(iField));
     if(!f || iField == id) return MAX_LC;
-    if(!ge) return (*f)(x, y, z);
-    if((ge->dim() == 0 && std::find(vertices.begin(), vertices.end(),
-                                    ge->tag()) != vertices.end()) ||
-       (ge->dim() == 1 &&
-        std::find(edges.begin(), edges.end(), ge->tag()) != edges.end()) ||
-       (ge->dim() == 2 &&
-        std::find(faces.begin(), faces.end(), ge->tag()) != faces.end()) ||
-       (ge->dim() == 3 &&
-        std::find(regions.begin(), regions.end(), ge->tag()) != regions.end()))
-      return (*f)(x, y, z);
+    if(applies(ge)) return (*f)(x, y, z);
     return MAX_LC;
   }
+  void evaluate(const double *xyz, std::size_t n, double *values,
+                GEntity *ge = 0)
+  {
+    // the entity is the same for all the points: test it only once
+    Field *f = (GModel::current()->getFields()->get(iField));
+    if(f && iField != id && applies(ge))
+      f->evaluate(xyz, n, values);
+    else
+      std::fill(values, values + n, MAX_LC);
+  }
   const char *getName() { return "Restrict"; }
 };
 
-#if defined(HAVE_ANN)
+#include <nanoflann.hpp>
+using namespace nanoflann;
+
+// This is an example of a custom data set class
+struct PointCloud {
+  std::vector<SPoint3> pts;
+};
+
+// And this is the "dataset to kd-tree" adaptor class:
+template <typename Derived> struct PointCloudAdaptor {
+  const Derived &obj; //!< A const ref to the data set origin
+
+  // The constructor that sets the data set source
+  PointCloudAdaptor(const Derived &obj_) : obj(obj_) {}
+
+  // CRTP helper method
+  inline const Derived &derived() const { return obj; }
+
+  // Must return the number of data points
+  inline size_t kdtree_get_point_count() const { return derived().pts.size(); }
+
+  // Returns the distance between the vector "p1[0:size-1]" and the data point
+  // with index "idx_p2" stored in the class:
+  inline double kdtree_distance(const double *p1, const size_t idx_p2,
+                                size_t /*size*/) const
+  {
+    const double d0 = p1[0] - derived().pts[idx_p2].x();
+    const double d1 = p1[1] - derived().pts[idx_p2].y();
+    const double d2 = p1[2] - derived().pts[idx_p2].z();
+    return d0 * d0 + d1 * d1 + d2 * d2;
+  }
+
+  // Returns the dim'th component of the idx'th point in the class: Since this
+  // is inlined and the "dim" argument is typically an immediate value, the
+  // "if/else's" are actually solved at compile time.
+  inline double kdtree_get_pt(const size_t idx, int dim) const
+  {
+    if(dim == 0)
+      return derived().pts[idx].x();
+    else if(dim == 1)
+      return derived().pts[idx].y();
+    else
+      return derived().pts[idx].z();
+  }
+
+  // Optional bounding-box computation: return false to default to a standard
+  // bbox computation loop.  Return true if the BBOX was already computed by the
+  // class and returned in "bb" so it can be avoided to redo it again.  Look at
+  // bb.size() to find out the expected dimensionality (e.g. 2 or 3 for point
+  // clouds)
+  template <class BBOX> bool kdtree_get_bbox(BBOX & /*bb*/) const
+  {
+    return false;
+  }
+
+}; // end of PointCloudAdaptor
+
+typedef PointCloudAdaptor<PointCloud> PC2KD;
+
+typedef KDTreeSingleIndexAdaptor<L2_Simple_Adaptor<double, PC2KD>, PC2KD, 3>
+  my_kd_tree_t;
+
 struct AttractorInfo {
   AttractorInfo(int a = 0, int b = 0, double c = 0, double d = 0)
     : ent(a), dim(b), u(c), v(d)
@@ -1785,20 +2008,17 @@ struct AttractorInfo {
 };
 
 class AttractorAnisoCurveField : public Field {
-  ANNkd_tree *kdtree;
-  ANNpointArray zeronodes;
-  ANNidxArray index;
-  ANNdistArray dist;
+  PointCloud _points;
+  PC2KD _pc2kd;
+  my_kd_tree_t *_kdtree;
   std::list<int> edges_id;
   double dMin, dMax, lMinTangent, lMaxTangent, lMinNormal, lMaxNormal;
   int n_nodes_by_edge;
   std::vector<SVector3> tg;
 
 public:
-  AttractorAnisoCurveField() : kdtree(0), zeronodes(0)
+  AttractorAnisoCurveField() : _pc2kd(_points), _kdtree(0)
   {
-    index = new ANNidx[1];
-    dist = new ANNdist[1];
     n_nodes_by_edge = 20;
     update_needed = true;
     dMin = 0.1;
@@ -1836,10 +2056,7 @@ public:
   virtual bool isotropic() const { return false; }
   ~AttractorAnisoCurveField()
   {
-    if(kdtree) delete kdtree;
-    if(zeronodes) annDeallocPts(zeronodes);
-    delete[] index;
-    delete[] dist;
+    if(_kdtree) delete _kdtree;
   }
   const char *getName() { return "AttractorAnisoCurve"; }
   std::string getDescription()
@@ -1855,16 +2072,12 @@ public:
   }
   void update()
   {
-    if(zeronodes) {
-      annDeallocPts(zeronodes);
-      delete kdtree;
-    }
-    int totpoints = n_nodes_by_edge * edges_id.size();
-    if(totpoints) {
-      zeronodes = annAllocPts(totpoints, 3);
+    if(_kdtree) {
+      delete _kdtree;
+      _kdtree = 0;
     }
-    tg.resize(totpoints);
-    int k = 0;
+    _points.pts.clear();
+    tg.clear();
     for(std::list<int>::iterator it = edges_id.begin(); it != edges_id.end();
         ++it) {
       GEdge *e = GModel::current()->getEdgeByTag(*it);
@@ -1875,27 +2088,58 @@ public:
           double t = b.low() + u * (b.high() - b.low());
           GPoint gp = e->point(t);
           SVector3 d = e->firstDer(t);
-          zeronodes[k][0] = gp.x();
-          zeronodes[k][1] = gp.y();
-          zeronodes[k][2] = gp.z();
-          tg[k] = d;
-          tg[k].normalize();
-          k++;
+          _points.pts.push_back(SPoint3(gp.x(), gp.y(), gp.z()));
+          tg.push_back(d);
+          tg.back().normalize();
         }
       }
     }
-    kdtree = new ANNkd_tree(zeronodes, totpoints, 3);
+    if(_points.pts.empty()) { // for backward compatibility
+      _points.pts.push_back(SPoint3(0., 0., 0.));
+      tg.push_back(SVector3(1., 0., 0.));
+    }
+    _kdtree = new my_kd_tree_t(3, _pc2kd, KDTreeSingleIndexAdaptorParams(10));
+    _kdtree->buildIndex();
+#if defined(_OPENMP)
+#pragma omp flush
+#pragma omp atomic write
+#endif
     update_needed = false;
   }
-  void operator()(double x, double y, double z, SMetric3 &metr, GEntity *ge = 0)
+  // the kd-tree is built by the first thread that evaluates the field; the
+  // other threads wait for it in the critical section
+  void _updateIfNeeded()
   {
-    if(update_needed) update();
-    double xyz[3] = {x, y, z};
+    bool needed;
+#if defined(_OPENMP)
+#pragma omp atomic read
+#endif
+    needed = update_needed;
 #if defined(_OPENMP)
-#pragma omp critical
+#pragma omp flush
 #endif
-    kdtree->annkSearch(xyz, 1, index, dist);
-    double d = sqrt(dist[0]);
+    if(!needed) return;
+#if defined(_OPENMP)
+#pragma omp critical(AttractorFieldUpdate)
+#endif
+    if(update_needed) update();
+  }
+  // squared distance to the closest point on the curves, and index of the
+  // point; the results are stored on the stack, so that concurrent queries
+  // do not need to be serialized
+  double closest(double x, double y, double z, std::size_t &index) const
+  {
+    double xyz[3] = {x, y, z}, dist2 = 0.;
+    KNNResultSet<double> resultSet(1);
+    resultSet.init(&index, &dist2);
+    _kdtree->findNeighbors(resultSet, xyz, SearchParams(10));
+    return dist2;
+  }
+  void operator()(double x, double y, double z, SMetric3 &metr, GEntity *ge = 0)
+  {
+    _updateIfNeeded();
+    std::size_t index = 0;
+    double d = sqrt(closest(x, y, z, index));
     double lTg = d < dMin ?
                    lMinTangent :
                    d > dMax ? lMaxTangent :
@@ -1905,7 +2149,7 @@ public:
                            d > dMax ? lMaxNormal :
                                       lMinNormal + (lMaxNormal - lMinNormal) *
                                                      (d - dMin) / (dMax - dMin);
-    SVector3 t = tg[index[0]];
+    SVector3 t = tg[index];
     SVector3 n0 = crossprod(t, fabs(t(0)) > fabs(t(1)) ? SVector3(0, 1, 0) :
                                                          SVector3(1, 0, 0));
     SVector3 n1 = crossprod(t, n0);
@@ -1913,34 +2157,27 @@ public:
   }
   virtual double operator()(double X, double Y, double Z, GEntity *ge = 0)
   {
-    if(update_needed) update();
-    double xyz[3] = {X, Y, Z};
-#if defined(_OPENMP)
-#pragma omp critical
-#endif
-    kdtree->annkSearch(xyz, 1, index, dist);
-    double d = sqrt(dist[0]);
+    _updateIfNeeded();
+    std::size_t index = 0;
+    double d = sqrt(closest(X, Y, Z, index));
     return std::max(d, 0.05);
   }
 };
 
 class AttractorField : public Field {
-  ANNkd_tree *kdtree;
-  ANNpointArray zeronodes;
+  PointCloud _points;
+  PC2KD _pc2kd;
+  my_kd_tree_t *_kdtree;
   std::list<int> nodes_id, edges_id, faces_id;
   std::vector<AttractorInfo> _infos;
   int _xFieldId, _yFieldId, _zFieldId;
   Field *_xField, *_yField, *_zField;
   int n_nodes_by_edge;
-  ANNidxArray index;
-  ANNdistArray dist;
 
 public:
   AttractorField(int dim, int tag, int nbe)
-    : kdtree(0), zeronodes(0), n_nodes_by_edge(nbe)
+    : _pc2kd(_points), _kdtree(0), n_nodes_by_edge(nbe)
   {
-    index = new ANNidx[1];
-    dist = new ANNdist[1];
     if(dim == 0)
       nodes_id.push_back(tag);
     else if(dim == 1)
@@ -1951,10 +2188,8 @@ public:
     _xFieldId = _yFieldId = _zFieldId = -1;
     update_needed = true;
   }
-  AttractorField() : kdtree(0), zeronodes(0)
+  AttractorField() : _pc2kd(_points), _kdtree(0)
   {
-    index = new ANNidx[1];
-    dist = new ANNdist[1];
     n_nodes_by_edge = 20;
     options["NodesList"] = new FieldOptionList(
       nodes_id, "Indices of nodes in the geometric model", &update_needed);
@@ -1980,10 +2215,7 @@ public:
   }
   ~AttractorField()
   {
-    delete[] index;
-    delete[] dist;
-    if(kdtree) delete kdtree;
-    if(zeronodes) annDeallocPts(zeronodes);
+    if(_kdtree) delete _kdtree;
   }
   const char *getName() { return "Attractor"; }
   std::string getDescription()
@@ -2002,11 +2234,9 @@ public:
     cy = _yField ? (*_yField)(x, y, z, ge) : y;
     cz = _zField ? (*_zField)(x, y, z, ge) : z;
   }
-  std::pair<AttractorInfo, SPoint3> getAttractorInfo() const
+  std::pair<AttractorInfo, SPoint3> getAttractorInfo(std::size_t index) const
   {
-    return std::make_pair(_infos[index[0]], SPoint3(zeronodes[index[0]][0],
-                                                    zeronodes[index[0]][1],
-                                                    zeronodes[index[0]][2]));
+    return std::make_pair(_infos[index], _points.pts[index]);
   }
 
   void update()
@@ -2022,10 +2252,11 @@ public:
       _zField = _zFieldId >= 0 ?
                   (GModel::current()->getFields()->get(_zFieldId)) :
                   NULL;
-      if(zeronodes) {
-        annDeallocPts(zeronodes);
-        delete kdtree;
+      if(_kdtree) {
+        delete _kdtree;
+        _kdtree = 0;
       }
+      _infos.clear();
 
       std::vector<SPoint3> points;
       std::vector<SPoint2> uvpoints;
@@ -2149,35 +2380,61 @@ public:
         pz.push_back(0.);
       }
 
-      zeronodes = annAllocPts(totpoints, 3);
-      for(int i = 0; i < totpoints; i++) {
-        zeronodes[i][0] = px[i];
-        zeronodes[i][1] = py[i];
-        zeronodes[i][2] = pz[i];
-      }
-      kdtree = new ANNkd_tree(zeronodes, totpoints, 3);
+      _points.pts.resize(totpoints);
+      for(int i = 0; i < totpoints; i++)
+        _points.pts[i] = SPoint3(px[i], py[i], pz[i]);
+      _kdtree = new my_kd_tree_t(3, _pc2kd, KDTreeSingleIndexAdaptorParams(10));
+      _kdtree->buildIndex();
+#if defined(_OPENMP)
+#pragma omp flush
+#pragma omp atomic write
+#endif
       update_needed = false;
     }
   }
-
-  using Field::operator();
-  virtual double operator()(double X, double Y, double Z, GEntity *ge = 0)
+  // the kd-tree is built by the first thread that evaluates the field; the
+  // other threads wait for it in the critical section
+  void _updateIfNeeded()
   {
+    bool needed;
 #if defined(_OPENMP)
-#pragma omp critical
+#pragma omp atomic read
 #endif
-    {
-      update();
-    }
-    // NOT thread safe anyway :-)
-    double xyz[3];
+    needed = update_needed;
+#if defined(_OPENMP)
+#pragma omp flush
+#endif
+    if(!needed) return;
+#if defined(_OPENMP)
+#pragma omp critical(AttractorFieldUpdate)
+#endif
+    if(update_needed) update();
+  }
+
+  // distance to the closest attractor, and index of the attractor; the
+  // results of the query are stored on the stack, so that concurrent queries do
+  // not need to be serialized
+  double getDistance(double X, double Y, double Z, std::size_t &index,
+                     GEntity *ge = 0)
+  {
+    _updateIfNeeded();
+    double xyz[3], dist2 = 0.;
     getCoord(X, Y, Z, xyz[0], xyz[1], xyz[2], ge);
-    kdtree->annkSearch(xyz, 1, index, dist);
-    double d = dist[0];
-    return sqrt(d);
+    KNNResultSet<double> resultSet(1);
+    resultSet.init(&index, &dist2);
+    _kdtree->findNeighbors(resultSet, xyz, SearchParams(10));
+    return sqrt(dist2);
+  }
+
+  using Field::operator();
+  virtual double operator()(double X, double Y, double Z, GEntity *ge = 0)
+  {
+    std::size_t index = 0;
+    return getDistance(X, Y, Z, index, ge);
   }
 };
 
+#if defined(HAVE_ANN)
 class OctreeField : public Field {
   // octree field
   class Cell {
@@ -2553,9 +2810,9 @@ void BoundaryLayerField::computeFor1dMesh(double x, double y, double z,
   metr = buildMetricTangentToCurve(t1, lc_n, lc_n);
 }
 
-void BoundaryLayerField::operator()(AttractorField *cc, double dist, double x,
-                                    double y, double z, SMetric3 &metr,
-                                    GEntity *ge)
+void BoundaryLayerField::operator()(AttractorField *cc, double dist,
+                                    std::size_t closest, double x, double y,
+                                    double z, SMetric3 &metr, GEntity *ge)
 {
   // dist = hwall -> lc = hwall * ratio
   // dist = hwall (1+ratio) -> lc = hwall ratio ^ 2
@@ -2576,7 +2833,7 @@ void BoundaryLayerField::operator()(AttractorField *cc, double dist, double x,
   lc_t = std::max(lc_t, CTX::instance()->mesh.lcMin);
   lc_t = std::min(lc_t, CTX::instance()->mesh.lcMax);
 
-  std::pair<AttractorInfo, SPoint3> pp = cc->getAttractorInfo();
+  std::pair<AttractorInfo, SPoint3> pp = cc->getAttractorInfo(closest);
   double beta = CTX::instance()->mesh.smoothRatio;
   if(pp.first.dim == 0) {
     GVertex *v = GModel::current()->getVertexByTag(pp.first.ent);
@@ -2665,9 +2922,10 @@ void BoundaryLayerField::operator()(double x, double y, double z,
   hop.push_back(v);
   for(std::list<AttractorField *>::iterator it = _att_fields.begin();
       it != _att_fields.end(); ++it) {
-    double cdist = (*(*it))(x, y, z);
-    AttractorInfo ainfo = (*it)->getAttractorInfo().first;
-    SPoint3 CLOSEST = (*it)->getAttractorInfo().second;
+    std::size_t closest = 0;
+    double cdist = (*it)->getDistance(x, y, z, closest);
+    AttractorInfo ainfo = (*it)->getAttractorInfo(closest).first;
+    SPoint3 CLOSEST = (*it)->getAttractorInfo(closest).second;
 
     bool doNotConsider = false;
     if(ge->dim() == ainfo.dim && ge->tag() == ainfo.ent) {
@@ -2681,11 +2939,12 @@ void BoundaryLayerField::operator()(double x, double y, double z,
     if(!doNotConsider) {
       SMetric3 localMetric;
       if(iIntersect) {
-        (*this)(*it, cdist, x, y, z, localMetric, ge);
+        (*this)(*it, cdist, closest, x, y, z, localMetric, ge);
         hop.push_back(localMetric);
       }
       if(cdist < current_distance) {
-        if(!iIntersect) (*this)(*it, cdist, x, y, z, localMetric, ge);
+        if(!iIntersect)
+          (*this)(*it, cdist, closest, x, y, z, localMetric, ge);
         current_distance = cdist;
         current_closest = *it;
         v = localMetric;
@@ -2701,68 +2960,6 @@ void BoundaryLayerField::operator()(double x, double y, double z,
 
 #endif
 
-#include <nanoflann.hpp>
-using namespace nanoflann;
-
-// This is an exampleof a custom data set class
-struct PointCloud {
-  std::vector<SPoint3> pts;
-};
-
-// And this is the "dataset to kd-tree" adaptor class:
-template <typename Derived> struct PointCloudAdaptor {
-  const Derived &obj; //!< A const ref to the data set origin
-
-  // The constructor that sets the data set source
-  PointCloudAdaptor(const Derived &obj_) : obj(obj_) {}
-
-  // CRTP helper method
-  inline const Derived &derived() const { return obj; }
-
-  // Must return the number of data points
-  inline size_t kdtree_get_point_count() const { return derived().pts.size(); }
-
-  // Returns the distance between the vector "p1[0:size-1]" and the data point
-  // with index "idx_p2" stored in the class:
-  inline double kdtree_distance(const double *p1, const size_t idx_p2,
-                                size_t /*size*/) const
-  {
-    const double d0 = p1[0] - derived().pts[idx_p2].x();
-    const double d1 = p1[1] - derived().pts[idx_p2].y();
-    const double d2 = p1[2] - derived().pts[idx_p2].z();
-    return d0 * d0 + d1 * d1 + d2 * d2;
-  }
-
-  // Returns the dim'th component of the idx'th point in the class: Since this
-  // is inlined and the "dim" argument is typically an immediate value, the
-  // "if/else's" are actually solved at compile time.
-  inline double kdtree_get_pt(const size_t idx, int dim) const
-  {
-    if(dim == 0)
-      return derived().pts[idx].x();
-    else if(dim == 1)
-      return derived().pts[idx].y();
-    else
-      return derived().pts[idx].z();
-  }
-
-  // Optional bounding-box computation: return false to default to a standard
-  // bbox computation loop.  Return true if the BBOX was already computed by the
-  // class and returned in "bb" so it can be avoided to redo it again.  Look at
-  // bb.size() to find out the expected dimensionality (e.g. 2 or 3 for point
-  // clouds)
-  template <class BBOX> bool kdtree_get_bbox(BBOX & /*bb*/) const
-  {
-    return false;
-  }
-
-}; // end of PointCloudAdaptor
-
-typedef PointCloudAdaptor<PointCloud> PC2KD;
-
-typedef KDTreeSingleIndexAdaptor<L2_Simple_Adaptor<double, PC2KD>, PC2KD, 3>
-  my_kd_tree_t;
-
 class DistanceField : public Field {
   std::list<int> nodes_id, edges_id, faces_id;
   int _xFieldId, _yFieldId, _zFieldId;
@@ -2926,11 +3123,9 @@ FieldManager::FieldManager()
   map_type_name["ExternalProcess"] = new FieldFactoryT<ExternalProcessField>();
   map_type_name["MathEval"] = new FieldFactoryT<MathEvalField>();
   map_type_name["MathEvalAniso"] = new FieldFactoryT<MathEvalFieldAniso>();
-#if defined(HAVE_ANN)
   map_type_name["Attractor"] = new FieldFactoryT<AttractorField>();
   map_type_name["AttractorAnisoCurve"] =
     new FieldFactoryT<AttractorAnisoCurveField>();
-#endif
   map_type_name["MaxEigenHessian"] = new FieldFactoryT<MaxEigenHessianField>();
   _background_field = -1;
 }
@@ -2955,6 +3150,7 @@ void FieldManager::setBackgroundField(Field *BGF)
   int id = newId();
   (*this)[id] = BGF;
   _background_field = id;
+  BGM_ClearCache();
 }
 
 void Field::putOnNewView()
@@ -2985,14 +3181,27 @@ void Field::putOnView(PView *view, int comp)
 {
   PViewData *data = view->getData();
   for(int ent = 0; ent < data->getNumEntities(0); ent++) {
+    // evaluate the field at all the nodes of the entity at once
+    std::vector<double> xyz;
     for(int ele = 0; ele < data->getNumElements(0, ent); ele++) {
       if(data->skipElement(0, ent, ele)) continue;
       for(int nod = 0; nod < data->getNumNodes(0, ent, ele); nod++) {
         double x, y, z;
         data->getNode(0, ent, ele, nod, x, y, z);
-        double val = (*this)(x, y, z);
+        xyz.push_back(x);
+        xyz.push_back(y);
+        xyz.push_back(z);
+      }
+    }
+    if(xyz.empty()) continue;
+    std::vector<double> val(xyz.size() / 3);
+    evaluate(&xyz[0], val.size(), &val[0]);
+    std::size_t k = 0;
+    for(int ele = 0; ele < data->getNumElements(0, ent); ele++) {
+      if(data->skipElement(0, ent, ele)) continue;
+      for(int nod = 0; nod < data->getNumNodes(0, ent, ele); nod++, k++) {
         for(int comp = 0; comp < data->getNumComponents(0, ent, ele); comp++)
-          data->setValue(0, ent, ele, nod, comp, val);
+          data->setValue(0, ent, ele, nod, comp, val[k]);
       }
     }
   }
@@ -108,6 +108,11 @@ public:
   virtual bool isotropic() const { return true; }
   // isotropic
   virtual double operator()(double x, double y, double z, GEntity *ge = 0) = 0;
+  // isotropic, for n points at once (xyz contains the 3 coordinates of each
+  // point, one point after the other): fields that combine other fields
+  // evaluate them once for all the points, instead of once per point
+  virtual void evaluate(const double *xyz, std::size_t n, double *values,
+                        GEntity *ge = 0);
   // anisotropic
   virtual void operator()(double x, double y, double z, SMetric3 &,
                           GEntity *ge = 0)
@@ -182,8 +187,8 @@ private:
   std::list<double> hwall_n_nodes;
   std::list<int> nodes_id, edges_id;
   std::list<int> edges_id_saved, nodes_id_saved, fan_nodes_id;
-  void operator()(AttractorField *cc, double dist, double x, double y, double z,
-                  SMetric3 &metr, GEntity *ge);
+  void operator()(AttractorField *cc, double dist, std::size_t closest,
+                  double x, double y, double z, SMetric3 &metr, GEntity *ge);
 
 public:
   double hwall_n, ratio, hfar, thickness, fan_angle;
@@ -4,7 +4,7 @@
 // issues on https://gitlab.onelab.info/gmsh/gmsh/issues
 
 #include <stdlib.h>
-#include <stack>
+#include <map>
 #include "GmshConfig.h"
 #include "GmshMessage.h"
 #include "Numeric.h"
@@ -25,6 +25,7 @@
 #include "meshGFaceBDS.h"
 #include "meshGRegion.h"
 #include "BackgroundMesh.h"
+#include "BackgroundMeshTools.h"
 #include "BoundaryLayers.h"
 #include "HighOrder.h"
 #include "Generator.h"
@@ -34,6 +35,7 @@
 #include "yamakawa.h"
 #include "meshGRegionRelocateVertex.h"
 #include "pointInsertion.h"
+#include "robustPredicates.h"
 
 #if defined(_OPENMP)
 #include <omp.h>
@@ -211,6 +213,11 @@ void GetStatistics(double stat[50], double quality[3][100])
   stat[15] = CTX::instance()->meshTimer[1];
   stat[16] = CTX::instance()->meshTimer[2];
 
+  std::size_t hits, misses;
+  BGM_GetCacheStatistics(hits, misses);
+  stat[38] = hits;
+  stat[39] = misses;
+
   if(quality) {
     for(int i = 0; i < 3; i++)
       for(int j = 0; j < 100; j++) quality[i][j] = 0.;
@@ -440,6 +447,16 @@ static void PrintMesh2dStatistics(GModel *m)
   fclose(statreport);
 }
 
+class DecreasingCost {
+public:
+  template <class T>
+  bool operator()(const std::pair<std::size_t, T> &a,
+                  const std::pair<std::size_t, T> &b) const
+  {
+    return a.first > b.first;
+  }
+};
+
 static void Mesh2D(GModel *m)
 {
   m->getFields()->initialize();
@@ -468,29 +485,44 @@ static void Mesh2D(GModel *m)
 
     int nIter = 0, nTot = m->getNumFaces();
     while(1) {
-      int nPending = 0;
-      std::vector<GFace *> temp;
-      temp.insert(temp.begin(), f.begin(), f.end());
+      // mesh the pending surfaces in parallel, largest first (estimated by the
+      // number of nodes on their boundary) so that a big surface does not end
+      // up being meshed alone at the end of the loop
+      std::vector<std::pair<std::size_t, GFace *> > temp;
+      for(std::set<GFace *, GEntityLessThan>::iterator it = f.begin();
+          it != f.end(); ++it) {
+        if((*it)->meshStatistics.status != GFace::PENDING) continue;
+        std::size_t cost = 0;
+        std::vector<GEdge *> const &edges = (*it)->edges();
+        for(std::size_t i = 0; i < edges.size(); i++)
+          cost += edges[i]->getNumMeshVertices() + 1;
+        temp.push_back(std::make_pair(cost, *it));
+      }
+      if(temp.empty()) break;
+      std::stable_sort(temp.begin(), temp.end(), DecreasingCost());
+      int nDone = 0;
 #if defined(_OPENMP)
-#pragma omp parallel for schedule(dynamic)
+#pragma omp parallel for schedule(dynamic, 1)
 #endif
       for(size_t K = 0; K < temp.size(); K++) {
-        if(temp[K]->meshStatistics.status == GFace::PENDING) {
-          backgroundMesh::current()->unset();
-          temp[K]->mesh(true);
+        backgroundMesh::unset();
+        temp[K].second->mesh(true);
 #if defined(_OPENMP)
-#pragma omp critical
+#pragma omp atomic
 #endif
-          {
-            nPending++;
-          }
+        nDone++;
+        if(!nIter) Msg::ProgressMeter(nDone, nTot, false, "Meshing 2D...");
+      }
+      // surfaces whose 1D mesh self-intersects are left pending by the parallel
+      // loop, as repairing them modifies the mesh of their bounding curves and
+      // of the adjacent surfaces: mesh them now, one at a time; the surfaces
+      // they un-mesh will be meshed in parallel again in the next iteration
+      for(size_t K = 0; K < temp.size(); K++) {
+        if(temp[K].second->meshStatistics.status == GFace::PENDING) {
+          backgroundMesh::unset();
+          temp[K].second->mesh(true);
         }
-        if(!nIter) Msg::ProgressMeter(nPending, nTot, false, "Meshing 2D...");
       }
-      if(!nPending) break;
-      // iter == 2 is for meshing re-parametrized surfaces
-      // after that, we serialize (self-intersections of 1D meshes are not thread safe)!
-      if(nIter > 2) Msg::SetNumThreads(1);
       if(nIter++ > 10) break;
     }
   }
@@ -506,49 +538,108 @@ static void Mesh2D(GModel *m)
   PrintMesh2dStatistics(m);
 }
 
+static void getRegionEntities(GRegion *gr, std::vector<GEntity *> &entities)
+{
+  std::vector<GFace *> faces = gr->faces();
+  std::vector<GFace *> const &f_e = gr->embeddedFaces();
+  faces.insert(faces.end(), f_e.begin(), f_e.end());
+  for(std::size_t i = 0; i < faces.size(); i++) {
+    entities.push_back(faces[i]);
+    std::vector<GEdge *> const &e = faces[i]->edges();
+    entities.insert(entities.end(), e.begin(), e.end());
+    std::vector<GVertex *> v = faces[i]->vertices();
+    entities.insert(entities.end(), v.begin(), v.end());
+  }
+  std::vector<GEdge *> const &e_e = gr->embeddedEdges();
+  for(std::size_t i = 0; i < e_e.size(); i++) {
+    entities.push_back(e_e[i]);
+    std::vector<GVertex *> v = e_e[i]->vertices();
+    entities.insert(entities.end(), v.begin(), v.end());
+  }
+  std::vector<GVertex *> const &v_e = gr->embeddedVertices();
+  entities.insert(entities.end(), v_e.begin(), v_e.end());
+}
+
+static std::size_t findRoot(std::vector<std::size_t> &parent, std::size_t i)
+{
+  while(parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+// group the regions that share a face, a curve or a point (directly or through
+// other regions): the meshes of regions in different groups are disjoint, so
+// that the groups can be meshed independently. The groups are ordered by their
+// first region, and the regions in each group keep their order in "del".
 static void
 FindConnectedRegions(const std::vector<GRegion *> &del,
                      std::vector<std::vector<GRegion *> > &connected)
 {
-  std::vector<GRegion *> delaunay = del;
-  // test: connected.resize(1); connected[0] = delaunay; return;
-
-  const unsigned int nbVolumes = delaunay.size();
+  const std::size_t nbVolumes = del.size();
   if(!nbVolumes) return;
-  while(delaunay.size()) {
-    std::set<GRegion *> oneDomain;
-    std::stack<GRegion *> _stack;
-    GRegion *r = delaunay[0];
-    _stack.push(r);
-    while(!_stack.empty()) {
-      r = _stack.top();
-      _stack.pop();
-      oneDomain.insert(r);
-      std::vector<GFace *> faces = r->faces();
-      for(std::vector<GFace *>::iterator it = faces.begin(); it != faces.end();
-          ++it) {
-        GFace *gf = *it;
-        GRegion *other =
-          (gf->getRegion(0) == r) ? gf->getRegion(1) : gf->getRegion(0);
-        if(other != 0 && oneDomain.find(other) == oneDomain.end())
-          _stack.push(other);
-      }
-    }
-    std::vector<GRegion *> temp1, temp2;
-    for(unsigned int i = 0; i < delaunay.size(); i++) {
-      r = delaunay[i];
-      if(oneDomain.find(r) == oneDomain.end())
-        temp1.push_back(r);
+
+  std::vector<std::size_t> parent(nbVolumes);
+  for(std::size_t i = 0; i < nbVolumes; i++) parent[i] = i;
+  std::map<GEntity *, std::size_t> owner;
+  for(std::size_t i = 0; i < nbVolumes; i++) {
+    std::vector<GEntity *> entities;
+    getRegionEntities(del[i], entities);
+    for(std::size_t j = 0; j < entities.size(); j++) {
+      std::pair<std::map<GEntity *, std::size_t>::iterator, bool> it =
+        owner.insert(std::make_pair(entities[j], i));
+      if(it.second) continue;
+      std::size_t r1 = findRoot(parent, i);
+      std::size_t r2 = findRoot(parent, it.first->second);
+      if(r1 < r2)
+        parent[r2] = r1;
       else
-        temp2.push_back(r);
+        parent[r1] = r2;
     }
-    connected.push_back(temp2);
-    delaunay = temp1;
+  }
+
+  std::map<std::size_t, std::size_t> group;
+  for(std::size_t i = 0; i < nbVolumes; i++) {
+    std::size_t r = findRoot(parent, i);
+    std::map<std::size_t, std::size_t>::iterator it = group.find(r);
+    if(it == group.end()) {
+      it = group.insert(std::make_pair(r, connected.size())).first;
+      connected.push_back(std::vector<GRegion *>());
+    }
+    connected[it->second].push_back(del[i]);
   }
   Msg::Info("3D Meshing %d volumes with %d connected components",
             nbVolumes, connected.size());
 }
 
+// renumber the nodes and elements numbered above maxVertex and maxElement, by
+// looping over the entities of the model: when the mesh is generated
+// concurrently, the numbers are assigned in an order that depends on the
+// scheduling of the threads; after renumbering, the numbering is the same
+// whatever the number of threads
+static void RenumberNewMeshEntities(GModel *m, std::size_t maxVertex,
+                                    std::size_t maxElement)
+{
+  std::vector<GEntity *> entities;
+  m->getEntities(entities);
+  std::size_t numVertex = maxVertex, numElement = maxElement;
+  for(std::size_t i = 0; i < entities.size(); i++) {
+    GEntity *ge = entities[i];
+    for(std::size_t j = 0; j < ge->mesh_vertices.size(); j++) {
+      MVertex *v = ge->mesh_vertices[j];
+      if(v->getNum() > maxVertex) v->forceNum(++numVertex);
+    }
+    for(std::size_t j = 0; j < ge->getNumMeshElements(); j++) {
+      MElement *e = ge->getMeshElement(j);
+      if(e->getNum() > maxElement) e->forceNum(++numElement);
+    }
+  }
+  m->setMaxVertexNumber(numVertex);
+  m->setMaxElementNumber(numElement);
+  m->destroyMeshCaches();
+}
+
 template <class ITERATOR>
 void fillv_(std::multimap<MVertex *, MElement *> &vertexToElement,
             ITERATOR it_beg, ITERATOR it_end)
@@ -836,12 +927,24 @@ static void Mesh3D(GModel *m)
   std::vector<GRegion *> delaunay;
   std::for_each(m->firstRegion(), m->lastRegion(), meshGRegion(delaunay));
 
-  // Mesh region on by one so Field/Restrict/RegionLists is honored
+  // with the Delaunay algorithm, group the regions that share part of their
+  // boundary: the groups have disjoint meshes, and are meshed concurrently
+  // (MMG3D is not reentrant, and HXT is parallel on its own). The grouping
+  // does not depend on the number of threads, so that the mesh does not either.
+  // Regions are always meshed one by one so that Field/Restrict/RegionsList is
+  // honored.
   std::vector<std::vector<GRegion *> > connected;
-  connected.resize(delaunay.size());
-  for(size_t i = 0; i < delaunay.size(); i++) {
-    connected[i].push_back(delaunay[i]);
+  if(CTX::instance()->mesh.algo3d == ALGO_3D_DELAUNAY) {
+    FindConnectedRegions(delaunay, connected);
   }
+  else {
+    connected.resize(delaunay.size());
+    for(size_t i = 0; i < delaunay.size(); i++) {
+      connected[i].push_back(delaunay[i]);
+    }
+  }
+  bool parallel = (CTX::instance()->mesh.algo3d == ALGO_3D_DELAUNAY &&
+                   connected.size() > 1);
 
   // remove quads elements for volumes that are recombined
   for(unsigned int i = 0; i < connected.size(); i++) {
@@ -860,9 +963,48 @@ static void Mesh3D(GModel *m)
   double vol_hexa_recombination = 0.;
   int nb_elements_recombination = 0, nb_hexa_recombination = 0;
 
-  for(unsigned int i = 0; i < connected.size(); i++) {
-    MeshDelaunayVolume(connected[i]);
+  // largest groups first (estimated by the number of boundary elements), so
+  // that a big group does not end up being meshed alone at the end of the loop
+  std::vector<std::pair<std::size_t, std::size_t> > order;
+  for(std::size_t i = 0; i < connected.size(); i++) {
+    std::size_t cost = 0;
+    for(std::size_t j = 0; j < connected[i].size(); j++) {
+      std::vector<GFace *> const &f = connected[i][j]->faces();
+      for(std::size_t k = 0; k < f.size(); k++)
+        cost += f[k]->getNumMeshElements();
+    }
+    order.push_back(std::make_pair(cost, i));
+  }
+  if(parallel) {
+    std::stable_sort(order.begin(), order.end(), DecreasingCost());
+    // the static filters of the robust predicates are global: set them once
+    // from the bounding box of the model, which bounds the coordinates of all
+    // the volumes (a filter computed for a larger box is still valid)
+    SBoundingBox3d bb = m->bounds();
+    if(!bb.empty()) {
+      double maxx = 1.01 * std::max(fabs(bb.min().x()), fabs(bb.max().x()));
+      double maxy = 1.01 * std::max(fabs(bb.min().y()), fabs(bb.max().y()));
+      double maxz = 1.01 * std::max(fabs(bb.min().z()), fabs(bb.max().z()));
+      robustPredicates::exactinit(1, maxx, maxy, maxz);
+    }
+    else
+      robustPredicates::exactinit(0, 1., 1., 1.);
+  }
+  std::size_t maxVertex = m->getMaxVertexNumber();
+  std::size_t maxElement = m->getMaxElementNumber();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 1) if(parallel)
+#endif
+  for(size_t K = 0; K < order.size(); K++) {
+    std::vector<GRegion *> &domain = connected[order[K].second];
+    for(std::size_t j = 0; j < domain.size(); j++) {
+      std::vector<GRegion *> regions(1, domain[j]);
+      MeshDelaunayVolume(regions, parallel ? &domain : 0);
+    }
+  }
+  if(parallel) RenumberNewMeshEntities(m, maxVertex, maxElement);
 
+  for(unsigned int i = 0; i < connected.size(); i++) {
     // additional code for experimental hex mesh
     for(unsigned j = 0; j < connected[i].size(); j++) {
       GRegion *gr = connected[i][j];
@@ -1070,6 +1212,9 @@ void GenerateMesh(GModel *m, int ask)
   // Change any high order elements back into first order ones
   SetOrder1(m);
 
+  // Cache the mesh sizes computed from the background field
+  BGM_StartCache();
+
   // 1D mesh
   if(ask == 1 || (ask > 1 && old < 1)) {
     std::for_each(m->firstRegion(), m->lastRegion(), deMeshGRegion());
@@ -1106,6 +1251,14 @@ void GenerateMesh(GModel *m, int ask)
     }
   }
 
+  if(CTX::instance()->mesh.lcCache > 0) {
+    std::size_t hits, misses;
+    BGM_GetCacheStatistics(hits, misses);
+    Msg::Info("Mesh size cache: %lu hits, %lu misses", (unsigned long)hits,
+              (unsigned long)misses);
+  }
+  BGM_StopCache();
+
   // Subdivide into quads or hexas
   if(m->getMeshStatus() == 2 && CTX::instance()->mesh.algoSubdivide == 1)
     RefineMesh(m, CTX::instance()->mesh.secondOrderLinear, true);
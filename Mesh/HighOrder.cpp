@@ -9,6 +9,8 @@
 
 #include <sstream>
 #include <vector>
+#include <map>
+#include <algorithm>
 #include "GmshConfig.h"
 #include "HighOrder.h"
 #include "MLine.h"
@@ -278,8 +280,9 @@ static bool getEdgeVerticesOnGeo(GEdge *ge, MVertex *v0, MVertex *v1,
     if(failed) {
       Msg::Warning(
         "Failed to compute equidistant parameters (relax = %g, value = %g) "
-        "for edge %d-%d parametrized with %g %g on GEdge %d",
-        relax, US[1], v0->getNum(), v1->getNum(), u0, u1, ge->tag());
+        "for edge %lu-%lu parametrized with %g %g on GEdge %d",
+        relax, US[1], (unsigned long)v0->getNum(),
+        (unsigned long)v1->getNum(), u0, u1, ge->tag());
       US[0] = uMin;
       const double du = (uMax - uMin) / (nPts + 1);
       for(int i = 1; i <= nPts; i++) US[i] = US[i - 1] + du;
@@ -423,13 +426,12 @@ static void getEdgeVertices(GEdge *ge, MElement *ele,
   // If not on geometry, create from mesh interpolation
   if(!gotVertOnGeo) interpVerticesInExistingEdge(ge, ele, veEdge, nPts);
   newHOVert.insert(newHOVert.end(), veEdge.begin(), veEdge.end());
-  if(edgeVertices.count(p) == 0) {
+  if(edgeVertices.find(p) == edgeVertices.end()) {
+    std::vector<MVertex *> &eVtcs = edgeVertices[p];
     if(increasing) // Add newly created vertices to list
-      edgeVertices[p].insert(edgeVertices[p].end(), veEdge.begin(),
-                             veEdge.end());
+      eVtcs.insert(eVtcs.end(), veEdge.begin(), veEdge.end());
     else
-      edgeVertices[p].insert(edgeVertices[p].end(), veEdge.rbegin(),
-                             veEdge.rend());
+      eVtcs.insert(eVtcs.end(), veEdge.rbegin(), veEdge.rend());
   }
   else if(p.first != p.second) { // Vertices already exist and edge is not a
                                  // degenerated edge
@@ -505,22 +507,26 @@ static void getEdgeVertices(GRegion *gr, MElement *ele,
     const bool increasing = getMinMaxVert(veOld[0], veOld[1], vMin, vMax);
     std::pair<MVertex *, MVertex *> p(vMin, vMax);
     std::vector<MVertex *> veEdge;
-    if(edgeVertices.count(p)) { // Vertices already exist
+    edgeContainer::iterator eIter = edgeVertices.find(p);
+
+    if(eIter != edgeVertices.end()) { // Vertices already exist
+      std::vector<MVertex *> &eVtcs = eIter->second;
       if(increasing)
-        veEdge.assign(edgeVertices[p].begin(), edgeVertices[p].end());
+        veEdge.assign(eVtcs.begin(), eVtcs.end());
       else
-        veEdge.assign(edgeVertices[p].rbegin(), edgeVertices[p].rend());
+        veEdge.assign(eVtcs.rbegin(), eVtcs.rend());
     }
     else { // Vertices do not exist, create them
       const MLineN edgeEl(veOld, ele->getPolynomialOrder());
       interpVerticesInExistingEdge(gr, &edgeEl, veEdge, nPts);
       newHOVert.insert(newHOVert.end(), veEdge.begin(), veEdge.end());
+
+      std::vector<MVertex *> &eVtcs = edgeVertices[p];
+
       if(increasing) // Add newly created vertices to list
-        edgeVertices[p].insert(edgeVertices[p].end(), veEdge.begin(),
-                               veEdge.end());
+        eVtcs.insert(eVtcs.end(), veEdge.begin(), veEdge.end());
       else
-        edgeVertices[p].insert(edgeVertices[p].end(), veEdge.rbegin(),
-                               veEdge.rend());
+        eVtcs.insert(eVtcs.end(), veEdge.rbegin(), veEdge.rend());
     }
     ve.insert(ve.end(), veEdge.begin(), veEdge.end());
   }
@@ -776,9 +782,8 @@ static void getFaceVertices(GFace *gf, MElement *ele,
     interpVerticesInExistingFace(gf, *coefficients, boundaryVertices, vFace);
   }
 
-  MFace face = ele->getFace(0);
-  faceVertices[face].insert(faceVertices[face].end(), vFace.begin(),
-                            vFace.end());
+  std::vector<MVertex *> &fVtcs = faceVertices[ele->getFace(0)];
+  fVtcs.insert(fVtcs.end(), vFace.begin(), vFace.end());
   newVertices.insert(newVertices.end(), vFace.begin(), vFace.end());
   newHOVert.insert(newHOVert.end(), vFace.begin(), vFace.end());
 }
@@ -887,8 +892,8 @@ static void getFaceVertices(GRegion *gr, MElement *ele,
       interpVerticesInExistingFace(gr, *coefficients, faceBoundaryVertices,
                                    vFace);
       newHOVert.insert(newHOVert.end(), vFace.begin(), vFace.end());
-      faceVertices[face].insert(faceVertices[face].end(), vFace.begin(),
-                                vFace.end());
+      std::vector<MVertex *> &fVtcs = faceVertices[face];
+      fVtcs.insert(fVtcs.end(), vFace.begin(), vFace.end());
     }
     newVertices.insert(newVertices.end(), vFace.begin(), vFace.end());
   }
@@ -1202,6 +1207,162 @@ static void setHighOrder(GRegion *gr, std::vector<MVertex *> &newHOVert,
   gr->deleteVertexArrays();
 }
 
+static void setHighOrder(GEntity *ge, std::vector<MVertex *> &newHOVert,
+                         edgeContainer &edgeVertices,
+                         faceContainer &faceVertices, bool linear,
+                         bool incomplete, int order)
+{
+  int nPts = order - 1;
+  switch(ge->dim()) {
+  case 1:
+    Msg::Info("Meshing curve %d order %d", ge->tag(), order);
+    setHighOrder(static_cast<GEdge *>(ge), newHOVert, edgeVertices, linear,
+                 nPts);
+    break;
+  case 2:
+    Msg::Info("Meshing surface %d order %d", ge->tag(), order);
+    setHighOrder(static_cast<GFace *>(ge), newHOVert, edgeVertices,
+                 faceVertices, linear, incomplete, nPts);
+    static_cast<GFace *>(ge)->getColumns()->clearElementData();
+    break;
+  case 3:
+    Msg::Info("Meshing volume %d order %d", ge->tag(), order);
+    setHighOrder(static_cast<GRegion *>(ge), newHOVert, edgeVertices,
+                 faceVertices, incomplete, nPts);
+    static_cast<GRegion *>(ge)->getColumns()->clearElementData();
+    break;
+  }
+}
+
+#if defined(_OPENMP)
+
+// Check that the entities do not share any edge or face whose high order
+// vertices do not exist yet, i.e. that each new edge or face would be created
+// by exactly one thread if the entities are processed concurrently. Edges and
+// faces with a vertex classified on the entity are internal to the entity:
+// only the ones with all their vertices on its boundary need to be checked.
+static bool haveDisjointHighOrderEntities(
+  const std::vector<GEntity *> &entities, edgeContainer &edgeVertices,
+  faceContainer &faceVertices, bool incomplete, int nPts)
+{
+  std::map<std::pair<MVertex *, MVertex *>, GEntity *> edgeOwner;
+  std::map<MFace, GEntity *, Less_Face> faceOwner;
+  for(std::size_t i = 0; i < entities.size(); i++) {
+    GEntity *ge = entities[i];
+    for(std::size_t j = 0; j < ge->getNumMeshElements(); j++) {
+      MElement *e = ge->getMeshElement(j);
+      for(int k = 0; k < e->getNumEdges(); k++) {
+        MEdge edge = e->getEdge(k);
+        if(edge.getVertex(0)->onWhat() == ge ||
+           edge.getVertex(1)->onWhat() == ge)
+          continue;
+        MVertex *vMin, *vMax;
+        getMinMaxVert(edge.getVertex(0), edge.getVertex(1), vMin, vMax);
+        std::pair<MVertex *, MVertex *> p(vMin, vMax);
+        if(edgeVertices.count(p)) continue;
+        GEntity *&owner = edgeOwner[p];
+        if(owner && owner != ge) return false;
+        owner = ge;
+      }
+      if(incomplete || ge->dim() < 2) continue;
+      for(int k = 0; k < e->getNumFaces(); k++) {
+        MFace face = e->getFace(k);
+        // no vertex is created inside second order triangles
+        if(face.getNumVertices() == 3 && nPts < 2) continue;
+        bool boundary = true;
+        for(std::size_t l = 0; l < face.getNumVertices(); l++)
+          if(face.getVertex(l)->onWhat() == ge) boundary = false;
+        if(!boundary || faceVertices.count(face)) continue;
+        GEntity *&owner = faceOwner[face];
+        if(owner && owner != ge) return false;
+        owner = ge;
+      }
+    }
+  }
+  return true;
+}
+
+#endif
+
+// Curve the mesh of entities of the same dimension. When several threads are
+// available, each entity is processed by a single thread, which stores the
+// edges and faces it creates in private containers; these are merged once all
+// the entities are done, and the new vertices and elements are renumbered in
+// the order of the entities so that the numbering does not depend on the
+// scheduling of the threads.
+static void
+setHighOrder(GModel *m, std::vector<GEntity *> &entities,
+             std::map<GEntity *, std::vector<MVertex *> > &newHOVert,
+             edgeContainer &edgeVertices, faceContainer &faceVertices,
+             bool linear, bool incomplete, int order, const char *msg,
+             int &counter, int nTot)
+{
+  std::vector<std::vector<MVertex *> *> newVert(entities.size());
+  for(std::size_t i = 0; i < entities.size(); i++)
+    newVert[i] = &newHOVert[entities[i]];
+
+  bool parallel = false;
+#if defined(_OPENMP)
+  parallel = Msg::GetMaxThreads() > 1 && entities.size() > 1 &&
+             haveDisjointHighOrderEntities(entities, edgeVertices,
+                                           faceVertices, incomplete, order - 1);
+#endif
+
+  if(!parallel) {
+    for(std::size_t i = 0; i < entities.size(); i++) {
+      Msg::ProgressMeter(++counter, nTot, false, msg);
+      setHighOrder(entities[i], *newVert[i], edgeVertices, faceVertices,
+                   linear, incomplete, order);
+    }
+    return;
+  }
+
+  // the placement matrices are built on demand: build them before the threads
+  // read them
+  for(int type = TYPE_TRI; type <= TYPE_PYR; type++)
+    getInnerVertexPlacement(type, order);
+
+  // largest entities first
+  std::vector<std::pair<std::size_t, std::size_t> > cost(entities.size());
+  for(std::size_t i = 0; i < entities.size(); i++)
+    cost[i] = std::make_pair(entities[i]->getNumMeshElements(), i);
+  std::sort(cost.rbegin(), cost.rend());
+
+  std::size_t maxVertex = m->getMaxVertexNumber();
+  std::size_t maxElement = m->getMaxElementNumber();
+  std::vector<edgeContainer> edges(entities.size(),
+                                   edgeContainer(&edgeVertices));
+  std::vector<faceContainer> faces(entities.size(),
+                                   faceContainer(&faceVertices));
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+  for(size_t K = 0; K < cost.size(); K++) {
+    std::size_t i = cost[K].second;
+    setHighOrder(entities[i], *newVert[i], edges[i], faces[i], linear,
+                 incomplete, order);
+#if defined(_OPENMP)
+#pragma omp atomic
+#endif
+    counter++;
+    Msg::ProgressMeter(counter, nTot, false, msg);
+  }
+
+  std::size_t numVertex = maxVertex, numElement = maxElement;
+  for(std::size_t i = 0; i < entities.size(); i++) {
+    edgeVertices.merge(edges[i]);
+    faceVertices.merge(faces[i]);
+    for(std::size_t j = 0; j < newVert[i]->size(); j++)
+      (*newVert[i])[j]->forceNum(++numVertex);
+    for(std::size_t j = 0; j < entities[i]->getNumMeshElements(); j++) {
+      MElement *e = entities[i]->getMeshElement(j);
+      if(e->getNum() > maxElement) e->forceNum(++numElement);
+    }
+  }
+  m->setMaxVertexNumber(numVertex);
+  m->setMaxElementNumber(numElement);
+}
+
 // High-level functions
 
 template <class T>
@@ -1261,8 +1422,8 @@ static void updatePeriodicEdgesAndFaces(GModel *m)
       for(unsigned int i = 0; i < src->getNumMeshElements(); i++) {
         MLine *srcLine = dynamic_cast<MLine *>(src->getMeshElement(i));
         if(!srcLine) {
-          Msg::Error("Master element %d is not an edge",
-                     src->getMeshElement(i)->getNum());
+          Msg::Error("Master element %lu is not an edge",
+                     (unsigned long)src->getMeshElement(i)->getNum());
           return;
         }
         srcEdges[MEdge(srcLine->getVertex(0), srcLine->getVertex(1))] = srcLine;
@@ -1272,17 +1433,17 @@ static void updatePeriodicEdgesAndFaces(GModel *m)
         MLine *tgtLine = dynamic_cast<MLine *>(tgt->getMeshElement(i));
         MVertex *vtcs[2];
         if(!tgtLine) {
-          Msg::Error("Slave element %d is not an edge",
-                     tgt->getMeshElement(i)->getNum());
+          Msg::Error("Slave element %lu is not an edge",
+                     (unsigned long)tgt->getMeshElement(i)->getNum());
           return;
         }
         for(int iVtx = 0; iVtx < 2; iVtx++) {
           MVertex *vtx = tgtLine->getVertex(iVtx);
           std::map<MVertex *, MVertex *>::iterator tIter = v2v.find(vtx);
           if(tIter == v2v.end()) {
-            Msg::Error("Cannot find periodic counterpart of vertex %d"
+            Msg::Error("Cannot find periodic counterpart of vertex %lu"
                        " of edge %d on edge %d",
-                       vtx->getNum(), tgt->tag(), src->tag());
+                       (unsigned long)vtx->getNum(), tgt->tag(), src->tag());
             return;
           }
           else
@@ -1292,11 +1453,12 @@ static void updatePeriodicEdgesAndFaces(GModel *m)
         std::map<MEdge, MLine *, Less_Edge>::iterator srcIter =
           srcEdges.find(MEdge(vtcs[0], vtcs[1]));
         if(srcIter == srcEdges.end()) {
-          Msg::Error("Can't find periodic counterpart of edge %d-%d on edge %d"
-                     ", connected to edge %d-%d on %d",
-                     tgtLine->getVertex(0)->getNum(),
-                     tgtLine->getVertex(1)->getNum(), tgt->tag(),
-                     vtcs[0]->getNum(), vtcs[1]->getNum(), src->tag());
+          Msg::Error("Can't find periodic counterpart of edge %lu-%lu on edge "
+                     "%d, connected to edge %lu-%lu on %d",
+                     (unsigned long)tgtLine->getVertex(0)->getNum(),
+                     (unsigned long)tgtLine->getVertex(1)->getNum(), tgt->tag(),
+                     (unsigned long)vtcs[0]->getNum(),
+                     (unsigned long)vtcs[1]->getNum(), src->tag());
           return;
         }
         else {
@@ -1358,9 +1520,9 @@ static void updatePeriodicEdgesAndFaces(GModel *m)
 
           std::map<MVertex *, MVertex *>::iterator tIter = v2v.find(vtx);
           if(tIter == v2v.end()) {
-            Msg::Error("Cannot find periodic counterpart of vertex %d"
+            Msg::Error("Cannot find periodic counterpart of vertex %lu"
                        " of surface %d on surface %d",
-                       vtx->getNum(), tgt->tag(), src->tag());
+                       (unsigned long)vtx->getNum(), tgt->tag(), src->tag());
             return;
           }
           else
@@ -1566,8 +1728,6 @@ void SetOrderN(GModel *m, int order, bool linear, bool incomplete,
 
   // - if onlyVisible is true, then only the visible entities will be curved.
 
-  int nPts = order - 1;
-
   char msg[256];
   sprintf(msg, "Meshing order %d (curvilinear %s)...", order,
           linear ? "off" : "on");
@@ -1583,35 +1743,60 @@ void SetOrderN(GModel *m, int order, bool linear, bool incomplete,
   faceContainer faceVertices;
   std::map<GEntity *, std::vector<MVertex *> > newHOVert;
 
+  // size the containers from the number of elements (each interior edge and
+  // face being shared by several elements)
+  std::size_t numEdges = 0, numFaces = 0;
+  for(GModel::eiter it = m->firstEdge(); it != m->lastEdge(); ++it)
+    numEdges += (*it)->lines.size();
+  for(GModel::fiter it = m->firstFace(); it != m->lastFace(); ++it) {
+    GFace *gf = *it;
+    numEdges += (3 * gf->triangles.size() + 4 * gf->quadrangles.size()) / 2;
+    numFaces += gf->triangles.size() + gf->quadrangles.size();
+  }
+  for(GModel::riter it = m->firstRegion(); it != m->lastRegion(); ++it) {
+    GRegion *gr = *it;
+    numEdges += (6 * gr->tetrahedra.size() + 12 * gr->hexahedra.size() +
+                 9 * gr->prisms.size() + 8 * gr->pyramids.size()) / 4;
+    numFaces += (4 * gr->tetrahedra.size() + 6 * gr->hexahedra.size() +
+                 5 * gr->prisms.size() + 5 * gr->pyramids.size()) / 2;
+  }
+  edgeVertices.reserve(numEdges);
+  if(!incomplete) faceVertices.reserve(numFaces);
+
   Msg::ResetProgressMeter();
 
   int counter = 0,
       nTot = m->getNumEdges() + m->getNumFaces() + m->getNumRegions();
 
+  std::vector<GEntity *> entities;
   for(GModel::eiter it = m->firstEdge(); it != m->lastEdge(); ++it) {
-    Msg::Info("Meshing curve %d order %d", (*it)->tag(), order);
-    Msg::ProgressMeter(++counter, nTot, false, msg);
-    if(onlyVisible && !(*it)->getVisibility()) continue;
-    setHighOrder(*it, newHOVert[*it], edgeVertices, linear, nPts);
+    if(onlyVisible && !(*it)->getVisibility())
+      Msg::ProgressMeter(++counter, nTot, false, msg);
+    else
+      entities.push_back(*it);
   }
+  setHighOrder(m, entities, newHOVert, edgeVertices, faceVertices, linear,
+               incomplete, order, msg, counter, nTot);
 
+  entities.clear();
   for(GModel::fiter it = m->firstFace(); it != m->lastFace(); ++it) {
-    Msg::Info("Meshing surface %d order %d", (*it)->tag(), order);
-    Msg::ProgressMeter(++counter, nTot, false, msg);
-    if(onlyVisible && !(*it)->getVisibility()) continue;
-    setHighOrder(*it, newHOVert[*it], edgeVertices, faceVertices, linear,
-                 incomplete, nPts);
-    if((*it)->getColumns() != 0) (*it)->getColumns()->clearElementData();
+    if(onlyVisible && !(*it)->getVisibility())
+      Msg::ProgressMeter(++counter, nTot, false, msg);
+    else
+      entities.push_back(*it);
   }
+  setHighOrder(m, entities, newHOVert, edgeVertices, faceVertices, linear,
+               incomplete, order, msg, counter, nTot);
 
+  entities.clear();
   for(GModel::riter it = m->firstRegion(); it != m->lastRegion(); ++it) {
-    Msg::Info("Meshing volume %d order %d", (*it)->tag(), order);
-    Msg::ProgressMeter(++counter, nTot, false, msg);
-    if(onlyVisible && !(*it)->getVisibility()) continue;
-    setHighOrder(*it, newHOVert[*it], edgeVertices, faceVertices, incomplete,
-                 nPts);
-    if((*it)->getColumns() != 0) (*it)->getColumns()->clearElementData();
+    if(onlyVisible && !(*it)->getVisibility())
+      Msg::ProgressMeter(++counter, nTot, false, msg);
+    else
+      entities.push_back(*it);
   }
+  setHighOrder(m, entities, newHOVert, edgeVertices, faceVertices, linear,
+               incomplete, order, msg, counter, nTot);
 
   // Update all high order vertices
   for(GModel::eiter it = m->firstEdge(); it != m->lastEdge(); ++it)
@@ -8,17 +8,146 @@
 
 #include "GModel.h"
 #include "MFace.h"
+#include "Hash.h"
+
+// open-addressing hash table (with linear probing) associating a list of
+// vertices to a mesh edge or face. The table can be sized up-front with
+// reserve() to avoid rehashing while the mesh is being processed. A table can
+// be given a parent table, whose entries are also returned by find() and
+// count() but are never modified: this allows to create the vertices of
+// disjoint sets of edges and faces in several private tables (e.g. one per
+// thread), that are then merged into the parent.
+template <class Key, class Hash, class Equal> class hoVertexContainer {
+public:
+  typedef std::pair<Key, std::vector<MVertex *> > value_type;
+  typedef value_type *iterator;
+
+private:
+  std::vector<value_type> _table;
+  std::vector<char> _used;
+  std::size_t _size;
+  hoVertexContainer *_parent;
+  // slot holding the key, or empty slot where it should be inserted
+  std::size_t _slot(const Key &key) const
+  {
+    const std::size_t mask = _table.size() - 1;
+    std::size_t i = Hash()(key) & mask;
+    while(_used[i] && !Equal()(_table[i].first, key)) i = (i + 1) & mask;
+    return i;
+  }
+  void _rehash(std::size_t capacity)
+  {
+    std::vector<value_type> table(capacity);
+    std::vector<char> used(capacity, 0);
+    _table.swap(table);
+    _used.swap(used);
+    for(std::size_t i = 0; i < table.size(); i++) {
+      if(!used[i]) continue;
+      std::size_t j = _slot(table[i].first);
+      _used[j] = 1;
+      _table[j].first = table[i].first;
+      _table[j].second.swap(table[i].second);
+    }
+  }
+
+public:
+  hoVertexContainer(hoVertexContainer *parent = 0) : _size(0), _parent(parent)
+  {
+  }
+  // make room for n entries (the load factor is kept below 1/2)
+  void reserve(std::size_t n)
+  {
+    std::size_t capacity = 16;
+    while(capacity < 2 * n) capacity *= 2;
+    if(capacity > _table.size()) _rehash(capacity);
+  }
+  std::size_t size() const { return _size; }
+  iterator end() const { return 0; }
+  iterator find(const Key &key)
+  {
+    if(_size) {
+      std::size_t i = _slot(key);
+      if(_used[i]) return &_table[i];
+    }
+    return _parent ? _parent->find(key) : end();
+  }
+  std::size_t count(const Key &key) { return find(key) ? 1 : 0; }
+  // entry of the key in this table (the parent is not searched), created if
+  // it does not exist
+  std::vector<MVertex *> &operator[](const Key &key)
+  {
+    if(2 * (_size + 1) > _table.size()) reserve(_size + 1);
+    std::size_t i = _slot(key);
+    if(!_used[i]) {
+      _used[i] = 1;
+      _table[i].first = key;
+      _size++;
+    }
+    return _table[i].second;
+  }
+  // move the entries of another table into this one; entries whose key
+  // already exists are left in the other table
+  void merge(hoVertexContainer &other)
+  {
+    if(!other._size) return;
+    reserve(_size + other._size);
+    for(std::size_t i = 0; i < other._table.size(); i++) {
+      if(!other._used[i]) continue;
+      std::size_t j = _slot(other._table[i].first);
+      if(_used[j]) continue;
+      _used[j] = 1;
+      _table[j].first = other._table[i].first;
+      _table[j].second.swap(other._table[i].second);
+      other._used[i] = 0;
+      other._size--;
+      _size++;
+    }
+    if(!other._size) {
+      std::vector<value_type>().swap(other._table);
+      std::vector<char>().swap(other._used);
+    }
+  }
+};
+
+// edges are hashed from the tags of their (sorted) vertices
+struct Hash_hoEdge {
+  std::size_t operator()(const std::pair<MVertex *, MVertex *> &e) const
+  {
+    std::size_t tags[2] = {e.first->getNum(), e.second->getNum()};
+    return HashFNV1a<sizeof(std::size_t[2])>::eval(tags);
+  }
+};
+
+struct Equal_hoEdge {
+  bool operator()(const std::pair<MVertex *, MVertex *> &e0,
+                  const std::pair<MVertex *, MVertex *> &e1) const
+  {
+    return e0 == e1;
+  }
+};
+
+// faces are hashed from the tags of their sorted vertices
+struct Hash_hoFace {
+  std::size_t operator()(const MFace &f) const
+  {
+    std::size_t tags[4] = {0, 0, 0, 0};
+    for(std::size_t i = 0; i < f.getNumVertices() && i < 4; i++)
+      tags[i] = f.getSortedVertex(i)->getNum();
+    return HashFNV1a<sizeof(std::size_t[4])>::eval(tags);
+  }
+};
 
 // for each pair of vertices (an edge), we build a list of vertices
 // that are the high order representation of the edge. The ordering of
 // vertices in the list is supposed to be (by construction) consistent
 // with the ordering of the pair.
-typedef std::map<std::pair<MVertex *, MVertex *>, std::vector<MVertex *> >
+typedef hoVertexContainer<std::pair<MVertex *, MVertex *>, Hash_hoEdge,
+                          Equal_hoEdge>
   edgeContainer;
 
 // for each face (a list of vertices) we build a list of vertices that
 // are the high order representation of the face
-typedef std::map<MFace, std::vector<MVertex *>, Less_Face> faceContainer;
+typedef hoVertexContainer<MFace, Hash_hoFace, Equal_Face> faceContainer;
 
 void SetOrder1(GModel *m, bool onlyVisible = false);
 void SetOrderN(GModel *m, int order, bool linear = true,
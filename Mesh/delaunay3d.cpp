@@ -894,7 +894,7 @@ static void print(const char *name, connContainer &conn, Vert *v)
   FILE *f = fopen(name, "w");
   fprintf(f, "View \"\"{\n");
 
-  if(v) fprintf(f, "SP(%g,%g,%g){%d};\n", v->x(), v->y(), v->z(), v->getNum());
+  if(v) fprintf(f, "SP(%g,%g,%g){%u};\n", v->x(), v->y(), v->z(), v->getNum());
 
   for(unsigned int i = 0; i < conn.size(); i++) {
     fprintf(f, "ST(%g,%g,%g,%g,%g,%g,%g,%g,%g){%g,%g,%g};\n",
@@ -985,12 +985,23 @@ static int checkLocalDelaunayness(tetContainer &c, int thread, char *msg)
 }
 */
 
-static Tet *randomTet(int thread, tetContainer &allocator)
+// reentrant pseudo-random generator (xorshift): unlike rand(), the sequence
+// does not depend on the other threads, so that the result is reproducible
+// when several volumes are meshed concurrently
+static unsigned int nextRandom(unsigned int &state)
+{
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+static Tet *randomTet(int thread, tetContainer &allocator, unsigned int &seed)
 {
   unsigned int N = allocator.size(thread);
   //  printf("coucou random TET %d %d\n",thread,N);
   while(1) {
-    Tet *t = allocator(thread, rand() % N);
+    Tet *t = allocator(thread, nextRandom(seed) % N);
     if(t->V[0]) return t;
   }
 }
@@ -1036,8 +1047,9 @@ void delaunayTrgl(const unsigned int numThreads,
     std::vector<bool> ok(NPTS_AT_ONCE);
     connContainer faceToTet;
     std::vector<Tet *> Choice(NPTS_AT_ONCE);
+    unsigned int seed = myThread + 1;
     for(unsigned int K = 0; K < NPTS_AT_ONCE; K++)
-      Choice[K] = randomTet(0, allocator);
+      Choice[K] = randomTet(0, allocator, seed);
 
     invalidCavities[myThread] = 0;
     for(unsigned int K = 0; K < NPTS_AT_ONCE; K++) {
@@ -1068,13 +1080,13 @@ void delaunayTrgl(const unsigned int numThreads,
 
         if(vToAdd[K]) {
           // In 3D, insertion of a point may lead to deletion of tets !!
-          if(!Choice[K]->V[0]) Choice[K] = randomTet(0, allocator);
+          if(!Choice[K]->V[0]) Choice[K] = randomTet(0, allocator, seed);
           while(1) {
             t[K] = walk(Choice[K], vToAdd[K], Npts, totSearch, myThread);
             if(t[K]) break;
             // the domain may not be convex. we then start from a random tet and
             // walk from there
-            Choice[K] = randomTet(0, allocator);
+            Choice[K] = randomTet(0, allocator, seed);
           }
         }
       }
@@ -1288,11 +1300,13 @@ void delaunayTriangulation(const int numThreads, const int nptsatonce,
 
   tetContainer allocator(numThreads, S.size() * 10);
 
+  const double r = d * CTX::instance()->mesh.randFactor3d / 4294967295.;
+  unsigned int seed = 1;
   for(unsigned int i = 0; i < N; i++) {
     MVertex *mv = S[i];
-    double dx = d * CTX::instance()->mesh.randFactor3d * (double)rand() / RAND_MAX;
-    double dy = d * CTX::instance()->mesh.randFactor3d * (double)rand() / RAND_MAX;
-    double dz = d * CTX::instance()->mesh.randFactor3d * (double)rand() / RAND_MAX;
+    double dx = r * nextRandom(seed);
+    double dy = r * nextRandom(seed);
+    double dz = r * nextRandom(seed);
     mv->x() += dx;
     mv->y() += dy;
     mv->z() += dz;
@@ -1301,7 +1315,13 @@ void delaunayTriangulation(const int numThreads, const int nptsatonce,
     _temp[v->getNum()] = mv;
   }
 
-  robustPredicates::exactinit(1, maxx, maxy, maxz);
+#if defined(_OPENMP)
+  // the static filters of the predicates are shared by all the threads: when
+  // several volumes are meshed concurrently, they are set once for the whole
+  // model before the volumes are meshed (see Mesh3D)
+  if(!omp_in_parallel())
+#endif
+    robustPredicates::exactinit(1, maxx, maxy, maxz);
 
   Vert *box[8];
   delaunayTriangulation(numThreads, nptsatonce, _vertices, box, allocator);
@@ -815,9 +815,10 @@ static bool recoverEdge(BDS_Mesh *m, GEdge *ge,
         else {
           if(_fatallyFailed) {
             Msg::Error(
-              "Unable to recover the edge %d (%d/%d) on curve %d (on surface %d)",
-              ge->lines[i]->getNum(), i + 1, ge->lines.size(), ge->tag(),
-              ge->faces().back()->tag());
+              "Unable to recover the edge %lu (%d/%d) on curve %d (on surface "
+              "%d)",
+              (unsigned long)ge->lines[i]->getNum(), i + 1,
+              (int)ge->lines.size(), ge->tag(), ge->faces().back()->tag());
             // outputScalarField(m->triangles, "wrongmesh.pos", 0);
             // outputScalarField(m->triangles, "wrongparam.pos", 1);
           }
@@ -1473,6 +1474,15 @@ bool meshGenerator(GFace *gf, int RECUR_ITER, bool repairSelfIntersecting1dMesh,
              edgesToRecover.size(), edgesNotRecovered.size());
 
   if(edgesNotRecovered.size() || gf->meshStatistics.refineAllEdges) {
+    // splitting the curves modifies the mesh of the neighboring surfaces,
+    // which is not thread safe: let the caller mesh this one serially
+    if(repairSelfIntersecting1dMesh && Msg::GetNumThreads() != 1) {
+      gf->meshStatistics.status = GFace::PENDING;
+      delete m;
+      Msg::Info("Surface %d has self-intersections in its 1D mesh: "
+                "serializing this one", gf->tag());
+      return true;
+    }
     std::ostringstream sstream;
     for(std::set<EdgeToRecover>::iterator itr = edgesNotRecovered.begin();
         itr != edgesNotRecovered.end(); ++itr)
@@ -2317,10 +2327,10 @@ static bool meshGeneratorPeriodic(GFace *gf, int RECUR_ITER,
                 }
               }
               if(pp == 0) {
-                Msg::Error("Embedded edge vertex %d is on the seam edge of "
+                Msg::Error("Embedded edge vertex %lu is on the seam edge of "
                            "surface %d and no appropriate point could be "
                            "found!",
-                           v->getNum(), gf->tag());
+                           (unsigned long)v->getNum(), gf->tag());
               }
             }
             else {
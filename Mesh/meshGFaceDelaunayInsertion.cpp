@@ -2405,7 +2405,8 @@ void recoverEdges(std::vector<MTri3 *> &t, std::vector<MEdge> &edges)
   for(unsigned int i = 0; i < edgesToRecover.size(); i++) {
     MVertex *mstart = edgesToRecover[i].getVertex(0);
     MVertex *mend = edgesToRecover[i].getVertex(1);
-    Msg::Info("recovering edge %d %d", mstart->getNum(), mend->getNum());
+    Msg::Info("recovering edge %lu %lu", (unsigned long)mstart->getNum(),
+              (unsigned long)mend->getNum());
     // int iter;
     while(recoverEdgeBySwaps(t, mstart, mend, edges)) {
       // iter ++;
@@ -920,7 +920,7 @@ int removeDiamonds(GFace *gf)
     if(!x) break;
     nbRemove += x;
   }
-  Msg::Debug("%i diamond quads removed", nbRemove);
+  Msg::Debug("%lu diamond quads removed", (unsigned long)nbRemove);
   return nbRemove;
 }
 
@@ -1068,8 +1068,8 @@ bool edgeSwap(std::set<swapquad> &configs, MTri3 *t1, GFace *gf, int iLocalEdge,
       v4 = t2->tri()->getVertex(i);
 
   if(!v4) {
-    printf("%d %d %d\n", v1->getNum(), v2->getNum(), v3->getNum());
-    printf("%d %d %d\n", t2->tri()->getVertex(0)->getNum(),
+    printf("%lu %lu %lu\n", v1->getNum(), v2->getNum(), v3->getNum());
+    printf("%lu %lu %lu\n", t2->tri()->getVertex(0)->getNum(),
            t2->tri()->getVertex(1)->getNum(),
            t2->tri()->getVertex(2)->getNum());
   }
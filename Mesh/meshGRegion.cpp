@@ -49,13 +49,20 @@ void splitQuadRecovery::add(const MFace &f, MVertex *v, GFace *gf)
   _tri[f3] = gf;
 }
 
-int splitQuadRecovery::buildPyramids(GModel *gm)
+int splitQuadRecovery::buildPyramids(GModel *gm,
+                                     const std::vector<GRegion *> *domain)
 {
   if(_quad.empty()) return 0;
 
   Msg::Info("Generating pyramids for hybrid mesh...");
+  std::vector<GRegion *> regions;
+  if(domain)
+    regions = *domain;
+  else
+    regions.assign(gm->firstRegion(), gm->lastRegion());
   int npyram = 0;
-  for(GModel::riter it = gm->firstRegion(); it != gm->lastRegion(); it++){
+  for(std::vector<GRegion *>::iterator it = regions.begin();
+      it != regions.end(); it++){
     GRegion *gr = *it;
     if(gr->meshAttributes.method == MESH_TRANSFINITE) continue;
     if(gr->geomType() == GEntity::DiscreteVolume) continue;
@@ -91,7 +98,8 @@ int splitQuadRecovery::buildPyramids(GModel *gm)
   return npyram;
 }
 
-void MeshDelaunayVolume(std::vector<GRegion *> &regions)
+void MeshDelaunayVolume(std::vector<GRegion *> &regions,
+                        const std::vector<GRegion *> *domain)
 {
   if(regions.empty()) return;
 
@@ -162,10 +170,10 @@ void MeshDelaunayVolume(std::vector<GRegion *> &regions)
     refineMeshMMG(gr);
   }
   else{
-    insertVerticesInRegion(gr, 2000000000, true, &sqr);
+    insertVerticesInRegion(gr, 2000000000, true, &sqr, domain);
   }
 
-  if(sqr.buildPyramids(gr->model())){
+  if(sqr.buildPyramids(gr->model(), domain)){
     Msg::Info("Optimizing pyramids for hybrid mesh...");
     RelocateVertices(regions, 3);
     Msg::Info("Done optimizing pyramids for hybrid mesh");
@@ -219,13 +227,20 @@ void optimizeMeshGRegion::operator()(GRegion *gr, bool always)
 }
 
 bool buildFaceSearchStructure(GModel *model, fs_cont &search,
-                              bool onlyTriangles)
+                              bool onlyTriangles,
+                              const std::vector<GRegion *> *domain)
 {
   search.clear();
 
+  std::vector<GRegion *> regions;
+  if(domain)
+    regions = *domain;
+  else
+    regions.assign(model->firstRegion(), model->lastRegion());
+
   std::set<GFace *> faces_to_consider;
-  GModel::riter rit = model->firstRegion();
-  while(rit != model->lastRegion()) {
+  std::vector<GRegion *>::iterator rit = regions.begin();
+  while(rit != regions.end()) {
     std::vector<GFace *> _faces = (*rit)->faces();
     faces_to_consider.insert(_faces.begin(), _faces.end());
     rit++;
@@ -50,7 +50,12 @@ public:
   void operator()(GRegion *);
 };
 
-void MeshDelaunayVolume(std::vector<GRegion *> &delaunay);
+// mesh the regions with the 3D Delaunay-based algorithms; if domain is given,
+// it should contain the regions and all the regions with which they share a
+// face, a curve or a point: only the mesh of the domain is then accessed, so
+// that independent domains can be meshed concurrently
+void MeshDelaunayVolume(std::vector<GRegion *> &delaunay,
+                        const std::vector<GRegion *> *domain = 0);
 bool CreateAnEmptyVolumeMesh(GRegion *gr);
 int MeshTransfiniteVolume(GRegion *gr);
 int SubdivideExtrudedMesh(GModel *m);
@@ -64,7 +69,11 @@ GFace *findInFaceSearchStructure(MVertex *p1, MVertex *p2, MVertex *p3,
 GFace *findInFaceSearchStructure(const MFace &f, const fs_cont &search);
 GEdge *findInEdgeSearchStructure(MVertex *p1, MVertex *p2,
                                  const es_cont &search);
-bool buildFaceSearchStructure(GModel *model, fs_cont &search, bool onlyTriangles = false);
+// if domain is given, only the faces of the regions in the domain are
+// considered, instead of the faces of all the regions in the model
+bool buildFaceSearchStructure(GModel *model, fs_cont &search,
+                              bool onlyTriangles = false,
+                              const std::vector<GRegion *> *domain = 0);
 bool buildEdgeSearchStructure(GModel *model, es_cont &search);
 
 // hybrid mesh recovery structure
@@ -77,7 +86,7 @@ public:
   void add(const MFace &f, MVertex *v, GFace *gf);
   std::map<MFace, GFace *, Less_Face> &getTri() { return _tri; }
   std::map<MFace, MVertex *, Less_Face> &getQuad() { return _quad; }
-  int buildPyramids(GModel *gm);
+  int buildPyramids(GModel *gm, const std::vector<GRegion *> *domain = 0);
 };
 
 // adapt the mesh of a region
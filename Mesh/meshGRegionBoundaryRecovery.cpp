@@ -41,6 +41,10 @@ typedef unsigned long intptr_t;
 #include "drawContext.h"
 #endif
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 namespace tetgenBR {
 
 #define REAL double
@@ -1266,25 +1270,27 @@ bool meshGRegionBoundaryRecovery(GRegion *gr, splitQuadRecovery *sqr)
       int etags[2] = {tetgenBR::sevent.s_marker1, tetgenBR::sevent.s_marker2};
       std::ostringstream pb;
       std::vector<double> x, y, z, val;
+      std::vector<GEntity *> ents;
+      std::vector<MVertex *> verts;
       for(int f = 0; f < 2; f++) {
         if(ftags[f] > 0) {
           GFace *gf = gr->model()->getFaceByTag(ftags[f]);
           if(gf) {
-            gr->model()->addLastMeshEntityError(gf);
+            ents.push_back(gf);
             pb << " surface " << ftags[f];
           }
         }
         if(etags[f] > 0) {
           GEdge *ge = gr->model()->getEdgeByTag(etags[f]);
           if(ge) {
-            gr->model()->addLastMeshEntityError(ge);
+            ents.push_back(ge);
             pb << " curve " << etags[f];
           }
         }
         for(int i = 0; i < 3; i++) {
           MVertex *v = all[vtags[f][i]];
           if(v) {
-            gr->model()->addLastMeshVertexError(v);
+            verts.push_back(v);
             x.push_back(v->x());
             y.push_back(v->y());
             z.push_back(v->z());
@@ -1304,12 +1310,29 @@ bool meshGRegionBoundaryRecovery(GRegion *gr, splitQuadRecovery *sqr)
       }
       Msg::Error("Invalid boundary mesh (%s) on%s", what.c_str(),
                  pb.str().c_str());
+      // boundary recovery can run concurrently on several regions: the error
+      // lists of the model and the list of views are shared
+#if defined(_OPENMP)
+#pragma omp critical(MeshErrorReport)
+#endif
+      {
+        for(std::size_t i = 0; i < ents.size(); i++)
+          gr->model()->addLastMeshEntityError(ents[i]);
+        for(std::size_t i = 0; i < verts.size(); i++)
+          gr->model()->addLastMeshVertexError(verts[i]);
 #if defined(HAVE_POST)
-      new PView("Boundary mesh issue", x, y, z, val);
-#if defined(HAVE_FLTK)
-      if(FlGui::available()) FlGui::instance()->updateViews(true, true);
-      drawContext::global()->draw();
+        new PView("Boundary mesh issue", x, y, z, val);
 #endif
+      }
+#if defined(HAVE_POST) && defined(HAVE_FLTK)
+#if defined(_OPENMP)
+      // the graphics can only be updated from the main thread
+      if(!omp_in_parallel())
+#endif
+      {
+        if(FlGui::available()) FlGui::instance()->updateViews(true, true);
+        drawContext::global()->draw();
+      }
 #endif
       ret = false;
     }
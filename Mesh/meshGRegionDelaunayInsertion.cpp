@@ -630,12 +630,13 @@ static void completeTheSetOfFaces(GModel *model, std::set<GFace *> &faces_bound)
 }
 
 GRegion *getRegionFromBoundingFaces(GModel *model,
+                                    const std::vector<GRegion *> &regions,
                                     std::set<GFace *> &faces_bound)
 {
   completeTheSetOfFaces (model, faces_bound);
 
-  GModel::riter git = model->firstRegion();
-  while(git != model->lastRegion()) {
+  std::vector<GRegion *>::const_iterator git = regions.begin();
+  while(git != regions.end()) {
     GRegion *gr = *git;
     ExtrudeParams *ep = gr->meshAttributes.extrude;
     if((ep && ep->mesh.ExtrudeMesh) ||
@@ -1255,10 +1256,31 @@ int isCavityCompatibleWithEmbeddedFace(
 }
 
 void insertVerticesInRegion(GRegion *gr, int maxVert, bool _classify,
-                            splitQuadRecovery *sqr)
+                            splitQuadRecovery *sqr,
+                            const std::vector<GRegion *> *domain)
 {
   //  TEST_IF_BOUNDARY_IS_RECOVERED (gr);
 
+  // regions (and their faces) whose mesh is taken into account: the whole
+  // model, or only the given domain if the region is meshed concurrently with
+  // other, independent, domains
+  std::vector<GRegion *> regions;
+  if(domain)
+    regions = *domain;
+  else
+    regions.assign(gr->model()->firstRegion(), gr->model()->lastRegion());
+  std::set<GFace *, GEntityLessThan> faces;
+  if(domain) {
+    for(std::size_t i = 0; i < regions.size(); i++) {
+      std::vector<GFace *> const &f = regions[i]->faces();
+      std::vector<GFace *> const &f_e = regions[i]->embeddedFaces();
+      faces.insert(f.begin(), f.end());
+      faces.insert(f_e.begin(), f_e.end());
+    }
+  }
+  else
+    faces.insert(gr->model()->firstFace(), gr->model()->lastFace());
+
   // printf("sizeof MTet4 = %d sizeof MTetrahedron %d sizeof(MVertex) %d\n",
   //       sizeof(MTet4), sizeof(MTetrahedron), sizeof(MVertex));
 
@@ -1272,8 +1294,8 @@ void insertVerticesInRegion(GRegion *gr, int maxVert, bool _classify,
     std::map<MVertex *, double, MVertexLessThanNum> vSizesMap;
     std::set<MVertex *, MVertexLessThanNum> bndVertices;
 
-    for(GModel::riter rit = gr->model()->firstRegion();
-        rit != gr->model()->lastRegion(); ++rit) {
+    for(std::vector<GRegion *>::iterator rit = regions.begin();
+        rit != regions.end(); ++rit) {
       std::vector<GEdge *> const &e = (*rit)->embeddedEdges();
       for(std::vector<GEdge *>::const_iterator it = e.begin(); it != e.end();
           ++it) {
@@ -1297,8 +1319,8 @@ void insertVerticesInRegion(GRegion *gr, int maxVert, bool _classify,
       }
     }
 
-    for(GModel::riter rit = gr->model()->firstRegion();
-        rit != gr->model()->lastRegion(); ++rit) {
+    for(std::vector<GRegion *>::iterator rit = regions.begin();
+        rit != regions.end(); ++rit) {
       std::vector<GVertex *> const &vertices = (*rit)->embeddedVertices();
       for(std::vector<GVertex *>::const_iterator it = vertices.begin();
           it != vertices.end(); ++it) {
@@ -1310,8 +1332,8 @@ void insertVerticesInRegion(GRegion *gr, int maxVert, bool _classify,
       }
     }
 
-    for(GModel::fiter it = gr->model()->firstFace();
-        it != gr->model()->lastFace(); ++it) {
+    for(std::set<GFace *, GEntityLessThan>::iterator it = faces.begin();
+        it != faces.end(); ++it) {
       GFace *gf = *it;
       for(unsigned int i = 0; i < gf->triangles.size(); i++) {
         setLcs(gf->triangles[i], vSizesMap, bndVertices);
@@ -1344,7 +1366,8 @@ void insertVerticesInRegion(GRegion *gr, int maxVert, bool _classify,
 
   if(_classify) {
     fs_cont search;
-    buildFaceSearchStructure(gr->model(), search, true); // only triangles
+    // only triangles
+    buildFaceSearchStructure(gr->model(), search, true, domain);
     if(sqr)
       search.insert(sqr->getTri().begin(), sqr->getTri().end());
 
@@ -1363,7 +1386,7 @@ void insertVerticesInRegion(GRegion *gr, int maxVert, bool _classify,
           "found %d tets with %d faces (%g sec for the classification)",
           theRegion.size(), faces_bound.size(), _t2 - _t1);
         GRegion *myGRegion =
-          getRegionFromBoundingFaces(gr->model(), faces_bound);
+          getRegionFromBoundingFaces(gr->model(), regions, faces_bound);
         if(myGRegion) { // a geometrical region associated to the list of faces
                         // has been found
           Msg::Info("Found region %d", myGRegion->tag());
@@ -1411,8 +1434,8 @@ void insertVerticesInRegion(GRegion *gr, int maxVert, bool _classify,
   // store all embedded faces
   std::set<MFace, Less_Face> allEmbeddedFaces;
   edgeContainerB allEmbeddedEdges;
-  for(GModel::riter it = gr->model()->firstRegion();
-      it != gr->model()->lastRegion(); ++it) {
+  for(std::vector<GRegion *>::iterator it = regions.begin();
+      it != regions.end(); ++it) {
     createAllEmbeddedFaces((*it), allEmbeddedFaces);
     createAllEmbeddedEdges((*it), allEmbeddedEdges);
   }
@@ -219,7 +219,8 @@ void connectTets(std::list<MTet4 *> &, const std::set<MFace, Less_Face> * = 0);
 void connectTets(std::vector<MTet4 *> &, const std::set<MFace, Less_Face> * = 0);
 void delaunayMeshIn3D(std::vector<MVertex *> &, std::vector<MTetrahedron *> &);
 void insertVerticesInRegion(GRegion *gr, int maxVert = 2000000000,
-                            bool _classify = true, splitQuadRecovery *sqr = 0);
+                            bool _classify = true, splitQuadRecovery *sqr = 0,
+                            const std::vector<GRegion *> *domain = 0);
 void bowyerWatsonFrontalLayers(GRegion *gr, bool hex);
 
 struct compareTet4Ptr {
@@ -4,6 +4,7 @@
 // bugs and problems to the public mailing list <gmsh@geuz.org>.
 
 #include <limits>
+#include <map>
 #include "qualityMeasuresJacobian.h"
 #include "MElement.h"
 #include "BasisFactory.h"
@@ -389,6 +390,298 @@ namespace jacobianBasedQuality {
     return _getMinAndDeleteDomains(domains);
   }
 
+  // Batched versions
+
+  static const std::size_t blockSize = 64;
+
+  // split the given elements in blocks of at most blockSize elements of the
+  // same type
+  static void _getBlocks(const std::vector<MElement *> &elements,
+                         const std::vector<std::size_t> &indices,
+                         std::vector<std::vector<std::size_t> > &blocks)
+  {
+    std::map<int, std::vector<std::size_t> > types;
+    for(std::size_t i = 0; i < indices.size(); i++)
+      types[elements[indices[i]]->getTypeForMSH()].push_back(indices[i]);
+    for(std::map<int, std::vector<std::size_t> >::iterator it = types.begin();
+        it != types.end(); ++it) {
+      const std::vector<std::size_t> &idx = it->second;
+      for(std::size_t i = 0; i < idx.size(); i += blockSize)
+        blocks.push_back(std::vector<std::size_t>(
+          idx.begin() + i, idx.begin() + std::min(i + blockSize, idx.size())));
+    }
+  }
+
+  // node coordinates of a block of elements, one column per element
+  static void _getNodes(const std::vector<MElement *> &elements,
+                        const std::vector<std::size_t> &block,
+                        fullMatrix<double> &nodesX, fullMatrix<double> &nodesY,
+                        fullMatrix<double> &nodesZ)
+  {
+    const int numNodes = elements[block[0]]->getNumVertices();
+    nodesX.resize(numNodes, block.size());
+    nodesY.resize(numNodes, block.size());
+    nodesZ.resize(numNodes, block.size());
+    for(std::size_t k = 0; k < block.size(); k++) {
+      MElement *el = elements[block[k]];
+      for(int i = 0; i < numNodes; i++) {
+        const MVertex *v = el->getVertex(i);
+        nodesX(i, k) = v->x();
+        nodesY(i, k) = v->y();
+        nodesZ(i, k) = v->z();
+      }
+    }
+  }
+
+  void minMaxJacobianDeterminant(const std::vector<MElement *> &elements,
+                                 std::vector<double> &min,
+                                 std::vector<double> &max,
+                                 const fullMatrix<double> *normals)
+  {
+    min.assign(elements.size(), 99);
+    max.assign(elements.size(), -99);
+
+    std::vector<std::size_t> indices(elements.size());
+    for(std::size_t i = 0; i < elements.size(); i++) indices[i] = i;
+    std::vector<std::vector<std::size_t> > blocks;
+    _getBlocks(elements, indices, blocks);
+
+    std::vector<const JacobianBasis *> jfs(blocks.size());
+    std::vector<const bezierBasis *> bfs(blocks.size());
+    for(std::size_t b = 0; b < blocks.size(); b++) {
+      MElement *el = elements[blocks[b][0]];
+      jfs[b] = el->getJacobianFuncSpace();
+      if(!jfs[b]) {
+        Msg::Error(
+          "Jacobian function space not implemented for type of element %d",
+          el->getTypeForMSH());
+        continue;
+      }
+      bfs[b] = jfs[b]->getBezier();
+    }
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(size_t b = 0; b < blocks.size(); b++) {
+      if(!jfs[b]) continue;
+      const std::vector<std::size_t> &block = blocks[b];
+      fullMatrix<double> nodesX, nodesY, nodesZ;
+      _getNodes(elements, block, nodesX, nodesY, nodesZ);
+
+      const int numJacNodes = jfs[b]->getNumJacNodes();
+      fullMatrix<double> coeffLag(numJacNodes, block.size());
+      fullMatrix<double> coeffBez(numJacNodes, block.size());
+      jfs[b]->getSignedJacobian(nodesX, nodesY, nodesZ, coeffLag, normals);
+      jfs[b]->lag2Bez(coeffLag, coeffBez);
+
+      for(std::size_t k = 0; k < block.size(); k++) {
+        fullVector<double> coeff(numJacNodes);
+        for(int i = 0; i < numJacNodes; i++) coeff(i) = coeffBez(i, k);
+
+        std::vector<_CoeffData *> domains;
+        domains.push_back(new _CoeffDataJac(coeff, bfs[b], 0));
+        _subdivideDomains(domains);
+
+        double &mn = min[block[k]], &mx = max[block[k]];
+        mn = domains[0]->minB();
+        mx = domains[0]->maxB();
+        delete domains[0];
+        for(std::size_t i = 1; i < domains.size(); ++i) {
+          mn = std::min(mn, domains[i]->minB());
+          mx = std::max(mx, domains[i]->maxB());
+          delete domains[i];
+        }
+      }
+    }
+  }
+
+  // function spaces of the Jacobian matrix and determinant used by the IGE
+  // and ICN measures
+  static bool _getMeasureSpaces(MElement *el, FuncSpaceData &jacMatSpace,
+                                FuncSpaceData &jacDetSpace)
+  {
+    const int order = el->getPolynomialOrder();
+    const int jacOrder = order * el->getDim();
+    const bool serendipFalse = false;
+    switch(el->getType()) {
+    case TYPE_TRI:
+      jacMatSpace = FuncSpaceData(el, order - 1, &serendipFalse);
+      jacDetSpace = FuncSpaceData(el, jacOrder - 2, &serendipFalse);
+      return true;
+    case TYPE_TET:
+      jacMatSpace = FuncSpaceData(el, order - 1, &serendipFalse);
+      jacDetSpace = FuncSpaceData(el, jacOrder - 3, &serendipFalse);
+      return true;
+    case TYPE_QUA:
+    case TYPE_HEX:
+    case TYPE_PRI:
+      jacMatSpace = FuncSpaceData(el, order, &serendipFalse);
+      jacDetSpace = FuncSpaceData(el, jacOrder, &serendipFalse);
+      return true;
+    case TYPE_PYR:
+      jacMatSpace = FuncSpaceData(el, false, order, order - 1, &serendipFalse);
+      jacDetSpace =
+        FuncSpaceData(el, false, jacOrder, jacOrder - 3, &serendipFalse);
+      return true;
+    default: return false;
+    }
+  }
+
+  // minimum of the IGE measure (if ideal is false) or of the ICN measure (if
+  // ideal is true) of a list of elements
+  static void _minMeasure(const std::vector<MElement *> &elements,
+                          std::vector<double> &result, bool knownValid,
+                          bool reversedOk, const fullMatrix<double> *normals,
+                          bool ideal)
+  {
+    result.assign(elements.size(), 0);
+
+    // computation of the measure should never be performed for invalid
+    // elements (for which the measure is 0)
+    std::vector<char> reversed(elements.size(), 0);
+    std::vector<std::size_t> indices;
+    indices.reserve(elements.size());
+    if(!knownValid) {
+      std::vector<double> jmin, jmax;
+      minMaxJacobianDeterminant(elements, jmin, jmax, normals);
+      for(std::size_t i = 0; i < elements.size(); i++) {
+        if(jmax[i] < 0) {
+          if(!reversedOk) continue;
+          reversed[i] = 1;
+        }
+        else if(jmin[i] <= 0)
+          continue;
+        indices.push_back(i);
+      }
+    }
+    else {
+      for(std::size_t i = 0; i < elements.size(); i++) indices.push_back(i);
+    }
+
+    std::vector<std::vector<std::size_t> > blocks;
+    _getBlocks(elements, indices, blocks);
+
+    std::vector<const GradientBasis *> gradBasis(blocks.size());
+    std::vector<const JacobianBasis *> jacBasis(blocks.size());
+    std::vector<const bezierBasis *> bfsMat(blocks.size());
+    std::vector<const bezierBasis *> bfsDet(blocks.size());
+    for(std::size_t b = 0; b < blocks.size(); b++) {
+      MElement *el = elements[blocks[b][0]];
+      FuncSpaceData jacMatSpace, jacDetSpace;
+      if(!_getMeasureSpaces(el, jacMatSpace, jacDetSpace)) {
+        Msg::Error("%s not implemented for type of element %d",
+                   ideal ? "ICN" : "IGE measure", el->getType());
+        for(std::size_t k = 0; k < blocks[b].size(); k++)
+          result[blocks[b][k]] = -1;
+        continue;
+      }
+      gradBasis[b] = BasisFactory::getGradientBasis(jacMatSpace);
+      jacBasis[b] = BasisFactory::getJacobianBasis(jacDetSpace);
+      bfsMat[b] = gradBasis[b]->getBezier();
+      bfsDet[b] = jacBasis[b]->getBezier();
+      // the raisers used by the measures are built on first use: build them
+      // before the parallel loop, as the bases above
+      bfsMat[b]->getRaiser();
+      bfsDet[b]->getRaiser();
+    }
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(size_t b = 0; b < blocks.size(); b++) {
+      if(!jacBasis[b]) continue;
+      const std::vector<std::size_t> &block = blocks[b];
+      const int nb = block.size();
+      const int type = elements[block[0]]->getType();
+      const int numMatCol = elements[block[0]]->getDim() == 2 ? 6 : 9;
+      fullMatrix<double> nodesX, nodesY, nodesZ;
+      _getNodes(elements, block, nodesX, nodesY, nodesZ);
+
+      // Bezier coefficients of the Jacobian determinant
+      const int numDet = jacBasis[b]->getNumJacNodes();
+      fullMatrix<double> detBez(numDet, nb);
+      {
+        fullMatrix<double> detLag(numDet, nb);
+        if(ideal)
+          jacBasis[b]->getSignedIdealJacobian(nodesX, nodesY, nodesZ, detLag,
+                                              normals);
+        else
+          jacBasis[b]->getSignedJacobian(nodesX, nodesY, nodesZ, detLag,
+                                         normals);
+        jacBasis[b]->lag2Bez(detLag, detBez);
+      }
+
+      // Bezier coefficients of the Jacobian matrix: the gradients with
+      // respect to each reference coordinate are computed for all the
+      // elements at once, with the coordinates of element k in columns 3 * k
+      // to 3 * k + 2
+      const int numMat = gradBasis[b]->getNumSamplingPoints();
+      const int numNodes = nodesX.size1();
+      fullMatrix<double> nodesXYZ(numNodes, 3 * nb);
+      for(int k = 0; k < nb; k++) {
+        for(int i = 0; i < numNodes; i++) {
+          nodesXYZ(i, 3 * k) = nodesX(i, k);
+          nodesXYZ(i, 3 * k + 1) = nodesY(i, k);
+          nodesXYZ(i, 3 * k + 2) = nodesZ(i, k);
+        }
+      }
+      fullMatrix<double> matBez[3];
+      for(int d = 0; d < numMatCol / 3; d++) {
+        const fullMatrix<double> *gSMat[3];
+        if(ideal) {
+          gSMat[0] = &gradBasis[b]->gradShapeIdealMatX;
+          gSMat[1] = &gradBasis[b]->gradShapeIdealMatY;
+          gSMat[2] = &gradBasis[b]->gradShapeIdealMatZ;
+        }
+        else {
+          gSMat[0] = &gradBasis[b]->gradShapeMatX;
+          gSMat[1] = &gradBasis[b]->gradShapeMatY;
+          gSMat[2] = &gradBasis[b]->gradShapeMatZ;
+        }
+        fullMatrix<double> matLag(numMat, 3 * nb);
+        gSMat[d]->mult(nodesXYZ, matLag);
+        matBez[d].resize(numMat, 3 * nb);
+        gradBasis[b]->lag2Bez(matLag, matBez[d]);
+      }
+
+      for(int k = 0; k < nb; k++) {
+        fullVector<double> coeffDetBez(numDet);
+        for(int i = 0; i < numDet; i++) coeffDetBez(i) = detBez(i, k);
+        if(reversed[block[k]]) coeffDetBez.scale(-1);
+
+        fullMatrix<double> coeffMatBez(numMat, numMatCol);
+        for(int j = 0; j < numMatCol; j++)
+          for(int i = 0; i < numMat; i++)
+            coeffMatBez(i, j) = matBez[j / 3](i, 3 * k + j % 3);
+
+        std::vector<_CoeffData *> domains;
+        if(ideal)
+          domains.push_back(new _CoeffDataICN(coeffDetBez, coeffMatBez,
+                                              bfsDet[b], bfsMat[b], 0));
+        else
+          domains.push_back(new _CoeffDataIGE(coeffDetBez, coeffMatBez,
+                                              bfsDet[b], bfsMat[b], 0, type));
+        _subdivideDomains(domains);
+        result[block[k]] = _getMinAndDeleteDomains(domains);
+      }
+    }
+  }
+
+  void minIGEMeasure(const std::vector<MElement *> &elements,
+                     std::vector<double> &ige, bool knownValid,
+                     bool reversedOk, const fullMatrix<double> *normals)
+  {
+    _minMeasure(elements, ige, knownValid, reversedOk, normals, false);
+  }
+
+  void minICNMeasure(const std::vector<MElement *> &elements,
+                     std::vector<double> &icn, bool knownValid,
+                     bool reversedOk, const fullMatrix<double> *normals)
+  {
+    _minMeasure(elements, icn, knownValid, reversedOk, normals, true);
+  }
+
   void sampleIGEMeasure(MElement *el, int deg, double &min, double &max)
   {
     fullVector<double> ige;
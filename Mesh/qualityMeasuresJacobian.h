@@ -23,6 +23,25 @@ namespace jacobianBasedQuality {
   double minICNMeasure(MElement *el, bool knownValid = false,
                        bool reversedOk = false,
                        const fullMatrix<double> *normals = NULL);
+
+  // Same as above for a list of elements: the elements are processed by
+  // blocks of elements of the same type, whose Jacobian determinants and
+  // gradients are computed with one matrix product per block, and the blocks
+  // (with the Bezier subdivision of their elements) are distributed over the
+  // threads. The results are stored in the order of the elements.
+  void minMaxJacobianDeterminant(const std::vector<MElement *> &el,
+                                 std::vector<double> &min,
+                                 std::vector<double> &max,
+                                 const fullMatrix<double> *normals = NULL);
+  void minIGEMeasure(const std::vector<MElement *> &el,
+                     std::vector<double> &ige, bool knownValid = false,
+                     bool reversedOk = false,
+                     const fullMatrix<double> *normals = NULL);
+  void minICNMeasure(const std::vector<MElement *> &el,
+                     std::vector<double> &icn, bool knownValid = false,
+                     bool reversedOk = false,
+                     const fullMatrix<double> *normals = NULL);
+
   void sampleIGEMeasure(MElement *el, int order, double &min, double &max);
   void sampleJacobian(MElement *el, int order, fullVector<double> &jac,
                       const fullMatrix<double> *normals = NULL);
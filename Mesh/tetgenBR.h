@@ -1544,15 +1544,14 @@ public:
   int s_marker2; // Tag of the 2nd segment.
   int f_vertices2[3];
   REAL int_point[3];
-  selfint_event()
-  {
-    e_type = 0;
-    f_marker1 = f_marker2 = 0;
-    s_marker1 = s_marker2 = 0;
-  }
 };
 
+// no constructor, so that it can be thread-private (being static, it is zero
+// initialized)
 static selfint_event sevent;
+#if defined(_OPENMP)
+#pragma omp threadprivate(sevent)
+#endif
 
 inline void terminatetetgen(tetgenmesh *m, int x)
 {
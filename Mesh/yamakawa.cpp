@@ -3318,7 +3318,8 @@ void PostOp::writeMSH(const char *filename, std::vector<MElement *> &elements)
   fprintf(f, "$Elements\n");
   fprintf(f, "%d\n", (int)elements.size());
   for(std::size_t i = 0; i < elements.size(); ++i) {
-    fprintf(f, "%d %d 0", elements[i]->getNum(), elements[i]->getTypeForMSH());
+    fprintf(f, "%lu %d 0", (unsigned long)elements[i]->getNum(),
+            elements[i]->getTypeForMSH());
     for(std::size_t k = 0; k < elements[i]->getNumVertices(); ++k)
       fprintf(f, " %d", elements[i]->getVertex(k)->getIndex());
     fprintf(f, "\n");
@@ -4183,9 +4184,9 @@ void PostOp::trihedra(MVertex *a, MVertex *b, MVertex *c, MVertex *d,
     if(diag1a.size() != 1 || diag1b.size() != 1 || diag2a.size() != 0 ||
        diag2b.size() != 0)
       Msg::Error("Quad face neighbor with %i+%i triangular faces (other "
-                 "diagonal: %i+%i) Trihedron: %i",
+                 "diagonal: %i+%i) Trihedron: %lu",
                  diag1a.size(), diag1b.size(), diag2a.size(), diag2b.size(),
-                 trih->getNum());
+                 (unsigned long)trih->getNum());
     gr->addTrihedron(trih);
   }
   else if(diag2a.size() == 1 || diag2b.size() == 1) {
@@ -4193,9 +4194,9 @@ void PostOp::trihedra(MVertex *a, MVertex *b, MVertex *c, MVertex *d,
     if(diag1a.size() != 0 || diag1b.size() != 0 || diag2a.size() != 1 ||
        diag2b.size() != 1)
       Msg::Error("Quad face neighbor with %i+%i triangular faces (other "
-                 "diagonal: %i+%i) Trihedron: %i",
+                 "diagonal: %i+%i) Trihedron: %lu",
                  diag2a.size(), diag2b.size(), diag1a.size(), diag1b.size(),
-                 trih->getNum());
+                 (unsigned long)trih->getNum());
     gr->addTrihedron(trih);
   }
 }
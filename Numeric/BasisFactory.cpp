@@ -12,24 +12,94 @@
 #include "CondNumBasis.h"
 #include "JacobianBasis.h"
 #include <map>
+#include <vector>
 #include <cstddef>
 
-std::map<int, nodalBasis *> BasisFactory::fs;
-std::map<int, CondNumBasis *> BasisFactory::cs;
-std::map<FuncSpaceData, JacobianBasis *> BasisFactory::js;
-std::map<FuncSpaceData, bezierBasis *> BasisFactory::bs;
-std::map<FuncSpaceData, GradientBasis *> BasisFactory::gs;
+// Registry of the bases of one kind. The bases are stored in a map that is
+// never modified once it has been published: a new basis is added by
+// publishing an updated copy of the map. Lookups thus only need to read the
+// pointer to the current map, without taking any lock. The previous maps are
+// kept until the registry is cleared, as other threads may still be reading
+// them; this costs little since only a few tens of bases are usually built.
+template <class Key, class Basis> class basisRegistry {
+private:
+  typedef std::map<Key, Basis *> basisMap;
+  basisMap *_current;
+  std::vector<basisMap *> _previous;
+
+public:
+  basisRegistry() : _current(new basisMap) {}
+  ~basisRegistry()
+  {
+    for(std::size_t i = 0; i < _previous.size(); i++) delete _previous[i];
+    delete _current;
+  }
+  Basis *find(const Key &key) const
+  {
+    basisMap *m;
+#if defined(_OPENMP)
+#pragma omp atomic read
+#endif
+    m = _current;
+#if defined(_OPENMP)
+#pragma omp flush
+#endif
+    typename basisMap::const_iterator it = m->find(key);
+    return it == m->end() ? NULL : it->second;
+  }
+  // add a basis built by the caller and return the basis stored for the key,
+  // which is not the given one (deleted) if another thread added a basis for
+  // the same key in the meantime
+  Basis *insert(const Key &key, Basis *basis)
+  {
+    Basis *stored = basis;
+#if defined(_OPENMP)
+#pragma omp critical(basisRegistry)
+#endif
+    {
+      typename basisMap::const_iterator it = _current->find(key);
+      if(it != _current->end()) {
+        stored = it->second;
+        delete basis;
+      }
+      else {
+        basisMap *m = new basisMap(*_current);
+        m->insert(std::make_pair(key, basis));
+        _previous.push_back(_current);
+#if defined(_OPENMP)
+#pragma omp flush
+#pragma omp atomic write
+#endif
+        _current = m;
+      }
+    }
+    return stored;
+  }
+  // delete the bases; must not be called concurrently with find or insert
+  void clear()
+  {
+    for(typename basisMap::iterator it = _current->begin();
+        it != _current->end(); ++it)
+      delete it->second;
+    _current->clear();
+    for(std::size_t i = 0; i < _previous.size(); i++) delete _previous[i];
+    _previous.clear();
+  }
+};
+
+basisRegistry<int, nodalBasis> BasisFactory::fs;
+basisRegistry<int, CondNumBasis> BasisFactory::cs;
+basisRegistry<FuncSpaceData, JacobianBasis> BasisFactory::js;
+basisRegistry<FuncSpaceData, bezierBasis> BasisFactory::bs;
+basisRegistry<FuncSpaceData, GradientBasis> BasisFactory::gs;
 
 const nodalBasis *BasisFactory::getNodalBasis(int tag)
 {
   // If the Basis has already been built, return it.
-  std::map<int, nodalBasis *>::const_iterator it = fs.find(tag);
-  if(it != fs.end()) {
-    return it->second;
-  }
+  nodalBasis *F = fs.find(tag);
+  if(F) return F;
   // Get the parent type to see which kind of basis
   // we want to create
-  nodalBasis *F = NULL;
   if(tag == MSH_TRI_MINI)
     F = new miniBasisTri();
   else if(tag == MSH_TET_MINI)
@@ -50,31 +120,16 @@ const nodalBasis *BasisFactory::getNodalBasis(int tag)
       return NULL;
     }
   }
-
-  std::pair<std::map<int, nodalBasis *>::const_iterator, bool> inserted;
-
-#if defined(_OPENMP)
-#pragma omp critical
-#endif
-  {
-    inserted = fs.insert(std::make_pair(tag, F));
-
-    if(!inserted.second) delete F;
-  }
-
-  return inserted.first->second;
+  return fs.insert(tag, F);
 }
 
 const JacobianBasis *BasisFactory::getJacobianBasis(FuncSpaceData fsd)
 {
   FuncSpaceData data = fsd.getForNonSerendipitySpace();
 
-  std::map<FuncSpaceData, JacobianBasis *>::const_iterator it = js.find(data);
-  if(it != js.end()) return it->second;
-
-  JacobianBasis *J = new JacobianBasis(data);
-  js.insert(std::make_pair(data, J));
-  return J;
+  JacobianBasis *J = js.find(data);
+  if(J) return J;
+  return js.insert(data, new JacobianBasis(data));
 }
 
 const JacobianBasis *BasisFactory::getJacobianBasis(int tag, int order)
@@ -99,22 +154,16 @@ const JacobianBasis *BasisFactory::getJacobianBasis(int tag)
 
 const CondNumBasis *BasisFactory::getCondNumBasis(int tag, int cnOrder)
 {
-  std::map<int, CondNumBasis *>::const_iterator it = cs.find(tag);
-  if(it != cs.end()) return it->second;
-
-  CondNumBasis *M = new CondNumBasis(tag, cnOrder);
-  cs.insert(std::make_pair(tag, M));
-  return M;
+  CondNumBasis *M = cs.find(tag);
+  if(M) return M;
+  return cs.insert(tag, new CondNumBasis(tag, cnOrder));
 }
 
 const GradientBasis *BasisFactory::getGradientBasis(FuncSpaceData data)
 {
-  std::map<FuncSpaceData, GradientBasis *>::const_iterator it = gs.find(data);
-  if(it != gs.end()) return it->second;
-
-  GradientBasis *G = new GradientBasis(data);
-  gs.insert(std::make_pair(data, G));
-  return G;
+  GradientBasis *G = gs.find(data);
+  if(G) return G;
+  return gs.insert(data, new GradientBasis(data));
 }
 
 const GradientBasis *BasisFactory::getGradientBasis(int tag, int order)
@@ -131,12 +180,9 @@ const bezierBasis *BasisFactory::getBezierBasis(FuncSpaceData fsd)
 {
   FuncSpaceData data = fsd.getForPrimaryElement();
 
-  std::map<FuncSpaceData, bezierBasis *>::const_iterator it = bs.find(data);
-  if(it != bs.end()) return it->second;
-
-  bezierBasis *B = new bezierBasis(data);
-  bs.insert(std::make_pair(data, B));
-  return B;
+  bezierBasis *B = bs.find(data);
+  if(B) return B;
+  return bs.insert(data, new bezierBasis(data));
 }
 
 const bezierBasis *BasisFactory::getBezierBasis(int parentTag, int order)
@@ -152,31 +198,8 @@ const bezierBasis *BasisFactory::getBezierBasis(int tag)
 
 void BasisFactory::clearAll()
 {
-  std::map<int, nodalBasis *>::iterator itF = fs.begin();
-  while(itF != fs.end()) {
-    delete itF->second;
-    itF++;
-  }
   fs.clear();
-
-  std::map<FuncSpaceData, JacobianBasis *>::iterator itJ = js.begin();
-  while(itJ != js.end()) {
-    delete itJ->second;
-    itJ++;
-  }
   js.clear();
-
-  std::map<FuncSpaceData, GradientBasis *>::iterator itG = gs.begin();
-  while(itG != gs.end()) {
-    delete itG->second;
-    itG++;
-  }
   gs.clear();
-
-  std::map<FuncSpaceData, bezierBasis *>::iterator itB = bs.begin();
-  while(itB != bs.end()) {
-    delete itB->second;
-    itB++;
-  }
   bs.clear();
 }
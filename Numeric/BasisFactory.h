@@ -13,18 +13,25 @@ class bezierBasis;
 class CondNumBasis;
 class JacobianBasis;
 class FuncSpaceData;
+template <class Key, class Basis> class basisRegistry;
 
 class BasisFactory {
 private:
-  static std::map<int, nodalBasis *> fs;
-  static std::map<int, CondNumBasis *> cs;
-  static std::map<FuncSpaceData, JacobianBasis *> js;
-  static std::map<FuncSpaceData, bezierBasis *> bs;
-  static std::map<FuncSpaceData, GradientBasis *> gs;
+  static basisRegistry<int, nodalBasis> fs;
+  static basisRegistry<int, CondNumBasis> cs;
+  static basisRegistry<FuncSpaceData, JacobianBasis> js;
+  static basisRegistry<FuncSpaceData, bezierBasis> bs;
+  static basisRegistry<FuncSpaceData, GradientBasis> gs;
 
 public:
   // Caution: the returned pointer can be NULL
 
+  // All the functions can be called concurrently by several threads: the
+  // lookup of an existing basis does not take any lock, and a new basis is
+  // built outside of any lock and then published atomically (if two threads
+  // build the same basis at the same time, only one of them is kept).
+  // clearAll() must not be called concurrently with the other functions.
+
   // Nodal
   static const nodalBasis *getNodalBasis(int tag);
 
@@ -703,10 +703,36 @@ void bezierBasis::_constructPyr()
 
 bezierBasisRaiser *bezierBasis::getRaiser() const
 {
-  if(!_raiser) {
-    const_cast<bezierBasis *>(this)->_raiser = new bezierBasisRaiser(this);
+  // the raiser is built on demand, possibly by several threads at the same
+  // time: only the first one to be published is kept
+  bezierBasisRaiser *raiser;
+#if defined(_OPENMP)
+#pragma omp atomic read
+#endif
+  raiser = _raiser;
+#if defined(_OPENMP)
+#pragma omp flush
+#endif
+  if(!raiser) {
+    raiser = new bezierBasisRaiser(this);
+#if defined(_OPENMP)
+#pragma omp critical(bezierBasisRaiser)
+#endif
+    {
+      if(_raiser) {
+        delete raiser;
+        raiser = _raiser;
+      }
+      else {
+#if defined(_OPENMP)
+#pragma omp flush
+#pragma omp atomic write
+#endif
+        const_cast<bezierBasis *>(this)->_raiser = raiser;
+      }
+    }
   }
-  return _raiser;
+  return raiser;
 }
 
 // const bezierBasis* bezierBasisRaiser::getRaisedBezierBasis(int raised) const
@@ -3,16 +3,22 @@
 // See the LICENSE.txt file for license information. Please report all
 // issues on https://gitlab.onelab.info/gmsh/gmsh/issues
 
+#include <algorithm>
 #include "mathEvaluator.h"
 
 #if defined(HAVE_MATHEX)
 
+// number of points evaluated together by each instruction of the compiled
+// programs
+static const std::size_t blockSize = 64;
+
 mathEvaluator::mathEvaluator(std::vector<std::string> &expressions,
                              const std::vector<std::string> &variables)
 {
   static std::string lastError;
 
   _expressions.resize(expressions.size());
+  _programs.resize(expressions.size());
   _variables.resize(variables.size(), 0.);
   bool error = false;
   for(unsigned int i = 0; i < expressions.size(); i++) {
@@ -22,6 +28,7 @@ mathEvaluator::mathEvaluator(std::vector<std::string> &expressions,
     try {
       _expressions[i]->expression(expressions[i]);
       _expressions[i]->parse();
+      if(!_compile(_expressions[i], _programs[i])) error = true;
     } catch(smlib::mathex::error &e) {
       if(e.what() + expressions[i] != lastError) {
         lastError = e.what() + expressions[i];
@@ -38,6 +45,7 @@ mathEvaluator::mathEvaluator(std::vector<std::string> &expressions,
     for(unsigned int i = 0; i < _expressions.size(); i++)
       delete(_expressions[i]);
     _expressions.clear();
+    _programs.clear();
     expressions.clear();
   }
 }
@@ -47,8 +55,145 @@ mathEvaluator::~mathEvaluator()
   for(unsigned int i = 0; i < _expressions.size(); i++) delete(_expressions[i]);
 }
 
+bool mathEvaluator::_compile(smlib::mathex *expression, program &prog)
+{
+  std::vector<smlib::mathex::instruction> code;
+  expression->getcode(code);
+  prog.code.resize(code.size());
+  prog.stackSize = 0;
+  int depth = 0;
+  for(std::size_t i = 0; i < code.size(); i++) {
+    instruction &c = prog.code[i];
+    c.index = 0;
+    c.value = 0.;
+    c.f1 = 0;
+    c.f2 = 0;
+    c.fn = 0;
+    switch(code[i].state) {
+    case smlib::mathex::instruction::VALUE:
+      c.op = instruction::VALUE;
+      c.value = code[i].value;
+      depth++;
+      break;
+    case smlib::mathex::instruction::VARIABLE:
+      c.op = instruction::VARIABLE;
+      if(_variables.empty() || code[i].var < &_variables[0] ||
+         code[i].var >= &_variables[0] + _variables.size()) {
+        Msg::Error("Unknown variable in compiled math expression");
+        return false;
+      }
+      c.index = code[i].var - &_variables[0];
+      depth++;
+      break;
+    case smlib::mathex::instruction::FUNCTION:
+      c.op = (std::string(code[i].name) == "-") ? instruction::NEGATE :
+                                                  instruction::FUNCTION;
+      c.f1 = code[i].f1;
+      break;
+    case smlib::mathex::instruction::BINOP:
+      switch(code[i].name[0]) {
+      case '+': c.op = instruction::ADD; break;
+      case '-': c.op = instruction::SUBTRACT; break;
+      case '*': c.op = instruction::MULTIPLY; break;
+      case '/': c.op = instruction::DIVIDE; break;
+      default: c.op = instruction::BINOP; break;
+      }
+      c.f2 = code[i].f2;
+      depth--;
+      break;
+    case smlib::mathex::instruction::USERFUNC:
+      c.op = instruction::USERFUNC;
+      c.index = code[i].numargs;
+      c.fn = code[i].fn;
+      depth += 1 - (int)code[i].numargs;
+      break;
+    }
+    if(depth < 1) {
+      Msg::Error("Invalid compiled math expression");
+      return false;
+    }
+    prog.stackSize = std::max(prog.stackSize, depth);
+  }
+  if(depth != 1) {
+    Msg::Error("Invalid compiled math expression");
+    return false;
+  }
+  return true;
+}
+
+bool mathEvaluator::_run(const program &prog, const double *values,
+                         std::size_t n, double *stack, double *res,
+                         std::size_t stride, std::string &error) const
+{
+  const std::size_t nv = _variables.size();
+  // the stack stores blocks of n values; top points to the last block
+  double *top = stack - blockSize;
+  std::vector<double> args;
+  try {
+    for(std::size_t i = 0; i < prog.code.size(); i++) {
+      const instruction &c = prog.code[i];
+      switch(c.op) {
+      case instruction::VALUE:
+        top += blockSize;
+        for(std::size_t j = 0; j < n; j++) top[j] = c.value;
+        break;
+      case instruction::VARIABLE:
+        top += blockSize;
+        for(std::size_t j = 0; j < n; j++) top[j] = values[j * nv + c.index];
+        break;
+      case instruction::NEGATE:
+        for(std::size_t j = 0; j < n; j++) top[j] = -top[j];
+        break;
+      case instruction::ADD:
+        top -= blockSize;
+        for(std::size_t j = 0; j < n; j++) top[j] += top[j + blockSize];
+        break;
+      case instruction::SUBTRACT:
+        top -= blockSize;
+        for(std::size_t j = 0; j < n; j++) top[j] -= top[j + blockSize];
+        break;
+      case instruction::MULTIPLY:
+        top -= blockSize;
+        for(std::size_t j = 0; j < n; j++) top[j] *= top[j + blockSize];
+        break;
+      case instruction::DIVIDE:
+        top -= blockSize;
+        for(std::size_t j = 0; j < n; j++) {
+          if(top[j + blockSize] == 0) {
+            error = "Error [binary_divide()]: division by zero";
+            return false;
+          }
+          top[j] /= top[j + blockSize];
+        }
+        break;
+      case instruction::FUNCTION:
+        for(std::size_t j = 0; j < n; j++) top[j] = c.f1(top[j]);
+        break;
+      case instruction::BINOP:
+        top -= blockSize;
+        for(std::size_t j = 0; j < n; j++)
+          top[j] = c.f2(top[j], top[j + blockSize]);
+        break;
+      case instruction::USERFUNC:
+        args.resize(c.index);
+        top -= (c.index - 1) * (int)blockSize;
+        for(std::size_t j = 0; j < n; j++) {
+          for(int k = 0; k < c.index; k++) args[k] = top[j + k * blockSize];
+          top[j] = c.fn(args);
+        }
+        break;
+      }
+    }
+  } catch(smlib::mathex::error &e) {
+    error = e.what();
+    return false;
+  }
+  for(std::size_t j = 0; j < n; j++) res[j * stride] = top[j];
+  return true;
+}
+
 bool mathEvaluator::eval(const std::vector<double> &values,
-                         std::vector<double> &res)
+                         std::vector<double> &res) const
 {
   if(values.size() != _variables.size()) {
     Msg::Error("Given %d value(s) for %d variable(s)", values.size(),
@@ -56,27 +201,46 @@ bool mathEvaluator::eval(const std::vector<double> &values,
     return false;
   }
 
-  if(res.size() != _expressions.size()) {
+  if(res.size() != _programs.size()) {
     Msg::Error("Given %d result(s) for %d expression(s)", res.size(),
-               _expressions.size());
+               _programs.size());
     return false;
   }
 
-  for(unsigned int i = 0; i < values.size(); i++) _variables[i] = values[i];
+  if(res.empty()) return true;
+  return eval(values.empty() ? 0 : &values[0], 1, &res[0]);
+}
 
-  for(unsigned int i = 0; i < _expressions.size(); i++) {
-    try {
-      res[i] = _expressions[i]->eval();
-    } catch(smlib::mathex::error &e) {
-      Msg::Error(e.what());
-      double eps = 1.e-20;
-      for(unsigned int j = 0; j < values.size(); j++)
-        _variables[j] = values[j] + eps;
-      try {
-        res[i] = _expressions[i]->eval();
-      } catch(smlib::mathex::error &e2) {
-        Msg::Error(e2.what());
-        return false;
+bool mathEvaluator::eval(const double *values, std::size_t n,
+                         double *res) const
+{
+  const std::size_t nv = _variables.size(), ne = _programs.size();
+  int stackSize = 0;
+  for(std::size_t i = 0; i < ne; i++)
+    stackSize = std::max(stackSize, _programs[i].stackSize);
+  std::vector<double> stack(stackSize * blockSize);
+  std::vector<double> shifted(nv);
+  std::string error;
+  for(std::size_t start = 0; start < n; start += blockSize) {
+    std::size_t m = std::min(blockSize, n - start);
+    const double *v = values + start * nv;
+    double *r = res + start * ne;
+    for(std::size_t i = 0; i < ne; i++) {
+      if(_run(_programs[i], v, m, &stack[0], r + i, ne, error)) continue;
+      // evaluation failed for some point in the block: evaluate the points
+      // one by one, and retry after a small perturbation of the values
+      for(std::size_t j = 0; j < m; j++) {
+        if(_run(_programs[i], v + j * nv, 1, &stack[0], r + j * ne + i, ne,
+                error))
+          continue;
+        Msg::Error(error.c_str());
+        double eps = 1.e-20;
+        for(std::size_t k = 0; k < nv; k++) shifted[k] = v[j * nv + k] + eps;
+        if(!_run(_programs[i], nv ? &shifted[0] : 0, 1, &stack[0],
+                 r + j * ne + i, ne, error)) {
+          Msg::Error(error.c_str());
+          return false;
+        }
       }
     }
   }
@@ -6,6 +6,7 @@
 #ifndef _MATH_EVALUATOR_H_
 #define _MATH_EVALUATOR_H_
 
+#include <cstddef>
 #include <vector>
 #include <string>
 #include "GmshConfig.h"
@@ -17,8 +18,41 @@
 
 class mathEvaluator {
 private:
+  // instruction of the compiled program of an expression: the program runs on
+  // a stack of blocks of values, one value per evaluation point
+  class instruction {
+  public:
+    enum type {
+      VALUE,
+      VARIABLE,
+      NEGATE,
+      ADD,
+      SUBTRACT,
+      MULTIPLY,
+      DIVIDE,
+      FUNCTION,
+      BINOP,
+      USERFUNC
+    };
+    type op;
+    int index; // variable index or number of arguments
+    double value;
+    double (*f1)(double);
+    double (*f2)(double, double);
+    double (*fn)(std::vector<double> const &);
+  };
+  class program {
+  public:
+    std::vector<instruction> code;
+    int stackSize;
+  };
   std::vector<smlib::mathex *> _expressions;
+  std::vector<program> _programs;
   std::vector<double> _variables;
+  bool _compile(smlib::mathex *expression, program &prog);
+  bool _run(const program &prog, const double *values, std::size_t n,
+            double *stack, double *res, std::size_t stride,
+            std::string &error) const;
 
 public:
   // initialize one or more expressions depending on zero or more
@@ -29,7 +63,16 @@ public:
   ~mathEvaluator();
   // evaluate the expression(s) using the given values and fill the
   // result vector. Returns true if the evaluation succeeded.
-  bool eval(const std::vector<double> &values, std::vector<double> &res);
+  bool eval(const std::vector<double> &values, std::vector<double> &res) const;
+  // evaluate the expression(s) at n points: values contains the values of
+  // the variables at the first point, then at the second point, etc., and res
+  // is filled in the same way with the values of the expressions. The
+  // expressions are compiled once and evaluated on blocks of points without
+  // modifying the evaluator, so that several threads can use the same
+  // evaluator concurrently. Returns true if the evaluation succeeded.
+  bool eval(const double *values, std::size_t n, double *res) const;
+  std::size_t getNumVariables() const { return _variables.size(); }
+  std::size_t getNumExpressions() const { return _programs.size(); }
 };
 
 #else
@@ -44,10 +87,17 @@ public:
     expressions.clear();
   }
   ~mathEvaluator() {}
-  bool eval(const std::vector<double> &values, std::vector<double> &res)
+  bool eval(const std::vector<double> &values,
+            std::vector<double> &res) const
   {
     return false;
   }
+  bool eval(const double *values, std::size_t n, double *res) const
+  {
+    return false;
+  }
+  std::size_t getNumVariables() const { return 0; }
+  std::size_t getNumExpressions() const { return 0; }
 };
 
 #endif
@@ -18,6 +18,7 @@
 #include "MElement.h"
 #include <sstream>
 #include <fstream>
+#include <algorithm>
 #include "qualityMeasuresJacobian.h"
 #if defined(HAVE_VISUDEV)
 #include "BasisFactory.h"
@@ -25,6 +26,9 @@
 
 class bezierBasis;
 
+// number of elements analysed in each call to the (batched) quality functions
+static const unsigned int chunkSize = 4096;
+
 StringXNumber CurvedMeshOptions_Number[] = {
   {GMSH_FULLRC, "JacobianDeterminant", NULL, 0},
   {GMSH_FULLRC, "IGEMeasure", NULL, 0},
@@ -363,17 +367,25 @@ void GMSH_AnalyseCurvedMeshPlugin::_computeMinMaxJandValidity(int dim)
     MsgProgressStatus progress(num);
 
     _data.reserve(_data.size() + num);
-    for(unsigned i = 0; i < num; ++i) {
-      MElement *el = entity->getMeshElement(i);
-      double min, max;
-      jacobianBasedQuality::minMaxJacobianDeterminant(el, min, max, normals);
-      _data.push_back(data_elementMinMax(el, min, max));
-      if(min < 0 && max < 0) ++cntInverted;
-      progress.next();
+    std::vector<MElement *> elements;
+    std::vector<double> min, max;
+    for(unsigned i0 = 0; i0 < num; i0 += chunkSize) {
+      const unsigned i1 = std::min(num, i0 + chunkSize);
+      elements.clear();
+      for(unsigned i = i0; i < i1; ++i)
+        elements.push_back(entity->getMeshElement(i));
+      jacobianBasedQuality::minMaxJacobianDeterminant(elements, min, max,
+                                                      normals);
+      for(unsigned k = 0; k < elements.size(); ++k) {
+        MElement *el = elements[k];
+        _data.push_back(data_elementMinMax(el, min[k], max[k]));
+        if(min[k] < 0 && max[k] < 0) ++cntInverted;
+        progress.next();
 
 #if defined(HAVE_VISUDEV)
-      _computePointwiseQuantities(el, normals);
+        _computePointwiseQuantities(el, normals);
 #endif
+      }
     }
     delete normals;
   }
@@ -389,16 +401,31 @@ void GMSH_AnalyseCurvedMeshPlugin::_computeMinIGE(int dim)
 
   MsgProgressStatus progress(_data.size());
 
-  for(unsigned int i = 0; i < _data.size(); ++i) {
-    MElement *const el = _data[i].element();
-    if(el->getDim() != dim) continue;
-    if(_data[i].minJ() <= 0 && _data[i].maxJ() > 0) {
-      _data[i].setMinS(0);
+  std::vector<unsigned int> indices;
+  std::vector<MElement *> elements;
+  std::vector<double> measure;
+  for(unsigned int i0 = 0; i0 < _data.size(); i0 += chunkSize) {
+    const unsigned int i1 =
+      std::min((unsigned int)_data.size(), i0 + chunkSize);
+    indices.clear();
+    elements.clear();
+    for(unsigned int i = i0; i < i1; ++i) {
+      MElement *const el = _data[i].element();
+      if(el->getDim() != dim) continue;
+      if(_data[i].minJ() <= 0 && _data[i].maxJ() > 0) {
+        _data[i].setMinS(0);
+        progress.next();
+      }
+      else {
+        indices.push_back(i);
+        elements.push_back(el);
+      }
     }
-    else {
-      _data[i].setMinS(jacobianBasedQuality::minIGEMeasure(el, true));
+    jacobianBasedQuality::minIGEMeasure(elements, measure, true);
+    for(unsigned int k = 0; k < indices.size(); ++k) {
+      _data[indices[k]].setMinS(measure[k]);
+      progress.next();
     }
-    progress.next();
   }
 
   _computedIGE[dim - 1] = true;
@@ -410,16 +437,31 @@ void GMSH_AnalyseCurvedMeshPlugin::_computeMinICN(int dim)
 
   MsgProgressStatus progress(_data.size());
 
-  for(unsigned int i = 0; i < _data.size(); ++i) {
-    MElement *const el = _data[i].element();
-    if(el->getDim() != dim) continue;
-    if(_data[i].minJ() <= 0 && _data[i].maxJ() > 0) {
-      _data[i].setMinI(0);
+  std::vector<unsigned int> indices;
+  std::vector<MElement *> elements;
+  std::vector<double> measure;
+  for(unsigned int i0 = 0; i0 < _data.size(); i0 += chunkSize) {
+    const unsigned int i1 =
+      std::min((unsigned int)_data.size(), i0 + chunkSize);
+    indices.clear();
+    elements.clear();
+    for(unsigned int i = i0; i < i1; ++i) {
+      MElement *const el = _data[i].element();
+      if(el->getDim() != dim) continue;
+      if(_data[i].minJ() <= 0 && _data[i].maxJ() > 0) {
+        _data[i].setMinI(0);
+        progress.next();
+      }
+      else {
+        indices.push_back(i);
+        elements.push_back(el);
+      }
     }
-    else {
-      _data[i].setMinI(jacobianBasedQuality::minICNMeasure(el, true));
+    jacobianBasedQuality::minICNMeasure(elements, measure, true);
+    for(unsigned int k = 0; k < indices.size(); ++k) {
+      _data[indices[k]].setMinI(measure[k]);
+      progress.next();
     }
-    progress.next();
   }
 
   _computedICN[dim - 1] = true;
@@ -31,6 +31,51 @@ StringXNumber *GMSH_CurlPlugin::getOption(int iopt)
   return &CurlOptions_Number[iopt];
 }
 
+// compute the curl on one element of the view
+class curlOnElement {
+private:
+  PViewData *_data;
+  int _step; // first non-empty step, for the element properties
+
+public:
+  curlOnElement(PViewData *data, int step) : _data(data), _step(step) {}
+  void operator()(int range, int ent, int ele, PViewDataList **out) const
+  {
+    if(_data->skipElement(_step, ent, ele)) return;
+    int numComp = _data->getNumComponents(_step, ent, ele);
+    if(numComp != 3) return;
+    int type = _data->getType(_step, ent, ele);
+    int numNodes = _data->getNumNodes(_step, ent, ele);
+    std::vector<double> *list = out[0]->incrementList(3, type, numNodes);
+    if(!list) return;
+    double x[8], y[8], z[8], val[8 * 3];
+    for(int nod = 0; nod < numNodes; nod++)
+      _data->getNode(_step, ent, ele, nod, x[nod], y[nod], z[nod]);
+    int dim = _data->getDimension(_step, ent, ele);
+    elementFactory factory;
+    element *element = factory.create(numNodes, dim, x, y, z);
+    if(!element) return;
+    for(int nod = 0; nod < numNodes; nod++) list->push_back(x[nod]);
+    for(int nod = 0; nod < numNodes; nod++) list->push_back(y[nod]);
+    for(int nod = 0; nod < numNodes; nod++) list->push_back(z[nod]);
+    for(int step = 0; step < _data->getNumTimeSteps(); step++) {
+      if(!_data->hasTimeStep(step)) continue;
+      for(int nod = 0; nod < numNodes; nod++)
+        for(int comp = 0; comp < numComp; comp++)
+          _data->getValue(step, ent, ele, nod, comp, val[numComp * nod + comp]);
+      for(int nod = 0; nod < numNodes; nod++) {
+        double u, v, w, f[3];
+        element->getNode(nod, u, v, w);
+        element->interpolateCurl(val, u, v, w, f, 3);
+        list->push_back(f[0]);
+        list->push_back(f[1]);
+        list->push_back(f[2]);
+      }
+    }
+    delete element;
+  }
+};
+
 PView *GMSH_CurlPlugin::execute(PView *v)
 {
   int iView = (int)CurlOptions_Number[0].def;
@@ -48,45 +93,9 @@ PView *GMSH_CurlPlugin::execute(PView *v)
   PViewDataList *data2 = getDataList(v2);
   int firstNonEmptyStep = data1->getFirstNonEmptyTimeStep();
 
-  for(int ent = 0; ent < data1->getNumEntities(firstNonEmptyStep); ent++) {
-    for(int ele = 0; ele < data1->getNumElements(firstNonEmptyStep, ent);
-        ele++) {
-      if(data1->skipElement(firstNonEmptyStep, ent, ele)) continue;
-      int numComp = data1->getNumComponents(firstNonEmptyStep, ent, ele);
-      if(numComp != 3) continue;
-      int type = data1->getType(firstNonEmptyStep, ent, ele);
-      int numNodes = data1->getNumNodes(firstNonEmptyStep, ent, ele);
-      std::vector<double> *out = data2->incrementList(3, type, numNodes);
-      if(!out) continue;
-      double x[8], y[8], z[8], val[8 * 3];
-      for(int nod = 0; nod < numNodes; nod++)
-        data1->getNode(firstNonEmptyStep, ent, ele, nod, x[nod], y[nod],
-                       z[nod]);
-      int dim = data1->getDimension(firstNonEmptyStep, ent, ele);
-      elementFactory factory;
-      element *element = factory.create(numNodes, dim, x, y, z);
-      if(!element) continue;
-      for(int nod = 0; nod < numNodes; nod++) out->push_back(x[nod]);
-      for(int nod = 0; nod < numNodes; nod++) out->push_back(y[nod]);
-      for(int nod = 0; nod < numNodes; nod++) out->push_back(z[nod]);
-      for(int step = 0; step < data1->getNumTimeSteps(); step++) {
-        if(!data1->hasTimeStep(step)) continue;
-        for(int nod = 0; nod < numNodes; nod++)
-          for(int comp = 0; comp < numComp; comp++)
-            data1->getValue(step, ent, ele, nod, comp,
-                            val[numComp * nod + comp]);
-        for(int nod = 0; nod < numNodes; nod++) {
-          double u, v, w, f[3];
-          element->getNode(nod, u, v, w);
-          element->interpolateCurl(val, u, v, w, f, 3);
-          out->push_back(f[0]);
-          out->push_back(f[1]);
-          out->push_back(f[2]);
-        }
-      }
-      delete element;
-    }
-  }
+  curlOnElement f(data1, firstNonEmptyStep);
+  postElementLoop loop(data1, firstNonEmptyStep);
+  loop.run(f, 1, &data2);
 
   for(int i = 0; i < data1->getNumTimeSteps(); i++) {
     if(!data1->hasTimeStep(i)) continue;
@@ -21,7 +21,8 @@ StringXNumber CutPlaneOptions_Number[] = {
   {GMSH_FULLRC, "ExtractVolume", GMSH_CutPlanePlugin::callbackVol, 0},
   {GMSH_FULLRC, "RecurLevel", GMSH_CutPlanePlugin::callbackRecur, 4},
   {GMSH_FULLRC, "TargetError", GMSH_CutPlanePlugin::callbackTarget, 0.},
-  {GMSH_FULLRC, "View", NULL, -1.}};
+  {GMSH_FULLRC, "View", NULL, -1.},
+  {GMSH_FULLRC, "OutputMesh", NULL, 0.}};
 
 extern "C" {
 GMSH_Plugin *GMSH_RegisterCutPlanePlugin() { return new GMSH_CutPlanePlugin(); }
@@ -111,6 +112,10 @@ std::string GMSH_CutPlanePlugin::getHelp() const
          "If `ExtractVolume' is nonzero, the plugin extracts "
          "the elements on one side of the plane (depending "
          "on the sign of `ExtractVolume').\n\n"
+         "If `OutputMesh' is set, the cut is created as a mesh-based "
+         "view on new discrete entities of the model, with nodes shared by "
+         "neighboring elements (only for views with node data, without "
+         "`ExtractVolume').\n\n"
          "If `View' < 0, the plugin is run on the current view.\n\n"
          "Plugin(CutPlane) creates one new view.";
 }
@@ -157,6 +162,7 @@ PView *GMSH_CutPlanePlugin::execute(PView *v)
   _valueTimeStep = -1;
   _orientation = GMSH_LevelsetPlugin::PLANE;
   _extractVolume = (int)CutPlaneOptions_Number[4].def;
+  _outputMesh = (int)CutPlaneOptions_Number[8].def;
   _recurLevel = (int)CutPlaneOptions_Number[5].def;
   _targetError = CutPlaneOptions_Number[6].def;
 
@@ -20,7 +20,8 @@ StringXNumber CutSphereOptions_Number[] = {
   {GMSH_FULLRC, "ExtractVolume", GMSH_CutSpherePlugin::callbackVol, 0.},
   {GMSH_FULLRC, "RecurLevel", GMSH_CutSpherePlugin::callbackRecur, 4},
   {GMSH_FULLRC, "TargetError", GMSH_CutSpherePlugin::callbackTarget, 0.},
-  {GMSH_FULLRC, "View", NULL, -1.}};
+  {GMSH_FULLRC, "View", NULL, -1.},
+  {GMSH_FULLRC, "OutputMesh", NULL, 0.}};
 
 extern "C" {
 GMSH_Plugin *GMSH_RegisterCutSpherePlugin()
@@ -112,6 +113,10 @@ std::string GMSH_CutSpherePlugin::getHelp() const
          "If `ExtractVolume' is nonzero, the plugin extracts "
          "the elements inside (if `ExtractVolume' < 0) or "
          "outside (if `ExtractVolume' > 0) the sphere.\n\n"
+         "If `OutputMesh' is set, the cut is created as a mesh-based "
+         "view on new discrete entities of the model, with nodes shared by "
+         "neighboring elements (only for views with node data, without "
+         "`ExtractVolume').\n\n"
          "If `View' < 0, the plugin is run on the current view.\n\n"
          "Plugin(CutSphere) creates one new view.";
 }
@@ -143,6 +148,7 @@ PView *GMSH_CutSpherePlugin::execute(PView *v)
   _ref[1] = CutSphereOptions_Number[1].def;
   _ref[2] = CutSphereOptions_Number[2].def;
   _extractVolume = (int)CutSphereOptions_Number[4].def;
+  _outputMesh = (int)CutSphereOptions_Number[8].def;
   _recurLevel = (int)CutSphereOptions_Number[5].def;
   _targetError = CutSphereOptions_Number[6].def;
 
@@ -12,6 +12,7 @@
 #include "distanceTerm.h"
 #include "Context.h"
 #include "Numeric.h"
+#include "BVH.h"
 
 #if defined(HAVE_SOLVER)
 #include "dofManager.h"
@@ -94,6 +95,22 @@ StringXString *GMSH_DistancePlugin::getOptionStr(int iopt)
 
 void GMSH_DistancePlugin::printView(std::vector<GEntity *> _entities,
                                     std::map<MVertex *, double> _distance_map)
+{
+  // the map is sorted by vertex pointer
+  std::vector<std::pair<MVertex *, double> > distances(_distance_map.begin(),
+                                                       _distance_map.end());
+  printView(_entities, distances);
+}
+
+static bool compareVertexDistance(const std::pair<MVertex *, double> &a,
+                                  const std::pair<MVertex *, double> &b)
+{
+  return a.first < b.first;
+}
+
+void GMSH_DistancePlugin::printView(
+  const std::vector<GEntity *> &_entities,
+  std::vector<std::pair<MVertex *, double> > &distances)
 {
   _fileName = DistanceOptions_String[0].def;
   _minScale = (double)DistanceOptions_Number[4].def;
@@ -101,12 +118,10 @@ void GMSH_DistancePlugin::printView(std::vector<GEntity *> _entities,
 
   double minDist = 1.e4;
   double maxDist = 0.0;
-  for(std::map<MVertex *, double>::iterator itv = _distance_map.begin();
-      itv != _distance_map.end(); ++itv) {
-    double dist = itv->second;
+  for(std::size_t i = 0; i < distances.size(); i++) {
+    double dist = distances[i].second;
     if(dist > maxDist) maxDist = dist;
     if(dist < minDist) minDist = dist;
-    itv->second = dist;
   }
 
   Msg::Info("Writing %s", _fileName.c_str());
@@ -169,7 +184,9 @@ void GMSH_DistancePlugin::printView(std::vector<GEntity *> _entities,
             fprintf(fName, ",%.16g,%.16g,%.16g", v->x(), v->y(), v->z());
           else
             fprintf(fName, "%.16g,%.16g,%.16g", v->x(), v->y(), v->z());
-          std::map<MVertex *, double>::iterator it = _distance_map.find(v);
+          std::vector<std::pair<MVertex *, double> >::iterator it =
+            std::lower_bound(distances.begin(), distances.end(),
+                             std::make_pair(v, 0.), compareVertexDistance);
           dist.push_back(it->second);
         }
 
@@ -195,6 +212,76 @@ void GMSH_DistancePlugin::printView(std::vector<GEntity *> _entities,
   fclose(fName);
 }
 
+// distance between a point and the straight (linear) representation of a
+// boundary element
+class boundaryDistance {
+private:
+  const std::vector<MElement *> &_elements;
+  int _order;
+
+public:
+  boundaryDistance(const std::vector<MElement *> &elements, int order)
+    : _elements(elements), _order(order)
+  {
+  }
+  // number of corners of the straight element used to compute the distance
+  // (0 if the element type is not supported)
+  static int getNumCorners(MElement *e, int order)
+  {
+    std::size_t n = e->getNumVertices();
+    if(n == 1) return 1;
+    if((n == 2 && order == 1) || (n == 3 && order == 2)) return 2;
+    if((n == 3 && order == 1) || (n == 6 && order == 2)) return 3;
+    return 0;
+  }
+  std::vector<double> getBoundingBoxes() const
+  {
+    std::vector<double> boxes(6 * _elements.size());
+    for(std::size_t i = 0; i < _elements.size(); i++) {
+      MElement *e = _elements[i];
+      double *b = &boxes[6 * i];
+      b[0] = b[3] = e->getVertex(0)->x();
+      b[1] = b[4] = e->getVertex(0)->y();
+      b[2] = b[5] = e->getVertex(0)->z();
+      for(int j = 1; j < getNumCorners(e, _order); j++) {
+        MVertex *v = e->getVertex(j);
+        b[0] = std::min(b[0], v->x());
+        b[1] = std::min(b[1], v->y());
+        b[2] = std::min(b[2], v->z());
+        b[3] = std::max(b[3], v->x());
+        b[4] = std::max(b[4], v->y());
+        b[5] = std::max(b[5], v->z());
+      }
+    }
+    return boxes;
+  }
+  double operator()(int i, const double *xyz) const
+  {
+    MElement *e = _elements[i];
+    SPoint3 p(xyz[0], xyz[1], xyz[2]), closePt;
+    MVertex *v1 = e->getVertex(0);
+    SPoint3 p1(v1->x(), v1->y(), v1->z());
+    double d = 1.e22;
+    switch(getNumCorners(e, _order)) {
+    case 1: d = p.distance(p1); break;
+    case 2: {
+      MVertex *v2 = e->getVertex(1);
+      SPoint3 p2(v2->x(), v2->y(), v2->z());
+      signedDistancePointLine(p1, p2, p, d, closePt);
+      break;
+    }
+    case 3: {
+      MVertex *v2 = e->getVertex(1), *v3 = e->getVertex(2);
+      SPoint3 p2(v2->x(), v2->y(), v2->z());
+      SPoint3 p3(v3->x(), v3->y(), v3->z());
+      signedDistancePointTriangle(p1, p2, p3, p, d, closePt);
+      break;
+    }
+    }
+    return std::abs(d);
+  }
+};
+
 PView *GMSH_DistancePlugin::execute(PView *v)
 {
   int id_pt = (int)DistanceOptions_Number[0].def;
@@ -264,7 +351,6 @@ PView *GMSH_DistancePlugin::execute(PView *v)
     distances.push_back(1.e22);
   }
 
-  int k = 0;
   for(unsigned int i = 0; i < _entities.size(); i++) {
     GEntity *ge = _entities[i];
     _maxDim = std::max(_maxDim, ge->dim());
@@ -276,8 +362,7 @@ PView *GMSH_DistancePlugin::execute(PView *v)
             SPoint3 p_empty();
             _closePts_map.insert(std::make_pair(v, p_empty));
       */
-      pt2Vertex[k] = v;
-      k++;
+      pt2Vertex.push_back(v);
     }
   }
 
@@ -286,6 +371,7 @@ PView *GMSH_DistancePlugin::execute(PView *v)
   if(type < 0.0) {
     bool existEntity = false;
 
+    std::vector<MElement *> boundary;
     for(unsigned int i = 0; i < _entities.size(); i++) {
       GEntity *g2 = _entities[i];
       int gDim = g2->dim();
@@ -303,36 +389,9 @@ PView *GMSH_DistancePlugin::execute(PView *v)
       if(computeForEntity) {
         existEntity = true;
         for(unsigned int k = 0; k < g2->getNumMeshElements(); k++) {
-          std::vector<double> iDistances;
-          std::vector<SPoint3> iClosePts;
-          std::vector<double> iDistancesE;
-          std::vector<int> iIsInYarn;
           MElement *e = g2->getMeshElement(k);
-          MVertex *v1 = e->getVertex(0);
-          MVertex *v2 = e->getVertex(1);
-          SPoint3 p1(v1->x(), v1->y(), v1->z());
-          SPoint3 p2(v2->x(), v2->y(), v2->z());
-          if((e->getNumVertices() == 2 && order == 1) ||
-             (e->getNumVertices() == 3 && order == 2)) {
-            signedDistancesPointsLine(iDistances, iClosePts, pts, p1, p2);
-          }
-          else if((e->getNumVertices() == 3 && order == 1) ||
-                  (e->getNumVertices() == 6 && order == 2)) {
-            MVertex *v3 = e->getVertex(2);
-            SPoint3 p3(v3->x(), v3->y(), v3->z());
-            signedDistancesPointsTriangle(iDistances, iClosePts, pts, p1, p2,
-                                          p3);
-          }
-          for(unsigned int kk = 0; kk < pts.size(); kk++) {
-            if(std::abs(iDistances[kk]) < distances[kk]) {
-              distances[kk] = std::abs(iDistances[kk]);
-              MVertex *v = pt2Vertex[kk];
-              _distance_map[v] = distances[kk];
-              /* TO DO (by AM)
-              _closePts_map[v] = iClosePts[kk];
-              */
-            }
-          }
+          if(boundaryDistance::getNumCorners(e, order))
+            boundary.push_back(e);
         }
       }
     }
@@ -342,7 +401,27 @@ PView *GMSH_DistancePlugin::execute(PView *v)
       if(id_face != 0) Msg::Error("The Physical Surface does not exist !");
     }
     else {
-      printView(_entities, _distance_map);
+      // closest boundary element of each node, found with a bounding volume
+      // hierarchy over the boundary elements
+      boundaryDistance f(boundary, order);
+      BVH bvh;
+      bvh.build(f.getBoundingBoxes());
+      std::vector<std::pair<MVertex *, double> > nodal(pts.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+      for(int kk = 0; kk < (int)pts.size(); kk++) {
+        double p[3] = {pts[kk].x(), pts[kk].y(), pts[kk].z()}, d;
+        if(bvh.closest(p, f, d, 1.e22) < 0) d = 0.;
+        nodal[kk] = std::make_pair(pt2Vertex[kk], d);
+      }
+      std::sort(nodal.begin(), nodal.end(), compareVertexDistance);
+      std::map<MVertex *, double>::iterator hint = _distance_map.begin();
+      for(std::size_t kk = 0; kk < nodal.size(); kk++) {
+        hint = _distance_map.insert(hint, nodal[kk]);
+        hint->second = nodal[kk].second;
+      }
+      printView(_entities, nodal);
     }
 
     /* TO DO (by AM)
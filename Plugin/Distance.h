@@ -37,6 +37,9 @@ public:
   PView *execute(PView *);
   void printView(std::vector<GEntity *> _entities,
                  std::map<MVertex *, double> _distance_map);
+  // same as above, with the distances stored in a vector sorted by vertex
+  void printView(const std::vector<GEntity *> &_entities,
+                 std::vector<std::pair<MVertex *, double> > &distances);
 };
 
 #endif
@@ -263,8 +263,8 @@ void GMSH_FaultZoneMesher::RetriveFissuresInfos(GFace *gFace)
       }
 
       if(its != _jointElements.end()) {
-        Msg::Warning("Element edge %d appears in a second GEntity",
-                     mElem->getNum());
+        Msg::Warning("Element edge %lu appears in a second GEntity",
+                     (unsigned long)mElem->getNum());
         continue;
       }
 
@@ -274,8 +274,8 @@ void GMSH_FaultZoneMesher::RetriveFissuresInfos(GFace *gFace)
         allConnectedQuadraticVertices.find(mElem->getVertex(2));
       if(its2 == allConnectedQuadraticVertices.end()) {
         Msg::Warning(
-          "Element edge %d seams to be not connected, it will be ignored",
-          mElem->getNum());
+          "Element edge %lu seams to be not connected, it will be ignored",
+          (unsigned long)mElem->getNum());
         continue;
       }
 
@@ -585,9 +585,9 @@ void GMSH_FaultZoneMesher::CreateJointElements(GModel *gModel, GFace *gFace,
       SVector3 tan = mElem->getEdge(0).tangent();
       int changeOri = (dot(crossprod(nor, tan), vectZ) > 0);
       if(changeOri)
-        Msg::Warning("Reverting local numbering node for element %d to set "
+        Msg::Warning("Reverting local numbering node for element %lu to set "
                      "outgoing normal for its corresponding joint element",
-                     mElem->getNum());
+                     (unsigned long)mElem->getNum());
       // retriving MVertices to create the new MElement
       for(std::size_t i = 0; i < mElem->getNumVertices(); i++) {
         MVertex *mVert = mElem->getVertex(i);
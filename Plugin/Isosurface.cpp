@@ -13,7 +13,8 @@ StringXNumber IsosurfaceOptions_Number[] = {
   {GMSH_FULLRC, "TargetError", GMSH_IsosurfacePlugin::callbackTarget, 0},
   {GMSH_FULLRC, "View", NULL, -1.},
   {GMSH_FULLRC, "OtherTimeStep", NULL, -1.},
-  {GMSH_FULLRC, "OtherView", NULL, -1.}};
+  {GMSH_FULLRC, "OtherView", NULL, -1.},
+  {GMSH_FULLRC, "OutputMesh", NULL, 0.}};
 
 extern "C" {
 GMSH_Plugin *GMSH_RegisterIsosurfacePlugin()
@@ -89,6 +90,10 @@ std::string GMSH_IsosurfacePlugin::getHelp() const
          "step in `View', the corresponding time step in `OtherView'. "
          "If `OtherView' < 0, the plugin uses `View' as the value "
          "source.\n\n"
+         "If `OutputMesh' is set, the cut is created as a mesh-based "
+         "view on new discrete entities of the model, with nodes shared by "
+         "neighboring elements (only for views with node data, without "
+         "`ExtractVolume').\n\n"
          "If `View' < 0, the plugin is run on the current view.\n\n"
          "Plugin(Isosurface) creates as many views as there are "
          "time steps in `View'.";
@@ -118,6 +123,7 @@ PView *GMSH_IsosurfacePlugin::execute(PView *v)
   int iView = (int)IsosurfaceOptions_Number[4].def;
   _valueIndependent = 0;
   _extractVolume = (int)IsosurfaceOptions_Number[1].def;
+  _outputMesh = (int)IsosurfaceOptions_Number[7].def;
   _recurLevel = (int)IsosurfaceOptions_Number[2].def;
   _targetError = IsosurfaceOptions_Number[3].def;
   _valueTimeStep = (int)IsosurfaceOptions_Number[5].def;
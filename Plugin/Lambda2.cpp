@@ -65,167 +65,183 @@ static int inv3x3tran(double mat[3][3], double inv[3][3], double *det)
   return 1;
 }
 
-static void eigen(std::vector<double> &inList, int inNb,
-                  std::vector<double> &outList, int *outNb, int nbTime,
-                  int nbNod, int nbComp, int lam)
+// compute the eigenvalue on one element: in points to the coordinates and
+// values of the element, and out to the 3 * nbNod + nbTime * nbNod output
+// values of the element
+static void eigenOnElement(const double *in, double *out, int nbTime,
+                           int nbNod, int nbComp, int lam)
 {
-  if(!inNb || (nbComp != 3 && nbComp != 9) || lam < 1 || lam > 3) return;
+  // copy node coordinates
+  for(int j = 0; j < 3 * nbNod; j++) *out++ = in[j];
 
-  // loop on elements
-  int nb = inList.size() / inNb;
-  for(unsigned int i = 0; i < inList.size(); i += nb) {
-    // copy node coordinates
-    for(int j = 0; j < 3 * nbNod; j++) outList.push_back(inList[i + j]);
-
-    // loop on time steps
-    for(int j = 0; j < nbTime; j++) {
-      double *x = &inList[i];
-      double *y = &inList[i + nbNod];
-      double *z = &inList[i + 2 * nbNod];
+  // loop on time steps
+  for(int j = 0; j < nbTime; j++) {
+    const double *x = &in[0];
+    const double *y = &in[nbNod];
+    const double *z = &in[2 * nbNod];
 
-      double GradVel[3][3];
+    double GradVel[3][3];
 
-      if(nbComp == 9) {
-        // val is the velocity gradient tensor: we assume that it is
-        // constant per element
-        double *v = &inList[i + 3 * nbNod + nbNod * nbComp * j + nbComp * 0];
-        GradVel[0][0] = v[0];
-        GradVel[0][1] = v[1];
-        GradVel[0][2] = v[2];
-        GradVel[1][0] = v[3];
-        GradVel[1][1] = v[4];
-        GradVel[1][2] = v[5];
-        GradVel[2][0] = v[6];
-        GradVel[2][1] = v[7];
-        GradVel[2][2] = v[8];
-      }
-      else if(nbComp == 3) {
-        // FIXME: the following could be greatly simplified and
-        // generalized by using the classes in shapeFunctions.h
+    if(nbComp == 9) {
+      // val is the velocity gradient tensor: we assume that it is
+      // constant per element
+      const double *v = &in[3 * nbNod + nbNod * nbComp * j + nbComp * 0];
+      GradVel[0][0] = v[0];
+      GradVel[0][1] = v[1];
+      GradVel[0][2] = v[2];
+      GradVel[1][0] = v[3];
+      GradVel[1][1] = v[4];
+      GradVel[1][2] = v[5];
+      GradVel[2][0] = v[6];
+      GradVel[2][1] = v[7];
+      GradVel[2][2] = v[8];
+    }
+    else if(nbComp == 3) {
+      // FIXME: the following could be greatly simplified and
+      // generalized by using the classes in shapeFunctions.h
 
-        // val contains the velocities: compute the gradient tensor
-        // from them
-        const int MAX_NOD = 4;
-        double val[3][MAX_NOD];
-        for(int k = 0; k < nbNod; k++) {
-          double *v = &inList[i + 3 * nbNod + nbNod * nbComp * j + nbComp * k];
-          for(int l = 0; l < 3; l++) {
-            val[l][k] = v[l];
-          }
-        }
-        // compute gradient of shape functions
-        double GradPhi_x[MAX_NOD][3];
-        double GradPhi_ksi[MAX_NOD][3];
-        double dx_dksi[3][3];
-        double dksi_dx[3][3];
-        double det;
-        if(nbNod == 3) { // triangles
-          double a[3], b[3], cross[3];
-          a[0] = x[1] - x[0];
-          a[1] = y[1] - y[0];
-          a[2] = z[1] - z[0];
-          b[0] = x[2] - x[0];
-          b[1] = y[2] - y[0];
-          b[2] = z[2] - z[0];
-          prodve(a, b, cross);
-          dx_dksi[0][0] = x[1] - x[0];
-          dx_dksi[0][1] = x[2] - x[0];
-          dx_dksi[0][2] = cross[0];
-          dx_dksi[1][0] = y[1] - y[0];
-          dx_dksi[1][1] = y[2] - y[0];
-          dx_dksi[1][2] = cross[1];
-          dx_dksi[2][0] = z[1] - z[0];
-          dx_dksi[2][1] = z[2] - z[0];
-          dx_dksi[2][2] = cross[2];
-          inv3x3tran(dx_dksi, dksi_dx, &det);
-          GradPhi_ksi[0][0] = -1;
-          GradPhi_ksi[0][1] = -1;
-          GradPhi_ksi[0][2] = 0;
-          GradPhi_ksi[1][0] = 1;
-          GradPhi_ksi[1][1] = 0;
-          GradPhi_ksi[1][2] = 0;
-          GradPhi_ksi[2][0] = 0;
-          GradPhi_ksi[2][1] = 1;
-          GradPhi_ksi[2][2] = 0;
-        }
-        else if(nbNod == 4) { // tetrahedra
-          dx_dksi[0][0] = x[1] - x[0];
-          dx_dksi[0][1] = x[2] - x[0];
-          dx_dksi[0][2] = x[3] - x[0];
-          dx_dksi[1][0] = y[1] - y[0];
-          dx_dksi[1][1] = y[2] - y[0];
-          dx_dksi[1][2] = y[3] - y[0];
-          dx_dksi[2][0] = z[1] - z[0];
-          dx_dksi[2][1] = z[2] - z[0];
-          dx_dksi[2][2] = z[3] - z[0];
-          inv3x3tran(dx_dksi, dksi_dx, &det);
-          GradPhi_ksi[0][0] = -1;
-          GradPhi_ksi[0][1] = -1;
-          GradPhi_ksi[0][2] = -1;
-          GradPhi_ksi[1][0] = 1;
-          GradPhi_ksi[1][1] = 0;
-          GradPhi_ksi[1][2] = 0;
-          GradPhi_ksi[2][0] = 0;
-          GradPhi_ksi[2][1] = 1;
-          GradPhi_ksi[2][2] = 0;
-          GradPhi_ksi[3][0] = 0;
-          GradPhi_ksi[3][1] = 0;
-          GradPhi_ksi[3][2] = 1;
-        }
-        else {
-          Msg::Error("Lambda2 not ready for this type of element");
-          return;
+      // val contains the velocities: compute the gradient tensor
+      // from them
+      const int MAX_NOD = 4;
+      double val[3][MAX_NOD];
+      for(int k = 0; k < nbNod; k++) {
+        const double *v = &in[3 * nbNod + nbNod * nbComp * j + nbComp * k];
+        for(int l = 0; l < 3; l++) {
+          val[l][k] = v[l];
         }
-        for(int k = 0; k < nbNod; k++) {
-          for(int l = 0; l < 3; l++) {
-            GradPhi_x[k][l] = 0.0;
-            for(int m = 0; m < 3; m++) {
-              GradPhi_x[k][l] += GradPhi_ksi[k][m] * dksi_dx[l][m];
-            }
+      }
+      // compute gradient of shape functions
+      double GradPhi_x[MAX_NOD][3];
+      double GradPhi_ksi[MAX_NOD][3];
+      double dx_dksi[3][3];
+      double dksi_dx[3][3];
+      double det;
+      if(nbNod == 3) { // triangles
+        double a[3], b[3], cross[3];
+        a[0] = x[1] - x[0];
+        a[1] = y[1] - y[0];
+        a[2] = z[1] - z[0];
+        b[0] = x[2] - x[0];
+        b[1] = y[2] - y[0];
+        b[2] = z[2] - z[0];
+        prodve(a, b, cross);
+        dx_dksi[0][0] = x[1] - x[0];
+        dx_dksi[0][1] = x[2] - x[0];
+        dx_dksi[0][2] = cross[0];
+        dx_dksi[1][0] = y[1] - y[0];
+        dx_dksi[1][1] = y[2] - y[0];
+        dx_dksi[1][2] = cross[1];
+        dx_dksi[2][0] = z[1] - z[0];
+        dx_dksi[2][1] = z[2] - z[0];
+        dx_dksi[2][2] = cross[2];
+        inv3x3tran(dx_dksi, dksi_dx, &det);
+        GradPhi_ksi[0][0] = -1;
+        GradPhi_ksi[0][1] = -1;
+        GradPhi_ksi[0][2] = 0;
+        GradPhi_ksi[1][0] = 1;
+        GradPhi_ksi[1][1] = 0;
+        GradPhi_ksi[1][2] = 0;
+        GradPhi_ksi[2][0] = 0;
+        GradPhi_ksi[2][1] = 1;
+        GradPhi_ksi[2][2] = 0;
+      }
+      else if(nbNod == 4) { // tetrahedra
+        dx_dksi[0][0] = x[1] - x[0];
+        dx_dksi[0][1] = x[2] - x[0];
+        dx_dksi[0][2] = x[3] - x[0];
+        dx_dksi[1][0] = y[1] - y[0];
+        dx_dksi[1][1] = y[2] - y[0];
+        dx_dksi[1][2] = y[3] - y[0];
+        dx_dksi[2][0] = z[1] - z[0];
+        dx_dksi[2][1] = z[2] - z[0];
+        dx_dksi[2][2] = z[3] - z[0];
+        inv3x3tran(dx_dksi, dksi_dx, &det);
+        GradPhi_ksi[0][0] = -1;
+        GradPhi_ksi[0][1] = -1;
+        GradPhi_ksi[0][2] = -1;
+        GradPhi_ksi[1][0] = 1;
+        GradPhi_ksi[1][1] = 0;
+        GradPhi_ksi[1][2] = 0;
+        GradPhi_ksi[2][0] = 0;
+        GradPhi_ksi[2][1] = 1;
+        GradPhi_ksi[2][2] = 0;
+        GradPhi_ksi[3][0] = 0;
+        GradPhi_ksi[3][1] = 0;
+        GradPhi_ksi[3][2] = 1;
+      }
+      for(int k = 0; k < nbNod; k++) {
+        for(int l = 0; l < 3; l++) {
+          GradPhi_x[k][l] = 0.0;
+          for(int m = 0; m < 3; m++) {
+            GradPhi_x[k][l] += GradPhi_ksi[k][m] * dksi_dx[l][m];
           }
         }
-        // compute gradient of velocities
-        for(int k = 0; k < 3; k++) {
-          for(int l = 0; l < 3; l++) {
-            GradVel[k][l] = 0.0;
-            for(int m = 0; m < nbNod; m++) {
-              GradVel[k][l] += val[k][m] * GradPhi_x[m][l];
-            }
+      }
+      // compute gradient of velocities
+      for(int k = 0; k < 3; k++) {
+        for(int l = 0; l < 3; l++) {
+          GradVel[k][l] = 0.0;
+          for(int m = 0; m < nbNod; m++) {
+            GradVel[k][l] += val[k][m] * GradPhi_x[m][l];
           }
         }
       }
-      else
-        for(int k = 0; k < 3; k++)
-          for(int l = 0; l < 3; l++) GradVel[k][l] = 0.0;
+    }
+    else
+      for(int k = 0; k < 3; k++)
+        for(int l = 0; l < 3; l++) GradVel[k][l] = 0.0;
 
-      // compute the sym and antisymetric parts
-      double sym[3][3];
-      double asym[3][3];
-      for(int m = 0; m < 3; m++) {
-        for(int n = 0; n < 3; n++) {
-          sym[m][n] = 0.5 * (GradVel[m][n] + GradVel[n][m]);
-          asym[m][n] = 0.5 * (GradVel[m][n] - GradVel[n][m]);
-        }
+    // compute the sym and antisymetric parts
+    double sym[3][3];
+    double asym[3][3];
+    for(int m = 0; m < 3; m++) {
+      for(int n = 0; n < 3; n++) {
+        sym[m][n] = 0.5 * (GradVel[m][n] + GradVel[n][m]);
+        asym[m][n] = 0.5 * (GradVel[m][n] - GradVel[n][m]);
       }
-      double a[3][3];
-      for(int m = 0; m < 3; m++) {
-        for(int n = 0; n < 3; n++) {
-          a[m][n] = 0.0;
-          for(int l = 0; l < 3; l++)
-            a[m][n] += sym[m][l] * sym[l][n] + asym[m][l] * asym[l][n];
-        }
+    }
+    double a[3][3];
+    for(int m = 0; m < 3; m++) {
+      for(int n = 0; n < 3; n++) {
+        a[m][n] = 0.0;
+        for(int l = 0; l < 3; l++)
+          a[m][n] += sym[m][l] * sym[l][n] + asym[m][l] * asym[l][n];
       }
-
-      // compute the eigenvalues
-      double lambda[3];
-      eigenvalue(a, lambda);
-      for(int k = 0; k < nbNod; k++) outList.push_back(lambda[lam - 1]);
     }
 
-    (*outNb)++;
+    // compute the eigenvalues
+    double lambda[3];
+    eigenvalue(a, lambda);
+    for(int k = 0; k < nbNod; k++) *out++ = lambda[lam - 1];
   }
 }
 
+static void eigen(std::vector<double> &inList, int inNb,
+                  std::vector<double> &outList, int *outNb, int nbTime,
+                  int nbNod, int nbComp, int lam)
+{
+  if(!inNb || (nbComp != 3 && nbComp != 9) || lam < 1 || lam > 3) return;
+  if(nbComp == 3 && nbNod != 3 && nbNod != 4) {
+    Msg::Error("Lambda2 not ready for this type of element");
+    return;
+  }
+
+  // the output size is known beforehand: each element writes its values at
+  // its own offset, so that the elements can be processed concurrently
+  int nb = inList.size() / inNb;
+  int outNbPerElement = 3 * nbNod + nbTime * nbNod;
+  std::size_t outBeg = outList.size();
+  outList.resize(outBeg + (std::size_t)inNb * outNbPerElement);
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if(inNb > 1000)
+#endif
+  for(int i = 0; i < inNb; i++)
+    eigenOnElement(&inList[(std::size_t)i * nb],
+                   &outList[outBeg + (std::size_t)i * outNbPerElement], nbTime,
+                   nbNod, nbComp, lam);
+  *outNb += inNb;
+}
+
 PView *GMSH_Lambda2Plugin::execute(PView *v)
 {
   int ev = (int)Lambda2Options_Number[0].def;
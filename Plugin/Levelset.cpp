@@ -3,6 +3,8 @@
 // See the LICENSE.txt file for license information. Please report all
 // issues on https://gitlab.onelab.info/gmsh/gmsh/issues
 
+#include <map>
+#include <algorithm>
 #include "Levelset.h"
 #include "MakeSimplex.h"
 #include "Numeric.h"
@@ -10,6 +12,14 @@
 #include "adaptiveData.h"
 #include "GmshDefines.h"
 #include "PViewOptions.h"
+#include "PViewDataGModel.h"
+#include "GModel.h"
+#include "discreteEdge.h"
+#include "discreteFace.h"
+#include "MLine.h"
+#include "MTriangle.h"
+#include "MQuadrangle.h"
+#include "Context.h"
 
 static const int exn[13][12][2] = {
   {{0, 0}}, // point
@@ -221,9 +231,69 @@ static void reorderPrism(int numComp, double xp[12], double yp[12],
   }
 }
 
+// Intersections of the edges of the elements with the levelset. They are
+// computed once per edge instead of once per simplex containing the edge: the
+// edges are identified by the numbers of their end nodes if the view has them
+// and if the levelset has the same value at a node in all the elements (the
+// intersections are then shared by all the elements processed with the
+// cache), or by their local nodes in the current element otherwise. When the
+// cut is created as a mesh, the cache also stores the intersection points
+// used by the elements of the cut, their values and the elements.
+class levelsetCache {
+public:
+  typedef std::pair<std::size_t, std::size_t> edge;
+  class point {
+  public:
+    edge e; // (n, n) if the point is the node n
+    // coordinates, and location along the edge from its first node
+    double x, y, z, c;
+    int index; // index in the mesh of the cut, or -1
+  };
+  std::map<edge, point> edges, localEdges;
+  bool shared, mesh;
+  int numComp, numSteps;
+  std::vector<edge> meshEdges; // edge of each point of the mesh
+  std::vector<double> meshXYZ, meshValues; // numSteps * numComp per point
+  std::vector<int> lines, triangles, quadrangles; // points of the elements
+  levelsetCache() : shared(false), mesh(false), numComp(0), numSteps(0) {}
+};
+
+// add the element obtained by cutting a simplex to the mesh of the cache,
+// together with the values of its nodes at the given step
+static void addMeshElement(levelsetCache &cache, int np, int numComp,
+                           double valp[12][9], int ep[12],
+                           levelsetCache::point *cut[12], int step,
+                           bool firstStep)
+{
+  if(np < 2 || np > 4 || numComp != cache.numComp) return;
+  int index[4];
+  for(int k = 0; k < np; k++) {
+    levelsetCache::point *p = cut[ep[k] - 1];
+    if(p->index < 0) {
+      p->index = cache.meshEdges.size();
+      cache.meshEdges.push_back(p->e);
+      cache.meshXYZ.push_back(p->x);
+      cache.meshXYZ.push_back(p->y);
+      cache.meshXYZ.push_back(p->z);
+      cache.meshValues.resize(
+        cache.meshValues.size() + cache.numSteps * numComp, 0.);
+    }
+    for(int comp = 0; comp < numComp; comp++)
+      cache.meshValues[(p->index * cache.numSteps + step) * numComp + comp] =
+        valp[k][comp];
+    index[k] = p->index;
+  }
+  if(!firstStep) return;
+  std::vector<int> *elements = &cache.quadrangles;
+  if(np == 2)
+    elements = &cache.lines;
+  else if(np == 3)
+    elements = &cache.triangles;
+  elements->insert(elements->end(), index, index + np);
+}
+
 GMSH_LevelsetPlugin::GMSH_LevelsetPlugin()
 {
-  _invert = 0.;
   _ref[0] = _ref[1] = _ref[2] = 0.;
   _valueIndependent = 0; // "moving" levelset
   _valueView = -1; // use same view for levelset and field data
@@ -233,12 +303,14 @@ GMSH_LevelsetPlugin::GMSH_LevelsetPlugin()
   _extractVolume =
     0; // to create isovolumes (keep all elements < or > levelset)
   _orientation = GMSH_LevelsetPlugin::NONE;
+  _outputMesh = 0; // to create a mesh-based view
 }
 
 void GMSH_LevelsetPlugin::_addElement(int np, int numEdges, int numComp,
                                       double xp[12], double yp[12],
                                       double zp[12], double valp[12][9],
-                                      PViewDataList *out, bool firstStep)
+                                      PViewDataList *out,
+                                      bool firstStep) const
 {
   std::vector<double> *list;
   int *nbPtr;
@@ -374,7 +446,7 @@ void GMSH_LevelsetPlugin::_addElement(int np, int numEdges, int numComp,
 void GMSH_LevelsetPlugin::_cutAndAddElements(
   PViewData *vdata, PViewData *wdata, int ent, int ele, int vstep, int wstep,
   double x[8], double y[8], double z[8], double levels[8],
-  double scalarValues[8], PViewDataList *out)
+  double scalarValues[8], levelsetCache &cache, PViewDataList *out) const
 {
   int stepmin = vstep, stepmax = vstep + 1, otherstep = wstep;
   if(stepmin < 0) {
@@ -388,15 +460,67 @@ void GMSH_LevelsetPlugin::_cutAndAddElements(
   int numComp = wdata->getNumComponents(otherstep, ent, ele);
   int type = vdata->getType(stepmin, ent, ele);
 
+  // identify the nodes by their numbers, so that the intersection of an edge
+  // shared by several elements is only computed once; if the nodes are not
+  // numbered, only the edges shared by the simplices of the element are
+  std::size_t nodes[8];
+  bool numbered = cache.shared;
+  for(int nod = 0; nod < numNodes; nod++) {
+    nodes[nod] = vdata->getNodeNumber(stepmin, ent, ele, nod);
+    if(!nodes[nod]) numbered = false;
+  }
+  if(!numbered) {
+    for(int nod = 0; nod < numNodes; nod++) nodes[nod] = nod;
+    cache.localEdges.clear();
+  }
+  std::map<levelsetCache::edge, levelsetCache::point> &edges =
+    numbered ? cache.edges : cache.localEdges;
+
   // decompose the element into simplices
   for(int simplex = 0; simplex < numSimplexDec(type); simplex++) {
     int n[4], ep[12], nsn, nse;
     getSimplexDec(numNodes, numEdges, type, simplex, n[0], n[1], n[2], n[3],
                   nsn, nse);
+    double invert = 0.;
+
+    // check which edges cut the iso: the end nodes are sorted by number, so
+    // that the intersection is computed in the same way in all the elements
+    // sharing the edge; if the levelset vanishes on an end node, the
+    // intersection is the node itself
+    levelsetCache::point *cut[12];
+    int cutNodes[12][2];
+    double cutCoef[12];
+    for(int i = 0; i < nse; i++) {
+      int n0 = n[exn[nse][i][0]], n1 = n[exn[nse][i][1]];
+      cut[i] = 0;
+      if(levels[n0] * levels[n1] > 0.) continue;
+      if(nodes[n1] < nodes[n0]) std::swap(n0, n1);
+      levelsetCache::edge e(nodes[n0], nodes[n1]);
+      if(levels[n0] == 0.)
+        e.second = nodes[n0];
+      else if(levels[n1] == 0.)
+        e.first = nodes[n1];
+      std::map<levelsetCache::edge, levelsetCache::point>::iterator it =
+        edges.find(e);
+      if(it == edges.end()) {
+        levelsetCache::point p;
+        p.e = e;
+        p.c = InterpolateIso(x, y, z, levels, 0., n0, n1, &p.x, &p.y, &p.z);
+        p.index = -1;
+        it = edges.insert(std::make_pair(e, p)).first;
+      }
+      cut[i] = &it->second;
+      cutNodes[i][0] = n0;
+      cutNodes[i][1] = n1;
+      // the location along the edge of a point cached for a node does not
+      // depend on the edge it was computed for
+      cutCoef[i] = (e.first != e.second) ? it->second.c :
+                                           (e.first == nodes[n0]) ? 0. : 1.;
+    }
 
     // loop over time steps
     for(int step = stepmin; step < stepmax; step++) {
-      // check which edges cut the iso and interpolate the value
+      // interpolate the value at the intersections
       if(wstep < 0) otherstep = step;
 
       if(!wdata->hasTimeStep(otherstep)) continue;
@@ -404,18 +528,17 @@ void GMSH_LevelsetPlugin::_cutAndAddElements(
       int np = 0;
       double xp[12], yp[12], zp[12], valp[12][9];
       for(int i = 0; i < nse; i++) {
-        int n0 = exn[nse][i][0], n1 = exn[nse][i][1];
-        if(levels[n[n0]] * levels[n[n1]] <= 0.) {
-          double c = InterpolateIso(x, y, z, levels, 0., n[n0], n[n1], &xp[np],
-                                    &yp[np], &zp[np]);
-          for(int comp = 0; comp < numComp; comp++) {
-            double v0, v1;
-            wdata->getValue(otherstep, ent, ele, n[n0], comp, v0);
-            wdata->getValue(otherstep, ent, ele, n[n1], comp, v1);
-            valp[np][comp] = v0 + c * (v1 - v0);
-          }
-          ep[np++] = i + 1;
+        if(!cut[i]) continue;
+        xp[np] = cut[i]->x;
+        yp[np] = cut[i]->y;
+        zp[np] = cut[i]->z;
+        for(int comp = 0; comp < numComp; comp++) {
+          double v0, v1;
+          wdata->getValue(otherstep, ent, ele, cutNodes[i][0], comp, v0);
+          wdata->getValue(otherstep, ent, ele, cutNodes[i][1], comp, v1);
+          valp[np][comp] = v0 + cutCoef[i] * (v1 - v0);
         }
+        ep[np++] = i + 1;
       }
 
       // remove identical nodes (this can happen if an edge actually
@@ -470,19 +593,19 @@ void GMSH_LevelsetPlugin::_cutAndAddElements(
           switch(_orientation) {
           case MAP:
             gradSimplex(x, y, z, scalarValues, gr);
-            _invert = prosca(gr, normal);
+            invert = prosca(gr, normal);
             break;
-          case PLANE: _invert = prosca(normal, _ref); break;
+          case PLANE: invert = prosca(normal, _ref); break;
           case SPHERE:
             gr[0] = xp[0] - _ref[0];
             gr[1] = yp[0] - _ref[1];
             gr[2] = zp[0] - _ref[2];
-            _invert = prosca(gr, normal);
+            invert = prosca(gr, normal);
           case NONE:
           default: break;
           }
         }
-        if(_invert > 0.) {
+        if(invert > 0.) {
           double xpi[12], ypi[12], zpi[12], valpi[12][9];
           int epi[12];
           for(int k = 0; k < np; k++)
@@ -520,16 +643,129 @@ void GMSH_LevelsetPlugin::_cutAndAddElements(
       }
 
       // finally, add the new element
-      _addElement(np, numEdges, numComp, xp, yp, zp, valp, out,
-                  step == stepmin);
+      if(cache.mesh)
+        addMeshElement(cache, np, numComp, valp, ep, cut, step - stepmin,
+                       step == stepmin);
+      else
+        _addElement(np, numEdges, numComp, xp, yp, zp, valp, out,
+                    step == stepmin);
+    }
+  }
+}
+
+// cut one element of the view, using the cache of the range of elements it
+// belongs to
+class levelsetOnElement {
+private:
+  const GMSH_LevelsetPlugin *_plugin;
+  PViewData *_vdata, *_wdata;
+  int _vstep, _wstep, _step;
+
+public:
+  mutable std::vector<levelsetCache> caches; // per range
+  levelsetOnElement(const GMSH_LevelsetPlugin *plugin, PViewData *vdata,
+                    PViewData *wdata, int vstep, int wstep, int numRanges,
+                    bool shared, bool mesh, int numComp, int numSteps)
+    : _plugin(plugin), _vdata(vdata), _wdata(wdata), _vstep(vstep),
+      _wstep(wstep), caches(numRanges)
+  {
+    _step = (vstep < 0) ? vdata->getFirstNonEmptyTimeStep() : vstep;
+    for(int r = 0; r < numRanges; r++) {
+      caches[r].shared = shared;
+      caches[r].mesh = mesh;
+      caches[r].numComp = numComp;
+      caches[r].numSteps = numSteps;
+    }
+  }
+  void operator()(int range, int ent, int ele, PViewDataList **out) const
+  {
+    if(_vdata->skipElement(_step, ent, ele)) return;
+    double x[8], y[8], z[8], levels[8];
+    double scalarValues[8] = {0., 0., 0., 0., 0., 0., 0., 0.};
+    for(int nod = 0; nod < _vdata->getNumNodes(_step, ent, ele); nod++) {
+      _vdata->getNode(_step, ent, ele, nod, x[nod], y[nod], z[nod]);
+      // the levelset only depends on the values for "moving" levelsets
+      if(_vstep >= 0)
+        _vdata->getScalarValue(_step, ent, ele, nod, scalarValues[nod]);
+      levels[nod] =
+        _plugin->levelset(x[nod], y[nod], z[nod], scalarValues[nod]);
     }
+    _plugin->_cutAndAddElements(_vdata, _wdata, ent, ele, _vstep, _wstep, x,
+                                y, z, levels, scalarValues, caches[range],
+                                out ? out[0] : 0);
+  }
+};
 
-    if(vstep < 0) {
-      for(int i = stepmin; i < stepmax; i++) {
-        out->Time.push_back(vdata->getTime(i));
+// create a mesh-based view with the mesh of the cut stored in the caches: the
+// points shared by several caches are merged, and the new elements are added
+// to new discrete entities of the model
+static PView *createMeshView(GModel *m, std::vector<levelsetCache> &caches,
+                             const std::vector<double> &times, int numComp)
+{
+  std::size_t numLines = 0, numSurfaces = 0;
+  for(std::size_t r = 0; r < caches.size(); r++) {
+    numLines += caches[r].lines.size();
+    numSurfaces += caches[r].triangles.size() + caches[r].quadrangles.size();
+  }
+  if(!numLines && !numSurfaces) {
+    Msg::Warning("Levelset does not cut any element");
+    return 0;
+  }
+
+  discreteEdge *de = 0;
+  discreteFace *df = 0;
+  if(numLines) {
+    de = new discreteEdge(m, m->getMaxElementaryNumber(1) + 1, 0, 0);
+    m->add(de);
+  }
+  if(numSurfaces) {
+    df = new discreteFace(m, m->getMaxElementaryNumber(2) + 1);
+    m->add(df);
+  }
+  GEntity *ge = df ? (GEntity *)df : (GEntity *)de;
+
+  std::map<levelsetCache::edge, MVertex *> vertices;
+  std::vector<std::size_t> tags;
+  std::vector<std::vector<std::vector<double> > > values(times.size());
+  for(std::size_t r = 0; r < caches.size(); r++) {
+    levelsetCache &c = caches[r];
+    std::vector<MVertex *> v(c.meshEdges.size());
+    for(std::size_t i = 0; i < c.meshEdges.size(); i++) {
+      std::map<levelsetCache::edge, MVertex *>::iterator it =
+        vertices.find(c.meshEdges[i]);
+      if(it != vertices.end()) {
+        v[i] = it->second;
+        continue;
+      }
+      v[i] = new MVertex(c.meshXYZ[3 * i], c.meshXYZ[3 * i + 1],
+                         c.meshXYZ[3 * i + 2], ge);
+      ge->mesh_vertices.push_back(v[i]);
+      vertices[c.meshEdges[i]] = v[i];
+      tags.push_back(v[i]->getNum());
+      for(std::size_t step = 0; step < times.size(); step++) {
+        double *val = &c.meshValues[(i * times.size() + step) * numComp];
+        values[step].push_back(std::vector<double>(val, val + numComp));
       }
     }
+    for(std::size_t i = 0; i < c.lines.size(); i += 2)
+      de->lines.push_back(new MLine(v[c.lines[i]], v[c.lines[i + 1]]));
+    for(std::size_t i = 0; i < c.triangles.size(); i += 3)
+      df->triangles.push_back(new MTriangle(
+        v[c.triangles[i]], v[c.triangles[i + 1]], v[c.triangles[i + 2]]));
+    for(std::size_t i = 0; i < c.quadrangles.size(); i += 4)
+      df->quadrangles.push_back(
+        new MQuadrangle(v[c.quadrangles[i]], v[c.quadrangles[i + 1]],
+                        v[c.quadrangles[i + 2]], v[c.quadrangles[i + 3]]));
   }
+  // the vertex and element caches (and the element octree) of the model do not
+  // know about the new entities
+  m->destroyMeshCaches();
+  CTX::instance()->mesh.changed = ENT_ALL;
+
+  PViewDataGModel *d = new PViewDataGModel(PViewDataGModel::NodeData);
+  for(std::size_t step = 0; step < times.size(); step++)
+    d->addData(m, tags, values[step], step, times[step], -1, numComp);
+  return new PView(d);
 }
 
 PView *GMSH_LevelsetPlugin::execute(PView *v)
@@ -569,54 +805,84 @@ PView *GMSH_LevelsetPlugin::execute(PView *v)
   // Force creation of one view per time step if we have multi meshes
   if(vdata->hasMultipleMeshes()) _valueIndependent = 0;
 
-  double x[8], y[8], z[8], levels[8];
-  double scalarValues[8] = {0., 0., 0., 0., 0., 0., 0., 0.};
+  // the intersections of the edges can be shared by the elements if the
+  // levelset is continuous, and the cut can be created as a mesh if the values
+  // are continuous too
+  bool shared = _valueIndependent || vdata->isNodeData();
+  bool mesh = false;
+  if(_outputMesh) {
+    if(_extractVolume)
+      Msg::Warning("Cannot create a mesh when extracting volumes");
+    else if(!vdata->isNodeData() || !wdata->isNodeData())
+      Msg::Warning("Cannot create a mesh from views without node data");
+    else
+      mesh = true;
+  }
+  PViewDataGModel *vgmodel = dynamic_cast<PViewDataGModel *>(vdata);
 
   if(_valueIndependent) {
     // create a single output view containing the (possibly multi-step) levelset
     int firstNonEmptyStep = vdata->getFirstNonEmptyTimeStep();
-    PViewDataList *out = getDataList(new PView());
-    for(int ent = 0; ent < vdata->getNumEntities(firstNonEmptyStep); ent++) {
-      for(int ele = 0; ele < vdata->getNumElements(firstNonEmptyStep, ent);
-          ele++) {
-        if(vdata->skipElement(firstNonEmptyStep, ent, ele)) continue;
-        for(int nod = 0; nod < vdata->getNumNodes(firstNonEmptyStep, ent, ele);
-            nod++) {
-          vdata->getNode(firstNonEmptyStep, ent, ele, nod, x[nod], y[nod],
-                         z[nod]);
-          levels[nod] = levelset(x[nod], y[nod], z[nod], 0.);
-        }
-        _cutAndAddElements(vdata, wdata, ent, ele, -1, _valueTimeStep, x, y, z,
-                           levels, scalarValues, out);
-      }
+    std::vector<double> times;
+    for(int step = firstNonEmptyStep; step < vdata->getNumTimeSteps(); step++)
+      times.push_back(vdata->getTime(step));
+    int wstep =
+      (_valueTimeStep < 0) ? wdata->getFirstNonEmptyTimeStep() : _valueTimeStep;
+    postElementLoop loop(vdata, firstNonEmptyStep,
+                         wdata->canReadConcurrently());
+    levelsetOnElement f(this, vdata, wdata, -1, _valueTimeStep,
+                        loop.getNumRanges(), shared, mesh,
+                        mesh ? wdata->getNumComponents(wstep, 0, 0) : 0,
+                        times.size());
+    PViewData *out = 0;
+    if(mesh) {
+      loop.run(f);
+      PView *v2 = createMeshView(vgmodel->getModel(firstNonEmptyStep),
+                                 f.caches, times, f.caches[0].numComp);
+      if(v2) out = v2->getData();
+    }
+    else {
+      PViewDataList *list = getDataList(new PView());
+      loop.run(f, 1, &list);
+      list->Time.insert(list->Time.end(), times.begin(), times.end());
+      out = list;
+    }
+    if(out) {
+      out->setName(vdata->getName() + "_Levelset");
+      out->setFileName(vdata->getFileName() + "_Levelset" +
+                       (mesh ? ".msh" : ".pos"));
+      out->finalize();
     }
-    out->setName(vdata->getName() + "_Levelset");
-    out->setFileName(vdata->getFileName() + "_Levelset.pos");
-    out->finalize();
   }
   else {
     // create one view per timestep
     for(int step = 0; step < vdata->getNumTimeSteps(); step++) {
       if(!vdata->hasTimeStep(step)) continue;
-      PViewDataList *out = getDataList(new PView());
-      for(int ent = 0; ent < vdata->getNumEntities(step); ent++) {
-        for(int ele = 0; ele < vdata->getNumElements(step, ent); ele++) {
-          if(vdata->skipElement(step, ent, ele)) continue;
-          for(int nod = 0; nod < vdata->getNumNodes(step, ent, ele); nod++) {
-            vdata->getNode(step, ent, ele, nod, x[nod], y[nod], z[nod]);
-            vdata->getScalarValue(step, ent, ele, nod, scalarValues[nod]);
-            levels[nod] = levelset(x[nod], y[nod], z[nod], scalarValues[nod]);
-          }
-          int wstep = (_valueTimeStep < 0) ? step : _valueTimeStep;
-          _cutAndAddElements(vdata, wdata, ent, ele, step, wstep, x, y, z,
-                             levels, scalarValues, out);
-        }
+      int wstep = (_valueTimeStep < 0) ? step : _valueTimeStep;
+      postElementLoop loop(vdata, step, wdata->canReadConcurrently());
+      levelsetOnElement f(this, vdata, wdata, step, wstep, loop.getNumRanges(),
+                          shared, mesh,
+                          mesh ? wdata->getNumComponents(wstep, 0, 0) : 0, 1);
+      PViewData *out = 0;
+      if(mesh) {
+        loop.run(f);
+        PView *v2 = createMeshView(vgmodel->getModel(step), f.caches,
+                                   std::vector<double>(1, vdata->getTime(step)),
+                                   f.caches[0].numComp);
+        if(v2) out = v2->getData();
+      }
+      else {
+        PViewDataList *list = getDataList(new PView());
+        loop.run(f, 1, &list);
+        out = list;
+      }
+      if(out) {
+        char tmp[246];
+        sprintf(tmp, "_Levelset_%d", step);
+        out->setName(vdata->getName() + tmp);
+        out->setFileName(vdata->getFileName() + tmp + (mesh ? ".msh" : ".pos"));
+        out->finalize();
       }
-      char tmp[246];
-      sprintf(tmp, "_Levelset_%d", step);
-      out->setName(vdata->getName() + tmp);
-      out->setFileName(vdata->getFileName() + tmp + ".pos");
-      out->finalize();
     }
   }
 
@@ -8,21 +8,24 @@
 
 #include "Plugin.h"
 
+class levelsetCache;
+
 class GMSH_LevelsetPlugin : public GMSH_PostPlugin {
+  friend class levelsetOnElement;
+
 private:
-  double _invert;
   void _addElement(int np, int numEdges, int numComp, double xp[12],
                    double yp[12], double zp[12], double valp[12][9],
-                   PViewDataList *out, bool firstStep);
+                   PViewDataList *out, bool firstStep) const;
   void _cutAndAddElements(PViewData *vdata, PViewData *wdata, int ent, int ele,
                           int step, int wstep, double x[8], double y[8],
                           double z[8], double levels[8], double scalarValues[8],
-                          PViewDataList *out);
+                          levelsetCache &cache, PViewDataList *out) const;
 
 protected:
   double _ref[3], _targetError;
   int _valueTimeStep, _valueView, _valueIndependent, _recurLevel,
-    _extractVolume;
+    _extractVolume, _outputMesh;
   typedef enum { NONE, PLANE, SPHERE, MAP } ORIENTATION;
   ORIENTATION _orientation;
 
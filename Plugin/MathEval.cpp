@@ -85,6 +85,89 @@ StringXString *GMSH_MathEvalPlugin::getOptionStr(int iopt)
   return &MathEvalOptions_String[iopt];
 }
 
+// evaluate the expressions on one element of the view
+class mathEvalOnElement {
+private:
+  PViewData *_data, *_otherData;
+  OctreePost *_octree;
+  const mathEvaluator &_f;
+  const std::vector<char> &_entities; // entities in the physical region
+  int _timeBeg, _timeEnd, _otherTimeStep, _forceInterpolation, _numComp2;
+  // has the evaluation failed in each range of elements?
+  mutable std::vector<char> _failed;
+
+public:
+  mathEvalOnElement(PViewData *data, PViewData *otherData, OctreePost *octree,
+                    const mathEvaluator &f, const std::vector<char> &entities,
+                    int timeBeg, int timeEnd, int otherTimeStep,
+                    int forceInterpolation, int numComp2, int numRanges)
+    : _data(data), _otherData(otherData), _octree(octree), _f(f),
+      _entities(entities), _timeBeg(timeBeg), _timeEnd(timeEnd),
+      _otherTimeStep(otherTimeStep), _forceInterpolation(forceInterpolation),
+      _numComp2(numComp2), _failed(numRanges, 0)
+  {
+  }
+  void operator()(int range, int ent, int ele, PViewDataList **out) const
+  {
+    if(_failed[range] || !_entities[ent]) return;
+    if(_data->skipElement(_timeBeg, ent, ele)) return;
+    int numNodes = _data->getNumNodes(_timeBeg, ent, ele);
+    int type = _data->getType(_timeBeg, ent, ele);
+    int numComp = _data->getNumComponents(_timeBeg, ent, ele);
+    int otherNumComp = (!_otherData || _octree) ?
+                         9 :
+                         _otherData->getNumComponents(_timeBeg, ent, ele);
+    std::vector<double> *list =
+      out[0]->incrementList(_numComp2, type, numNodes);
+    std::vector<double> v(std::max(9, numComp), 0.);
+    std::vector<double> w(std::max(9, otherNumComp), 0.);
+    std::vector<double> x(numNodes), y(numNodes), z(numNodes);
+    for(int nod = 0; nod < numNodes; nod++)
+      _data->getNode(_timeBeg, ent, ele, nod, x[nod], y[nod], z[nod]);
+    for(int nod = 0; nod < numNodes; nod++) list->push_back(x[nod]);
+    for(int nod = 0; nod < numNodes; nod++) list->push_back(y[nod]);
+    for(int nod = 0; nod < numNodes; nod++) list->push_back(z[nod]);
+    const int numVariables = 21;
+    std::vector<double> values(numNodes * numVariables);
+    std::vector<double> res(numNodes * _numComp2);
+    for(int step = _timeBeg; step < _timeEnd; step++) {
+      if(!_data->hasTimeStep(step)) continue;
+      int step2 = (_otherTimeStep < 0) ? step : _otherTimeStep;
+      for(int nod = 0; nod < numNodes; nod++) {
+        for(int comp = 0; comp < numComp; comp++)
+          _data->getValue(step, ent, ele, nod, comp, v[comp]);
+        if(_otherData) {
+          if(_octree) {
+            int qn = _forceInterpolation ? numNodes : 0;
+            if(!_octree->searchScalar(x[nod], y[nod], z[nod], &w[0], step2,
+                                      0, qn, &x[0], &y[0], &z[0]))
+              if(!_octree->searchVector(x[nod], y[nod], z[nod], &w[0], step2,
+                                        0, qn, &x[0], &y[0], &z[0]))
+                _octree->searchTensor(x[nod], y[nod], z[nod], &w[0], step2, 0,
+                                      qn, &x[0], &y[0], &z[0]);
+          }
+          else
+            for(int comp = 0; comp < otherNumComp; comp++)
+              _otherData->getValue(step2, ent, ele, nod, comp, w[comp]);
+        }
+        double *val = &values[nod * numVariables];
+        val[0] = x[nod];
+        val[1] = y[nod];
+        val[2] = z[nod];
+        for(int i = 0; i < 9; i++) val[3 + i] = v[i];
+        for(int i = 0; i < 9; i++) val[12 + i] = w[i];
+      }
+      // evaluate the expressions on all the nodes of the element at once
+      if(_f.eval(&values[0], numNodes, &res[0]))
+        list->insert(list->end(), res.begin(), res.end());
+      else {
+        _failed[range] = 1;
+        return;
+      }
+    }
+  }
+};
+
 PView *GMSH_MathEvalPlugin::execute(PView *view)
 {
   int timeStep = (int)MathEvalOptions_Number[0].def;
@@ -156,7 +239,6 @@ PView *GMSH_MathEvalPlugin::execute(PView *view)
   for(unsigned int i = 0; i < numVariables; i++) variables[i] = names[i];
   mathEvaluator f(expr, variables);
   if(expr.empty()) return view;
-  std::vector<double> values(numVariables), res(numComp2);
 
   OctreePost *octree = 0;
   if(forceInterpolation ||
@@ -181,71 +263,29 @@ PView *GMSH_MathEvalPlugin::execute(PView *view)
   int firstNonEmptyStep = data1->getFirstNonEmptyTimeStep();
   int timeBeg = (timeStep < 0) ? firstNonEmptyStep : timeStep;
   int timeEnd = (timeStep < 0) ? -timeStep : timeStep + 1;
-  for(int ent = 0; ent < data1->getNumEntities(timeBeg); ent++) {
-    bool ok = (physicalRegion <= 0);
-    if(physicalRegion > 0) {
+  std::vector<char> entities(data1->getNumEntities(timeBeg), 1);
+  if(physicalRegion > 0) {
+    for(std::size_t ent = 0; ent < entities.size(); ent++) {
       GEntity *ge = data1->getEntity(timeBeg, ent);
       if(ge) {
         std::vector<int>::iterator it =
           std::find(ge->physicals.begin(), ge->physicals.end(), physicalRegion);
-        ok = (it != ge->physicals.end());
-      }
-    }
-    if(!ok) continue;
-    for(int ele = 0; ele < data1->getNumElements(timeBeg, ent); ele++) {
-      if(data1->skipElement(timeBeg, ent, ele)) continue;
-      int numNodes = data1->getNumNodes(timeBeg, ent, ele);
-      int type = data1->getType(timeBeg, ent, ele);
-      int numComp = data1->getNumComponents(timeBeg, ent, ele);
-      int otherNumComp = (!otherData || octree) ?
-                           9 :
-                           otherData->getNumComponents(timeBeg, ent, ele);
-      std::vector<double> *out = data2->incrementList(numComp2, type, numNodes);
-      std::vector<double> v(std::max(9, numComp), 0.);
-      std::vector<double> w(std::max(9, otherNumComp), 0.);
-      std::vector<double> x(numNodes), y(numNodes), z(numNodes);
-      for(int nod = 0; nod < numNodes; nod++)
-        data1->getNode(timeBeg, ent, ele, nod, x[nod], y[nod], z[nod]);
-      for(int nod = 0; nod < numNodes; nod++) out->push_back(x[nod]);
-      for(int nod = 0; nod < numNodes; nod++) out->push_back(y[nod]);
-      for(int nod = 0; nod < numNodes; nod++) out->push_back(z[nod]);
-      for(int step = timeBeg; step < timeEnd; step++) {
-        if(!data1->hasTimeStep(step)) continue;
-        int step2 = (otherTimeStep < 0) ? step : otherTimeStep;
-        for(int nod = 0; nod < numNodes; nod++) {
-          for(int comp = 0; comp < numComp; comp++)
-            data1->getValue(step, ent, ele, nod, comp, v[comp]);
-          if(otherData) {
-            if(octree) {
-              int qn = forceInterpolation ? numNodes : 0;
-              if(!octree->searchScalar(x[nod], y[nod], z[nod], &w[0], step2, 0,
-                                       qn, &x[0], &y[0], &z[0]))
-                if(!octree->searchVector(x[nod], y[nod], z[nod], &w[0], step2,
-                                         0, qn, &x[0], &y[0], &z[0]))
-                  octree->searchTensor(x[nod], y[nod], z[nod], &w[0], step2, 0,
-                                       qn, &x[0], &y[0], &z[0]);
-            }
-            else
-              for(int comp = 0; comp < otherNumComp; comp++)
-                otherData->getValue(step2, ent, ele, nod, comp, w[comp]);
-          }
-          values[0] = x[nod];
-          values[1] = y[nod];
-          values[2] = z[nod];
-          for(int i = 0; i < 9; i++) values[3 + i] = v[i];
-          for(int i = 0; i < 9; i++) values[12 + i] = w[i];
-          if(f.eval(values, res)) {
-            for(int i = 0; i < numComp2; i++) out->push_back(res[i]);
-          }
-          else {
-            goto end;
-          }
-        }
+        entities[ent] = (it != ge->physicals.end());
       }
+      else
+        entities[ent] = 0;
     }
   }
 
-end:
+  // the other view is also read concurrently, directly or through the octree
+  bool concurrent = octree ? octree->canSearchConcurrently() :
+                             otherData->canReadConcurrently();
+  postElementLoop loop(data1, timeBeg, concurrent);
+  mathEvalOnElement g(data1, otherData, octree, f, entities, timeBeg, timeEnd,
+                      otherTimeStep, forceInterpolation, numComp2,
+                      loop.getNumRanges());
+  loop.run(g, 1, &data2);
+
   if(octree) delete octree;
 
   if(timeStep < 0) {
@@ -88,6 +88,115 @@ StringXString *GMSH_ModifyComponentsPlugin::getOptionStr(int iopt)
   return &ModifyComponentsOptions_String[iopt];
 }
 
+// modify the components of one element of the view, in place
+class modifyComponentsOnElement {
+private:
+  PViewData *_data1, *_data2;
+  OctreePost *_octree;
+  mathEvaluator &_f;
+  const std::vector<std::string> &_expressions;
+  int _step, _step2;
+  bool _forceInterpolation;
+  // for node-based data, index of the first node of each element (numbered
+  // consecutively over all the entities), and whether the element is the
+  // first one to visit the node, i.e. the one that modifies it
+  std::vector<int> _firstElement, _firstNode;
+  std::vector<char> _owner;
+
+public:
+  modifyComponentsOnElement(PViewData *data1, PViewData *data2,
+                            OctreePost *octree, mathEvaluator &f,
+                            const std::vector<std::string> &expressions,
+                            int step, int step2, bool forceInterpolation)
+    : _data1(data1), _data2(data2), _octree(octree), _f(f),
+      _expressions(expressions), _step(step), _step2(step2),
+      _forceInterpolation(forceInterpolation)
+  {
+    if(!_data1->isNodeData()) return;
+    // tag all the nodes with "0" (the default tag), then find the element
+    // that modifies each node in the order of a serial loop, so that the
+    // elements can then be processed in any order
+    int numEntities = _data1->getNumEntities(_step);
+    _firstElement.resize(numEntities + 1, 0);
+    for(int ent = 0; ent < numEntities; ent++)
+      _firstElement[ent + 1] =
+        _firstElement[ent] + _data1->getNumElements(_step, ent);
+    _firstNode.resize(_firstElement.back() + 1, 0);
+    for(int ent = 0; ent < numEntities; ent++) {
+      for(int ele = 0; ele < _data1->getNumElements(_step, ent); ele++) {
+        int i = _firstElement[ent] + ele;
+        int numNodes = 0;
+        if(!_data1->skipElement(_step, ent, ele)) {
+          numNodes = _data1->getNumNodes(_step, ent, ele);
+          for(int nod = 0; nod < numNodes; nod++)
+            _data1->tagNode(_step, ent, ele, nod, 0);
+        }
+        _firstNode[i + 1] = _firstNode[i] + numNodes;
+      }
+    }
+    _owner.resize(_firstNode.back(), 0);
+    for(int ent = 0; ent < numEntities; ent++) {
+      for(int ele = 0; ele < _data1->getNumElements(_step, ent); ele++) {
+        int i = _firstElement[ent] + ele;
+        for(int nod = 0; nod < _firstNode[i + 1] - _firstNode[i]; nod++) {
+          double x, y, z;
+          if(_data1->getNode(_step, ent, ele, nod, x, y, z))
+            continue; // node already visited
+          _owner[_firstNode[i] + nod] = 1;
+          _data1->tagNode(_step, ent, ele, nod, 1);
+        }
+      }
+    }
+  }
+  void operator()(int range, int ent, int ele, PViewDataList **out) const
+  {
+    if(_data1->skipElement(_step, ent, ele)) return;
+    int numComp = _data1->getNumComponents(_step, ent, ele);
+    int numComp2 = _octree ? 9 : _data2->getNumComponents(_step2, ent, ele);
+    int numNodes = _data1->getNumNodes(_step, ent, ele);
+    std::vector<double> x(numNodes), y(numNodes), z(numNodes);
+    for(int nod = 0; nod < numNodes; nod++)
+      _data1->getNode(_step, ent, ele, nod, x[nod], y[nod], z[nod]);
+    std::vector<double> values(23), res(9);
+    for(int nod = 0; nod < numNodes; nod++) {
+      if(_data1->isNodeData() &&
+         !_owner[_firstNode[_firstElement[ent] + ele] + nod])
+        continue; // node is modified by another element
+      std::vector<double> v(std::max(9, numComp), 0.);
+      for(int comp = 0; comp < numComp; comp++)
+        _data1->getValue(_step, ent, ele, nod, comp, v[comp]);
+      std::vector<double> w(std::max(9, numComp2), 0.);
+      if(_octree) {
+        int qn = _forceInterpolation ? numNodes : 0;
+        if(!_octree->searchScalar(x[nod], y[nod], z[nod], &w[0], _step2, 0, qn,
+                                  &x[0], &y[0], &z[0]))
+          if(!_octree->searchVector(x[nod], y[nod], z[nod], &w[0], _step2, 0,
+                                    qn, &x[0], &y[0], &z[0]))
+            _octree->searchTensor(x[nod], y[nod], z[nod], &w[0], _step2, 0,
+                                  qn, &x[0], &y[0], &z[0]);
+      }
+      else {
+        for(int comp = 0; comp < numComp2; comp++)
+          _data2->getValue(_step2, ent, ele, nod, comp, w[comp]);
+      }
+      values[0] = x[nod];
+      values[1] = y[nod];
+      values[2] = z[nod];
+      values[3] = _data1->getTime(_step);
+      values[4] = _step;
+      for(int i = 0; i < 9; i++) values[5 + i] = v[i];
+      for(int i = 0; i < 9; i++) values[14 + i] = w[i];
+      if(_f.eval(values, res)) {
+        for(int comp = 0; comp < numComp; comp++) {
+          if(_expressions[comp].size()) {
+            _data1->setValue(_step, ent, ele, nod, comp, res[comp]);
+          }
+        }
+      }
+    }
+  }
+};
+
 PView *GMSH_ModifyComponentsPlugin::execute(PView *view)
 {
   int timeStep = (int)ModifyComponentsOptions_Number[0].def;
@@ -146,8 +255,6 @@ PView *GMSH_ModifyComponentsPlugin::execute(PView *view)
   for(unsigned int i = 0; i < numVariables; i++) variables[i] = names[i];
   mathEvaluator f(expressions0, variables);
 
-  std::vector<double> values(numVariables), res(9);
-
   OctreePost *octree = 0;
   if(forceInterpolation ||
      (data1->getNumEntities() != data2->getNumEntities()) ||
@@ -159,69 +266,20 @@ PView *GMSH_ModifyComponentsPlugin::execute(PView *view)
   for(int step = 0; step < data1->getNumTimeSteps(); step++) {
     if(timeStep >= 0 && timeStep != step) continue;
 
-    double time = data1->getTime(step);
     int step2 = (otherTimeStep < 0) ? step : otherTimeStep;
 
-    if(data1->isNodeData()) {
-      // tag all the nodes with "0" (the default tag)
-      for(int ent = 0; ent < data1->getNumEntities(step); ent++) {
-        for(int ele = 0; ele < data1->getNumElements(step, ent); ele++) {
-          if(data1->skipElement(step, ent, ele)) continue;
-          for(int nod = 0; nod < data1->getNumNodes(step, ent, ele); nod++)
-            data1->tagNode(step, ent, ele, nod, 0);
-        }
-      }
-    }
-
-    for(int ent = 0; ent < data1->getNumEntities(step); ent++) {
-      for(int ele = 0; ele < data1->getNumElements(step, ent); ele++) {
-        if(data1->skipElement(step, ent, ele)) continue;
-        int numComp = data1->getNumComponents(step, ent, ele);
-        int numComp2 = octree ? 9 : data2->getNumComponents(step2, ent, ele);
-        int numNodes = data1->getNumNodes(step, ent, ele);
-        std::vector<double> x(numNodes), y(numNodes), z(numNodes);
-        std::vector<int> tag(numNodes);
-        for(int nod = 0; nod < numNodes; nod++)
-          tag[nod] =
-            data1->getNode(step, ent, ele, nod, x[nod], y[nod], z[nod]);
-        for(int nod = 0; nod < numNodes; nod++) {
-          if(data1->isNodeData() && tag[nod])
-            continue; // node has already been modified
-          std::vector<double> v(std::max(9, numComp), 0.);
-          for(int comp = 0; comp < numComp; comp++)
-            data1->getValue(step, ent, ele, nod, comp, v[comp]);
-          std::vector<double> w(std::max(9, numComp2), 0.);
-          if(octree) {
-            int qn = forceInterpolation ? numNodes : 0;
-            if(!octree->searchScalar(x[nod], y[nod], z[nod], &w[0], step2, 0,
-                                     qn, &x[0], &y[0], &z[0]))
-              if(!octree->searchVector(x[nod], y[nod], z[nod], &w[0], step2, 0,
-                                       qn, &x[0], &y[0], &z[0]))
-                octree->searchTensor(x[nod], y[nod], z[nod], &w[0], step2, 0,
-                                     qn, &x[0], &y[0], &z[0]);
-          }
-          else {
-            for(int comp = 0; comp < numComp2; comp++)
-              data2->getValue(step2, ent, ele, nod, comp, w[comp]);
-          }
-          values[0] = x[nod];
-          values[1] = y[nod];
-          values[2] = z[nod];
-          values[3] = time;
-          values[4] = step;
-          for(int i = 0; i < 9; i++) values[5 + i] = v[i];
-          for(int i = 0; i < 9; i++) values[14 + i] = w[i];
-          if(f.eval(values, res)) {
-            for(int comp = 0; comp < numComp; comp++) {
-              if(expressions[comp].size()) {
-                data1->setValue(step, ent, ele, nod, comp, res[comp]);
-              }
-            }
-          }
-          if(data1->isNodeData()) data1->tagNode(step, ent, ele, nod, 1);
-        }
-      }
-    }
+    // the values are modified in place: the other view can only be read
+    // concurrently if the values read are not the ones being modified, which
+    // is the case without interpolation since each node is only read and
+    // written by the element that modifies it
+    bool concurrent = octree ?
+                        (octree->canSearchConcurrently() &&
+                         (v2 != v1 || step2 != step)) :
+                        data2->canReadConcurrently();
+    modifyComponentsOnElement g(data1, data2, octree, f, expressions, step,
+                                step2, forceInterpolation);
+    postElementLoop loop(data1, step, concurrent);
+    loop.run(g);
   }
 
   if(octree) delete octree;
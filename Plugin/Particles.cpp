@@ -4,6 +4,7 @@
 // issues on https://gitlab.onelab.info/gmsh/gmsh/issues
 
 #include <cmath>
+#include <algorithm>
 #include "GmshConfig.h"
 #include "Particles.h"
 #include "OctreePost.h"
@@ -248,32 +249,54 @@ PView *GMSH_ParticlesPlugin::execute(PView *v)
   double c4 =
     DT * DT * (beta + (0.5 + gamma - 2 * beta) + (0.5 - gamma + beta));
 
-  for(int i = 0; i < getNbU(); ++i) {
-    for(int j = 0; j < getNbV(); ++j) {
-      double XINIT[3], X0[3], X1[3];
-      getPoint(i, j, XINIT);
-      getPoint(i, j, X0);
-      getPoint(i, j, X1);
-      data2->NbVP++;
-      data2->VP.push_back(XINIT[0]);
-      data2->VP.push_back(XINIT[1]);
-      data2->VP.push_back(XINIT[2]);
-      for(int iter = 0; iter < maxIter; iter++) {
-        double F[3], X[3];
-        o1.searchVector(X1[0], X1[1], X1[2], F, timeStep);
-        for(int k = 0; k < 3; k++)
-          X[k] = (c2 * X1[k] + c3 * X0[k] + c4 * F[k]) / c1;
-        data2->VP.push_back(X[0] - XINIT[0]);
-        data2->VP.push_back(X[1] - XINIT[1]);
-        data2->VP.push_back(X[2] - XINIT[2]);
-        for(int k = 0; k < 3; k++) {
-          X0[k] = X1[k];
-          X1[k] = X[k];
-        }
+  // the trajectories are independent: the particles are distributed in
+  // contiguous ranges to the threads, which fill their own output buffer; the
+  // buffers are then appended in thread order, so that the view does not depend
+  // on the number of threads
+  int numU = getNbU(), numV = getNbV(), numParticles = numU * numV;
+  int nthreads = 1;
+#if defined(_OPENMP)
+  if(o1.canSearchConcurrently())
+    nthreads = std::max(1, std::min(Msg::GetMaxThreads(), numParticles));
+#endif
+  std::vector<std::vector<double> > out(nthreads);
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+#endif
+  for(int p = 0; p < numParticles; p++) {
+    std::vector<double> &VP = out[Msg::GetThreadNum()];
+    double XINIT[3], X0[3], X1[3];
+    getPoint(p / numV, p % numV, XINIT);
+    getPoint(p / numV, p % numV, X0);
+    getPoint(p / numV, p % numV, X1);
+    VP.push_back(XINIT[0]);
+    VP.push_back(XINIT[1]);
+    VP.push_back(XINIT[2]);
+    // element containing the previous position, tried first for the next one
+    void *hint = 0;
+    for(int iter = 0; iter < maxIter; iter++) {
+      double F[3], X[3];
+      o1.searchVector(X1[0], X1[1], X1[2], F, timeStep, 0, 0, 0, 0, 0, false,
+                      &hint);
+      for(int k = 0; k < 3; k++)
+        X[k] = (c2 * X1[k] + c3 * X0[k] + c4 * F[k]) / c1;
+      VP.push_back(X[0] - XINIT[0]);
+      VP.push_back(X[1] - XINIT[1]);
+      VP.push_back(X[2] - XINIT[2]);
+      for(int k = 0; k < 3; k++) {
+        X0[k] = X1[k];
+        X1[k] = X[k];
       }
     }
   }
 
+  for(int t = 0; t < nthreads; t++) {
+    data2->VP.insert(data2->VP.end(), out[t].begin(), out[t].end());
+    std::vector<double>().swap(out[t]);
+  }
+  data2->NbVP += numParticles;
+
   v2->getOptions()->vectorType = PViewOptions::Displacement;
 
   data2->setName(data1->getName() + "_Particles");
@@ -54,6 +54,19 @@ std::string GMSH_Plugin::serialize()
   return sstream.str();
 }
 
+postElementLoop::postElementLoop(PViewData *data, int step, bool concurrent)
+  : _numRanges(1)
+{
+  int numEntities = data->getNumEntities(step);
+  _offsets.resize(numEntities + 1, 0);
+  for(int ent = 0; ent < numEntities; ent++)
+    _offsets[ent + 1] = _offsets[ent] + data->getNumElements(step, ent);
+#if defined(_OPENMP)
+  if(concurrent && _offsets.back() > 1000 && data->canReadConcurrently())
+    _numRanges = std::max(1, Msg::GetMaxThreads());
+#endif
+}
+
 PView *GMSH_PostPlugin::executeRemote(PView *view)
 {
   int j = -1, remoteIndex = -1;
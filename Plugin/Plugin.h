@@ -14,6 +14,8 @@
 //  in the executable. I think that it's a good way to start.
 
 #include <string>
+#include <vector>
+#include <algorithm>
 #include "Options.h"
 #include "GmshMessage.h"
 #include "PView.h"
@@ -107,6 +109,62 @@ public:
   virtual bool geometricalFilter(fullMatrix<double> *) const { return true; }
 };
 
+// Traversal of the elements of a view, for the post-processing plugins that
+// process each element independently. The elements of all the entities are
+// numbered consecutively and split into contiguous ranges, processed
+// concurrently if the view can be read by several threads. Each range appends
+// its results to its own list-based data sets, which are then appended to the
+// output data sets in the order of the ranges: the output is thus the same as
+// with a serial loop over the entities and their elements.
+class postElementLoop {
+private:
+  // index of the first element of each entity, and total number of elements
+  std::vector<int> _offsets;
+  int _numRanges;
+
+public:
+  // loop over the elements of the given step of data; the elements are
+  // processed serially if concurrent is false (e.g. if the plugin reads
+  // another view that cannot be read concurrently)
+  postElementLoop(PViewData *data, int step, bool concurrent = true);
+  // number of ranges of elements, processed concurrently if larger than 1
+  int getNumRanges() const { return _numRanges; }
+  // call f(range, ent, ele, out) for all the elements, where out are the
+  // numOut data sets in which the results for the element should be appended
+  template <class F> void run(F &f, int numOut = 0, PViewDataList **out = 0)
+  {
+    std::vector<PViewDataList *> outs(_numRanges * numOut);
+    for(int i = 0; i < numOut; i++) {
+      outs[i] = out[i];
+      for(int r = 1; r < _numRanges; r++)
+        outs[r * numOut + i] = new PViewDataList();
+    }
+    int numEntities = _offsets.size() - 1;
+    int size = _offsets.back() / _numRanges;
+    int rest = _offsets.back() % _numRanges;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static, 1) num_threads(_numRanges)
+#endif
+    for(int r = 0; r < _numRanges; r++) {
+      int begin = r * size + std::min(r, rest);
+      int end = begin + size + (r < rest ? 1 : 0);
+      int ent = std::upper_bound(_offsets.begin(), _offsets.end(), begin) -
+                _offsets.begin() - 1;
+      PViewDataList **o = numOut ? &outs[r * numOut] : 0;
+      for(int i = begin; i < end; i++) {
+        while(ent < numEntities - 1 && i >= _offsets[ent + 1]) ent++;
+        f(r, ent, i - _offsets[ent], o);
+      }
+    }
+    for(int r = 1; r < _numRanges; r++) {
+      for(int i = 0; i < numOut; i++) {
+        out[i]->appendElements(*outs[r * numOut + i]);
+        delete outs[r * numOut + i];
+      }
+    }
+  }
+};
+
 // The base class for solver plugins. The idea is to be able to
 // associate some properties to physical entities, so that we can
 // interface gmsh with a solver (ABAQUS...), i.e., create the input
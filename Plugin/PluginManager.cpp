@@ -10,6 +10,7 @@
 #include "Context.h"
 #include "Plugin.h"
 #include "PluginManager.h"
+#include "PViewDataGModel.h"
 #include "Isosurface.h"
 #include "CutGrid.h"
 #include "StreamLines.h"
@@ -123,6 +124,8 @@ void PluginManager::action(std::string pluginName, std::string action,
   if(action == "Run") {
     Msg::Info("Running Plugin(%s)...", pluginName.c_str());
     plugin->run();
+    // the plugin does not reference the values of the steps it read anymore
+    PViewDataGModel::releaseSteps();
     Msg::Info("Done running Plugin(%s)", pluginName.c_str());
   }
   else
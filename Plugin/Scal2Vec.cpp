@@ -46,6 +46,50 @@ StringXString *GMSH_Scal2VecPlugin::getOptionStr(int iopt)
   return &Scal2VecOptions_String[iopt];
 }
 
+// build the vector on one element of the reference view
+class scal2VecOnElement {
+private:
+  PViewData *_data, **_comp;
+  int _step; // first non-empty step of the reference view
+
+public:
+  scal2VecOnElement(PViewData *data, int step, PViewData **comp)
+    : _data(data), _comp(comp), _step(step)
+  {
+  }
+  void operator()(int range, int ent, int ele, PViewDataList **out) const
+  {
+    if(_data->skipElement(_step, ent, ele)) return;
+    int type = _data->getType(_step, ent, ele);
+    int numNodes = _data->getNumNodes(_step, ent, ele);
+    std::vector<double> *list = out[0]->incrementList(
+      3, type, numNodes); // Pointer in data of the new view
+    if(!list) return;
+    double x[8], y[8], z[8];
+    for(int nod = 0; nod < numNodes; nod++)
+      _data->getNode(_step, ent, ele, nod, x[nod], y[nod], z[nod]);
+    int dim = _data->getDimension(_step, ent, ele);
+    elementFactory factory;
+    element *element = factory.create(numNodes, dim, x, y, z);
+    if(!element) return;
+    for(int nod = 0; nod < numNodes; nod++)
+      list->push_back(x[nod]); // Save coordinates (x,y,z)
+    for(int nod = 0; nod < numNodes; nod++) list->push_back(y[nod]);
+    for(int nod = 0; nod < numNodes; nod++) list->push_back(z[nod]);
+    for(int step = _step; step < _data->getNumTimeSteps(); step++) {
+      if(!_data->hasTimeStep(step)) continue;
+      for(int nod = 0; nod < numNodes; nod++) {
+        for(int comp = 0; comp < 3; comp++) {
+          double val = 0.;
+          if(_comp[comp]) _comp[comp]->getValue(step, ent, ele, nod, 0, val);
+          list->push_back(val); // Save value
+        }
+      }
+    }
+    delete element;
+  }
+};
+
 PView *GMSH_Scal2VecPlugin::execute(PView *v)
 {
   // Load options
@@ -78,39 +122,16 @@ PView *GMSH_Scal2VecPlugin::execute(PView *v)
   PViewDataList *dataNew = getDataList(vNew);
 
   int step0 = dataRef->getFirstNonEmptyTimeStep();
-  for(int ent = 0; ent < dataRef->getNumEntities(step0); ent++) {
-    for(int ele = 0; ele < dataRef->getNumElements(step0, ent); ele++) {
-      if(dataRef->skipElement(step0, ent, ele)) continue;
-      int type = dataRef->getType(step0, ent, ele);
-      int numNodes = dataRef->getNumNodes(step0, ent, ele);
-      std::vector<double> *out = dataNew->incrementList(
-        3, type, numNodes); // Pointer in data of the new view
-      if(!out) continue;
-      double x[8], y[8], z[8];
-      for(int nod = 0; nod < numNodes; nod++)
-        dataRef->getNode(step0, ent, ele, nod, x[nod], y[nod], z[nod]);
-      int dim = dataRef->getDimension(step0, ent, ele);
-      elementFactory factory;
-      element *element = factory.create(numNodes, dim, x, y, z);
-      if(!element) continue;
-      for(int nod = 0; nod < numNodes; nod++)
-        out->push_back(x[nod]); // Save coordinates (x,y,z)
-      for(int nod = 0; nod < numNodes; nod++) out->push_back(y[nod]);
-      for(int nod = 0; nod < numNodes; nod++) out->push_back(z[nod]);
-      for(int step = step0; step < dataRef->getNumTimeSteps(); step++) {
-        if(!dataRef->hasTimeStep(step)) continue;
-        for(int nod = 0; nod < numNodes; nod++) {
-          for(int comp = 0; comp < 3; comp++) {
-            double val = 0.;
-            if(vComp[comp])
-              vComp[comp]->getData()->getValue(step, ent, ele, nod, 0, val);
-            out->push_back(val); // Save value
-          }
-        }
-      }
-      delete element;
-    }
+  PViewData *dataComp[3];
+  bool concurrent = true;
+  for(int comp = 0; comp < 3; comp++) {
+    dataComp[comp] = vComp[comp] ? vComp[comp]->getData() : 0;
+    if(dataComp[comp] && !dataComp[comp]->canReadConcurrently())
+      concurrent = false;
   }
+  scal2VecOnElement f(dataRef, step0, dataComp);
+  postElementLoop loop(dataRef, step0, concurrent);
+  loop.run(f, 1, &dataNew);
 
   for(int step = step0; step < dataRef->getNumTimeSteps(); step++) {
     if(!dataRef->hasTimeStep(step)) continue;
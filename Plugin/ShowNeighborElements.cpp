@@ -76,9 +76,9 @@ void GMSH_ShowNeighborElementsPlugin::_init(GEntity *ent)
   _vert2elem.clear();
   for(unsigned i = 0; i < ent->getNumMeshElements(); ++i) {
     MElement *el = ent->getMeshElement(i);
-    if(el->getNum() == _nel1 || el->getNum() == _nel2 ||
-       el->getNum() == _nel3 || el->getNum() == _nel4 ||
-       el->getNum() == _nel5) {
+    int num = el->getNum();
+    if(num == _nel1 || num == _nel2 || num == _nel3 || num == _nel4 ||
+       num == _nel5) {
       el->setVisibility(true);
       for(std::size_t k = 0; k < el->getNumVertices();
           ++k) { // TODO only corner vertices?
@@ -4,6 +4,7 @@
 // issues on https://gitlab.onelab.info/gmsh/gmsh/issues
 
 #include <cmath>
+#include <algorithm>
 #include "GmshConfig.h"
 #include "StreamLines.h"
 #include "OctreePost.h"
@@ -30,7 +31,8 @@ StringXNumber StreamLinesOptions_Number[] = {
   {GMSH_FULLRC, "MaxIter", NULL, 100},
   {GMSH_FULLRC, "TimeStep", NULL, 0},
   {GMSH_FULLRC, "View", NULL, -1.},
-  {GMSH_FULLRC, "OtherView", NULL, -1.}};
+  {GMSH_FULLRC, "OtherView", NULL, -1.},
+  {GMSH_FULLRC, "Tolerance", NULL, 0.}};
 
 extern "C" {
 GMSH_Plugin *GMSH_RegisterStreamLinesPlugin()
@@ -163,6 +165,11 @@ std::string GMSH_StreamLinesPlugin::getHelp() const
          "on the vector view.\n\n"
          "The time stepping scheme is a RK44 with step size "
          "`DT' and `MaxIter' maximum number of iterations.\n\n"
+         "If `Tolerance' > 0, each step of size `DT' is "
+         "instead performed with an adaptive Runge-Kutta "
+         "Dormand-Prince 5(4) scheme, which takes as many "
+         "substeps as necessary to keep the estimated local "
+         "error on the position below `Tolerance'.\n\n"
          "If `TimeStep' < 0, the plugin tries to compute "
          "streamlines of the unsteady flow.\n\n"
          "If `View' < 0, the plugin is run on the current view.\n\n"
@@ -209,6 +216,142 @@ void GMSH_StreamLinesPlugin::getPoint(int iU, int iV, double *X)
     v * (StreamLinesOptions_Number[8].def - StreamLinesOptions_Number[2].def);
 }
 
+// velocity at point X, interpolated in the vector view (0 outside the view)
+static void velocity(OctreePost &o, int step, const double X[3], double V[3],
+                     void **hint)
+{
+  o.searchVector(X[0], X[1], X[2], V, step, 0, 0, 0, 0, 0, false, hint);
+}
+
+// advance X by DT with the classical 4th order Runge-Kutta scheme
+static void stepRK4(OctreePost &o, int step, double DT, double X[3],
+                    void **hint)
+{
+  // dX/dt = V
+  // X1 = X + a1 * DT * V(X)
+  // X2 = X + a2 * DT * V(X1)
+  // X3 = X + a3 * DT * V(X2)
+  // X4 = X + a4 * DT * V(X3)
+  // X = X + b1 X1 + b2 X2 + b3 X3 + b4 x4
+  const double b1 = 1. / 3., b2 = 2. / 3., b3 = 1. / 3., b4 = 1. / 6.;
+  const double a1 = 0.5, a2 = 0.5, a3 = 1., a4 = 1.;
+  double val[3], X1[3], X2[3], X3[3], X4[3];
+  velocity(o, step, X, val, hint);
+  for(int k = 0; k < 3; k++) X1[k] = X[k] + DT * val[k] * a1;
+  velocity(o, step, X1, val, hint);
+  for(int k = 0; k < 3; k++) X2[k] = X[k] + DT * val[k] * a2;
+  velocity(o, step, X2, val, hint);
+  for(int k = 0; k < 3; k++) X3[k] = X[k] + DT * val[k] * a3;
+  velocity(o, step, X3, val, hint);
+  for(int k = 0; k < 3; k++) X4[k] = X[k] + DT * val[k] * a4;
+  for(int k = 0; k < 3; k++)
+    X[k] += (b1 * (X1[k] - X[k]) + b2 * (X2[k] - X[k]) + b3 * (X3[k] - X[k]) +
+             b4 * (X4[k] - X[k]));
+}
+
+// advance X by DT with the embedded Runge-Kutta Dormand-Prince 5(4) scheme,
+// using substeps such that the estimated local error stays below tol; h is the
+// (absolute) size of the first substep to try, and is updated with the size
+// proposed for the next one
+static void stepDOPRI(OctreePost &o, int step, double DT, double tol,
+                      double X[3], double &h, void **hint)
+{
+  static const double a[7][6] = {
+    {0., 0., 0., 0., 0., 0.},
+    {1. / 5., 0., 0., 0., 0., 0.},
+    {3. / 40., 9. / 40., 0., 0., 0., 0.},
+    {44. / 45., -56. / 15., 32. / 9., 0., 0., 0.},
+    {19372. / 6561., -25360. / 2187., 64448. / 6561., -212. / 729., 0., 0.},
+    {9017. / 3168., -355. / 33., 46732. / 5247., 49. / 176., -5103. / 18656.,
+     0.},
+    {35. / 384., 0., 500. / 1113., 125. / 192., -2187. / 6784., 11. / 84.}};
+  // difference between the 5th and the 4th order weights
+  static const double e[7] = {
+    35. / 384. - 5179. / 57600., 0., 500. / 1113. - 7571. / 16695.,
+    125. / 192. - 393. / 640., -2187. / 6784. + 92097. / 339200.,
+    11. / 84. - 187. / 2100., -1. / 40.};
+  // the (sub)step sizes are positive, the stream line being traced backward
+  // if DT < 0; substeps smaller than hmin are accepted whatever the error,
+  // which bounds the cost of a step
+  const double dir = (DT < 0.) ? -1. : 1., len = std::abs(DT);
+  const double hmin = len / 1024.;
+  double t = 0.;
+  while(t < len) {
+    if(h > len) h = len;
+    if(h < hmin) h = hmin;
+    bool last = (t + h >= len);
+    double hh = last ? len - t : h;
+    // the last stage is evaluated at the 5th order solution
+    double k[7][3], Y[3];
+    for(int s = 0; s < 7; s++) {
+      for(int j = 0; j < 3; j++) {
+        Y[j] = X[j];
+        for(int r = 0; r < s; r++) Y[j] += dir * hh * a[s][r] * k[r][j];
+      }
+      velocity(o, step, Y, k[s], hint);
+    }
+    double err = 0.;
+    for(int j = 0; j < 3; j++) {
+      double d = 0.;
+      for(int s = 0; s < 7; s++) d += dir * hh * e[s] * k[s][j];
+      err = std::max(err, std::abs(d));
+    }
+    double fac = (err > 0.) ? 0.9 * pow(tol / err, 0.2) : 5.;
+    fac = std::min(5., std::max(0.2, fac));
+    if(err <= tol || hh <= hmin) {
+      for(int j = 0; j < 3; j++) X[j] = Y[j];
+      t = last ? len : t + hh;
+    }
+    h = hh * fac;
+  }
+}
+
+// trace the stream line starting at X; the output is appended to out, as a
+// multi-step vector point if o2 is not given, or as scalar lines with the
+// values interpolated in o2 if it is
+static void traceStreamLine(OctreePost &o1, OctreePost *o2, int numSteps2,
+                            const std::vector<int> &steps, double DT,
+                            double tol, double X[3], std::vector<double> &out)
+{
+  double XINIT[3] = {X[0], X[1], X[2]};
+  void *hint1 = 0, *hint2 = 0;
+  std::vector<double> val2(numSteps2);
+  if(o2) {
+    o2->searchScalar(X[0], X[1], X[2], &val2[0], -1, 0, 0, 0, 0, 0, false,
+                     &hint2);
+  }
+  else {
+    out.push_back(X[0]);
+    out.push_back(X[1]);
+    out.push_back(X[2]);
+  }
+  double h = std::abs(DT);
+  for(std::size_t iter = 0; iter < steps.size(); iter++) {
+    double XPREV[3] = {X[0], X[1], X[2]};
+    if(tol > 0.)
+      stepDOPRI(o1, steps[iter], DT, tol, X, h, &hint1);
+    else
+      stepRK4(o1, steps[iter], DT, X, &hint1);
+    if(o2) {
+      out.push_back(XPREV[0]);
+      out.push_back(X[0]);
+      out.push_back(XPREV[1]);
+      out.push_back(X[1]);
+      out.push_back(XPREV[2]);
+      out.push_back(X[2]);
+      out.insert(out.end(), val2.begin(), val2.end());
+      o2->searchScalar(X[0], X[1], X[2], &val2[0], -1, 0, 0, 0, 0, 0, false,
+                       &hint2);
+      out.insert(out.end(), val2.begin(), val2.end());
+    }
+    else {
+      out.push_back(X[0] - XINIT[0]);
+      out.push_back(X[1] - XINIT[1]);
+      out.push_back(X[2] - XINIT[2]);
+    }
+  }
+}
+
 PView *GMSH_StreamLinesPlugin::execute(PView *v)
 {
   double DT = StreamLinesOptions_Number[11].def;
@@ -216,6 +359,7 @@ PView *GMSH_StreamLinesPlugin::execute(PView *v)
   int timeStep = (int)StreamLinesOptions_Number[13].def;
   int iView = (int)StreamLinesOptions_Number[14].def;
   int otherView = (int)StreamLinesOptions_Number[15].def;
+  double tol = StreamLinesOptions_Number[16].def;
 
   PView *v1 = getView(iView, v);
   if(!v1) return v;
@@ -231,100 +375,62 @@ PView *GMSH_StreamLinesPlugin::execute(PView *v)
   }
 
   OctreePost o1(v1);
-  double *val2 = 0;
-  OctreePost *o2 = 0;
-  if(data2) {
-    val2 = new double[data2->getNumTimeSteps()];
-    o2 = new OctreePost(v2);
-  }
+  OctreePost *o2 = data2 ? new OctreePost(v2) : 0;
+  int numSteps2 = data2 ? data2->getNumTimeSteps() : 0;
 
   PView *v3 = new PView();
   PViewDataList *data3 = getDataList(v3);
 
-  const double b1 = 1. / 3., b2 = 2. / 3., b3 = 1. / 3., b4 = 1. / 6.;
-  const double a1 = 0.5, a2 = 0.5, a3 = 1., a4 = 1.;
-  double XINIT[3], X[3], DX[3], X1[3], X2[3], X3[3], X4[3];
+  // time step of the vector view used for each iteration
+  std::vector<int> steps(std::max(maxIter, 0), timeStep);
+  if(timeStep < 0) {
+    int currentTimeStep = 0;
+    for(int iter = 0; iter < maxIter; iter++) {
+      double T0 = data1->getTime(0);
+      double currentT = T0 + DT * iter;
+      data3->Time.push_back(currentT);
+      for(; currentTimeStep < data1->getNumTimeSteps() - 1 &&
+            currentT > 0.5 * (data1->getTime(currentTimeStep) +
+                              data1->getTime(currentTimeStep + 1));
+          currentTimeStep++)
+        ;
+      steps[iter] = currentTimeStep;
+    }
+  }
 
-  for(int i = 0; i < getNbU(); ++i) {
-    for(int j = 0; j < getNbV(); ++j) {
-      getPoint(i, j, XINIT);
-      getPoint(i, j, X);
+  // the stream lines are independent: the seeds are distributed in contiguous
+  // ranges to the threads, which fill their own output buffer; the buffers are
+  // then appended in thread order, so that the view does not depend on the
+  // number of threads
+  int numU = getNbU(), numV = getNbV(), numSeeds = numU * numV;
+  int nthreads = 1;
+#if defined(_OPENMP)
+  if(o1.canSearchConcurrently() && (!o2 || o2->canSearchConcurrently()))
+    nthreads = std::max(1, std::min(Msg::GetMaxThreads(), numSeeds));
+#endif
+  std::vector<std::vector<double> > out(nthreads);
 
-      if(data2) {
-        o2->searchScalar(X[0], X[1], X[2], val2, -1);
-      }
-      else {
-        data3->NbVP++;
-        data3->VP.push_back(X[0]);
-        data3->VP.push_back(X[1]);
-        data3->VP.push_back(X[2]);
-      }
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+#endif
+  for(int s = 0; s < numSeeds; s++) {
+    double X[3];
+    getPoint(s / numV, s % numV, X);
+    traceStreamLine(o1, o2, numSteps2, steps, DT, tol, X,
+                    out[Msg::GetThreadNum()]);
+  }
 
-      int currentTimeStep = 0;
-
-      for(int iter = 0; iter < maxIter; iter++) {
-        double XPREV[3] = {X[0], X[1], X[2]};
-
-        if(timeStep < 0) {
-          double T0 = data1->getTime(0);
-          double currentT = T0 + DT * iter;
-          data3->Time.push_back(currentT);
-          for(; currentTimeStep < data1->getNumTimeSteps() - 1 &&
-                currentT > 0.5 * (data1->getTime(currentTimeStep) +
-                                  data1->getTime(currentTimeStep + 1));
-              currentTimeStep++)
-            ;
-        }
-        else {
-          currentTimeStep = timeStep;
-        }
-
-        // dX/dt = V
-        // X1 = X + a1 * DT * V(X)
-        // X2 = X + a2 * DT * V(X1)
-        // X3 = X + a3 * DT * V(X2)
-        // X4 = X + a4 * DT * V(X3)
-        // X = X + b1 X1 + b2 X2 + b3 X3 + b4 x4
-        double val[3];
-        o1.searchVector(X[0], X[1], X[2], val, currentTimeStep);
-        for(int k = 0; k < 3; k++) X1[k] = X[k] + DT * val[k] * a1;
-        o1.searchVector(X1[0], X1[1], X1[2], val, currentTimeStep);
-        for(int k = 0; k < 3; k++) X2[k] = X[k] + DT * val[k] * a2;
-        o1.searchVector(X2[0], X2[1], X2[2], val, currentTimeStep);
-        for(int k = 0; k < 3; k++) X3[k] = X[k] + DT * val[k] * a3;
-        o1.searchVector(X3[0], X3[1], X3[2], val, currentTimeStep);
-        for(int k = 0; k < 3; k++) X4[k] = X[k] + DT * val[k] * a4;
-
-        for(int k = 0; k < 3; k++)
-          X[k] += (b1 * (X1[k] - X[k]) + b2 * (X2[k] - X[k]) +
-                   b3 * (X3[k] - X[k]) + b4 * (X4[k] - X[k]));
-        for(int k = 0; k < 3; k++) DX[k] = X[k] - XINIT[k];
-
-        if(data2) {
-          data3->NbSL++;
-          data3->SL.push_back(XPREV[0]);
-          data3->SL.push_back(X[0]);
-          data3->SL.push_back(XPREV[1]);
-          data3->SL.push_back(X[1]);
-          data3->SL.push_back(XPREV[2]);
-          data3->SL.push_back(X[2]);
-          for(int k = 0; k < data2->getNumTimeSteps(); k++)
-            data3->SL.push_back(val2[k]);
-          o2->searchScalar(X[0], X[1], X[2], val2, -1);
-          for(int k = 0; k < data2->getNumTimeSteps(); k++)
-            data3->SL.push_back(val2[k]);
-        }
-        else {
-          data3->VP.push_back(DX[0]);
-          data3->VP.push_back(DX[1]);
-          data3->VP.push_back(DX[2]);
-        }
-      }
-    }
+  std::vector<double> &list = data2 ? data3->SL : data3->VP;
+  for(int t = 0; t < nthreads; t++) {
+    list.insert(list.end(), out[t].begin(), out[t].end());
+    std::vector<double>().swap(out[t]);
   }
+  if(data2)
+    data3->NbSL += numSeeds * (int)steps.size();
+  else
+    data3->NbVP += numSeeds;
 
   if(data2) {
-    delete[] val2;
     delete o2;
   }
   else {
@@ -975,7 +975,7 @@ double GMSH_ThinLayerFixMeshPlugin::computeDistToOppSide(MVertex *v)
     LastPos = CurrentPos;
 
     if(CurrentTet != 0) {
-      if((CurrentTet->tet()->getNum()) == prevprevtet) {
+      if((int)CurrentTet->tet()->getNum() == prevprevtet) {
         // std::cout<<"reached standstill"<<std::endl;
         while(1) {
         }
@@ -3,7 +3,7 @@
 // See the LICENSE.txt file for license information. Please report all
 // issues on https://gitlab.onelab.info/gmsh/gmsh/issues
 
-#include "Octree.h"
+#include "BVH.h"
 #include "OctreePost.h"
 #include "PView.h"
 #include "PViewData.h"
@@ -44,22 +44,6 @@ static void minmax(int n, double *X, double *Y, double *Z, double *min,
   }
 }
 
-static void centroid(int n, double *X, double *Y, double *Z, double *c)
-{
-  const double oc = 1. / (double)n;
-  c[0] = X[0];
-  c[1] = Y[0];
-  c[2] = Z[0];
-  for(int i = 1; i < n; i++) {
-    c[0] += X[i];
-    c[1] += Y[i];
-    c[2] += Z[i];
-  }
-  c[0] *= oc;
-  c[1] *= oc;
-  c[2] *= oc;
-}
-
 static void pntBB(void *a, double *min, double *max)
 {
   double *X = (double *)a, *Y = &X[1], *Z = &X[2];
@@ -166,87 +150,99 @@ static int pyrInEle(void *a, double *x)
   return pyr.isInside(uvw[0], uvw[1], uvw[2]);
 }
 
-static void pntCentroid(void *a, double *x)
-{
-  double *X = (double *)a, *Y = &X[1], *Z = &X[2];
-  centroid(1, X, Y, Z, x);
-}
+// elements of one type in a list-based view, located with a bounding volume
+// hierarchy over their bounding boxes
 
-static void linCentroid(void *a, double *x)
-{
-  double *X = (double *)a, *Y = &X[2], *Z = &X[4];
-  centroid(2, X, Y, Z, x);
-}
+class listBasedElementInside {
+private:
+  std::vector<double> &_list;
+  int _stride;
+  int (*_inEle)(void *, double *);
+  double *_P;
 
-static void triCentroid(void *a, double *x)
-{
-  double *X = (double *)a, *Y = &X[3], *Z = &X[6];
-  centroid(3, X, Y, Z, x);
-}
-
-static void quaCentroid(void *a, double *x)
-{
-  double *X = (double *)a, *Y = &X[4], *Z = &X[8];
-  centroid(4, X, Y, Z, x);
-}
-
-static void tetCentroid(void *a, double *x)
-{
-  double *X = (double *)a, *Y = &X[4], *Z = &X[8];
-  centroid(4, X, Y, Z, x);
-}
-
-static void hexCentroid(void *a, double *x)
-{
-  double *X = (double *)a, *Y = &X[8], *Z = &X[16];
-  centroid(8, X, Y, Z, x);
-}
-
-static void priCentroid(void *a, double *x)
-{
-  double *X = (double *)a, *Y = &X[6], *Z = &X[12];
-  centroid(6, X, Y, Z, x);
-}
-
-static void pyrCentroid(void *a, double *x)
-{
-  double *X = (double *)a, *Y = &X[5], *Z = &X[10];
-  centroid(5, X, Y, Z, x);
-}
-
-static void addListOfStuff(Octree *o, std::vector<double> &l, int nbelm)
-{
-  for(unsigned int i = 0; i < l.size(); i += nbelm) Octree_Insert(&l[i], o);
-}
+public:
+  std::vector<void *> *found;
+  listBasedElementInside(std::vector<double> &list, int stride,
+                         int (*inEle)(void *, double *), double *P)
+    : _list(list), _stride(stride), _inEle(inEle), _P(P), found(0)
+  {
+  }
+  bool operator()(int i)
+  {
+    if(!_inEle(&_list[i * _stride], _P)) return false;
+    if(!found) return true;
+    found->push_back(&_list[i * _stride]);
+    return false;
+  }
+};
+
+class listBasedElements {
+private:
+  std::vector<double> &_list;
+  int _stride;
+  int (*_inEle)(void *, double *);
+  BVH _bvh;
+
+public:
+  listBasedElements(std::vector<double> &list, int stride,
+                    void (*bb)(void *, double *, double *),
+                    int (*inEle)(void *, double *))
+    : _list(list), _stride(stride), _inEle(inEle)
+  {
+    int n = list.size() / stride;
+    std::vector<double> boxes(6 * n);
+    for(int i = 0; i < n; i++)
+      bb(&list[i * stride], &boxes[6 * i], &boxes[6 * i + 3]);
+    _bvh.build(boxes);
+  }
+  void *search(double *P, void *hint = 0) const
+  {
+    listBasedElementInside f(_list, _stride, _inEle, P);
+    int h = -1;
+    if(hint && !_list.empty()) {
+      double *X = (double *)hint;
+      if(X >= &_list[0] && X < &_list[0] + _list.size())
+        h = (X - &_list[0]) / _stride;
+    }
+    int i = _bvh.find(P, f, 0., h);
+    return (i < 0) ? 0 : &_list[i * _stride];
+  }
+  void searchAll(double *P, std::vector<void *> *out) const
+  {
+    listBasedElementInside f(_list, _stride, _inEle, P);
+    f.found = out;
+    _bvh.find(P, f);
+  }
+};
 
 // OctreePost implementation
 
 OctreePost::~OctreePost()
 {
-  Octree_Delete(_SPP);
-  Octree_Delete(_VPP);
-  Octree_Delete(_TPP);
-  Octree_Delete(_SL);
-  Octree_Delete(_VL);
-  Octree_Delete(_TL);
-  Octree_Delete(_ST);
-  Octree_Delete(_VT);
-  Octree_Delete(_TT);
-  Octree_Delete(_SQ);
-  Octree_Delete(_VQ);
-  Octree_Delete(_TQ);
-  Octree_Delete(_SS);
-  Octree_Delete(_VS);
-  Octree_Delete(_TS);
-  Octree_Delete(_SH);
-  Octree_Delete(_VH);
-  Octree_Delete(_TH);
-  Octree_Delete(_SI);
-  Octree_Delete(_VI);
-  Octree_Delete(_TI);
-  Octree_Delete(_SY);
-  Octree_Delete(_VY);
-  Octree_Delete(_TY);
+  delete _SPP;
+  delete _VPP;
+  delete _TPP;
+  delete _SL;
+  delete _VL;
+  delete _TL;
+  delete _ST;
+  delete _VT;
+  delete _TT;
+  delete _SQ;
+  delete _VQ;
+  delete _TQ;
+  delete _SS;
+  delete _VS;
+  delete _TS;
+  delete _SH;
+  delete _VH;
+  delete _TH;
+  delete _SI;
+  delete _VI;
+  delete _TI;
+  delete _SY;
+  delete _VY;
+  delete _TY;
 }
 
 OctreePost::OctreePost(PView *v)
@@ -280,129 +276,80 @@ void OctreePost::_create(PViewData *data)
       return;
     }
 
-    SBoundingBox3d bb = l->getBoundingBox();
-    // make bounding box larger up to (absolute) geometrical tolerance
-    double eps = CTX::instance()->geom.tolerance;
-    SPoint3 bbmin = bb.min(), bbmax = bb.max(), bbeps(eps, eps, eps);
-    bbmin -= bbeps;
-    bbmax += bbeps;
-    double min[3] = {bbmin.x(), bbmin.y(), bbmin.z()};
-    double size[3] = {bbmax.x() - bbmin.x(), bbmax.y() - bbmin.y(),
-                      bbmax.z() - bbmin.z()};
-    const int maxElePerBucket = 100; // memory vs. speed trade-off
-
-    _SPP =
-      Octree_Create(maxElePerBucket, min, size, pntBB, pntCentroid, pntInEle);
-    addListOfStuff(_SPP, l->SP, 3 + 1 * l->getNumTimeSteps());
-    Octree_Arrange(_SPP);
-    _VPP =
-      Octree_Create(maxElePerBucket, min, size, pntBB, pntCentroid, pntInEle);
-    addListOfStuff(_VPP, l->VP, 3 + 3 * l->getNumTimeSteps());
-    Octree_Arrange(_VPP);
-    _TPP =
-      Octree_Create(maxElePerBucket, min, size, pntBB, pntCentroid, pntInEle);
-    addListOfStuff(_TPP, l->TP, 3 + 9 * l->getNumTimeSteps());
-    Octree_Arrange(_TPP);
-
-    _SL =
-      Octree_Create(maxElePerBucket, min, size, linBB, linCentroid, linInEle);
-    addListOfStuff(_SL, l->SL, 6 + 2 * l->getNumTimeSteps());
-    Octree_Arrange(_SL);
-    _VL =
-      Octree_Create(maxElePerBucket, min, size, linBB, linCentroid, linInEle);
-    addListOfStuff(_VL, l->VL, 6 + 6 * l->getNumTimeSteps());
-    Octree_Arrange(_VL);
-    _TL =
-      Octree_Create(maxElePerBucket, min, size, linBB, linCentroid, linInEle);
-    addListOfStuff(_TL, l->TL, 6 + 18 * l->getNumTimeSteps());
-    Octree_Arrange(_TL);
-
-    _ST =
-      Octree_Create(maxElePerBucket, min, size, triBB, triCentroid, triInEle);
-    addListOfStuff(_ST, l->ST, 9 + 3 * l->getNumTimeSteps());
-    Octree_Arrange(_ST);
-    _VT =
-      Octree_Create(maxElePerBucket, min, size, triBB, triCentroid, triInEle);
-    addListOfStuff(_VT, l->VT, 9 + 9 * l->getNumTimeSteps());
-    Octree_Arrange(_VT);
-    _TT =
-      Octree_Create(maxElePerBucket, min, size, triBB, triCentroid, triInEle);
-    addListOfStuff(_TT, l->TT, 9 + 27 * l->getNumTimeSteps());
-    Octree_Arrange(_TT);
-
-    _SQ =
-      Octree_Create(maxElePerBucket, min, size, quaBB, quaCentroid, quaInEle);
-    addListOfStuff(_SQ, l->SQ, 12 + 4 * l->getNumTimeSteps());
-    Octree_Arrange(_SQ);
-    _VQ =
-      Octree_Create(maxElePerBucket, min, size, quaBB, quaCentroid, quaInEle);
-    addListOfStuff(_VQ, l->VQ, 12 + 12 * l->getNumTimeSteps());
-    Octree_Arrange(_VQ);
-    _TQ =
-      Octree_Create(maxElePerBucket, min, size, quaBB, quaCentroid, quaInEle);
-    addListOfStuff(_TQ, l->TQ, 12 + 36 * l->getNumTimeSteps());
-    Octree_Arrange(_TQ);
-
-    _SS =
-      Octree_Create(maxElePerBucket, min, size, tetBB, tetCentroid, tetInEle);
-    addListOfStuff(_SS, l->SS, 12 + 4 * l->getNumTimeSteps());
-    Octree_Arrange(_SS);
-    _VS =
-      Octree_Create(maxElePerBucket, min, size, tetBB, tetCentroid, tetInEle);
-    addListOfStuff(_VS, l->VS, 12 + 12 * l->getNumTimeSteps());
-    Octree_Arrange(_VS);
-    _TS =
-      Octree_Create(maxElePerBucket, min, size, tetBB, tetCentroid, tetInEle);
-    addListOfStuff(_TS, l->TS, 12 + 36 * l->getNumTimeSteps());
-    Octree_Arrange(_TS);
-
-    _SH =
-      Octree_Create(maxElePerBucket, min, size, hexBB, hexCentroid, hexInEle);
-    addListOfStuff(_SH, l->SH, 24 + 8 * l->getNumTimeSteps());
-    Octree_Arrange(_SH);
-    _VH =
-      Octree_Create(maxElePerBucket, min, size, hexBB, hexCentroid, hexInEle);
-    addListOfStuff(_VH, l->VH, 24 + 24 * l->getNumTimeSteps());
-    Octree_Arrange(_VH);
-    _TH =
-      Octree_Create(maxElePerBucket, min, size, hexBB, hexCentroid, hexInEle);
-    addListOfStuff(_TH, l->TH, 24 + 72 * l->getNumTimeSteps());
-    Octree_Arrange(_TH);
-
-    _SI =
-      Octree_Create(maxElePerBucket, min, size, priBB, priCentroid, priInEle);
-    addListOfStuff(_SI, l->SI, 18 + 6 * l->getNumTimeSteps());
-    Octree_Arrange(_SI);
-    _VI =
-      Octree_Create(maxElePerBucket, min, size, priBB, priCentroid, priInEle);
-    addListOfStuff(_VI, l->VI, 18 + 18 * l->getNumTimeSteps());
-    Octree_Arrange(_VI);
-    _TI =
-      Octree_Create(maxElePerBucket, min, size, priBB, priCentroid, priInEle);
-    addListOfStuff(_TI, l->TI, 18 + 54 * l->getNumTimeSteps());
-    Octree_Arrange(_TI);
-
-    _SY =
-      Octree_Create(maxElePerBucket, min, size, pyrBB, pyrCentroid, pyrInEle);
-    addListOfStuff(_SY, l->SY, 15 + 5 * l->getNumTimeSteps());
-    Octree_Arrange(_SY);
-    _VY =
-      Octree_Create(maxElePerBucket, min, size, pyrBB, pyrCentroid, pyrInEle);
-    addListOfStuff(_VY, l->VY, 15 + 15 * l->getNumTimeSteps());
-    Octree_Arrange(_VY);
-    _TY =
-      Octree_Create(maxElePerBucket, min, size, pyrBB, pyrCentroid, pyrInEle);
-    addListOfStuff(_TY, l->TY, 15 + 45 * l->getNumTimeSteps());
-    Octree_Arrange(_TY);
+    _SPP = new listBasedElements(l->SP, 3 + 1 * l->getNumTimeSteps(),
+                                 pntBB, pntInEle);
+    _VPP = new listBasedElements(l->VP, 3 + 3 * l->getNumTimeSteps(),
+                                 pntBB, pntInEle);
+    _TPP = new listBasedElements(l->TP, 3 + 9 * l->getNumTimeSteps(),
+                                 pntBB, pntInEle);
+
+    _SL = new listBasedElements(l->SL, 6 + 2 * l->getNumTimeSteps(),
+                                linBB, linInEle);
+    _VL = new listBasedElements(l->VL, 6 + 6 * l->getNumTimeSteps(),
+                                linBB, linInEle);
+    _TL = new listBasedElements(l->TL, 6 + 18 * l->getNumTimeSteps(),
+                                linBB, linInEle);
+
+    _ST = new listBasedElements(l->ST, 9 + 3 * l->getNumTimeSteps(),
+                                triBB, triInEle);
+    _VT = new listBasedElements(l->VT, 9 + 9 * l->getNumTimeSteps(),
+                                triBB, triInEle);
+    _TT = new listBasedElements(l->TT, 9 + 27 * l->getNumTimeSteps(),
+                                triBB, triInEle);
+
+    _SQ = new listBasedElements(l->SQ, 12 + 4 * l->getNumTimeSteps(),
+                                quaBB, quaInEle);
+    _VQ = new listBasedElements(l->VQ, 12 + 12 * l->getNumTimeSteps(),
+                                quaBB, quaInEle);
+    _TQ = new listBasedElements(l->TQ, 12 + 36 * l->getNumTimeSteps(),
+                                quaBB, quaInEle);
+
+    _SS = new listBasedElements(l->SS, 12 + 4 * l->getNumTimeSteps(),
+                                tetBB, tetInEle);
+    _VS = new listBasedElements(l->VS, 12 + 12 * l->getNumTimeSteps(),
+                                tetBB, tetInEle);
+    _TS = new listBasedElements(l->TS, 12 + 36 * l->getNumTimeSteps(),
+                                tetBB, tetInEle);
+
+    _SH = new listBasedElements(l->SH, 24 + 8 * l->getNumTimeSteps(),
+                                hexBB, hexInEle);
+    _VH = new listBasedElements(l->VH, 24 + 24 * l->getNumTimeSteps(),
+                                hexBB, hexInEle);
+    _TH = new listBasedElements(l->TH, 24 + 72 * l->getNumTimeSteps(),
+                                hexBB, hexInEle);
+
+    _SI = new listBasedElements(l->SI, 18 + 6 * l->getNumTimeSteps(),
+                                priBB, priInEle);
+    _VI = new listBasedElements(l->VI, 18 + 18 * l->getNumTimeSteps(),
+                                priBB, priInEle);
+    _TI = new listBasedElements(l->TI, 18 + 54 * l->getNumTimeSteps(),
+                                priBB, priInEle);
+
+    _SY = new listBasedElements(l->SY, 15 + 5 * l->getNumTimeSteps(),
+                                pyrBB, pyrInEle);
+    _VY = new listBasedElements(l->VY, 15 + 15 * l->getNumTimeSteps(),
+                                pyrBB, pyrInEle);
+    _TY = new listBasedElements(l->TY, 15 + 45 * l->getNumTimeSteps(),
+                                pyrBB, pyrInEle);
   }
 }
 
-static void *getElement(double P[3], Octree *octree, int nbNod, int qn,
-                        double *qx, double *qy, double *qz)
+bool OctreePost::canSearchConcurrently() const
+{
+  return !_theViewDataGModel || _theViewDataGModel->canReadConcurrently();
+}
+
+// if hint is given, the element it points to (found for a previous, nearby
+// point) is tried first, and it is updated with the element found
+static void *getElement(double P[3], listBasedElements *elements, int nbNod,
+                        int qn, double *qx, double *qy, double *qz,
+                        void **hint)
 {
+  if(!elements) return 0;
+  void *e = 0;
   if(qn && qx && qy && qz) {
     std::vector<void *> v;
-    Octree_SearchAll(P, octree, &v);
+    elements->searchAll(P, &v);
     if(nbNod == qn) {
       // try to use the value from the same geometrical element as the one
       // provided in qx/y/z
@@ -414,21 +361,26 @@ static void *getElement(double P[3], Octree *octree, int nbNod, int qn,
           ok &= (fabs(X[j] - qx[j]) < eps && fabs(Y[j] - qy[j]) < eps &&
                  fabs(Z[j] - qz[j]) < eps);
         }
-        if(ok) return v[i];
+        if(ok) {
+          e = v[i];
+          break;
+        }
       }
     }
-    if(v.size()) return v[0];
+    if(!e && v.size()) e = v[0];
   }
   else {
-    return Octree_Search(P, octree);
+    e = elements->search(P, hint ? *hint : 0);
   }
-  return 0;
+  if(e && hint) *hint = e;
+  return e;
 }
 
 static MElement *getElement(double P[3], GModel *m, int qn, double *qx,
-                            double *qy, double *qz)
+                            double *qy, double *qz, void **hint)
 {
   SPoint3 pt(P);
+  MElement *e = 0;
   if(qn && qx && qy && qz) {
     // try to use the value from the same geometrical element as the one
     // provided in qx/y/z
@@ -443,15 +395,19 @@ static MElement *getElement(double P[3], GModel *m, int qn, double *qx,
             (std::abs(v->x() - qx[j]) < eps && std::abs(v->y() - qy[j]) < eps &&
              std::abs(v->z() - qz[j]) < eps);
         }
-        if(ok) return elements[i];
+        if(ok) {
+          e = elements[i];
+          break;
+        }
       }
     }
-    if(elements.size()) return elements[0];
+    if(!e && elements.size()) e = elements[0];
   }
   else {
-    return m->getMeshElementByCoord(pt);
+    e = m->getMeshElementByCoord(pt, -1, true, hint ? (MElement *)*hint : 0);
   }
-  return 0;
+  if(e && hint) *hint = e;
+  return e;
 }
 
 bool OctreePost::_getValue(void *in, int dim, int nbNod, int nbComp,
@@ -558,7 +514,7 @@ bool OctreePost::_getValue(void *in, int nbComp, double P[3], int timestep,
 
 bool OctreePost::searchScalar(double x, double y, double z, double *values,
                               int step, double *size, int qn, double *qx,
-                              double *qy, double *qz, bool grad)
+                              double *qy, double *qz, bool grad, void **hint)
 {
   double P[3] = {x, y, z};
   int mult = grad ? 3 : 1;
@@ -578,36 +534,36 @@ bool OctreePost::searchScalar(double x, double y, double z, double *values,
   }
 
   if(_theViewDataList) {
-    if(_getValue(getElement(P, _SS, 4, qn, qx, qy, qz), 3, 4, 1, P, step,
+    if(_getValue(getElement(P, _SS, 4, qn, qx, qy, qz, hint), 3, 4, 1, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _SH, 8, qn, qx, qy, qz), 3, 8, 1, P, step,
+    if(_getValue(getElement(P, _SH, 8, qn, qx, qy, qz, hint), 3, 8, 1, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _SI, 6, qn, qx, qy, qz), 3, 6, 1, P, step,
+    if(_getValue(getElement(P, _SI, 6, qn, qx, qy, qz, hint), 3, 6, 1, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _SY, 5, qn, qx, qy, qz), 3, 5, 1, P, step,
+    if(_getValue(getElement(P, _SY, 5, qn, qx, qy, qz, hint), 3, 5, 1, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _ST, 3, qn, qx, qy, qz), 2, 3, 1, P, step,
+    if(_getValue(getElement(P, _ST, 3, qn, qx, qy, qz, hint), 2, 3, 1, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _SQ, 4, qn, qx, qy, qz), 2, 4, 1, P, step,
+    if(_getValue(getElement(P, _SQ, 4, qn, qx, qy, qz, hint), 2, 4, 1, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _SL, 2, qn, qx, qy, qz), 1, 2, 1, P, step,
+    if(_getValue(getElement(P, _SL, 2, qn, qx, qy, qz, hint), 1, 2, 1, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _SPP, 1, qn, qx, qy, qz), 0, 1, 1, P, step,
+    if(_getValue(getElement(P, _SPP, 1, qn, qx, qy, qz, hint), 0, 1, 1, P, step,
                  values, size, grad))
       return true;
   }
   else if(_theViewDataGModel) {
     GModel *m = _theViewDataGModel->getModel((step < 0) ? 0 : step);
     if(m) {
-      if(_getValue(getElement(P, m, qn, qx, qy, qz), 1, P, step, values, size,
-                   grad))
+      if(_getValue(getElement(P, m, qn, qx, qy, qz, hint), 1, P, step, values,
+                   size, grad))
         return true;
     }
   }
@@ -618,15 +574,17 @@ bool OctreePost::searchScalar(double x, double y, double z, double *values,
 bool OctreePost::searchScalarWithTol(double x, double y, double z,
                                      double *values, int step, double *size,
                                      double tol, int qn, double *qx, double *qy,
-                                     double *qz, bool grad)
+                                     double *qz, bool grad, void **hint)
 {
-  bool a = searchScalar(x, y, z, values, step, size, qn, qx, qy, qz, grad);
+  bool a =
+    searchScalar(x, y, z, values, step, size, qn, qx, qy, qz, grad, hint);
   if(!a && tol != 0.) {
     double oldtol1 = element::getTolerance();
     double oldtol2 = MElement::getTolerance();
     element::setTolerance(tol);
     MElement::setTolerance(tol);
-    a = searchScalar(x, y, z, values, step, size, qn, qx, qy, qz, grad);
+    a = searchScalar(x, y, z, values, step, size, qn, qx, qy, qz, grad,
+                     hint);
     element::setTolerance(oldtol1);
     MElement::setTolerance(oldtol2);
   }
@@ -635,7 +593,7 @@ bool OctreePost::searchScalarWithTol(double x, double y, double z,
 
 bool OctreePost::searchVector(double x, double y, double z, double *values,
                               int step, double *size, int qn, double *qx,
-                              double *qy, double *qz, bool grad)
+                              double *qy, double *qz, bool grad, void **hint)
 {
   double P[3] = {x, y, z};
   int mult = grad ? 3 : 1;
@@ -653,36 +611,36 @@ bool OctreePost::searchVector(double x, double y, double z, double *values,
   }
 
   if(_theViewDataList) {
-    if(_getValue(getElement(P, _VS, 4, qn, qx, qy, qz), 3, 4, 3, P, step,
+    if(_getValue(getElement(P, _VS, 4, qn, qx, qy, qz, hint), 3, 4, 3, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _VH, 8, qn, qx, qy, qz), 3, 8, 3, P, step,
+    if(_getValue(getElement(P, _VH, 8, qn, qx, qy, qz, hint), 3, 8, 3, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _VI, 6, qn, qx, qy, qz), 3, 6, 3, P, step,
+    if(_getValue(getElement(P, _VI, 6, qn, qx, qy, qz, hint), 3, 6, 3, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _VY, 5, qn, qx, qy, qz), 3, 5, 3, P, step,
+    if(_getValue(getElement(P, _VY, 5, qn, qx, qy, qz, hint), 3, 5, 3, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _VT, 3, qn, qx, qy, qz), 2, 3, 3, P, step,
+    if(_getValue(getElement(P, _VT, 3, qn, qx, qy, qz, hint), 2, 3, 3, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _VQ, 4, qn, qx, qy, qz), 2, 4, 3, P, step,
+    if(_getValue(getElement(P, _VQ, 4, qn, qx, qy, qz, hint), 2, 4, 3, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _VL, 2, qn, qx, qy, qz), 1, 2, 3, P, step,
+    if(_getValue(getElement(P, _VL, 2, qn, qx, qy, qz, hint), 1, 2, 3, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _VPP, 1, qn, qx, qy, qz), 0, 1, 3, P, step,
+    if(_getValue(getElement(P, _VPP, 1, qn, qx, qy, qz, hint), 0, 1, 3, P, step,
                  values, size, grad))
       return true;
   }
   else if(_theViewDataGModel) {
     GModel *m = _theViewDataGModel->getModel((step < 0) ? 0 : step);
     if(m) {
-      if(_getValue(getElement(P, m, qn, qx, qy, qz), 3, P, step, values, size,
-                   grad))
+      if(_getValue(getElement(P, m, qn, qx, qy, qz, hint), 3, P, step, values,
+                   size, grad))
         return true;
     }
   }
@@ -693,15 +651,17 @@ bool OctreePost::searchVector(double x, double y, double z, double *values,
 bool OctreePost::searchVectorWithTol(double x, double y, double z,
                                      double *values, int step, double *size,
                                      double tol, int qn, double *qx, double *qy,
-                                     double *qz, bool grad)
+                                     double *qz, bool grad, void **hint)
 {
-  bool a = searchVector(x, y, z, values, step, size, qn, qx, qy, qz, grad);
+  bool a =
+    searchVector(x, y, z, values, step, size, qn, qx, qy, qz, grad, hint);
   if(!a && tol != 0.) {
     double oldtol1 = element::getTolerance();
     double oldtol2 = MElement::getTolerance();
     element::setTolerance(tol);
     MElement::setTolerance(tol);
-    a = searchVector(x, y, z, values, step, size, qn, qx, qy, qz, grad);
+    a = searchVector(x, y, z, values, step, size, qn, qx, qy, qz, grad,
+                     hint);
     element::setTolerance(oldtol1);
     MElement::setTolerance(oldtol2);
   }
@@ -710,7 +670,7 @@ bool OctreePost::searchVectorWithTol(double x, double y, double z,
 
 bool OctreePost::searchTensor(double x, double y, double z, double *values,
                               int step, double *size, int qn, double *qx,
-                              double *qy, double *qz, bool grad)
+                              double *qy, double *qz, bool grad, void **hint)
 {
   double P[3] = {x, y, z};
   int mult = grad ? 3 : 1;
@@ -728,36 +688,36 @@ bool OctreePost::searchTensor(double x, double y, double z, double *values,
   }
 
   if(_theViewDataList) {
-    if(_getValue(getElement(P, _TS, 4, qn, qx, qy, qz), 3, 4, 9, P, step,
+    if(_getValue(getElement(P, _TS, 4, qn, qx, qy, qz, hint), 3, 4, 9, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _TH, 8, qn, qx, qy, qz), 3, 8, 9, P, step,
+    if(_getValue(getElement(P, _TH, 8, qn, qx, qy, qz, hint), 3, 8, 9, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _TI, 6, qn, qx, qy, qz), 3, 6, 9, P, step,
+    if(_getValue(getElement(P, _TI, 6, qn, qx, qy, qz, hint), 3, 6, 9, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _TY, 5, qn, qx, qy, qz), 3, 5, 9, P, step,
+    if(_getValue(getElement(P, _TY, 5, qn, qx, qy, qz, hint), 3, 5, 9, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _TT, 3, qn, qx, qy, qz), 2, 3, 9, P, step,
+    if(_getValue(getElement(P, _TT, 3, qn, qx, qy, qz, hint), 2, 3, 9, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _TQ, 4, qn, qx, qy, qz), 2, 4, 9, P, step,
+    if(_getValue(getElement(P, _TQ, 4, qn, qx, qy, qz, hint), 2, 4, 9, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _TL, 2, qn, qx, qy, qz), 1, 2, 9, P, step,
+    if(_getValue(getElement(P, _TL, 2, qn, qx, qy, qz, hint), 1, 2, 9, P, step,
                  values, size, grad))
       return true;
-    if(_getValue(getElement(P, _TPP, 1, qn, qx, qy, qz), 0, 1, 9, P, step,
+    if(_getValue(getElement(P, _TPP, 1, qn, qx, qy, qz, hint), 0, 1, 9, P, step,
                  values, size, grad))
       return true;
   }
   else if(_theViewDataGModel) {
     GModel *m = _theViewDataGModel->getModel((step < 0) ? 0 : step);
     if(m) {
-      if(_getValue(getElement(P, m, qn, qx, qy, qz), 9, P, step, values, size,
-                   grad))
+      if(_getValue(getElement(P, m, qn, qx, qy, qz, hint), 9, P, step, values,
+                   size, grad))
         return true;
     }
   }
@@ -768,15 +728,17 @@ bool OctreePost::searchTensor(double x, double y, double z, double *values,
 bool OctreePost::searchTensorWithTol(double x, double y, double z,
                                      double *values, int step, double *size,
                                      double tol, int qn, double *qx, double *qy,
-                                     double *qz, bool grad)
+                                     double *qz, bool grad, void **hint)
 {
-  bool a = searchTensor(x, y, z, values, step, size, qn, qx, qy, qz, grad);
+  bool a =
+    searchTensor(x, y, z, values, step, size, qn, qx, qy, qz, grad, hint);
   if(!a && tol != 0.) {
     double oldtol1 = element::getTolerance();
     double oldtol2 = MElement::getTolerance();
     element::setTolerance(tol);
     MElement::setTolerance(tol);
-    a = searchTensor(x, y, z, values, step, size, qn, qx, qy, qz, grad);
+    a = searchTensor(x, y, z, values, step, size, qn, qx, qy, qz, grad,
+                     hint);
     element::setTolerance(oldtol1);
     MElement::setTolerance(oldtol2);
   }
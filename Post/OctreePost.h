@@ -6,23 +6,24 @@
 #ifndef _OCTREE_POST_H_
 #define _OCTREE_POST_H_
 
-#include "Octree.h"
-
 class PView;
 class PViewData;
 class PViewDataList;
 class PViewDataGModel;
+class listBasedElements;
 
 class OctreePost {
 private:
-  Octree *_SPP, *_VPP, *_TPP; // _SP & co reserved by win32
-  Octree *_SL, *_VL, *_TL;
-  Octree *_ST, *_VT, *_TT;
-  Octree *_SQ, *_VQ, *_TQ;
-  Octree *_SS, *_VS, *_TS;
-  Octree *_SH, *_VH, *_TH;
-  Octree *_SI, *_VI, *_TI;
-  Octree *_SY, *_VY, *_TY;
+  // elements of list-based views, located with a bounding volume hierarchy
+  // (for model-based views, the elements are located in the model)
+  listBasedElements *_SPP, *_VPP, *_TPP; // _SP & co reserved by win32
+  listBasedElements *_SL, *_VL, *_TL;
+  listBasedElements *_ST, *_VT, *_TT;
+  listBasedElements *_SQ, *_VQ, *_TQ;
+  listBasedElements *_SS, *_VS, *_TS;
+  listBasedElements *_SH, *_VH, *_TH;
+  listBasedElements *_SI, *_VI, *_TI;
+  listBasedElements *_SY, *_VY, *_TY;
   PViewDataList *_theViewDataList;
   PViewDataGModel *_theViewDataGModel;
   void _create(PViewData *data);
@@ -35,34 +36,48 @@ public:
   OctreePost(PView *v);
   OctreePost(PViewData *data);
   ~OctreePost();
+  // can the search functions be called concurrently by several threads (the
+  // steps of MSH-based views that can be dropped from memory are read again
+  // when accessed, which is not thread-safe)?
+  bool canSearchConcurrently() const;
   // search for the value of the View at point x, y, z. Values are interpolated
   // using standard first order shape functions in the post element. If several
   // time steps are present, they are all interpolated unless time step is set
   // to a different value than -1. If qn is given, n node coordinates stored in
   // qx/y/z are used to select which element is used to interpolate (if the
   // query returned more than one). If grad is true, return the component-wise
-  // derivative (gradient) in xyz coordinates instead of the value.
+  // derivative (gradient) in xyz coordinates instead of the value. If hint is
+  // given, it should point to the opaque element handle returned by a previous
+  // search for a nearby point (or to 0): this element is then tried first, and
+  // the handle is updated with the element found. Each thread should use its
+  // own hint.
   bool searchScalar(double x, double y, double z, double *values, int step = -1,
                     double *size = 0, int qn = 0, double *qx = 0,
-                    double *qy = 0, double *qz = 0, bool grad = false);
+                    double *qy = 0, double *qz = 0, bool grad = false,
+                    void **hint = 0);
   bool searchScalarWithTol(double x, double y, double z, double *values,
                            int step = -1, double *size = 0, double tol = 1.e-2,
                            int qn = 0, double *qx = 0, double *qy = 0,
-                           double *qz = 0, bool grad = false);
+                           double *qz = 0, bool grad = false,
+                           void **hint = 0);
   bool searchVector(double x, double y, double z, double *values, int step = -1,
                     double *size = 0, int qn = 0, double *qx = 0,
-                    double *qy = 0, double *qz = 0, bool grad = false);
+                    double *qy = 0, double *qz = 0, bool grad = false,
+                    void **hint = 0);
   bool searchVectorWithTol(double x, double y, double z, double *values,
                            int step = -1, double *size = 0, double tol = 1.e-2,
                            int qn = 0, double *qx = 0, double *qy = 0,
-                           double *qz = 0, bool grad = false);
+                           double *qz = 0, bool grad = false,
+                           void **hint = 0);
   bool searchTensor(double x, double y, double z, double *values, int step = -1,
                     double *size = 0, int qn = 0, double *qx = 0,
-                    double *qy = 0, double *qz = 0, bool grad = false);
+                    double *qy = 0, double *qz = 0, bool grad = false,
+                    void **hint = 0);
   bool searchTensorWithTol(double x, double y, double z, double *values,
                            int step = -1, double *size = 0, double tol = 1.e-2,
                            int qn = 0, double *qx = 0, double *qy = 0,
-                           double *qz = 0, bool grad = false);
+                           double *qz = 0, bool grad = false,
+                           void **hint = 0);
 };
 
 #endif
@@ -142,6 +142,14 @@ public:
                        double z);
   virtual void tagNode(int step, int ent, int ele, int nod, int tag) {}
 
+  // return the number of the nod-th node from the ele-th element in the ent-th
+  // entity, shared by all the elements connected to the node, or 0 if the
+  // nodes are not numbered
+  virtual std::size_t getNodeNumber(int step, int ent, int ele, int nod)
+  {
+    return 0;
+  }
+
   // return the number of components available for the ele-th element in the
   // ent-th entity
   virtual int getNumComponents(int step, int ent, int ele) { return 0; }
@@ -213,6 +221,10 @@ public:
   // true if data is given at Gauss points (instead of vertices)
   virtual bool useGaussPoints() { return false; }
 
+  // true if the accessors above (getNode, getValue, etc.) can be called
+  // concurrently by several threads
+  virtual bool canReadConcurrently() { return false; }
+
   // initialize/destroy adaptive data
   void initAdaptiveData(int step, int level, double tol);
 
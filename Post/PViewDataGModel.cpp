@@ -252,11 +252,7 @@ bool PViewDataGModel::finalize(bool computeMinMax,
 
 MElement *PViewDataGModel::_getElement(int step, int ent, int ele)
 {
-  static int lastStep = -1, lastEnt = -1, lastEle = -1;
-  static MElement *curr = 0;
-  if(step != lastStep || ent != lastEnt || ele != lastEle)
-    curr = _steps[step]->getEntity(ent)->getMeshElement(ele);
-  return curr;
+  return _steps[step]->getEntity(ent)->getMeshElement(ele);
 }
 
 std::string PViewDataGModel::getFileName(int step)
@@ -270,7 +266,7 @@ int PViewDataGModel::getNumTimeSteps() { return _steps.size(); }
 int PViewDataGModel::getFirstNonEmptyTimeStep(int start)
 {
   for(unsigned int i = start; i < _steps.size(); i++)
-    if(_steps[i]->getNumData()) return i;
+    if(_steps[i]->hasData()) return i;
   return start;
 }
 
@@ -302,7 +298,17 @@ double PViewDataGModel::getMin(int step, bool onlyVisible,
     return vmin;
   }
 
-  if(step < 0) return _min;
+  if(step < 0) {
+    // the min of the deferred steps is only known once they have been loaded;
+    // if none is known yet, load the first one
+    double vmin = _min;
+    for(std::size_t i = 0; i < _steps.size(); i++)
+      if(_steps[i]->isDeferred()) vmin = std::min(vmin, _steps[i]->getMin());
+    for(std::size_t i = 0; i < _steps.size() && vmin == VAL_INF; i++)
+      if(_steps[i]->isDeferred()) vmin = getMin(i);
+    return vmin;
+  }
+  if(_steps[step]->isDeferred()) _steps[step]->getNumData();
   return _steps[step]->getMin();
 }
 
@@ -328,7 +334,15 @@ double PViewDataGModel::getMax(int step, bool onlyVisible,
     return vmax;
   }
 
-  if(step < 0) return _max;
+  if(step < 0) {
+    double vmax = _max;
+    for(std::size_t i = 0; i < _steps.size(); i++)
+      if(_steps[i]->isDeferred()) vmax = std::max(vmax, _steps[i]->getMax());
+    for(std::size_t i = 0; i < _steps.size() && vmax == -VAL_INF; i++)
+      if(_steps[i]->isDeferred()) vmax = getMax(i);
+    return vmax;
+  }
+  if(_steps[step]->isDeferred()) _steps[step]->getNumData();
   return _steps[step]->getMax();
 }
 
@@ -592,6 +606,14 @@ void PViewDataGModel::tagNode(int step, int ent, int ele, int nod, int tag)
   v->setIndex(tag);
 }
 
+std::size_t PViewDataGModel::getNodeNumber(int step, int ent, int ele, int nod)
+{
+  // Gauss points are not shared between elements
+  if(_type == GaussPointData) return 0;
+  MElement *e = _getElement(step, ent, ele);
+  return _getNode(e, nod)->getNum();
+}
+
 int PViewDataGModel::getNumComponents(int step, int ent, int ele)
 {
   return _steps[step]->getNumComponents();
@@ -665,6 +687,7 @@ void PViewDataGModel::getValue(int step, int ent, int ele, int nod, int comp,
 void PViewDataGModel::setValue(int step, int ent, int ele, int nod, int comp,
                                double val)
 {
+  _steps[step]->setModified();
   MElement *e = _getElement(step, ent, ele);
   switch(_type) {
   case NodeData: {
@@ -690,6 +713,16 @@ void PViewDataGModel::setValue(int step, int ent, int ele, int nod, int comp,
   }
 }
 
+bool PViewDataGModel::canReadConcurrently()
+{
+  // steps that can be dropped from memory are read again when accessed, and
+  // the Gauss points are allocated on first access
+  if(_type == GaussPointData) return false;
+  for(std::size_t i = 0; i < _steps.size(); i++)
+    if(_steps[i]->isDroppable()) return false;
+  return true;
+}
+
 int PViewDataGModel::getNumEdges(int step, int ent, int ele)
 {
   return _getElement(step, ent, ele)->getNumEdges();
@@ -828,7 +861,7 @@ bool PViewDataGModel::skipElement(int step, int ent, int ele,
 
 bool PViewDataGModel::hasTimeStep(int step)
 {
-  if(step >= 0 && step < getNumTimeSteps() && _steps[step]->getNumData())
+  if(step >= 0 && step < getNumTimeSteps() && _steps[step]->hasData())
     return true;
   return false;
 }
@@ -6,10 +6,23 @@
 #ifndef _PVIEW_DATA_GMODEL_H_
 #define _PVIEW_DATA_GMODEL_H_
 
+#include <stdio.h>
+#include <stdint.h>
+#include <algorithm>
 #include "PViewData.h"
 #include "GModel.h"
 #include "SBoundingBox3d.h"
 
+// The location of a block of records ($NodeData, $ElementData or
+// $ElementNodeData) in a MSH file.
+class stepDataRecords {
+public:
+  std::string fileName;
+  int64_t offset;
+  int numEnt;
+  bool binary, swap, multiple;
+};
+
 template <class Real> class stepData {
 private:
   // a pointer to the underlying model
@@ -37,6 +50,24 @@ private:
   // FIXME: we should change this design and store a vector<int> of tags, and do
   // indirect addressing, even if it's a bit slower...
   std::vector<Real *> *_data;
+  // the values pointed to by _data are carved out of a few large contiguous
+  // blocks instead of being allocated one index at a time; blocks grow
+  // geometrically, and a block of exactly the right size can be reserved
+  // when the number of values to store is known in advance
+  std::vector<Real *> _blocks;
+  Real *_blockNext, *_blockEnd;
+  std::size_t _numAllocated;
+  Real *_allocate(std::size_t n)
+  {
+    if((std::size_t)(_blockEnd - _blockNext) < n) {
+      std::size_t s = std::min(std::max(_numAllocated, (std::size_t)1024),
+                               (std::size_t)(1 << 20));
+      reserveValues(std::max(n, s));
+    }
+    Real *d = _blockNext;
+    _blockNext += n;
+    return d;
+  }
   // a vector containing the multiplying factor allowing to compute
   // the number of values stored in _data for each index (number of
   // values = getMult() * getNumComponents()). If _mult is empty, a
@@ -47,16 +78,76 @@ private:
   std::vector<std::vector<double> > _gaussPoints;
   // a set of all "partitions" encountered in the data
   std::set<int> _partitions;
+  // if the values have only been read from MSH files, the location of the
+  // records in the files: the values can then be dropped from memory when the
+  // memory budget for such steps (PostProcessing.MaxStepMemory) is exceeded,
+  // and are read again the next time they are accessed
+  std::vector<stepDataRecords> _records;
+  // binary records of fixed size are not even decoded when the file is read,
+  // but only the first time the step is accessed: the min/max of the step are
+  // then only known once it has been loaded
+  bool _deferred, _minMaxPending;
+  bool _reading;
+  unsigned long _lastAccess;
+  // all the steps whose values can be dropped, a counter incremented each time
+  // one of them is accessed (to find the least recently used ones), and the
+  // value of the counter at the last call to releaseAccesses(): steps accessed
+  // since then can still be referenced by the caller, and are never dropped
+  static std::vector<stepData<Real> *> _droppable;
+  static unsigned long _accessCounter, _releasedAccess;
+  bool _readRecords(FILE *fp, int numEnt, bool binary, bool swap,
+                    bool multiple, bool computeMinMax, bool showProgress);
+  // the values are read (in the stepDataLoad critical section) into separate
+  // storage, and _data is only published, atomically, once they are complete
+  void _load();
+  void _unload();
+  void _register();
+  void _unregister();
+  static void _dropLeastRecentlyUsed();
+  std::vector<Real *> *_loadedData()
+  {
+    std::vector<Real *> *d;
+#if defined(_OPENMP)
+#pragma omp atomic read
+#endif
+    d = _data;
+#if defined(_OPENMP)
+#pragma omp flush
+#endif
+    return d;
+  }
+  void _touch()
+  {
+    unsigned long c;
+#if defined(_OPENMP)
+#pragma omp atomic capture
+#endif
+    c = ++_accessCounter;
+#if defined(_OPENMP)
+#pragma omp atomic write
+#endif
+    _lastAccess = c;
+  }
+  void _pin()
+  {
+    if(_records.empty()) return;
+    _unregister();
+    _records.clear();
+  }
 
 public:
   stepData(GModel *model, int numComp, const std::string &fileName = "",
            int fileIndex = -1, double time = 0., double min = VAL_INF,
            double max = -VAL_INF)
     : _model(model), _fileName(fileName), _fileIndex(fileIndex), _time(time),
-      _min(min), _max(max), _numComp(numComp), _data(0)
+      _min(min), _max(max), _numComp(numComp), _data(0), _blockNext(0),
+      _blockEnd(0), _numAllocated(0), _deferred(false), _minMaxPending(false),
+      _reading(false), _lastAccess(0)
   {
   }
-  stepData(stepData<Real> &other) : _data(0)
+  stepData(stepData<Real> &other)
+    : _data(0), _blockNext(0), _blockEnd(0), _numAllocated(0),
+      _deferred(false), _minMaxPending(false), _reading(false), _lastAccess(0)
   {
     _model = other._model;
     _entities = other._entities;
@@ -70,11 +161,15 @@ public:
     if(other._data) {
       int n = other.getNumData();
       _data = new std::vector<Real *>(n, (Real *)0);
+      std::size_t size = 0;
+      for(int i = 0; i < n; i++)
+        if(other.getData(i)) size += other.getMult(i) * _numComp;
+      reserveValues(size);
       for(int i = 0; i < n; i++) {
         Real *d = other.getData(i);
         if(d) {
           int m = other.getMult(i) * _numComp;
-          (*_data)[i] = new Real[m];
+          (*_data)[i] = _allocate(m);
           for(int j = 0; j < m; j++) (*_data)[i][j] = d[j];
         }
       }
@@ -93,6 +188,7 @@ public:
   int getNumComponents() { return _numComp; }
   int getMult(int index)
   {
+    if(!_records.empty() && !_loadedData()) _load();
     if(index < 0 || index >= (int)_mult.size()) return 1;
     return _mult[index];
   }
@@ -108,21 +204,45 @@ public:
   void setMax(double max) { _max = max; }
   int getNumData()
   {
+    if(!_records.empty() && !_loadedData()) _load();
     if(!_data) return 0;
     return _data->size();
   }
+  // does the step contain values? (without loading it)
+  bool hasData()
+  {
+    for(std::size_t i = 0; i < _records.size(); i++)
+      if(_records[i].numEnt) return true;
+    return getNumData() > 0;
+  }
   void resizeData(int n)
   {
     if(!_data) _data = new std::vector<Real *>(n, (Real *)0);
     if(n > (int)_data->size()) _data->resize(n, (Real *)0);
   }
+  // make sure that the next n values allocated by getData() will be
+  // contiguous in memory
+  void reserveValues(std::size_t n)
+  {
+    if((std::size_t)(_blockEnd - _blockNext) >= n) return;
+    _blocks.push_back(new Real[n]);
+    _blockNext = _blocks.back();
+    _blockEnd = _blockNext + n;
+    _numAllocated += n;
+  }
   Real *getData(int index, bool allocIfNeeded = false, int mult = 1)
   {
     if(index < 0) return 0;
+    if(!_records.empty()) {
+      if(!_loadedData()) _load();
+      _touch();
+    }
     if(allocIfNeeded) {
+      // values not coming from a file can't be dropped
+      if(!_reading) _pin();
       if(index >= getNumData()) resizeData(index + 100); // optimize this
       if(!(*_data)[index]) {
-        (*_data)[index] = new Real[_numComp * mult];
+        (*_data)[index] = _allocate(_numComp * mult);
         for(int i = 0; i < _numComp * mult; i++) (*_data)[index][i] = 0.;
       }
       if(mult > 1) {
@@ -138,12 +258,15 @@ public:
   }
   void destroyData()
   {
+    _pin();
     if(_data) {
-      for(unsigned int i = 0; i < _data->size(); i++)
-        if((*_data)[i]) delete[](*_data)[i];
       delete _data;
       _data = 0;
     }
+    for(std::size_t i = 0; i < _blocks.size(); i++) delete[] _blocks[i];
+    std::vector<Real *>().swap(_blocks);
+    _blockNext = _blockEnd = 0;
+    _numAllocated = 0;
   }
   std::vector<double> &getGaussPoints(int msh)
   {
@@ -151,8 +274,25 @@ public:
     return _gaussPoints[msh];
   }
   std::set<int> &getPartitions() { return _partitions; }
+  // read a block of records from a MSH file and update the min/max
+  bool readMSH(const std::string &fileName, FILE *fp, bool binary, bool swap,
+               int numEnt, bool multiple);
+  // mark the values as modified, i.e. not only read from MSH files
+  void setModified() { _pin(); }
+  // can the values be dropped from memory (and read again when accessed)?
+  bool isDroppable() const { return !_records.empty(); }
+  // were some records only decoded after the file was read?
+  bool isDeferred() const { return _deferred; }
+  // is the step currently in memory?
+  bool isLoaded() { return _loadedData() != 0; }
+  // declare that the values of the steps accessed so far are not referenced
+  // anymore (e.g. once a plugin has run or the vertex arrays of a view have
+  // been filled), so that they can be dropped to satisfy the memory budget;
+  // does nothing if called from within a parallel region
+  static void releaseAccesses();
   double getMemoryInMb()
   {
+    if(!_data) return 0.;
     double b = 0.;
     for(int i = 0; i < getNumData(); i++) b += getMult(i);
     return b * getNumComponents() * sizeof(Real) / 1024. / 1024.;
@@ -221,6 +361,7 @@ public:
   void setNode(int step, int ent, int ele, int nod, double x, double y,
                double z);
   void tagNode(int step, int ent, int ele, int nod, int tag);
+  std::size_t getNodeNumber(int step, int ent, int ele, int nod);
   int getNumComponents(int step, int ent, int ele);
   int getNumValues(int step, int ent, int ele);
   void getValue(int step, int ent, int ele, int idx, double &val);
@@ -241,6 +382,9 @@ public:
   bool hasModel(GModel *model, int step = -1);
   bool isNodeData() { return _type == NodeData; }
   bool useGaussPoints() { return _type == GaussPointData; }
+  bool canReadConcurrently();
+  // see stepData::releaseAccesses()
+  static void releaseSteps() { stepData<double>::releaseAccesses(); }
   GModel *getModel(int step) { return _steps[step]->getModel(); }
   GEntity *getEntity(int step, int ent);
   MElement *getElement(int step, int entity, int element);
@@ -257,7 +401,7 @@ public:
                int step, double time, int partition, int numComp);
 
   // Add some data "on the fly", without a map
-  bool addData(GModel *model, const std::vector<int> &tags,
+  bool addData(GModel *model, const std::vector<std::size_t> &tags,
                const std::vector<std::vector<double> > &data, int step,
                double time, int partition, int numComp);
 
@@ -13,6 +13,240 @@
 #include "OS.h"
 #include "Context.h"
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+template <class Real>
+std::vector<stepData<Real> *> stepData<Real>::_droppable;
+
+template <class Real> unsigned long stepData<Real>::_accessCounter = 0;
+
+template <class Real> unsigned long stepData<Real>::_releasedAccess = 0;
+
+template <class Real>
+bool stepData<Real>::_readRecords(FILE *fp, int numEnt, bool binary,
+                                  bool swap, bool multiple, bool computeMinMax,
+                                  bool showProgress)
+{
+  if(showProgress) Msg::ResetProgressMeter();
+  for(int i = 0; i < numEnt; i++) {
+    int num;
+    if(binary) {
+      if(fread(&num, sizeof(int), 1, fp) != 1) return false;
+      if(swap) SwapBytes((char *)&num, sizeof(int), 1);
+    }
+    else {
+      if(fscanf(fp, "%d", &num) != 1) return false;
+    }
+    if(num < 0) return false;
+    int mult = 1;
+    if(multiple) {
+      if(binary) {
+        if(fread(&mult, sizeof(int), 1, fp) != 1) return false;
+        if(swap) SwapBytes((char *)&mult, sizeof(int), 1);
+      }
+      else {
+        if(fscanf(fp, "%d", &mult) != 1) return false;
+      }
+    }
+    Real *d = getData(num, true, mult);
+    if(binary) {
+      if((int)fread(d, sizeof(Real), _numComp * mult, fp) != _numComp * mult)
+        return false;
+      if(swap) SwapBytes((char *)d, sizeof(Real), _numComp * mult);
+    }
+    else {
+      for(int j = 0; j < _numComp * mult; j++)
+        if(fscanf(fp, "%lf", &d[j]) != 1) return false;
+    }
+    if(computeMinMax) {
+      // compute min/max here to avoid calling finalize(true) later: this would
+      // be very slow for large multi-step, multi-partition datasets (since we
+      // would recompute the min/max for all the previously loaded
+      // steps/partitions, and thus loop over all the elements many times)
+      for(int j = 0; j < mult; j++) {
+        double val = ComputeScalarRep(_numComp, &d[_numComp * j]);
+        _min = std::min(_min, val);
+        _max = std::max(_max, val);
+      }
+    }
+    if(showProgress && numEnt > 100000)
+      Msg::ProgressMeter(i + 1, numEnt, true, "Reading data");
+  }
+  return true;
+}
+
+template <class Real>
+bool stepData<Real>::readMSH(const std::string &fileName, FILE *fp,
+                             bool binary, bool swap, int numEnt, bool multiple)
+{
+  bool droppable = CTX::instance()->post.maxStepMemory > 0 &&
+                   (!_data || !_records.empty());
+
+  stepDataRecords rec;
+  rec.fileName = fileName;
+  rec.offset = FileTell(fp);
+  rec.numEnt = numEnt;
+  rec.binary = binary;
+  rec.swap = swap;
+  rec.multiple = multiple;
+
+  if(droppable && binary && !multiple && rec.offset >= 0) {
+    // all the records have the same size: skip them, they will be decoded the
+    // first time the step is accessed
+    int64_t size = (int64_t)numEnt * (sizeof(int) + _numComp * sizeof(Real));
+    if(FileSeek(fp, rec.offset + size, SEEK_SET)) return false;
+    if(_records.empty()) _register();
+    // the values in memory do not include the new records
+    _unload();
+    _records.push_back(rec);
+    _deferred = true;
+    _minMaxPending = true;
+    return true;
+  }
+
+  // values added to a step that is not in memory come on top of the ones
+  // already read
+  if(!_data && !_records.empty()) _load();
+
+  resizeData(numEnt);
+  if(!multiple) reserveValues((std::size_t)numEnt * _numComp);
+  _reading = true;
+  bool ok = _readRecords(fp, numEnt, binary, swap, multiple, true, true);
+  _reading = false;
+  if(!ok) return false;
+
+  if(droppable && rec.offset >= 0) {
+    if(_records.empty()) _register();
+    _records.push_back(rec);
+    _lastAccess = ++_accessCounter;
+    // the values were only accessed by the reader
+    releaseAccesses();
+  }
+  return true;
+}
+
+template <class Real> void stepData<Real>::_load()
+{
+#if defined(_OPENMP)
+#pragma omp critical(stepDataLoad)
+#endif
+  if(!_data) {
+    // read the values in a temporary step (without records, so that it is
+    // neither registered nor dropped), so that concurrent readers never see a
+    // partially read step
+    stepData<Real> tmp(_model, _numComp);
+    // the min/max of the deferred records are computed on the first load
+    bool computeMinMax = _minMaxPending;
+    for(std::size_t i = 0; i < _records.size(); i++) {
+      const stepDataRecords &rec = _records[i];
+      FILE *fp = Fopen(rec.fileName.c_str(), "rb");
+      if(!fp) {
+        Msg::Error("Unable to open file '%s'", rec.fileName.c_str());
+        continue;
+      }
+      Msg::Debug("Reading %d records from '%s' at offset %g", rec.numEnt,
+                 rec.fileName.c_str(), (double)rec.offset);
+      tmp.resizeData(rec.numEnt);
+      if(!rec.multiple) tmp.reserveValues((std::size_t)rec.numEnt * _numComp);
+      if(FileSeek(fp, rec.offset, SEEK_SET) ||
+         !tmp._readRecords(fp, rec.numEnt, rec.binary, rec.swap, rec.multiple,
+                           computeMinMax, false))
+        Msg::Error("Could not read data in file '%s'", rec.fileName.c_str());
+      fclose(fp);
+    }
+    if(computeMinMax) {
+      _min = std::min(_min, tmp._min);
+      _max = std::max(_max, tmp._max);
+      _minMaxPending = false;
+    }
+    if(!tmp._data) tmp._data = new std::vector<Real *>();
+    _blocks.swap(tmp._blocks);
+    std::swap(_blockNext, tmp._blockNext);
+    std::swap(_blockEnd, tmp._blockEnd);
+    std::swap(_numAllocated, tmp._numAllocated);
+    _mult.swap(tmp._mult);
+    std::vector<Real *> *data = tmp._data;
+    tmp._data = 0;
+#if defined(_OPENMP)
+#pragma omp flush
+#pragma omp atomic write
+#endif
+    _data = data;
+    // the step is being accessed: never drop it right away, even if it does
+    // not fit in the memory budget by itself
+    _touch();
+    _dropLeastRecentlyUsed();
+  }
+}
+
+template <class Real> void stepData<Real>::_unload()
+{
+  if(_data) {
+    delete _data;
+    _data = 0;
+  }
+  for(std::size_t i = 0; i < _blocks.size(); i++) delete[] _blocks[i];
+  std::vector<Real *>().swap(_blocks);
+  _blockNext = _blockEnd = 0;
+  _numAllocated = 0;
+  std::vector<int>().swap(_mult);
+}
+
+template <class Real> void stepData<Real>::_register()
+{
+  _droppable.push_back(this);
+}
+
+template <class Real> void stepData<Real>::_unregister()
+{
+  typename std::vector<stepData<Real> *>::iterator it =
+    std::find(_droppable.begin(), _droppable.end(), this);
+  if(it != _droppable.end()) _droppable.erase(it);
+}
+
+template <class Real> void stepData<Real>::_dropLeastRecentlyUsed()
+{
+  // must be called in the stepDataLoad critical section
+  double budget = CTX::instance()->post.maxStepMemory;
+  if(budget <= 0) return;
+#if defined(_OPENMP)
+  // other threads could be using the values
+  if(omp_in_parallel()) return;
+#endif
+  while(1) {
+    double mem = 0.;
+    stepData<Real> *lru = 0;
+    for(std::size_t i = 0; i < _droppable.size(); i++) {
+      stepData<Real> *s = _droppable[i];
+      if(!s->_data) continue;
+      mem += s->_numAllocated * sizeof(Real) / 1024. / 1024.;
+      // the caller can hold pointers to the values of the steps it accessed
+      if(s->_lastAccess > _releasedAccess) continue;
+      if(!lru || s->_lastAccess < lru->_lastAccess) lru = s;
+    }
+    if(mem <= budget || !lru) break;
+    Msg::Debug("Dropping step data read from '%s' from memory",
+               lru->_records[0].fileName.c_str());
+    lru->_unload();
+  }
+}
+
+template <class Real> void stepData<Real>::releaseAccesses()
+{
+#if defined(_OPENMP)
+  if(omp_in_parallel()) return;
+#pragma omp critical(stepDataLoad)
+#endif
+  {
+    _releasedAccess = _accessCounter;
+    _dropLeastRecentlyUsed();
+  }
+}
+
+template class stepData<double>;
+
 bool PViewDataGModel::addData(GModel *model,
                               const std::map<int, std::vector<double> > &data,
                               int step, double time, int partition, int numComp)
@@ -37,6 +271,12 @@ bool PViewDataGModel::addData(GModel *model,
                                      model->getNumMeshElements();
   _steps[step]->resizeData(numEnt);
 
+  std::size_t numValues = 0;
+  for(std::map<int, std::vector<double> >::const_iterator it = data.begin();
+      it != data.end(); it++)
+    numValues += (it->second.size() / numComp) * numComp;
+  _steps[step]->reserveValues(numValues);
+
   for(std::map<int, std::vector<double> >::const_iterator it = data.begin();
       it != data.end(); it++) {
     int mult = it->second.size() / numComp;
@@ -48,7 +288,8 @@ bool PViewDataGModel::addData(GModel *model,
   return true;
 }
 
-bool PViewDataGModel::addData(GModel *model, const std::vector<int> &tags,
+bool PViewDataGModel::addData(GModel *model,
+                              const std::vector<std::size_t> &tags,
                               const std::vector<std::vector<double> > &data,
                               int step, double time, int partition, int numComp)
 {
@@ -70,6 +311,12 @@ bool PViewDataGModel::addData(GModel *model, const std::vector<int> &tags,
                                      model->getNumMeshElements();
   _steps[step]->resizeData(numEnt);
 
+  // all the values of the step end up in a single contiguous block
+  std::size_t numValues = 0;
+  for(unsigned int i = 0; i < data.size(); i++)
+    numValues += (data[i].size() / numComp) * numComp;
+  _steps[step]->reserveValues(numValues);
+
   for(unsigned int i = 0; i < data.size(); i++) {
     int mult = data[i].size() / numComp;
     double *d = _steps[step]->getData(tags[i], true, mult);
@@ -111,53 +358,12 @@ bool PViewDataGModel::readMSH(const std::string &viewName,
   if(numSteps > maxSteps) return true;
   */
 
-  _steps[step]->resizeData(numEnt);
-
-  Msg::ResetProgressMeter();
-  for(int i = 0; i < numEnt; i++) {
-    int num;
-    if(binary) {
-      if(fread(&num, sizeof(int), 1, fp) != 1) return false;
-      if(swap) SwapBytes((char *)&num, sizeof(int), 1);
-    }
-    else {
-      if(fscanf(fp, "%d", &num) != 1) return false;
-    }
-    if(num < 0) return false;
-    int mult = 1;
-    if(_type == ElementNodeData || _type == GaussPointData) {
-      if(binary) {
-        if(fread(&mult, sizeof(int), 1, fp) != 1) return false;
-        if(swap) SwapBytes((char *)&mult, sizeof(int), 1);
-      }
-      else {
-        if(fscanf(fp, "%d", &mult) != 1) return false;
-      }
-    }
-    double *d = _steps[step]->getData(num, true, mult);
-    if(binary) {
-      if((int)fread(d, sizeof(double), numComp * mult, fp) != numComp * mult)
-        return false;
-      if(swap) SwapBytes((char *)d, sizeof(double), numComp * mult);
-    }
-    else {
-      for(int j = 0; j < numComp * mult; j++)
-        if(fscanf(fp, "%lf", &d[j]) != 1) return false;
-    }
-    // compute min/max here to avoid calling finalize(true) later:
-    // this would be very slow for large multi-step, multi-partition
-    // datasets (since we would recompute the min/max for all the
-    // previously loaded steps/partitions, and thus loop over all the
-    // elements many times)
-    for(int j = 0; j < mult; j++) {
-      double val = ComputeScalarRep(numComp, &d[numComp * j]);
-      _steps[step]->setMin(std::min(_steps[step]->getMin(), val));
-      _steps[step]->setMax(std::max(_steps[step]->getMax(), val));
-      _min = std::min(_min, val);
-      _max = std::max(_max, val);
-    }
-    if(numEnt > 100000) Msg::ProgressMeter(i + 1, numEnt, true, "Reading data");
-  }
+  if(!_steps[step]->readMSH(fileName, fp, binary, swap, numEnt,
+                            _type == ElementNodeData ||
+                              _type == GaussPointData))
+    return false;
+  _min = std::min(_min, _steps[step]->getMin());
+  _max = std::max(_max, _steps[step]->getMax());
 
   if(partition >= 0) _steps[step]->getPartitions().insert(partition);
 
@@ -453,6 +659,7 @@ void PViewDataGModel::importLists(int N[24], std::vector<double> *V[24])
       _steps[step]->computeBoundingBox();
       _steps[step]->setTime(step);
       _steps[step]->resizeData(nbe);
+      _steps[step]->reserveValues((std::size_t)nbe * nc * nn);
       for(unsigned int j = 0; j < list->size(); j += stride) {
         double *tmp = &(*list)[j];
         int num = (int)tmp[0];
@@ -827,7 +1034,7 @@ bool PViewDataGModel::readMED(const std::string &fileName, int fileIndex)
       // elements of different type are in the mesh before these ones)
       int startIndex = 0;
       if(tags.empty()) {
-        int maxv, maxe;
+        std::size_t maxv, maxe;
         _steps[step]->getModel()->getCheckPointedMaxNumbers(maxv, maxe);
         if(nodal) {
           startIndex += maxv;
@@ -811,6 +811,45 @@ bool PViewDataList::combineSpace(nameData &nd)
   return finalize();
 }
 
+void PViewDataList::appendElements(PViewDataList &other)
+{
+  for(int i = 0; i < 33; i++) {
+    std::vector<double> *list, *otherList;
+    int *nbe, *otherNbe, nbc, nbn;
+    if(i < 27) {
+      _getRawData(i, &list, &nbe, &nbc, &nbn);
+      other._getRawData(i, &otherList, &otherNbe, &nbc, &nbn);
+    }
+    else { // no constant number of nodes for polygons and polyhedra
+      std::vector<double> *l[6] = {&SG, &VG, &TG, &SD, &VD, &TD};
+      std::vector<double> *ol[6] = {&other.SG, &other.VG, &other.TG,
+                                    &other.SD, &other.VD, &other.TD};
+      int *n[6] = {&NbSG, &NbVG, &NbTG, &NbSD, &NbVD, &NbTD};
+      int *on[6] = {&other.NbSG, &other.NbVG, &other.NbTG,
+                    &other.NbSD, &other.NbVD, &other.NbTD};
+      list = l[i - 27];
+      otherList = ol[i - 27];
+      nbe = n[i - 27];
+      otherNbe = on[i - 27];
+    }
+    list->insert(list->end(), otherList->begin(), otherList->end());
+    std::vector<double>().swap(*otherList);
+    *nbe += *otherNbe;
+    *otherNbe = 0;
+  }
+  for(int t = 0; t < 2; t++) {
+    for(std::size_t i = 0; i < other.polyNumNodes[t].size(); i++) {
+      int n = other.polyNumNodes[t][i];
+      polyNumNodes[t].push_back(n);
+      polyAgNumNodes[t].push_back(polyAgNumNodes[t].back() + n);
+      polyTotNumNodes[t] += n;
+    }
+    other.polyNumNodes[t].clear();
+    other.polyAgNumNodes[t].resize(1, 0);
+    other.polyTotNumNodes[t] = 0;
+  }
+}
+
 bool PViewDataList::combineTime(nameData &nd)
 {
   // sanity checks
@@ -134,6 +134,9 @@ public:
   // specific to list-based data sets
   void setOrder2(int type);
   std::vector<double> *incrementList(int numComp, int type, int numNodes = 0);
+  // append the elements of another list-based data set with the same number
+  // of time steps (e.g. computed concurrently), and clear them in the other
+  void appendElements(PViewDataList &other);
 
   // I/O routines
   bool readPOS(FILE *fp, double version, bool binary);
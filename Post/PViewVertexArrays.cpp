@@ -15,6 +15,7 @@
 #include "PViewOptions.h"
 #include "PViewData.h"
 #include "PViewDataRemote.h"
+#include "PViewDataGModel.h"
 #include "Numeric.h"
 #include "VertexArray.h"
 #include "SmoothData.h"
@@ -1571,7 +1572,10 @@ public:
 bool PView::fillVertexArrays()
 {
   initPView init;
-  return init(this);
+  bool ret = init(this);
+  // the vertex arrays now hold copies of the values they need
+  PViewDataGModel::releaseSteps();
+  return ret;
 }
 
 void PView::fillVertexArray(onelab::localNetworkClient *remote, int length,
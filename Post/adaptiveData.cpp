@@ -1210,159 +1210,74 @@ template <> void adaptiveElements<adaptivePyramid>::init(int level)
 #endif
 }
 
-template <class T>
-bool adaptiveElements<T>::adapt(double tol, int numComp,
-                                std::vector<PCoords> &coords,
-                                std::vector<PValues> &values, double &minVal,
-                                double &maxVal, GMSH_PostPlugin *plug,
-                                bool onlyComputeMinMax)
+// compute c = a * b on the first numCols columns of b and c, the columns
+// being split in one slab per thread
+static void multiplyByColumnSlabs(const fullMatrix<double> &a,
+                                  fullMatrix<double> &b, fullMatrix<double> &c,
+                                  int numCols)
 {
-  int numVertices = T::allVertices.size();
-
-  if(!numVertices) {
-    Msg::Warning("No adapted vertices to interpolate");
-    return false;
-  }
-
-  int numVals = _coeffsVal ? _coeffsVal->size1() : T::numNodes;
-
-  if(numVals != (int)values.size()) {
-    Msg::Warning("Wrong number of values in adaptation %d != %i", numVals,
-                 values.size());
-    return false;
-  }
-
-#ifdef TIMER
-  double t1 = GetTimeInSeconds();
+  int nt = 1;
+#if defined(_OPENMP)
+  if((double)a.size1() * a.size2() * numCols > 1.e6)
+    nt = std::min(Msg::GetMaxThreads(), numCols);
 #endif
-
-  fullVector<double> val(numVals), res(numVertices);
-  switch(numComp) {
-  case 1: {
-    for(int i = 0; i < numVals; i++) val(i) = values[i].v[0];
-    break;
-  }
-  case 3:
-  case 9: {
-    for(int i = 0; i < numVals; i++) {
-      val(i) = 0;
-      for(int k = 0; k < numComp; k++)
-        val(i) += values[i].v[k] * values[i].v[k];
-    }
-    break;
-  }
-  default: {
-    Msg::Error("Can only adapt scalar, vector or tensor data");
-    return false;
-  }
-  }
-
-  _interpolVal->mult(val, res);
-
-  // minVal = VAL_INF;
-  // maxVal = -VAL_INF;
-  for(int i = 0; i < numVertices; i++) {
-    minVal = std::min(minVal, res(i));
-    maxVal = std::max(maxVal, res(i));
-  }
-  if(onlyComputeMinMax) return true;
-
-  fullMatrix<double> *resxyz = 0;
-  if(numComp == 3 || numComp == 9) {
-    fullMatrix<double> valxyz(numVals, numComp);
-    resxyz = new fullMatrix<double>(numVertices, numComp);
-    for(int i = 0; i < numVals; i++) {
-      for(int k = 0; k < numComp; k++) {
-        valxyz(i, k) = values[i].v[k];
-      }
-    }
-    _interpolVal->mult(valxyz, *resxyz);
-  }
-
-  int numNodes = _coeffsGeom ? _coeffsGeom->size1() : T::numNodes;
-  if(numNodes != (int)coords.size()) {
-    Msg::Error("Wrong number of nodes in adaptation %d != %i", numNodes,
-               coords.size());
-    if(resxyz) delete resxyz;
-    return false;
-  }
-
-  fullMatrix<double> xyz(numNodes, 3), XYZ(numVertices, 3);
-  for(int i = 0; i < numNodes; i++) {
-    xyz(i, 0) = coords[i].c[0];
-    xyz(i, 1) = coords[i].c[1];
-    xyz(i, 2) = coords[i].c[2];
-  }
-  _interpolGeom->mult(xyz, XYZ);
-
-#ifdef TIMER
-  adaptiveData::timerAdapt += GetTimeInSeconds() - t1;
-  return true;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static, 1)
 #endif
-
-  int i = 0;
-  for(std::set<adaptiveVertex>::iterator it = T::allVertices.begin();
-      it != T::allVertices.end(); ++it) {
-    // ok because we know this will not change the set ordering
-    adaptiveVertex *p = (adaptiveVertex *)&(*it);
-    p->val = res(i);
-    if(resxyz) {
-      p->val = (*resxyz)(i, 0);
-      p->valy = (*resxyz)(i, 1);
-      p->valz = (*resxyz)(i, 2);
-      if(numComp == 9) {
-        p->valyx = (*resxyz)(i, 3);
-        p->valyy = (*resxyz)(i, 4);
-        p->valyz = (*resxyz)(i, 5);
-        p->valzx = (*resxyz)(i, 6);
-        p->valzy = (*resxyz)(i, 7);
-        p->valzz = (*resxyz)(i, 8);
-      }
-    }
-    p->X = XYZ(i, 0);
-    p->Y = XYZ(i, 1);
-    p->Z = XYZ(i, 2);
-    i++;
+  for(int t = 0; t < nt; t++) {
+    int c0 = (numCols * t) / nt, c1 = (numCols * (t + 1)) / nt;
+    if(c1 == c0) continue;
+    fullMatrix<double> bs(b, c0, c1 - c0), cs(c, c0, c1 - c0);
+    a.mult(bs, cs);
   }
+}
 
-  if(resxyz) delete resxyz;
-
-  for(typename std::list<T *>::iterator it = T::all.begin(); it != T::all.end();
-      it++)
-    (*it)->visible = false;
-
-  if(!plug || tol != 0.) {
-    double avg = fabs(maxVal - minVal);
-    if(tol < 0) avg = 1.; // force visibility to the smallest subdivision
-    T::error(avg, tol);
-  }
-
-  if(plug) plug->assignSpecificVisibility();
-
-  coords.clear();
-  values.clear();
-  for(typename std::list<T *>::iterator it = T::all.begin(); it != T::all.end();
-      it++) {
-    if((*it)->visible) {
-      adaptiveVertex **p = (*it)->p;
-      for(int i = 0; i < T::numNodes; i++) {
-        coords.push_back(PCoords(p[i]->X, p[i]->Y, p[i]->Z));
-        switch(numComp) {
-        case 1: values.push_back(PValues(p[i]->val)); break;
-        case 3:
-          values.push_back(PValues(p[i]->val, p[i]->valy, p[i]->valz));
-          break;
-        case 9:
-          values.push_back(PValues(p[i]->val, p[i]->valy, p[i]->valz,
-                                   p[i]->valyx, p[i]->valyy, p[i]->valyz,
-                                   p[i]->valzx, p[i]->valzy, p[i]->valzz));
-          break;
-        }
-      }
+// copy the values (starting at column cv) and the coordinates (starting at
+// column cx) of row i into the vertex
+static void setAdaptiveVertex(adaptiveVertex *p, const fullMatrix<double> &res,
+                              const fullMatrix<double> &XYZ, int i, int cv,
+                              int cx, int numComp)
+{
+  if(numComp == 1)
+    p->val = res(i, cv);
+  else {
+    p->val = res(i, cv + 1);
+    p->valy = res(i, cv + 2);
+    p->valz = res(i, cv + 3);
+    if(numComp == 9) {
+      p->valyx = res(i, cv + 4);
+      p->valyy = res(i, cv + 5);
+      p->valyz = res(i, cv + 6);
+      p->valzx = res(i, cv + 7);
+      p->valzy = res(i, cv + 8);
+      p->valzz = res(i, cv + 9);
     }
   }
+  p->X = XYZ(i, cx);
+  p->Y = XYZ(i, cx + 1);
+  p->Z = XYZ(i, cx + 2);
+}
 
-  return true;
+// append an element to a list-based view
+static void addAdaptiveElement(adaptiveVertex **p, int numNodes, int numComp,
+                               std::vector<double> &list)
+{
+  for(int k = 0; k < numNodes; k++) list.push_back(p[k]->X);
+  for(int k = 0; k < numNodes; k++) list.push_back(p[k]->Y);
+  for(int k = 0; k < numNodes; k++) list.push_back(p[k]->Z);
+  for(int k = 0; k < numNodes; k++) {
+    list.push_back(p[k]->val);
+    if(numComp == 1) continue;
+    list.push_back(p[k]->valy);
+    list.push_back(p[k]->valz);
+    if(numComp == 3) continue;
+    list.push_back(p[k]->valyx);
+    list.push_back(p[k]->valyy);
+    list.push_back(p[k]->valyz);
+    list.push_back(p[k]->valzx);
+    list.push_back(p[k]->valzy);
+    list.push_back(p[k]->valzz);
+  }
 }
 
 template <class T>
@@ -1437,69 +1352,143 @@ void adaptiveElements<T>::addInView(double tol, int step, PViewData *in,
   outList->clear();
   *outNb = 0;
 
+  int numVertices = T::allVertices.size();
+  if(!numVertices) {
+    Msg::Warning("No adapted vertices to interpolate");
+    return;
+  }
+  int numVals = _coeffsVal ? _coeffsVal->size1() : T::numNodes;
+  int numNodes = _coeffsGeom ? _coeffsGeom->size1() : T::numNodes;
+
+  // rows of the vertices of the unrefined reference element
+  T *root = *T::all.begin();
+  int rootRows[8];
+  for(int k = 0; k < T::numNodes; k++)
+    rootRows[k] = std::distance(T::allVertices.begin(),
+                                T::allVertices.find(*root->p[k]));
+
+  std::vector<std::pair<int, int> > elements;
   for(int ent = 0; ent < in->getNumEntities(step); ent++) {
     for(int ele = 0; ele < in->getNumElements(step, ent); ele++) {
       if(in->skipElement(step, ent, ele) ||
          in->getNumEdges(step, ent, ele) != T::numEdges)
         continue;
-      int numNodes = in->getNumNodes(step, ent, ele);
-      std::vector<PCoords> coords;
-      for(int i = 0; i < numNodes; i++) {
-        double x, y, z;
-        in->getNode(step, ent, ele, i, x, y, z);
-        coords.push_back(PCoords(x, y, z));
-      }
-      int numVal = in->getNumValues(step, ent, ele);
-      std::vector<PValues> values;
+      elements.push_back(std::make_pair(ent, ele));
+    }
+  }
 
-      switch(numComp) {
-      case 1:
-        for(int i = 0; i < numVal; i++) {
-          double val;
-          in->getValue(step, ent, ele, i, val);
-          values.push_back(PValues(val));
-        }
-        break;
-      case 3: {
-        for(int i = 0; i < numVal / 3; i++) {
-          double vx, vy, vz;
-          in->getValue(step, ent, ele, 3 * i + 0, vx);
-          in->getValue(step, ent, ele, 3 * i + 1, vy);
-          in->getValue(step, ent, ele, 3 * i + 2, vz);
-          values.push_back(PValues(vx, vy, vz));
+  // The elements are processed by blocks: the data of the elements of a block
+  // is gathered in two matrices, so that the values and the coordinates at the
+  // vertices of the refined reference element are computed with one
+  // matrix-matrix product each, split among the threads. For each element,
+  // the first column of the values holds the quantity used for the min/max
+  // (the value or its squared norm), followed by the components.
+  int numCols = (numComp == 1) ? 1 : numComp + 1;
+  int blockSize =
+    std::max(1, std::min(256, (1 << 21) / (numVertices * (numCols + 3))));
+  fullMatrix<double> val(numVals, blockSize * numCols);
+  fullMatrix<double> xyz(numNodes, 3 * blockSize);
+  fullMatrix<double> res(numVertices, blockSize * numCols);
+  fullMatrix<double> XYZ(numVertices, 3 * blockSize);
+  std::vector<char> valid(blockSize);
+
+  for(std::size_t start = 0; start < elements.size(); start += blockSize) {
+    int nb = std::min(blockSize, (int)(elements.size() - start));
+    for(int b = 0; b < nb; b++) {
+      int ent = elements[start + b].first, ele = elements[start + b].second;
+      valid[b] = 0;
+      int numVal = in->getNumValues(step, ent, ele) / numComp;
+      if(numVal != numVals) {
+        Msg::Warning("Wrong number of values in adaptation %d != %i", numVals,
+                     numVal);
+        continue;
+      }
+      if(in->getNumNodes(step, ent, ele) != numNodes) {
+        Msg::Error("Wrong number of nodes in adaptation %d != %i", numNodes,
+                   in->getNumNodes(step, ent, ele));
+        continue;
+      }
+      for(int i = 0; i < numNodes; i++)
+        in->getNode(step, ent, ele, i, xyz(i, 3 * b), xyz(i, 3 * b + 1),
+                    xyz(i, 3 * b + 2));
+      for(int i = 0; i < numVals; i++) {
+        double norm = 0.;
+        for(int k = 0; k < numComp; k++) {
+          double v;
+          in->getValue(step, ent, ele, numComp * i + k, v);
+          if(numComp == 1)
+            val(i, b) = v;
+          else
+            val(i, numCols * b + 1 + k) = v;
+          norm += v * v;
         }
-        break;
+        if(numComp != 1) val(i, numCols * b) = norm;
       }
-      case 9: {
-        for(int i = 0; i < numVal / 9; i++) {
-          double vxx, vxy, vxz, vyx, vyy, vyz, vzx, vzy, vzz;
-          in->getValue(step, ent, ele, 9 * i + 0, vxx);
-          in->getValue(step, ent, ele, 9 * i + 1, vxy);
-          in->getValue(step, ent, ele, 9 * i + 2, vxz);
-          in->getValue(step, ent, ele, 9 * i + 3, vyx);
-          in->getValue(step, ent, ele, 9 * i + 4, vyy);
-          in->getValue(step, ent, ele, 9 * i + 5, vyz);
-          in->getValue(step, ent, ele, 9 * i + 6, vzx);
-          in->getValue(step, ent, ele, 9 * i + 7, vzy);
-          in->getValue(step, ent, ele, 9 * i + 8, vzz);
-          values.push_back(
-            PValues(vxx, vxy, vxz, vyx, vyy, vyz, vzx, vzy, vzz));
+      valid[b] = 1;
+    }
+
+    multiplyByColumnSlabs(*_interpolVal, val, res, nb * numCols);
+    multiplyByColumnSlabs(*_interpolGeom, xyz, XYZ, 3 * nb);
+
+    for(int b = 0; b < nb; b++) {
+      if(!valid[b]) continue;
+      int c = numCols * b;
+      double &minVal = out->Min, &maxVal = out->Max;
+      for(int i = 0; i < numVertices; i++) {
+        minVal = std::min(minVal, res(i, c));
+        maxVal = std::max(maxVal, res(i, c));
+      }
+
+      // the error estimate of a refined element compares averages of the
+      // values at its vertices: if the values vary less than the tolerance
+      // over the whole element, the unrefined element will be selected, so
+      // the tree of the refined reference element does not need to be
+      // visited
+      double avg = fabs(maxVal - minVal);
+      bool refine = true;
+      if(!plug && tol > 0.) {
+        int cv = (numComp == 1) ? c : c + 1;
+        double vmin = res(0, cv), vmax = res(0, cv);
+        for(int i = 1; i < numVertices; i++) {
+          vmin = std::min(vmin, res(i, cv));
+          vmax = std::max(vmax, res(i, cv));
         }
-        break;
+        refine = (vmax - vmin >= 0.5 * avg * tol);
+      }
+
+      if(!refine) {
+        for(int k = 0; k < T::numNodes; k++)
+          setAdaptiveVertex(root->p[k], res, XYZ, rootRows[k], c, 3 * b,
+                            numComp);
+        addAdaptiveElement(root->p, T::numNodes, numComp, *outList);
+        (*outNb)++;
+        continue;
       }
+
+      int i = 0;
+      for(std::set<adaptiveVertex>::iterator it = T::allVertices.begin();
+          it != T::allVertices.end(); ++it) {
+        // ok because we know this will not change the set ordering
+        setAdaptiveVertex((adaptiveVertex *)&(*it), res, XYZ, i++, c, 3 * b,
+                          numComp);
+      }
+
+      for(typename std::list<T *>::iterator it = T::all.begin();
+          it != T::all.end(); it++)
+        (*it)->visible = false;
+
+      if(!plug || tol != 0.) {
+        if(tol < 0) avg = 1.; // force visibility to the smallest subdivision
+        T::error(avg, tol);
       }
-      if(adapt(tol, numComp, coords, values, out->Min, out->Max, plug)){
-        *outNb += coords.size() / T::numNodes;
-        for(unsigned int i = 0; i < coords.size() / T::numNodes; i++) {
-          for(int k = 0; k < T::numNodes; ++k)
-            outList->push_back(coords[T::numNodes * i + k].c[0]);
-          for(int k = 0; k < T::numNodes; ++k)
-            outList->push_back(coords[T::numNodes * i + k].c[1]);
-          for(int k = 0; k < T::numNodes; ++k)
-            outList->push_back(coords[T::numNodes * i + k].c[2]);
-          for(int k = 0; k < T::numNodes; ++k)
-            for(int l = 0; l < numComp; ++l)
-              outList->push_back(values[T::numNodes * i + k].v[l]);
+
+      if(plug) plug->assignSpecificVisibility();
+
+      for(typename std::list<T *>::iterator it = T::all.begin();
+          it != T::all.end(); it++) {
+        if((*it)->visible) {
+          addAdaptiveElement((*it)->p, T::numNodes, numComp, *outList);
+          (*outNb)++;
         }
       }
     }
@@ -2561,7 +2550,7 @@ void adaptiveElements<T>::addInViewForVTK(int step, PViewData *in,
       adaptForVTK(myVTKData.vtkTol, numComp, coords, values, minVal,
                   maxVal); // ,plug);
 
-      // Inside initial element, after adapt() has been called
+      // Inside initial element, after adaptForVTK() has been called
 
       // Build the mapping of the canonical element,
       // or recycle existing one in case  of uniform refinement
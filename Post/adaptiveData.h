@@ -610,11 +610,6 @@ public:
   // create the _interpolVal and _interpolGeom matrices at the given
   // refinement level
   void init(int level);
-  // process the element data in coords/values and return the refined
-  // elements in coords/values
-  bool adapt(double tol, int numComp, std::vector<PCoords> &coords,
-             std::vector<PValues> &values, double &minVal, double &maxVal,
-             GMSH_PostPlugin *plug = 0, bool onlyComputeMinMax = false);
   // adapt all the T-type elements in the input view and add the
   // refined elements in the output view (we will remove this when we
   // switch to true on-the-fly local refinement in drawPost())
@@ -626,7 +621,7 @@ public:
   //   with paraview,
   // - and/or generation of VTK data structure for ParaView plugin.
 
-  // Clone of adapt for VTK output files
+  // Adaptation of the element data in coords/values for VTK output files
   void adaptForVTK(double tol, int numComp, std::vector<PCoords> &coords,
                    std::vector<PValues> &values, double &minVal,
                    double &maxVal);
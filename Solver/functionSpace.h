@@ -70,8 +70,8 @@ public:
                                std::vector<Dof> &keys) const
   {
     Msg::Warning(
-      "this function is defined to get Dofs of vertex %d on element %d",
-      v->getNum(), ele->getNum());
+      "this function is defined to get Dofs of vertex %lu on element %lu",
+      (unsigned long)v->getNum(), (unsigned long)ele->getNum());
   }
   virtual FunctionSpaceBase *clone(const int id) const
   {
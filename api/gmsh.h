@@ -328,7 +328,7 @@ namespace gmsh { // Top-level functions
 
       // Get the last nodes (if any) where a meshing error occurred. Currently only
       // populated by the new 3D meshing algorithms.
-      GMSH_API void getLastNodeError(std::vector<int> & nodeTags);
+      GMSH_API void getLastNodeError(std::vector<std::size_t> & nodeTags);
 
       // Get the nodes classified on the entity of dimension `dim' and tag `tag'.
       // If `tag' < 0, get the nodes for all entities of dimension `dim'. If `dim'
@@ -343,7 +343,7 @@ namespace gmsh { // Top-level functions
       // classified on the boundary of the entity (wich will be reparametrized on
       // the entity if `dim' >= 0 in order to compute their parametric
       // coordinates).
-      GMSH_API void getNodes(std::vector<int> & nodeTags,
+      GMSH_API void getNodes(std::vector<std::size_t> & nodeTags,
                              std::vector<double> & coord,
                              std::vector<double> & parametricCoord,
                              const int dim = -1,
@@ -356,7 +356,7 @@ namespace gmsh { // Top-level functions
       // meshes all the nodes in the model should be numbered in a continuous
       // sequence of tags from 1 to N to maintain reasonnable performance (in this
       // case the internal cache is based on a vector; otherwise it uses a map).
-      GMSH_API void getNode(const int nodeTag,
+      GMSH_API void getNode(const size_t nodeTag,
                             std::vector<double> & coord,
                             std::vector<double> & parametricCoord);
 
@@ -369,7 +369,7 @@ namespace gmsh { // Top-level functions
       // x, y, z coordinates of the nodes, concatenated: [n1x, n1y, n1z, n2x, ...].
       GMSH_API void getNodesForPhysicalGroup(const int dim,
                                              const int tag,
-                                             std::vector<int> & nodeTags,
+                                             std::vector<std::size_t> & nodeTags,
                                              std::vector<double> & coord);
 
       // Set the nodes classified on the geometrical entity of dimension `dim' and
@@ -382,7 +382,7 @@ namespace gmsh { // Top-level functions
       // of `nodeTags'.
       GMSH_API void setNodes(const int dim,
                              const int tag,
-                             const std::vector<int> & nodeTags,
+                             const std::vector<std::size_t> & nodeTags,
                              const std::vector<double> & coord,
                              const std::vector<double> & parametricCoord = std::vector<double>());
 
@@ -406,8 +406,8 @@ namespace gmsh { // Top-level functions
       // the node tags of all the elements of the given type, concatenated: [e1n1,
       // e1n2, ..., e1nN, e2n1, ...].
       GMSH_API void getElements(std::vector<int> & elementTypes,
-                                std::vector<std::vector<int> > & elementTags,
-                                std::vector<std::vector<int> > & nodeTags,
+                                std::vector<std::vector<std::size_t> > & elementTags,
+                                std::vector<std::vector<std::size_t> > & nodeTags,
                                 const int dim = -1,
                                 const int tag = -1);
 
@@ -417,9 +417,9 @@ namespace gmsh { // Top-level functions
       // model should be numbered in a continuous sequence of tags from 1 to N to
       // maintain reasonnable performance (in this case the internal cache is based
       // on a vector; otherwise it uses a map).
-      GMSH_API void getElement(const int elementTag,
+      GMSH_API void getElement(const size_t elementTag,
                                int & elementType,
-                               std::vector<int> & nodeTags);
+                               std::vector<std::size_t> & nodeTags);
 
       // Get the tag, type and node tags of the element located at coordinates
       // (`x', `y', `z'). This is a sometimes useful but inefficient way of
@@ -427,9 +427,9 @@ namespace gmsh { // Top-level functions
       GMSH_API void getElementByCoordinates(const double x,
                                             const double y,
                                             const double z,
-                                            int & elementTag,
+                                            std::size_t & elementTag,
                                             int & elementType,
-                                            std::vector<int> & nodeTags);
+                                            std::vector<std::size_t> & nodeTags);
 
       // Set the elements of the entity of dimension `dim' and tag `tag'. `types'
       // contains the MSH types of the elements (e.g. `2' for 3-node triangles: see
@@ -444,8 +444,8 @@ namespace gmsh { // Top-level functions
       GMSH_API void setElements(const int dim,
                                 const int tag,
                                 const std::vector<int> & elementTypes,
-                                const std::vector<std::vector<int> > & elementTags,
-                                const std::vector<std::vector<int> > & nodeTags);
+                                const std::vector<std::vector<std::size_t> > & elementTags,
+                                const std::vector<std::vector<std::size_t> > & nodeTags);
 
       // Get the types of elements in the entity of dimension `dim' and tag `tag'.
       // If `tag' < 0, get the types for all entities of dimension `dim'. If `dim'
@@ -475,8 +475,8 @@ namespace gmsh { // Top-level functions
       // `numTasks' > 1, only compute and return the part of the data indexed by
       // `task'.
       GMSH_API void getElementsByType(const int elementType,
-                                      std::vector<int> & elementTags,
-                                      std::vector<int> & nodeTags,
+                                      std::vector<std::size_t> & elementTags,
+                                      std::vector<std::size_t> & nodeTags,
                                       const int tag = -1,
                                       const size_t task = 0,
                                       const size_t numTasks = 1);
@@ -486,8 +486,8 @@ namespace gmsh { // Top-level functions
       GMSH_API void preallocateElementsByType(const int elementType,
                                               const bool elementTag,
                                               const bool nodeTag,
-                                              std::vector<int> & elementTags,
-                                              std::vector<int> & nodeTags,
+                                              std::vector<std::size_t> & elementTags,
+                                              std::vector<std::size_t> & nodeTags,
                                               const int tag = -1);
 
       // Get the Jacobians of all the elements of type `elementType' classified on
@@ -1518,7 +1518,7 @@ namespace gmsh { // Top-level functions
                                const int step,
                                const std::string & modelName,
                                const std::string & dataType,
-                               const std::vector<int> & tags,
+                               const std::vector<std::size_t> & tags,
                                const std::vector<std::vector<double> > & data,
                                const double time = 0.,
                                const int numComponents = -1,
@@ -1531,7 +1531,7 @@ namespace gmsh { // Top-level functions
     GMSH_API void getModelData(const int tag,
                                const int step,
                                std::string & dataType,
-                               std::vector<int> & tags,
+                               std::vector<std::size_t> & tags,
                                std::vector<std::vector<double> > & data,
                                double & time,
                                int & numComponents);
@@ -58,6 +58,15 @@ def _ovectorint(ptr, size):
         lib.gmshFree(ptr)
     return v
 
+def _ovectorsize(ptr, size):
+    if use_numpy:
+        v = numpy.ctypeslib.as_array(ptr, (size, ))
+        weakreffinalize(v, lib.gmshFree, ptr)
+    else:
+        v = list(ptr[i] for i in range(size))
+        lib.gmshFree(ptr)
+    return v
+
 def _ovectordouble(ptr, size):
     if use_numpy:
         v = numpy.ctypeslib.as_array(ptr, (size, ))
@@ -78,6 +87,12 @@ def _ovectorvectorint(ptr, size, n):
     lib.gmshFree(ptr)
     return v
 
+def _ovectorvectorsize(ptr, size, n):
+    v = [_ovectorsize(pointer(ptr[i].contents), size[i]) for i in range(n.value)]
+    lib.gmshFree(size)
+    lib.gmshFree(ptr)
+    return v
+
 def _ovectorvectordouble(ptr, size, n):
     v = [_ovectordouble(pointer(ptr[i].contents), size[i]) for i in range(n.value)]
     lib.gmshFree(size)
@@ -105,6 +120,21 @@ def _ivectorvectorint(os):
     size = c_size_t(n)
     return arrays, sizes, size
 
+def _ivectorsize(o):
+    if use_numpy:
+        return numpy.ascontiguousarray(o, numpy.uintp).ctypes, c_size_t(len(o))
+    else:
+        return (c_size_t * len(o))(*o), c_size_t(len(o))
+
+def _ivectorvectorsize(os):
+    n = len(os)
+    parrays = [_ivectorsize(o) for o in os]
+    sizes = (c_size_t * n)(*(a[1] for a in parrays))
+    arrays = (POINTER(c_size_t) * n)(*(cast(a[0], POINTER(c_size_t)) for a in parrays))
+    arrays.ref = [a[0] for a in parrays]
+    size = c_size_t(n)
+    return arrays, sizes, size
+
 def _ivectorvectordouble(os):
     n = len(os)
     parrays = [_ivectordouble(o) for o in os]
@@ -1040,7 +1070,7 @@ class model:
 
             Return `nodeTags'.
             """
-            api_nodeTags_, api_nodeTags_n_ = POINTER(c_int)(), c_size_t()
+            api_nodeTags_, api_nodeTags_n_ = POINTER(c_size_t)(), c_size_t()
             ierr = c_int()
             lib.gmshModelMeshGetLastNodeError(
                 byref(api_nodeTags_), byref(api_nodeTags_n_),
@@ -1049,7 +1079,7 @@ class model:
                 raise ValueError(
                     "gmshModelMeshGetLastNodeError returned non-zero error code: ",
                     ierr.value)
-            return _ovectorint(api_nodeTags_, api_nodeTags_n_.value)
+            return _ovectorsize(api_nodeTags_, api_nodeTags_n_.value)
 
         @staticmethod
         def getNodes(dim=-1, tag=-1, includeBoundary=False):
@@ -1069,7 +1099,7 @@ class model:
 
             Return `nodeTags', `coord', `parametricCoord'.
             """
-            api_nodeTags_, api_nodeTags_n_ = POINTER(c_int)(), c_size_t()
+            api_nodeTags_, api_nodeTags_n_ = POINTER(c_size_t)(), c_size_t()
             api_coord_, api_coord_n_ = POINTER(c_double)(), c_size_t()
             api_parametricCoord_, api_parametricCoord_n_ = POINTER(c_double)(), c_size_t()
             ierr = c_int()
@@ -1086,7 +1116,7 @@ class model:
                     "gmshModelMeshGetNodes returned non-zero error code: ",
                     ierr.value)
             return (
-                _ovectorint(api_nodeTags_, api_nodeTags_n_.value),
+                _ovectorsize(api_nodeTags_, api_nodeTags_n_.value),
                 _ovectordouble(api_coord_, api_coord_n_.value),
                 _ovectordouble(api_parametricCoord_, api_parametricCoord_n_.value))
 
@@ -1106,7 +1136,7 @@ class model:
             api_parametricCoord_, api_parametricCoord_n_ = POINTER(c_double)(), c_size_t()
             ierr = c_int()
             lib.gmshModelMeshGetNode(
-                c_int(nodeTag),
+                c_size_t(nodeTag),
                 byref(api_coord_), byref(api_coord_n_),
                 byref(api_parametricCoord_), byref(api_parametricCoord_n_),
                 byref(ierr))
@@ -1142,7 +1172,7 @@ class model:
 
             Return `nodeTags', `coord'.
             """
-            api_nodeTags_, api_nodeTags_n_ = POINTER(c_int)(), c_size_t()
+            api_nodeTags_, api_nodeTags_n_ = POINTER(c_size_t)(), c_size_t()
             api_coord_, api_coord_n_ = POINTER(c_double)(), c_size_t()
             ierr = c_int()
             lib.gmshModelMeshGetNodesForPhysicalGroup(
@@ -1156,7 +1186,7 @@ class model:
                     "gmshModelMeshGetNodesForPhysicalGroup returned non-zero error code: ",
                     ierr.value)
             return (
-                _ovectorint(api_nodeTags_, api_nodeTags_n_.value),
+                _ovectorsize(api_nodeTags_, api_nodeTags_n_.value),
                 _ovectordouble(api_coord_, api_coord_n_.value))
 
         @staticmethod
@@ -1170,7 +1200,7 @@ class model:
             vector contains the parametric coordinates of the nodes, if any. The length
             of `parametricCoord' can be 0 or `dim' times the length of `nodeTags'.
             """
-            api_nodeTags_, api_nodeTags_n_ = _ivectorint(nodeTags)
+            api_nodeTags_, api_nodeTags_n_ = _ivectorsize(nodeTags)
             api_coord_, api_coord_n_ = _ivectordouble(coord)
             api_parametricCoord_, api_parametricCoord_n_ = _ivectordouble(parametricCoord)
             ierr = c_int()
@@ -1222,8 +1252,8 @@ class model:
             Return `elementTypes', `elementTags', `nodeTags'.
             """
             api_elementTypes_, api_elementTypes_n_ = POINTER(c_int)(), c_size_t()
-            api_elementTags_, api_elementTags_n_, api_elementTags_nn_ = POINTER(POINTER(c_int))(), POINTER(c_size_t)(), c_size_t()
-            api_nodeTags_, api_nodeTags_n_, api_nodeTags_nn_ = POINTER(POINTER(c_int))(), POINTER(c_size_t)(), c_size_t()
+            api_elementTags_, api_elementTags_n_, api_elementTags_nn_ = POINTER(POINTER(c_size_t))(), POINTER(c_size_t)(), c_size_t()
+            api_nodeTags_, api_nodeTags_n_, api_nodeTags_nn_ = POINTER(POINTER(c_size_t))(), POINTER(c_size_t)(), c_size_t()
             ierr = c_int()
             lib.gmshModelMeshGetElements(
                 byref(api_elementTypes_), byref(api_elementTypes_n_),
@@ -1238,8 +1268,8 @@ class model:
                     ierr.value)
             return (
                 _ovectorint(api_elementTypes_, api_elementTypes_n_.value),
-                _ovectorvectorint(api_elementTags_, api_elementTags_n_, api_elementTags_nn_),
-                _ovectorvectorint(api_nodeTags_, api_nodeTags_n_, api_nodeTags_nn_))
+                _ovectorvectorsize(api_elementTags_, api_elementTags_n_, api_elementTags_nn_),
+                _ovectorvectorsize(api_nodeTags_, api_nodeTags_n_, api_nodeTags_nn_))
 
         @staticmethod
         def getElement(elementTag):
@@ -1254,10 +1284,10 @@ class model:
             Return `elementType', `nodeTags'.
             """
             api_elementType_ = c_int()
-            api_nodeTags_, api_nodeTags_n_ = POINTER(c_int)(), c_size_t()
+            api_nodeTags_, api_nodeTags_n_ = POINTER(c_size_t)(), c_size_t()
             ierr = c_int()
             lib.gmshModelMeshGetElement(
-                c_int(elementTag),
+                c_size_t(elementTag),
                 byref(api_elementType_),
                 byref(api_nodeTags_), byref(api_nodeTags_n_),
                 byref(ierr))
@@ -1267,7 +1297,7 @@ class model:
                     ierr.value)
             return (
                 api_elementType_.value,
-                _ovectorint(api_nodeTags_, api_nodeTags_n_.value))
+                _ovectorsize(api_nodeTags_, api_nodeTags_n_.value))
 
         @staticmethod
         def getElementByCoordinates(x, y, z):
@@ -1278,9 +1308,9 @@ class model:
 
             Return `elementTag', `elementType', `nodeTags'.
             """
-            api_elementTag_ = c_int()
+            api_elementTag_ = c_size_t()
             api_elementType_ = c_int()
-            api_nodeTags_, api_nodeTags_n_ = POINTER(c_int)(), c_size_t()
+            api_nodeTags_, api_nodeTags_n_ = POINTER(c_size_t)(), c_size_t()
             ierr = c_int()
             lib.gmshModelMeshGetElementByCoordinates(
                 c_double(x),
@@ -1297,7 +1327,7 @@ class model:
             return (
                 api_elementTag_.value,
                 api_elementType_.value,
-                _ovectorint(api_nodeTags_, api_nodeTags_n_.value))
+                _ovectorsize(api_nodeTags_, api_nodeTags_n_.value))
 
         @staticmethod
         def setElements(dim, tag, elementTypes, elementTags, nodeTags):
@@ -1313,8 +1343,8 @@ class model:
             the given type, concatenated: [e1n1, e1n2, ..., e1nN, e2n1, ...].
             """
             api_elementTypes_, api_elementTypes_n_ = _ivectorint(elementTypes)
-            api_elementTags_, api_elementTags_n_, api_elementTags_nn_ = _ivectorvectorint(elementTags)
-            api_nodeTags_, api_nodeTags_n_, api_nodeTags_nn_ = _ivectorvectorint(nodeTags)
+            api_elementTags_, api_elementTags_n_, api_elementTags_nn_ = _ivectorvectorsize(elementTags)
+            api_nodeTags_, api_nodeTags_n_, api_nodeTags_nn_ = _ivectorvectorsize(nodeTags)
             ierr = c_int()
             lib.gmshModelMeshSetElements(
                 c_int(dim),
@@ -1400,8 +1430,8 @@ class model:
 
             Return `elementTags', `nodeTags'.
             """
-            api_elementTags_, api_elementTags_n_ = POINTER(c_int)(), c_size_t()
-            api_nodeTags_, api_nodeTags_n_ = POINTER(c_int)(), c_size_t()
+            api_elementTags_, api_elementTags_n_ = POINTER(c_size_t)(), c_size_t()
+            api_nodeTags_, api_nodeTags_n_ = POINTER(c_size_t)(), c_size_t()
             ierr = c_int()
             lib.gmshModelMeshGetElementsByType(
                 c_int(elementType),
@@ -1416,8 +1446,8 @@ class model:
                     "gmshModelMeshGetElementsByType returned non-zero error code: ",
                     ierr.value)
             return (
-                _ovectorint(api_elementTags_, api_elementTags_n_.value),
-                _ovectorint(api_nodeTags_, api_nodeTags_n_.value))
+                _ovectorsize(api_elementTags_, api_elementTags_n_.value),
+                _ovectorsize(api_nodeTags_, api_nodeTags_n_.value))
 
         @staticmethod
         def preallocateElementsByType(elementType, elementTag, nodeTag, tag=-1):
@@ -1427,8 +1457,8 @@ class model:
 
             Return `elementTags', `nodeTags'.
             """
-            api_elementTags_, api_elementTags_n_ = POINTER(c_int)(), c_size_t()
-            api_nodeTags_, api_nodeTags_n_ = POINTER(c_int)(), c_size_t()
+            api_elementTags_, api_elementTags_n_ = POINTER(c_size_t)(), c_size_t()
+            api_nodeTags_, api_nodeTags_n_ = POINTER(c_size_t)(), c_size_t()
             ierr = c_int()
             lib.gmshModelMeshPreallocateElementsByType(
                 c_int(elementType),
@@ -1443,8 +1473,8 @@ class model:
                     "gmshModelMeshPreallocateElementsByType returned non-zero error code: ",
                     ierr.value)
             return (
-                _ovectorint(api_elementTags_, api_elementTags_n_.value),
-                _ovectorint(api_nodeTags_, api_nodeTags_n_.value))
+                _ovectorsize(api_elementTags_, api_elementTags_n_.value),
+                _ovectorsize(api_nodeTags_, api_nodeTags_n_.value))
 
         @staticmethod
         def getJacobians(elementType, integrationType, tag=-1, task=0, numTasks=1):
@@ -4017,7 +4047,7 @@ class view:
         entity; if negative, it is automatically inferred (when possible) from the
         input data. `partition' allows to specify data in several sub-sets.
         """
-        api_tags_, api_tags_n_ = _ivectorint(tags)
+        api_tags_, api_tags_n_ = _ivectorsize(tags)
         api_data_, api_data_n_, api_data_nn_ = _ivectorvectordouble(data)
         ierr = c_int()
         lib.gmshViewAddModelData(
@@ -4047,7 +4077,7 @@ class view:
         Return `dataType', `tags', `data', `time', `numComponents'.
         """
         api_dataType_ = c_char_p()
-        api_tags_, api_tags_n_ = POINTER(c_int)(), c_size_t()
+        api_tags_, api_tags_n_ = POINTER(c_size_t)(), c_size_t()
         api_data_, api_data_n_, api_data_nn_ = POINTER(POINTER(c_double))(), POINTER(c_size_t)(), c_size_t()
         api_time_ = c_double()
         api_numComponents_ = c_int()
@@ -4067,7 +4097,7 @@ class view:
                 ierr.value)
         return (
             _ostring(api_dataType_),
-            _ovectorint(api_tags_, api_tags_n_.value),
+            _ovectorsize(api_tags_, api_tags_n_.value),
             _ovectorvectordouble(api_data_, api_data_n_, api_data_nn_),
             api_time_.value,
             api_numComponents_.value)
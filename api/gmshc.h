@@ -346,7 +346,7 @@ GMSH_API void gmshModelMeshGetLastEntityError(int ** dimTags, size_t * dimTags_n
 
 /* Get the last nodes (if any) where a meshing error occurred. Currently only
  * populated by the new 3D meshing algorithms. */
-GMSH_API void gmshModelMeshGetLastNodeError(int ** nodeTags, size_t * nodeTags_n,
+GMSH_API void gmshModelMeshGetLastNodeError(size_t ** nodeTags, size_t * nodeTags_n,
                                             int * ierr);
 
 /* Get the nodes classified on the entity of dimension `dim' and tag `tag'. If
@@ -361,7 +361,7 @@ GMSH_API void gmshModelMeshGetLastNodeError(int ** nodeTags, size_t * nodeTags_n
  * `includeBoundary' is set, also return the nodes classified on the boundary
  * of the entity (wich will be reparametrized on the entity if `dim' >= 0 in
  * order to compute their parametric coordinates). */
-GMSH_API void gmshModelMeshGetNodes(int ** nodeTags, size_t * nodeTags_n,
+GMSH_API void gmshModelMeshGetNodes(size_t ** nodeTags, size_t * nodeTags_n,
                                     double ** coord, size_t * coord_n,
                                     double ** parametricCoord, size_t * parametricCoord_n,
                                     const int dim,
@@ -375,7 +375,7 @@ GMSH_API void gmshModelMeshGetNodes(int ** nodeTags, size_t * nodeTags_n,
  * the nodes in the model should be numbered in a continuous sequence of tags
  * from 1 to N to maintain reasonnable performance (in this case the internal
  * cache is based on a vector; otherwise it uses a map). */
-GMSH_API void gmshModelMeshGetNode(const int nodeTag,
+GMSH_API void gmshModelMeshGetNode(const size_t nodeTag,
                                    double ** coord, size_t * coord_n,
                                    double ** parametricCoord, size_t * parametricCoord_n,
                                    int * ierr);
@@ -390,7 +390,7 @@ GMSH_API void gmshModelMeshRebuildNodeCache(const int onlyIfNecessary,
  * y, z coordinates of the nodes, concatenated: [n1x, n1y, n1z, n2x, ...]. */
 GMSH_API void gmshModelMeshGetNodesForPhysicalGroup(const int dim,
                                                     const int tag,
-                                                    int ** nodeTags, size_t * nodeTags_n,
+                                                    size_t ** nodeTags, size_t * nodeTags_n,
                                                     double ** coord, size_t * coord_n,
                                                     int * ierr);
 
@@ -403,7 +403,7 @@ GMSH_API void gmshModelMeshGetNodesForPhysicalGroup(const int dim,
  * of `parametricCoord' can be 0 or `dim' times the length of `nodeTags'. */
 GMSH_API void gmshModelMeshSetNodes(const int dim,
                                     const int tag,
-                                    int * nodeTags, size_t nodeTags_n,
+                                    size_t * nodeTags, size_t nodeTags_n,
                                     double * coord, size_t coord_n,
                                     double * parametricCoord, size_t parametricCoord_n,
                                     int * ierr);
@@ -428,8 +428,8 @@ GMSH_API void gmshModelMeshReclassifyNodes(int * ierr);
  * the node tags of all the elements of the given type, concatenated: [e1n1,
  * e1n2, ..., e1nN, e2n1, ...]. */
 GMSH_API void gmshModelMeshGetElements(int ** elementTypes, size_t * elementTypes_n,
-                                       int *** elementTags, size_t ** elementTags_n, size_t *elementTags_nn,
-                                       int *** nodeTags, size_t ** nodeTags_n, size_t *nodeTags_nn,
+                                       size_t *** elementTags, size_t ** elementTags_n, size_t *elementTags_nn,
+                                       size_t *** nodeTags, size_t ** nodeTags_n, size_t *nodeTags_nn,
                                        const int dim,
                                        const int tag,
                                        int * ierr);
@@ -440,9 +440,9 @@ GMSH_API void gmshModelMeshGetElements(int ** elementTypes, size_t * elementType
  * should be numbered in a continuous sequence of tags from 1 to N to maintain
  * reasonnable performance (in this case the internal cache is based on a
  * vector; otherwise it uses a map). */
-GMSH_API void gmshModelMeshGetElement(const int elementTag,
+GMSH_API void gmshModelMeshGetElement(const size_t elementTag,
                                       int * elementType,
-                                      int ** nodeTags, size_t * nodeTags_n,
+                                      size_t ** nodeTags, size_t * nodeTags_n,
                                       int * ierr);
 
 /* Get the tag, type and node tags of the element located at coordinates (`x',
@@ -451,9 +451,9 @@ GMSH_API void gmshModelMeshGetElement(const int elementTag,
 GMSH_API void gmshModelMeshGetElementByCoordinates(const double x,
                                                    const double y,
                                                    const double z,
-                                                   int * elementTag,
+                                                   size_t * elementTag,
                                                    int * elementType,
-                                                   int ** nodeTags, size_t * nodeTags_n,
+                                                   size_t ** nodeTags, size_t * nodeTags_n,
                                                    int * ierr);
 
 /* Set the elements of the entity of dimension `dim' and tag `tag'. `types'
@@ -468,8 +468,8 @@ GMSH_API void gmshModelMeshGetElementByCoordinates(const double x,
 GMSH_API void gmshModelMeshSetElements(const int dim,
                                        const int tag,
                                        int * elementTypes, size_t elementTypes_n,
-                                       const int ** elementTags, const size_t * elementTags_n, size_t elementTags_nn,
-                                       const int ** nodeTags, const size_t * nodeTags_n, size_t nodeTags_nn,
+                                       const size_t ** elementTags, const size_t * elementTags_n, size_t elementTags_nn,
+                                       const size_t ** nodeTags, const size_t * nodeTags_n, size_t nodeTags_nn,
                                        int * ierr);
 
 /* Get the types of elements in the entity of dimension `dim' and tag `tag'.
@@ -502,8 +502,8 @@ GMSH_API void gmshModelMeshGetElementProperties(const int elementType,
  * `numTasks' > 1, only compute and return the part of the data indexed by
  * `task'. */
 GMSH_API void gmshModelMeshGetElementsByType(const int elementType,
-                                             int ** elementTags, size_t * elementTags_n,
-                                             int ** nodeTags, size_t * nodeTags_n,
+                                             size_t ** elementTags, size_t * elementTags_n,
+                                             size_t ** nodeTags, size_t * nodeTags_n,
                                              const int tag,
                                              const size_t task,
                                              const size_t numTasks,
@@ -514,8 +514,8 @@ GMSH_API void gmshModelMeshGetElementsByType(const int elementType,
 GMSH_API void gmshModelMeshPreallocateElementsByType(const int elementType,
                                                      const int elementTag,
                                                      const int nodeTag,
-                                                     int ** elementTags, size_t * elementTags_n,
-                                                     int ** nodeTags, size_t * nodeTags_n,
+                                                     size_t ** elementTags, size_t * elementTags_n,
+                                                     size_t ** nodeTags, size_t * nodeTags_n,
                                                      const int tag,
                                                      int * ierr);
 
@@ -1621,7 +1621,7 @@ GMSH_API void gmshViewAddModelData(const int tag,
                                    const int step,
                                    const char * modelName,
                                    const char * dataType,
-                                   int * tags, size_t tags_n,
+                                   size_t * tags, size_t tags_n,
                                    const double ** data, const size_t * data_n, size_t data_nn,
                                    const double time,
                                    const int numComponents,
@@ -1635,7 +1635,7 @@ GMSH_API void gmshViewAddModelData(const int tag,
 GMSH_API void gmshViewGetModelData(const int tag,
                                    const int step,
                                    char ** dataType,
-                                   int ** tags, size_t * tags_n,
+                                   size_t ** tags, size_t * tags_n,
                                    double *** data, size_t ** data_n, size_t *data_nn,
                                    double * time,
                                    int * numComponents,
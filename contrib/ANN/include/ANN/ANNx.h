@@ -59,6 +59,12 @@ enum ANNerr {ANNwarn = 0, ANNabort = 1};
 extern int		ANNmaxPtsVisited;	// maximum number of pts visited
 extern int		ANNptsVisited;		// number of pts visited in search
 
+// gmsh: search state is private to each thread, so that concurrent queries
+// (e.g. when meshing surfaces in parallel) are safe
+#if defined(_OPENMP)
+#pragma omp threadprivate(ANNptsVisited)
+#endif
+
 //----------------------------------------------------------------------
 //	Global function declarations
 //----------------------------------------------------------------------
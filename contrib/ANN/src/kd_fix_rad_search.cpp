@@ -51,6 +51,12 @@ ANNmin_k*		ANNkdFRPointMK;			// set of k closest points
 int				ANNkdFRPtsVisited;		// total points visited
 int				ANNkdFRPtsInRange;		// number of points in the range
 
+// gmsh: search state is private to each thread, so that concurrent queries
+// (e.g. when meshing surfaces in parallel) are safe
+#if defined(_OPENMP)
+#pragma omp threadprivate(ANNkdFRDim, ANNkdFRSqRad, ANNkdFRMaxErr, ANNkdFRPts, ANNkdFRPointMK, ANNkdFRPtsVisited, ANNkdFRPtsInRange)
+#endif
+
 //----------------------------------------------------------------------
 //	annkFRSearch - fixed radius search for k nearest neighbors
 //----------------------------------------------------------------------
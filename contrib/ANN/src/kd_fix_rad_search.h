@@ -41,4 +41,10 @@
 
 extern ANNpoint			ANNkdFRQ;			// query point (static copy)
 
+// gmsh: search state is private to each thread, so that concurrent queries
+// (e.g. when meshing surfaces in parallel) are safe
+#if defined(_OPENMP)
+#pragma omp threadprivate(ANNkdFRQ)
+#endif
+
 #endif
@@ -46,4 +46,10 @@ extern ANNpointArray	ANNprPts;		// the points
 extern ANNpr_queue		*ANNprBoxPQ;	// priority queue for boxes
 extern ANNmin_k			*ANNprPointMK;	// set of k closest points
 
+// gmsh: search state is private to each thread, so that concurrent queries
+// (e.g. when meshing surfaces in parallel) are safe
+#if defined(_OPENMP)
+#pragma omp threadprivate(ANNprEps, ANNprDim, ANNprQ, ANNprMaxErr, ANNprPts, ANNprBoxPQ, ANNprPointMK)
+#endif
+
 #endif
@@ -45,4 +45,10 @@ extern ANNpointArray	ANNkdPts;		// the points (static copy)
 extern ANNmin_k			*ANNkdPointMK;	// set of k closest points
 extern int				ANNptsVisited;	// number of points visited
 
+// gmsh: search state is private to each thread, so that concurrent queries
+// (e.g. when meshing surfaces in parallel) are safe
+#if defined(_OPENMP)
+#pragma omp threadprivate(ANNkdDim, ANNkdQ, ANNkdMaxErr, ANNkdPts, ANNkdPointMK)
+#endif
+
 #endif
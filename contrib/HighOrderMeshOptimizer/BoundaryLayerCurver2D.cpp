@@ -231,8 +231,9 @@ namespace BoundaryLayerCurver
           _paramVerticesOnGFace[2*i+0] = param[0];
           _paramVerticesOnGFace[2*i+1] = param[1];
           if (!success) {
-            Msg::Warning("Could not compute param of vertex %d on surface %d",
-                         edge->getVertex(i)->getNum(), gface->tag());
+            Msg::Warning("Could not compute param of vertex %lu on surface %d",
+                         (unsigned long)edge->getVertex(i)->getNum(),
+                         gface->tag());
           }
           // TODO: Check if periodic face
         }
@@ -243,8 +244,9 @@ namespace BoundaryLayerCurver
           bool success = reparamMeshVertexOnEdge(edge->getVertex(i), gedge,
                                                  _paramVerticesOnGEdge[i]);
           if (!success) {
-            Msg::Warning("Could not compute param of vertex %d on edge %d",
-                         edge->getVertex(i)->getNum(), gedge->tag());
+            Msg::Warning("Could not compute param of vertex %lu on edge %d",
+                         (unsigned long)edge->getVertex(i)->getNum(),
+                         gedge->tag());
           }
           else if (gedge->periodic(0) &&
                    edge->getVertex(i) == gedge->getBeginVertex()->mesh_vertices[0]) {
@@ -120,8 +120,9 @@ namespace
         SVector3 n2 = SVector3(gradients[2][0], gradients[2][1], gradients[2][2]);
 
         if (dot(n, n2) < 0) {
-          Msg::Warning("Boundary elements have opposite normals (3) %d -- %d",
-                       bottom1->getNum(), bottom2->getNum());
+          Msg::Warning("Boundary elements have opposite normals (3) %lu -- %lu",
+                       (unsigned long)bottom1->getNum(),
+                       (unsigned long)bottom2->getNum());
           n.negate();
         }
         n.axpy(1, n2);
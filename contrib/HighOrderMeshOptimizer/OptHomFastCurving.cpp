@@ -643,17 +643,19 @@ public:
     for (std::set<MVertex*>::iterator itV = vert_.begin();
          itV != vert_.end(); ++itV) {
       SPoint3 p = (*itV)->point();
-      fprintf(fp, "%i %g %g %g\n", (*itV)->getNum(), p.x(), p.y(), p.z());
+      fprintf(fp, "%lu %g %g %g\n", (unsigned long)(*itV)->getNum(), p.x(),
+              p.y(), p.z());
     }
     fprintf(fp, "$EndNodes\n");
     fprintf(fp, "$Elements\n");
     fprintf(fp, "%d\n", elt_.size());
     int iV = 0;
     for (int iEl = 0; iEl < elt_.size(); iEl++) {
-      fprintf(fp, "%i %i 2 0 0 ", elt_[iEl]->getNum(),
+      fprintf(fp, "%lu %i 2 0 0 ", (unsigned long)elt_[iEl]->getNum(),
                                   elt_[iEl]->getTypeForMSH());
       for (int iVEl = 0; iVEl < elt_[iEl]->getNumVertices(); iVEl++)
-        fprintf(fp, " %i", elt_[iEl]->getVertex(iVEl)->getNum());
+        fprintf(fp, " %lu",
+                (unsigned long)elt_[iEl]->getVertex(iVEl)->getNum());
       fprintf(fp, "\n");
     }
     fprintf(fp, "$EndElements\n");
@@ -152,9 +152,9 @@ void OptHomPeriodicity::_relocateMasterVertices()
             SPoint3 p3 (v->x()*coeff, v->y()*coeff, v->z()*coeff);
             double u;
             if (!master->XYZToU(p3.x(),p3.y(),p3.z(),u)) {
-              Msg::Warning("Could not project average position of periodic master %i on edge %i, "
+              Msg::Warning("Could not project average position of periodic master %lu on edge %i, "
                            " -> repositioning",
-                           v->getNum(),master->tag());
+                           (unsigned long)v->getNum(),master->tag());
             }
             GPoint gp = master->point(u);
             v->setXYZ(gp.x(), gp.y(), gp.z());
@@ -243,8 +243,8 @@ void OptHomPeriodicity::_copyBackMasterVertices()
             SPoint3 p = _transform(mv,tfo);
             double u;
             if (!slave->XYZToU(p.x(),p.y(),p.z(),u)) {
-              Msg::Warning("Could not position slave periodic point %i on edge %i within tolerance ",
-                         sv->getNum(),slave->tag());
+              Msg::Warning("Could not position slave periodic point %lu on edge %i within tolerance ",
+                         (unsigned long)sv->getNum(),slave->tag());
             }
             sv->setXYZ(p.x(), p.y(), p.z());
             sv->setParameter(0,u);
@@ -259,8 +259,8 @@ void OptHomPeriodicity::_copyBackMasterVertices()
             SPoint3 p = _transform(mv,tfo);
             double u;
             if (!slave->XYZToU(p.x(),p.y(),p.z(),u)) {
-              Msg::Warning("Could not position slave periodic point %i on edge %i within tolerance",
-                         sv->getNum(),slave->tag());
+              Msg::Warning("Could not position slave periodic point %lu on edge %i within tolerance",
+                         (unsigned long)sv->getNum(),slave->tag());
             }
             sv->setXYZ(p.x(), p.y(), p.z());
             sv->setParameter(0,u);
@@ -692,6 +692,47 @@
          return evalstack[0];
       } // eval()
 
+   // export the parsed code, with the addresses of the variables and functions
+   // instead of their indices in the tables
+       void mathex::getcode(vector<instruction> &code)
+      {
+         if(status == notparsed) parse();
+         if(status == invalid) throw error("getcode()", "invalid expression");
+
+         code.resize(bytecode.size());
+         for(unsigned i=0; i<bytecode.size(); i++) {
+            instruction &c = code[i];
+            c = instruction();
+            switch(bytecode[i].state) {
+               case CODETOKEN::VALUE:
+                  c.state = instruction::VALUE;
+                  c.value = bytecode[i].value;
+                  break;
+               case CODETOKEN::VARIABLE:
+                  c.state = instruction::VARIABLE;
+                  c.var = vartable[bytecode[i].idx].var;
+                  break;
+               case CODETOKEN::FUNCTION:
+                  c.state = instruction::FUNCTION;
+                  c.name = cfunctable[bytecode[i].idx].name;
+                  c.f1 = cfunctable[bytecode[i].idx].f;
+                  break;
+               case CODETOKEN::BINOP:
+                  c.state = instruction::BINOP;
+                  c.name = &binoptable[bytecode[i].idx].name;
+                  c.f2 = binoptable[bytecode[i].idx].f;
+                  break;
+               case CODETOKEN::USERFUNC:
+                  c.state = instruction::USERFUNC;
+                  c.numargs = bytecode[i].numargs;
+                  c.fn = functable[bytecode[i].idx].f;
+                  break;
+               default:
+                  throw  error("getcode()", "invalid code token");
+            }
+         }
+      } // getcode()
+
    /////////////////
    // parser
    //---------------
@@ -255,6 +255,25 @@ using namespace std;
          return pos; }
       void parse(); /// < parse expression 
       double eval(); /// < eval expression
+
+      /// parsed code token with resolved variable and function addresses,
+      /// for evaluators that run the code without going through eval()
+      class instruction {
+      public:
+         enum type {VALUE=0, VARIABLE, FUNCTION, BINOP, USERFUNC};
+         type state;
+         unsigned numargs; // number of arguments of USERFUNC
+         double value; // VALUE
+         double *var; // VARIABLE
+         const char *name; // FUNCTION name, BINOP name in name[0]
+         double (*f1)(double); // FUNCTION
+         double (*f2)(double, double); // BINOP
+         double (*fn)(vector<double> const &); // USERFUNC
+          instruction()
+         { state = VALUE; numargs = 0; value = 0.; var = 0; name = "";
+           f1 = 0; f2 = 0; fn = 0; }
+      };
+      void getcode(vector<instruction> &code); /// < parse if needed and export code
       void reset(); /// < reset all
        mathex() /// < default constructor
       {reset();}
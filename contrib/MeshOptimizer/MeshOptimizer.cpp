@@ -414,6 +414,115 @@ void  updateDisplayPatchHistory(std::list<char*> &_patchHistory, const std::stri
 }
 
 
+#if defined(_OPENMP)
+
+// Sort the patches in groups such that the patches of a group do not share any
+// vertex: the patches of a group can then be optimized concurrently, and each
+// of them reads the vertex positions written by the patches of the previous
+// groups only, which makes the result independent of the number of threads.
+// Patches are assigned greedily to the first possible group, in order.
+static void getIndependentPatchGroups(const std::vector<elSetVertSetPair> &toOptimize,
+                                      const std::vector<elSet> &bndElts,
+                                      std::vector<std::vector<int> > &groups)
+{
+  std::map<MVertex*, std::vector<int> > vertexGroups;
+  for (int iPatch = 0; iPatch < toOptimize.size(); ++iPatch) {
+    vertSet verts(toOptimize[iPatch].second);
+    const elSet &els = toOptimize[iPatch].first;
+    for (elSet::const_iterator it = els.begin(); it != els.end(); ++it)
+      for (int i = 0; i < (*it)->getNumVertices(); i++)
+        verts.insert((*it)->getVertex(i));
+    for (elSet::const_iterator it = bndElts[iPatch].begin();
+         it != bndElts[iPatch].end(); ++it)
+      for (int i = 0; i < (*it)->getNumVertices(); i++)
+        verts.insert((*it)->getVertex(i));
+    std::set<int> used;
+    for (vertSet::iterator it = verts.begin(); it != verts.end(); ++it) {
+      std::map<MVertex*, std::vector<int> >::iterator itV =
+        vertexGroups.find(*it);
+      if (itV != vertexGroups.end())
+        used.insert(itV->second.begin(), itV->second.end());
+    }
+    int iGroup = 0;
+    while (used.count(iGroup)) iGroup++;
+    if (iGroup == groups.size()) groups.push_back(std::vector<int>());
+    groups[iGroup].push_back(iPatch);
+    for (vertSet::iterator it = verts.begin(); it != verts.end(); ++it)
+      vertexGroups[*it].push_back(iGroup);
+  }
+}
+
+// Optimize the patches concurrently, one group of independent patches after
+// the other
+static void optimizeIndependentPatches(const elEntMap &e2eOpt,
+                                       const elEntMap &bndEl2Ent,
+                                       std::vector<elSetVertSetPair> &toOptimize,
+                                       const std::vector<elSet> &bndElts,
+                                       MeshOptParameters &par,
+                                       int nbPatchSuccess[3],
+                                       std::vector<std::pair<double,double> > &newObjFunctionRange,
+                                       std::vector<std::string> &objFunctionNames)
+{
+  std::vector<std::vector<int> > groups;
+  getIndependentPatchGroups(toOptimize, bndElts, groups);
+  Msg::Info("Optimizing %lu patches in %lu groups of independent patches",
+            (unsigned long)toOptimize.size(), (unsigned long)groups.size());
+
+  std::vector<int> success(toOptimize.size(), -1);
+  std::vector<std::vector<std::pair<double,double> > > range(toOptimize.size());
+  for (int iGroup = 0; iGroup < groups.size(); ++iGroup) {
+    const std::vector<int> &group = groups[iGroup];
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int i = 0; i < group.size(); ++i) {
+      const int iPatch = group[i];
+      if (par.verbose > 1)
+        Msg::Info("Optimizing patch %i/%lu composed of %lu elements, "
+                  "%lu boundary elements", iPatch,
+                  (unsigned long)toOptimize.size()-1,
+                  (unsigned long)toOptimize[iPatch].first.size(),
+                  (unsigned long)bndElts[iPatch].size());
+      MeshOpt opt(e2eOpt, bndEl2Ent, toOptimize[iPatch].first,
+                  toOptimize[iPatch].second, bndElts[iPatch], par);
+      if (par.verbose > 3) {
+        std::ostringstream ossI1;
+        ossI1 << "initial_patch-" << iPatch << ".msh";
+        opt.patch.writeMSH(ossI1.str().c_str());
+      }
+      if (opt.patch.nPC() > 0)
+        success[iPatch] = opt.optimize(par);
+      else
+        if (par.verbose > 1) Msg::Info("Patch %i has no degree of freedom, skipping", iPatch);
+      if (par.verbose > 3) {
+        std::ostringstream ossI2;
+        ossI2 << "final_patch-" << iPatch << ".msh";
+        opt.patch.writeMSH(ossI2.str().c_str());
+      }
+      opt.updateResults();
+      range[iPatch] = opt.objFunction()->minMax();
+      if (iPatch == 0) objFunctionNames = opt.objFunction()->names();
+      // the vertices of the patch are not read by the other patches of the
+      // group
+      if (success[iPatch] >= 0) opt.patch.updateGEntityPositions();
+    }
+  }
+
+  // gather the results in the order of the patches
+  for (int iPatch = 0; iPatch < toOptimize.size(); ++iPatch) {
+    if (iPatch == 0)
+      newObjFunctionRange = range[iPatch];
+    else {
+      for (int i = 0; i < newObjFunctionRange.size(); i++){
+        newObjFunctionRange[i].first = std::min(newObjFunctionRange[i].first, range[iPatch][i].first);
+        newObjFunctionRange[i].second = std::max(newObjFunctionRange[i].second, range[iPatch][i].second);
+      }
+    }
+    par.success = std::min(par.success, success[iPatch]);
+    nbPatchSuccess[success[iPatch]+1]++;
+  }
+}
+
+#endif
+
 void optimizeDisjointPatches(const vertElVecMap &vertex2elements,
                              const elEntMap &element2entity,
                              const elElMap &el2BndEl,
@@ -442,6 +551,19 @@ void optimizeDisjointPatches(const vertElVecMap &vertex2elements,
     for (int iPatch = 0; iPatch < toOptimize.size(); ++iPatch)
       getAdjacentBndElts(el2BndEl, bndEl2Ent, toOptimize[iPatch].first, bndElts[iPatch], par);
   }
+
+#if defined(_OPENMP)
+  // the patches are disjoint: optimize them concurrently if several threads
+  // are available (not with the ncurses interface, which displays the
+  // progress patch by patch)
+  if (Msg::GetMaxThreads() > 1 && !par.nCurses && toOptimize.size() > 1) {
+    optimizeIndependentPatches(e2eOpt, bndEl2Ent, toOptimize, bndElts, par,
+                               nbPatchSuccess, newObjFunctionRange,
+                               objFunctionNames);
+    return;
+  }
+#endif
+
   if (par.nCurses)
     displayResultTable(nbPatchSuccess, toOptimize.size());
   for (int iPatch = 0; iPatch < toOptimize.size(); ++iPatch) {
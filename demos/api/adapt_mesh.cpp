@@ -69,11 +69,11 @@ class myMesh{
  public:
   myMesh()
   {
-    std::vector<int> vtags;
+    std::vector<std::size_t> vtags;
     std::vector<double> vxyz, vuvw;
     gmsh::model::mesh::getNodes(vtags, vxyz, vuvw);
     std::vector<int> etypes;
-    std::vector<std::vector<int> > etags, evtags;
+    std::vector<std::vector<std::size_t> > etags, evtags;
     gmsh::model::mesh::getElements(etypes, etags, evtags);
     for(unsigned int i = 0; i < vtags.size(); i++){
       _nodes[vtags[i]] = new myVertex
@@ -188,7 +188,7 @@ void computeSizeField(const myMesh &mesh,
 }
 
 void getKeysValues(const std::map<int, double> &f,
-                   std::vector<int> &keys,
+                   std::vector<std::size_t> &keys,
                    std::vector<std::vector<double> > &values)
 {
   keys.clear();
@@ -231,7 +231,7 @@ int main(int argc, char **argv)
   myFunction f;
   std::map<int, double> f_nod, err_ele;
   computeInterpolationError(mesh, f, f_nod, err_ele);
-  std::vector<int> keys;
+  std::vector<std::size_t> keys;
   std::vector<std::vector<double> > values;
   int f_view = gmsh::view::add("nodal function");
   getKeysValues(f_nod, keys, values);